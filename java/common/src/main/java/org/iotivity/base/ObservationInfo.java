@@ -25,18 +25,27 @@ package org.iotivity.base;
 public class ObservationInfo {
 
     private ObserveAction mObserveAction;
-    private byte mOcObservationId;
+    private int mOcObservationId;
 
-    private ObservationInfo(int observationAction, byte observationId) {
+    private ObservationInfo(int observationAction, int observationId) {
         this.mObserveAction = ObserveAction.get(observationAction);
         this.mOcObservationId = observationId;
     }
 
-    public ObservationInfo(ObserveAction observeAction, byte observationId) {
+    public ObservationInfo(ObserveAction observeAction, int observationId) {
         this.mObserveAction = observeAction;
         this.mOcObservationId = observationId;
     }
 
+    /**
+     * @deprecated observation ids no longer fit in a byte, use
+     *             {@link #ObservationInfo(ObserveAction, int)} instead.
+     */
+    @Deprecated
+    public ObservationInfo(ObserveAction observeAction, byte observationId) {
+        this(observeAction, observationId & 0xFF);
+    }
+
     public ObserveAction getObserveAction() {
         return mObserveAction;
     }
@@ -45,11 +54,29 @@ public class ObservationInfo {
         this.mObserveAction = observeAction;
     }
 
-    public byte getOcObservationId() {
+    public int getObservationId() {
         return mOcObservationId;
     }
 
+    public void setObservationId(int observationId) {
+        this.mOcObservationId = observationId;
+    }
+
+    /**
+     * @deprecated observation ids no longer fit in a byte and are truncated here, use
+     *             {@link #getObservationId()} instead.
+     */
+    @Deprecated
+    public byte getOcObservationId() {
+        return (byte) mOcObservationId;
+    }
+
+    /**
+     * @deprecated observation ids no longer fit in a byte, use
+     *             {@link #setObservationId(int)} instead.
+     */
+    @Deprecated
     public void setOcObservationId(byte ocObservationId) {
-        this.mOcObservationId = ocObservationId;
+        this.mOcObservationId = ocObservationId & 0xFF;
     }
 }
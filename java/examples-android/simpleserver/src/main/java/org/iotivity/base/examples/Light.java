@@ -230,7 +230,7 @@ public class Light implements OcPlatform.EntityHandler {
         sendResponse(response);
     }
 
-    private List<Byte> mObservationIds; //IDs of observes
+    private List<Integer> mObservationIds; //IDs of observes
 
     private EntityHandlerResult handleObserver(final OcResourceRequest request) {
         ObservationInfo observationInfo = request.getObservationInfo();
@@ -239,10 +239,10 @@ public class Light implements OcPlatform.EntityHandler {
                 if (null == mObservationIds) {
                     mObservationIds = new LinkedList<>();
                 }
-                mObservationIds.add(observationInfo.getOcObservationId());
+                mObservationIds.add(observationInfo.getObservationId());
                 break;
             case UNREGISTER:
-                mObservationIds.remove((Byte)observationInfo.getOcObservationId());
+                mObservationIds.remove((Integer)observationInfo.getObservationId());
                 break;
         }
         // Observation happens on a different thread in notifyObservers method.
@@ -270,9 +270,13 @@ public class Light implements OcPlatform.EntityHandler {
                 if (mIsListOfObservers) {
                     OcResourceResponse response = new OcResourceResponse();
                     response.setResourceRepresentation(getOcRepresentation());
+                    int[] observationIds = new int[mObservationIds.size()];
+                    for (int i = 0; i < observationIds.length; i++) {
+                        observationIds[i] = mObservationIds.get(i);
+                    }
                     OcPlatform.notifyListOfObservers(
                             mResourceHandle,
-                            mObservationIds,
+                            observationIds,
                             response);
                 } else {
                     OcPlatform.notifyAllObservers(mResourceHandle);
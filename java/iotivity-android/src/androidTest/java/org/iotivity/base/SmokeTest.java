@@ -1537,7 +1537,7 @@ public class SmokeTest extends InstrumentationTestCase {
             }
         };
 
-        final List<Byte> observationIdList = new LinkedList<Byte>();
+        final List<Integer> observationIdList = new LinkedList<Integer>();
         OcPlatform.EntityHandler entityHandler = new OcPlatform.EntityHandler() {
             @Override
             public EntityHandlerResult handleEntity(OcResourceRequest ocResourceRequest) {
@@ -1574,7 +1574,7 @@ public class SmokeTest extends InstrumentationTestCase {
                     switch (observationInfo.getObserveAction()) {
                         case REGISTER:
                             synchronized (observationIdList) {
-                                observationIdList.add(observationInfo.getOcObservationId());
+                                observationIdList.add(observationInfo.getObservationId());
                                 timer.schedule(new TimerTask() {
                                     int numNotified = 1;
 
@@ -195,7 +195,10 @@ public final class OcPlatform {
      * @param ocResourceResponse  OcResourceResponse object used by app to fill the response for
      *                            this resource change
      * @throws OcException if failure
+     * @deprecated observation ids no longer fit in a byte, use
+     *             {@link #notifyListOfObservers(OcResourceHandle, int[], OcResourceResponse)}
      */
+    @Deprecated
     public static void notifyListOfObservers(
             OcResourceHandle ocResourceHandle,
             List<Byte> ocObservationIdList,
@@ -206,22 +209,44 @@ public final class OcPlatform {
             throw new OcException(ErrorCode.INVALID_PARAM, "ocObservationIdList cannot be null");
         }
 
-        byte[] idArr = new byte[ocObservationIdList.size()];
-        Iterator<Byte> it = ocObservationIdList.iterator();
-        int i = 0;
-        while (it.hasNext()) {
-            idArr[i++] = (byte) it.next();
+        OcPlatform.notifyListOfObservers2(
+                ocResourceHandle,
+                toObservationIdArray(ocObservationIdList),
+                ocResourceResponse);
+    }
+
+    /**
+     * API for notifying only specific clients that resource's attributes have changed.
+     * <p>
+     * Note: This API is for server side only.
+     * </p>
+     *
+     * @param ocResourceHandle   resource handle of the resource
+     * @param ocObservationIds   These set of ids are ones which which will be notified upon
+     *                           resource change.
+     * @param ocResourceResponse OcResourceResponse object used by app to fill the response for
+     *                           this resource change
+     * @throws OcException if failure
+     */
+    public static void notifyListOfObservers(
+            OcResourceHandle ocResourceHandle,
+            int[] ocObservationIds,
+            OcResourceResponse ocResourceResponse) throws OcException {
+        OcPlatform.initCheck();
+
+        if (ocObservationIds == null) {
+            throw new OcException(ErrorCode.INVALID_PARAM, "ocObservationIds cannot be null");
         }
 
         OcPlatform.notifyListOfObservers2(
                 ocResourceHandle,
-                idArr,
+                ocObservationIds,
                 ocResourceResponse);
     }
 
     private static native void notifyListOfObservers2(
             OcResourceHandle ocResourceHandle,
-            byte[] ocObservationIdArray,
+            int[] ocObservationIdArray,
             OcResourceResponse ocResourceResponse) throws OcException;
 
     /**
@@ -237,7 +262,11 @@ public final class OcPlatform {
      *                            this resource change
      * @param qualityOfService    the quality of communication
      * @throws OcException if failure
+     * @deprecated observation ids no longer fit in a byte, use
+     *             {@link #notifyListOfObservers(OcResourceHandle, int[], OcResourceResponse,
+     *             QualityOfService)}
      */
+    @Deprecated
     public static void notifyListOfObservers(
             OcResourceHandle ocResourceHandle,
             List<Byte> ocObservationIdList,
@@ -249,24 +278,61 @@ public final class OcPlatform {
             throw new OcException(ErrorCode.INVALID_PARAM, "ocObservationIdList cannot be null");
         }
 
-        byte[] idArr = new byte[ocObservationIdList.size()];
-        Iterator<Byte> it = ocObservationIdList.iterator();
-        int i = 0;
-        while (it.hasNext()) {
-            idArr[i++] = (byte) it.next();
+        OcPlatform.notifyListOfObservers3(
+                ocResourceHandle,
+                toObservationIdArray(ocObservationIdList),
+                ocResourceResponse,
+                qualityOfService.getValue()
+        );
+    }
+
+    /**
+     * API for notifying only specific clients that resource's attributes have changed.
+     * <p>
+     * Note: This API is for server side only.
+     * </p>
+     *
+     * @param ocResourceHandle   resource handle of the resource
+     * @param ocObservationIds   These set of ids are ones which which will be notified upon
+     *                           resource change.
+     * @param ocResourceResponse OcResourceResponse object used by app to fill the response for
+     *                           this resource change
+     * @param qualityOfService   the quality of communication
+     * @throws OcException if failure
+     */
+    public static void notifyListOfObservers(
+            OcResourceHandle ocResourceHandle,
+            int[] ocObservationIds,
+            OcResourceResponse ocResourceResponse,
+            QualityOfService qualityOfService) throws OcException {
+        OcPlatform.initCheck();
+
+        if (ocObservationIds == null) {
+            throw new OcException(ErrorCode.INVALID_PARAM, "ocObservationIds cannot be null");
         }
 
         OcPlatform.notifyListOfObservers3(
                 ocResourceHandle,
-                idArr,
+                ocObservationIds,
                 ocResourceResponse,
                 qualityOfService.getValue()
         );
     }
 
+    // Byte ids were passed on as unsigned 8 bit values.
+    private static int[] toObservationIdArray(List<Byte> ocObservationIdList) {
+        int[] idArr = new int[ocObservationIdList.size()];
+        Iterator<Byte> it = ocObservationIdList.iterator();
+        int i = 0;
+        while (it.hasNext()) {
+            idArr[i++] = it.next() & 0xFF;
+        }
+        return idArr;
+    }
+
     private static native void notifyListOfObservers3(
             OcResourceHandle ocResourceHandle,
-            byte[] ocObservationIdArray,
+            int[] ocObservationIdArray,
             OcResourceResponse ocResourceResponse,
             int qualityOfService) throws OcException;
 
@@ -710,13 +710,13 @@ JNIEXPORT void JNICALL Java_org_iotivity_base_OcPlatform_notifyAllObservers1
 /*
 * Class:     org_iotivity_base_OcPlatform
 * Method:    notifyListOfObservers2
-* Signature: (Lorg/iotivity/base/OcResourceHandle;[Ljava/lang/Byte;Lorg/iotivity/base/OcResourceResponse;)V
+* Signature: (Lorg/iotivity/base/OcResourceHandle;[ILorg/iotivity/base/OcResourceResponse;)V
 */
 JNIEXPORT void JNICALL Java_org_iotivity_base_OcPlatform_notifyListOfObservers2(
     JNIEnv *env,
     jclass clazz,
     jobject jResourceHandle,
-    jbyteArray jObservationIdArr,
+    jintArray jObservationIdArr,
     jobject jResourceResponse)
 {
     LOGD("OcPlatform_notifyListOfObservers2");
@@ -751,15 +751,11 @@ JNIEXPORT void JNICALL Java_org_iotivity_base_OcPlatform_notifyListOfObservers2(
     }
 
     int len = env->GetArrayLength(jObservationIdArr);
-    uint8_t* bArr = (uint8_t*)env->GetByteArrayElements(jObservationIdArr, 0);
+    jint* idArr = env->GetIntArrayElements(jObservationIdArr, 0);
 
-    ObservationIds observationIds;
-    for (int i = 0; i < len; ++i)
-    {
-        observationIds.push_back(bArr[i]);
-    }
+    ObservationIds observationIds(idArr, idArr + len);
 
-    env->ReleaseByteArrayElements(jObservationIdArr, (jbyte*)bArr, 0);
+    env->ReleaseIntArrayElements(jObservationIdArr, idArr, JNI_ABORT);
 
     try
     {
@@ -783,13 +779,13 @@ JNIEXPORT void JNICALL Java_org_iotivity_base_OcPlatform_notifyListOfObservers2(
 /*
 * Class:     org_iotivity_base_OcPlatform
 * Method:    notifyListOfObservers3
-* Signature: (Lorg/iotivity/base/OcResourceHandle;[Ljava/lang/Byte;Lorg/iotivity/base/OcResourceResponse;I)V
+* Signature: (Lorg/iotivity/base/OcResourceHandle;[ILorg/iotivity/base/OcResourceResponse;I)V
 */
 JNIEXPORT void JNICALL Java_org_iotivity_base_OcPlatform_notifyListOfObservers3(
     JNIEnv *env,
     jclass clazz,
     jobject jResourceHandle,
-    jbyteArray jObservationIdArr,
+    jintArray jObservationIdArr,
     jobject jResourceResponse,
     jint jQoS)
 {
@@ -825,15 +821,11 @@ JNIEXPORT void JNICALL Java_org_iotivity_base_OcPlatform_notifyListOfObservers3(
     }
 
     int len = env->GetArrayLength(jObservationIdArr);
-    uint8_t* bArr = (uint8_t*)env->GetByteArrayElements(jObservationIdArr, 0);
+    jint* idArr = env->GetIntArrayElements(jObservationIdArr, 0);
 
-    ObservationIds observationIds;
-    for (int i = 0; i < len; ++i)
-    {
-        observationIds.push_back(bArr[i]);
-    }
+    ObservationIds observationIds(idArr, idArr + len);
 
-    env->ReleaseByteArrayElements(jObservationIdArr, (jbyte*)bArr, 0);
+    env->ReleaseIntArrayElements(jObservationIdArr, idArr, JNI_ABORT);
 
     try
     {
@@ -143,6 +143,17 @@ typedef struct
 // Todo: This struct will be refactored once Zigbee_Wrapper is finished.
 } PIZigbeeProfile;
 
+/**
+ * Last value a ZigBee device reported for one attribute of a resource.
+ */
+typedef struct PIZigbeeAttributeValue
+{
+    char * attributeId;
+    char * value;
+    uint64_t updated; // Monotonic time of the report, in seconds.
+    struct PIZigbeeAttributeValue * next;
+} PIZigbeeAttributeValue;
+
 /**
  * Parameter list for a resource. Abstraction of PIResource.
  */
@@ -153,6 +164,7 @@ typedef struct
     char * nodeId;
     char * endpointId;
     char * clusterId;
+    PIZigbeeAttributeValue * attributeCache;
 } PIResource_Zigbee;
 
 #ifdef __cplusplus
@@ -238,6 +238,15 @@ OCStackResult DeleteResource(PIPluginBase * plugin, PIResourceBase * resource)
         OICFree (((PIResource_Zigbee *)resource)->nodeId);
         OICFree (((PIResource_Zigbee *)resource)->endpointId);
         OICFree (((PIResource_Zigbee *)resource)->clusterId);
+
+        PIZigbeeAttributeValue * cached = NULL;
+        PIZigbeeAttributeValue * tmp = NULL;
+        LL_FOREACH_SAFE(((PIResource_Zigbee *)resource)->attributeCache, cached, tmp)
+        {
+            OICFree (cached->attributeId);
+            OICFree (cached->value);
+            OICFree (cached);
+        }
     }
     OICFree (resource);
     return OC_STACK_OK;
@@ -32,7 +32,9 @@
 
 #include <stdbool.h>
 #include <string.h>
+#include <strings.h>
 #include <stdlib.h>
+#include <time.h>
 #include <inttypes.h> // To convert "int64_t" to string.
 #include <math.h>
 #include <errno.h>
@@ -50,6 +52,7 @@
 #include "pluginlist.h"
 
 #include "ocpayload.h"
+#include <coap/utlist.h>
 #include "oic_malloc.h"
 #include "oic_string.h"
 #include "logger.h"
@@ -101,6 +104,12 @@
 #define MAX_STRLEN_DOUBLE (3 + DBL_MANT_DIG - DBL_MIN_EXP)
 #define MAX_STRLEN_BOOL (1)
 
+// Reporting intervals asked of devices, in seconds. A reported value is served from
+// the cache until two maximum intervals pass without a new report.
+#define ZB_REPORT_MIN_INTERVAL               (1)
+#define ZB_REPORT_MAX_INTERVAL               (300)
+#define ZB_ATTRIBUTE_CACHE_MAX_AGE           (2 * ZB_REPORT_MAX_INTERVAL)
+
 #define DEFAULT_TRANS_TIME "0000"
 #define DEFAULT_MOVETOLEVEL_MODE "0"
 
@@ -146,6 +155,7 @@ typedef enum
 } ZigBeeAttributeDataType;
 
 char * getZBDataTypeString(ZigBeeAttributeDataType attrType);
+char * getZBReportableChange(ZigBeeAttributeDataType attrType);
 OCEntityHandlerResult ProcessEHRequest(PIPluginBase * plugin, OCEntityHandlerRequest *ehRequest,
         OCRepPayload **payload);
 
@@ -197,6 +207,85 @@ bool getZigBeeAttributesIfValid(const char * OICResourceType,
                                     AttributeList *attributeList,
                                     OCRepPayload *payload);
 
+static uint64_t getMonotonicSeconds(void)
+{
+    struct timespec now = { .tv_sec = 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec;
+}
+
+static const char * getCachedAttributeValue(PIResource_Zigbee * piResource,
+                                            const char * attributeId)
+{
+    PIZigbeeAttributeValue * cached = NULL;
+    LL_FOREACH(piResource->attributeCache, cached)
+    {
+        if (strcasecmp(cached->attributeId, attributeId) == 0)
+        {
+            if (getMonotonicSeconds() - cached->updated > ZB_ATTRIBUTE_CACHE_MAX_AGE)
+            {
+                // The device stopped reporting; don't trust the last report.
+                return NULL;
+            }
+            return cached->value;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Stores a reported value. Returns true if the value differs from the cached one.
+ */
+static bool updateCachedAttributeValue(PIResource_Zigbee * piResource,
+                                       const char * attributeId,
+                                       const char * value)
+{
+    PIZigbeeAttributeValue * cached = NULL;
+    LL_FOREACH(piResource->attributeCache, cached)
+    {
+        if (strcasecmp(cached->attributeId, attributeId) == 0)
+        {
+            break;
+        }
+    }
+    if (!cached)
+    {
+        cached = (PIZigbeeAttributeValue *) OICCalloc(1, sizeof(*cached));
+        if (!cached)
+        {
+            OIC_LOG(ERROR, TAG, "Out of memory");
+            return false;
+        }
+        cached->attributeId = OICStrdup(attributeId);
+        if (!cached->attributeId)
+        {
+            OIC_LOG(ERROR, TAG, "Out of memory");
+            OICFree(cached);
+            return false;
+        }
+        LL_PREPEND(piResource->attributeCache, cached);
+    }
+    cached->updated = getMonotonicSeconds();
+    if (cached->value && strcmp(cached->value, value) == 0)
+    {
+        return false;
+    }
+    OICFree(cached->value);
+    cached->value = OICStrdup(value);
+    return true;
+}
+
+static void clearAttributeCache(PIResource_Zigbee * piResource)
+{
+    PIZigbeeAttributeValue * cached = NULL;
+    LL_FOREACH(piResource->attributeCache, cached)
+    {
+        OICFree(cached->value);
+        cached->value = NULL;
+        cached->updated = 0;
+    }
+}
+
 const char * getResourceTypeForIASZoneType(TWDevice *device, PIPluginBase* plugin)
 {
     if (!device)
@@ -316,6 +405,41 @@ exit:
     return OC_STACK_NO_MEMORY;
 }
 
+static void configureAttributeReporting(PIResource_Zigbee * piResource, PIPlugin_Zigbee* plugin)
+{
+    AttributeList attributeList = { 0, (CIECommandMask) 0,
+        .list[0] = { NULL, NULL, OIC_ATTR_NULL, ZB_NULL, { .i = 0 } } };
+    OCStackResult result = getZigBeeAttributesForOICResource(
+        piResource->header.piResource.resourceTypeName, &attributeList);
+    if (result != OC_STACK_OK)
+    {
+        OIC_LOG_V(ERROR, TAG, "Failed to fetch attributes for %s",
+            piResource->header.piResource.resourceTypeName);
+        return;
+    }
+
+    for (uint32_t i = 0; i < attributeList.count; i++)
+    {
+        result = TWConfigureReporting(piResource->eui,
+                                      piResource->nodeId,
+                                      piResource->endpointId,
+                                      piResource->clusterId,
+                                      attributeList.list[i].zigBeeAttribute,
+                                      getZBDataTypeString(attributeList.list[i].zigbeeType),
+                                      getZBReportableChange(attributeList.list[i].zigbeeType),
+                                      ZB_REPORT_MIN_INTERVAL,
+                                      ZB_REPORT_MAX_INTERVAL,
+                                      plugin);
+        if (result != OC_STACK_OK)
+        {
+            // Not fatal: GETs keep reading this attribute from the device.
+            OIC_LOG_V(ERROR, TAG, "Failed to configure reporting of %s",
+                attributeList.list[i].zigBeeAttribute);
+        }
+        OICFree(attributeList.list[i].oicAttribute);
+    }
+}
+
 void foundZigbeeCallback(TWDevice *device, PIPlugin_Zigbee* plugin)
 {
     if (!device)
@@ -389,7 +513,14 @@ void foundZigbeeCallback(TWDevice *device, PIPlugin_Zigbee* plugin)
         piResource->endpointId = OICStrdup(device->endpointOfInterest->endpointId);
         piResource->clusterId =
             OICStrdup(device->endpointOfInterest->clusterList->clusterIds[i].clusterId);
+        piResource->attributeCache = NULL;
         plugin->header.NewResourceFoundCB(&(plugin)->header, &piResource->header);
+
+        // IAS zones already push their state through zone status updates.
+        if (strcmp(foundClusterID, ZB_IAS_ZONE_CLUSTER) != 0)
+        {
+            configureAttributeReporting(piResource, plugin);
+        }
     }
 }
 
@@ -416,6 +547,32 @@ void zigbeeZoneStatusUpdate(TWUpdate * update, PIPlugin_Zigbee* plugin)
                                                  piResource->header.piResource.resourceHandle);
 }
 
+static void zigbeeAttributeReport(TWAttributeReport * report, PIPlugin_Zigbee* plugin)
+{
+    if (!report || !report->value)
+    {
+        return;
+    }
+
+    PIResource_Zigbee * piResource = NULL;
+    OCStackResult result = GetResourceFromZigBeeNodeId((PIPluginBase *)plugin,
+                                                    &piResource,
+                                                    report->nodeId,
+                                                    report->endpoint,
+                                                    report->clusterId);
+    if (result != OC_STACK_OK || !piResource)
+    {
+        OIC_LOG_V(ERROR, TAG, "Failed to retrieve resource handle with result: %d", result);
+        return;
+    }
+
+    if (updateCachedAttributeValue(piResource, report->attributeId, report->value))
+    {
+        plugin->header.ObserveNotificationUpdate((PIPluginBase *)plugin,
+                                                 piResource->header.piResource.resourceHandle);
+    }
+}
+
 void deviceNodeIdChanged(const char * eui, const char * nodeId, PIPlugin_Zigbee* plugin)
 {
     if(!eui || !nodeId)
@@ -462,6 +619,11 @@ OCStackResult ZigbeeInit(const char * comPort, PIPlugin_Zigbee ** plugin,
     {
         return result;
     }
+    result = TWSetAttributeReportCallback(zigbeeAttributeReport, *plugin);
+    if(result != OC_STACK_OK)
+    {
+        return result;
+    }
     return TWSetEndDeviceNodeIdChangedCallback(deviceNodeIdChanged, *plugin);
 }
 
@@ -847,21 +1009,58 @@ OCEntityHandlerResult processGetRequest(PIPluginBase * plugin,
         OCRepPayloadDestroy(*payload);
         return OC_EH_ERROR;
     }
+
+    // Serve recently reported values from the cache and read the rest in one go
+    // rather than one round-trip each.
+    char * outVals[MAX_ATTRIBUTES] = { NULL };
+    char * zigBeeAttributes[MAX_ATTRIBUTES] = { NULL };
+    uint32_t readIndexes[MAX_ATTRIBUTES] = { 0 };
+    uint8_t readCount = 0;
     for (uint32_t i = 0; i<attributeList.count; i++)
     {
-        char * outVal = NULL;
-        uint8_t outValLength = 0;
+        const char * cachedVal = getCachedAttributeValue(piResource,
+                                     attributeList.list[i].zigBeeAttribute);
+        if (cachedVal)
+        {
+            outVals[i] = OICStrdup(cachedVal);
+        }
+        else
+        {
+            zigBeeAttributes[readCount] = attributeList.list[i].zigBeeAttribute;
+            readIndexes[readCount] = i;
+            readCount++;
+        }
+    }
+    if (readCount > 0)
+    {
+        char * readVals[MAX_ATTRIBUTES] = { NULL };
+        uint8_t readValLengths[MAX_ATTRIBUTES] = { 0 };
+        stackResult = TWGetAttributes(piResource->eui,
+                                      piResource->nodeId,
+                                      piResource->endpointId,
+                                      piResource->clusterId,
+                                      zigBeeAttributes,
+                                      readCount,
+                                      readVals,
+                                      readValLengths,
+                                      (PIPlugin_Zigbee *)plugin);
+        if (stackResult != OC_STACK_OK)
+        {
+            stackResult = OC_EH_ERROR;
+            OCRepPayloadDestroy(*payload);
+            goto exit;
+        }
+        for (uint8_t k = 0; k < readCount; k++)
+        {
+            outVals[readIndexes[k]] = readVals[k];
+        }
+    }
 
-        stackResult = TWGetAttribute(piResource->eui,
-                                     piResource->nodeId,
-                                     piResource->endpointId,
-                                     piResource->clusterId,
-                                     attributeList.list[i].zigBeeAttribute,
-                                     &outVal,
-                                     &outValLength,
-                                     (PIPlugin_Zigbee *)plugin);
+    for (uint32_t i = 0; i<attributeList.count; i++)
+    {
+        char * outVal = outVals[i];
 
-        if (stackResult != OC_STACK_OK || !outVal)
+        if (!outVal)
         {
             stackResult = OC_EH_ERROR;
             OCRepPayloadDestroy(*payload);
@@ -876,11 +1075,13 @@ OCEntityHandlerResult processGetRequest(PIPluginBase * plugin,
 
             if (*endPtr != 0 || errno != 0)
             {
-                return OC_EH_ERROR;
+                stackResult = OC_EH_ERROR;
+                goto exit;
             }
             if (!attributeList.list[i].oicAttribute)
             {
-                return OC_EH_ERROR;
+                stackResult = OC_EH_ERROR;
+                goto exit;
             }
             if (strcmp(attributeList.list[i].oicAttribute, OIC_DIMMING_ATTRIBUTE) == 0)
             {
@@ -928,11 +1129,13 @@ OCEntityHandlerResult processGetRequest(PIPluginBase * plugin,
 
             if (getDoubleValueFromString(outVal, &value) != OC_EH_OK)
             {
-                return OC_EH_ERROR;
+                stackResult = OC_EH_ERROR;
+                goto exit;
             }
             if (!piResource->clusterId)
             {
-                return OC_EH_ERROR;
+                stackResult = OC_EH_ERROR;
+                goto exit;
             }
             if (strcmp(piResource->clusterId, ZB_TEMPERATURE_CLUSTER) == 0)
             {
@@ -959,7 +1162,8 @@ OCEntityHandlerResult processGetRequest(PIPluginBase * plugin,
 
             if (errno != 0 || *endPtr != 0)
             {
-                return OC_EH_ERROR;
+                stackResult = OC_EH_ERROR;
+                goto exit;
             }
             // value COULD be a bit mask and the LSB indicates boolean true/false.
             // If not a bit mask, it'll be plain 0 or 1.
@@ -968,8 +1172,6 @@ OCEntityHandlerResult processGetRequest(PIPluginBase * plugin,
                                               attributeList.list[i].oicAttribute,
                                               value);
         }
-
-        OICFree(outVal);
     }
 
     if (boolRes == false)
@@ -981,6 +1183,7 @@ OCEntityHandlerResult processGetRequest(PIPluginBase * plugin,
 exit:
     for (; attributeListIndex < attributeList.count; attributeListIndex++)
     {
+        OICFree(outVals[attributeListIndex]);
         OICFree(attributeList.list[attributeListIndex].oicAttribute);
     }
     return stackResult;
@@ -1009,6 +1212,9 @@ OCEntityHandlerResult processPutRequest(PIPluginBase * plugin,
         OIC_LOG(ERROR, TAG, "Failed to get resource from handle");
         return OC_EH_ERROR;
     }
+    // Whatever is written changes the device's state; read it back instead of
+    // serving reports from before the write.
+    clearAttributeCache(piResource);
 
     bool boolRes = getZigBeeAttributesIfValid(
                         piResource->header.piResource.resourceTypeName,
@@ -1229,3 +1435,19 @@ char * getZBDataTypeString(ZigBeeAttributeDataType attrType)
             return ZB_DATA_TYPE_NULL;
     }
 }
+
+char * getZBReportableChange(ZigBeeAttributeDataType attrType)
+{
+    // Analog types report on the smallest change. Discrete types have no
+    // reportable change and report every change.
+    switch (attrType)
+    {
+        case ZB_8_UINT:
+            return "01";
+        case ZB_16_SINT:
+        case ZB_16_UINT:
+            return "0001";
+        default:
+            return NULL;
+    }
+}
@@ -62,6 +62,7 @@ typedef enum
     TW_ENROLLED,
     TW_ZONESTATUS,
     TW_ADDRESS_RESPONSE,
+    TW_REPORTATTR,
     TW_NONE,
     TW_MAX_ENTRY
 } TWEntryType;
@@ -132,6 +133,34 @@ TWResultCode TWIssueATCommand(PIPlugin_Zigbee * plugin, const char * command);
  */
 TWResultCode TWDequeueEntry(PIPlugin_Zigbee * plugin, TWEntry ** entry, TWEntryType type);
 
+/**
+ * Returns true for a queued line which the caller of TWDequeueLine wants.
+ *
+ * @param line A line of a queued entry.
+ *
+ * @param ctx The context passed to TWDequeueLine.
+ */
+typedef bool (*TWLineMatcher)(const char * line, void * ctx);
+
+/**
+ * Returns a single line out of the response/prompt queue. Other lines of the
+ * entry holding it stay queued for other callers.
+ *
+ * @param plugin The plugin' scope which the socket is managed within.
+ *
+ * @param entry An entry holding only the matched line. Returned by-reference,
+ * NULL if no line matched before the timeout. Release with TWDeleteEntry.
+ *
+ * @param type The type of entry the line must be in. Must not be TW_NONE.
+ * Blocks like TWDequeueEntry.
+ *
+ * @param match Called for the lines of queued entries of type until it accepts one.
+ *
+ * @param matchCtx Passed to match.
+ */
+TWResultCode TWDequeueLine(PIPlugin_Zigbee * plugin, TWEntry ** entry, TWEntryType type,
+                           TWLineMatcher match, void * matchCtx);
+
 /**
  * Helper function to deallocate memory of a TWEntry.
  *
@@ -129,11 +129,26 @@ typedef struct
     char eui[SIZE_EUI];
 } TWEnrollee;
 
+/**
+ *
+ * Defines a ZigBee attribute report.
+ *
+ */
+typedef struct
+{
+    char nodeId[SIZE_NODEID];
+    char endpoint[SIZE_ENDPOINTID];
+    char clusterId[SIZE_CLUSTERID];
+    char attributeId[SIZE_ATTRIBUTEID];
+    const char* value;                      //only valid during the callback
+} TWAttributeReport;
+
 typedef void (*TWDeviceFoundCallback)(TWDevice* device, PIPlugin_Zigbee* plugin);
 typedef void (*TWEnrollmentSucceedCallback)(TWEnrollee* enrollee, PIPlugin_Zigbee* plugin);
 typedef void (*TWDeviceStatusUpdateCallback)(TWUpdate* update, PIPlugin_Zigbee* plugin);
 typedef void (*TWDeviceNodeIdChangedCallback)(const char* eui, const char* nodeId,
                                               PIPlugin_Zigbee* plugin);
+typedef void (*TWAttributeReportCallback)(TWAttributeReport* report, PIPlugin_Zigbee* plugin);
 
 /**
  *
@@ -171,6 +186,28 @@ OCStackResult TWGetAttribute(char* extendedUniqueId, char* nodeId, char* endpoin
                              char** outValue, uint8_t* outValueLength,
                              PIPlugin_Zigbee* plugin);
 
+/**
+ *
+ * Gets several values of the same cluster at once. The attributes are read with
+ * as few commands as possible and the responses are matched by attribute id.
+ *
+ * @param[in] extendedUniqueId The extended unique id of the device.
+ * @param[in] nodeId The node id of the device.
+ * @param[in] endpointId The endpoint id from which the attributes belong.
+ * @param[in] clusterId The cluster id from which the attributes belong.
+ * @param[in] attributeIds The attribute ids to read.
+ * @param[in] attributeCount The number of entries in attributeIds.
+ * @param[out] outValues The value of each attribute, in the order of attributeIds.
+ *                       Each value must be freed by the caller.
+ * @param[out] outValueLengths The length of each value.
+ * @param[in] plugin The plugin instance to operate with.
+ *
+ */
+OCStackResult TWGetAttributes(char* extendedUniqueId, char* nodeId, char* endpointId,
+                              char* clusterId, char* attributeIds[], uint8_t attributeCount,
+                              char* outValues[], uint8_t outValueLengths[],
+                              PIPlugin_Zigbee* plugin);
+
 /**
  *
  * Sets a value at the specified parameters.
@@ -292,6 +329,40 @@ OCStackResult TWSetStatusUpdateCallback(TWDeviceStatusUpdateCallback callback,
  */
 OCStackResult TWListenForStatusUpdates(char* nodeId, char* endpointId, PIPlugin_Zigbee* plugin);
 
+/**
+ *
+ * Sets attribute report callback.
+ * This callback will be called when a remote ZigBee device reports an attribute value.
+ *
+ */
+OCStackResult TWSetAttributeReportCallback(TWAttributeReportCallback callback,
+                                           PIPlugin_Zigbee* plugin);
+
+/**
+ *
+ * Asks a remote device to report an attribute to this radio. The device reports when
+ * the value changes, but at most every minInterval and at least every maxInterval seconds.
+ * Reports are handed to the TWAttributeReportCallback.
+ *
+ * @param[in] extendedUniqueId The extended unique id of the device.
+ * @param[in] nodeId The node id of the device.
+ * @param[in] endpointId The endpoint id from which the attribute belongs.
+ * @param[in] clusterId The cluster id from which the attribute belongs.
+ * @param[in] attributeId The attribute id to report.
+ * @param[in] attributeType The attribute type of the attribute.
+ * @param[in] reportableChange The change that triggers a report, in the attribute type.
+ *                             NULL for discrete types (booleans, bitmaps).
+ * @param[in] minInterval The minimum reporting interval in seconds.
+ * @param[in] maxInterval The maximum reporting interval in seconds.
+ * @param[in] plugin The plugin instance to operate with.
+ *
+ */
+OCStackResult TWConfigureReporting(char* extendedUniqueId, char* nodeId, char* endpointId,
+                                   char* clusterId, char* attributeId, char* attributeType,
+                                   char* reportableChange,
+                                   uint16_t minInterval, uint16_t maxInterval,
+                                   PIPlugin_Zigbee* plugin);
+
 /**
  *
  * Process TWEntry.
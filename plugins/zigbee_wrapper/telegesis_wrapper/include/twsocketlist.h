@@ -43,12 +43,18 @@ extern "C" {
 // TODO: Use OICMutex instead of mutex directly.
 #include <pthread.h>
 
+/** Number of bytes pulled off the serial port by a single read(). */
+#define TW_READ_BUFFER_SIZE (256)
+
 typedef struct TWSock
 {
     PIPlugin_Zigbee * plugin; // Handle
     char * eui; // The associated Zigbee radio's EUI.
     int fd;
+    /** Bytes read from 'fd' but not yet consumed. Only the reader thread touches these. **/
     char * buffer;
+    size_t bufferStart;
+    size_t bufferEnd;
     /** 'queue' MUST BE ACCESSED THREAD SAFE **/
     TWEntry * queue;
     pthread_mutex_t mutex; // TODO: Use OIC_MUTEX instead.
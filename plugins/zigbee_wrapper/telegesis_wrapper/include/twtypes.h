@@ -85,6 +85,8 @@ extern "C" {
 #define AT_CMD_COLOR_CTRL_MOVE_TO_COLOR_TEMPERATURE     "AT+CCMVTOCT:"
 #define AT_CMD_GET_LOCAL_EUI                            "ATS04?"
 #define AT_CMD_REMOTE_EUI_REQUEST                       "AT+EUIREQ:"
+#define AT_CMD_BIND                                     "AT+BIND:"
+#define AT_CMD_CONFIGURE_REPORTING                      "AT+CFGRPT:"
 
 #define TW_ENDCONTROL_ERROR_STRING                      "ERROR:"
 
@@ -92,6 +94,7 @@ extern "C" {
 #define SIZE_NODEID                 (5)
 #define SIZE_CLUSTERID              (5)
 #define SIZE_ENDPOINTID             (3)
+#define SIZE_ATTRIBUTEID            (5)
 
 #define SIZE_ZONESTATUS             (5)
 #define SIZE_ZONESTATUS_EXTENDED    (3)
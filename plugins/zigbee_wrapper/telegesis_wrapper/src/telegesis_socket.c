@@ -39,17 +39,18 @@
  */
 void * readForever(/*PIPlugin_Zigbee */void * plugin);
 /**
- * Just grabs the next char in the buffer. Called by readBufferLine() multiple times.
+ * Just grabs the next char in the socket's buffer, refilling the buffer from the
+ * port when it runs dry. Called by readBufferLine() multiple times.
  */
-char readBufferChar(int fd, ssize_t * readDataBytes);
+char readBufferChar(TWSock * twSock, ssize_t * readDataBytes);
 /**
  * Calls readBufferChar() until line is formed.
  */
-const char * readBufferLine(int fd);
+const char * readBufferLine(TWSock * twSock);
 /**
  * Calls readBufferLine() until a full TWEntry is formed.
  */
-TWEntry * readEntry(int fd);
+TWEntry * readEntry(TWSock * twSock);
 /**
  * Posts the TWEntry to the queue.
  */
@@ -90,7 +91,9 @@ static TWEntryTypePair TWEntryTypePairArray[] =
     {"ENROLLED:",       1, TW_ENROLLED},
     {"ZONESTATUS:",     1, TW_ZONESTATUS},
     {"AddrResp:",       1, TW_ADDRESS_RESPONSE},
-    {"REPORTATTR:",     1, TW_NONE},
+    {"REPORTATTR:",     1, TW_REPORTATTR},
+    {"CFGRPTRSP:",      1, TW_NONE},
+    {"Bind:",           1, TW_NONE},
     {"Unknown:",        0, TW_NONE},
     {"Unknown:",        1, TW_MAX_ENTRY}
 };
@@ -194,23 +197,35 @@ TWResultCode TWReleaseMutex(pthread_mutex_t * mutex)
     return TW_RESULT_ERROR;
 }
 
-char readBufferChar(int fd, ssize_t * readDataBytes)
+char readBufferChar(TWSock * twSock, ssize_t * readDataBytes)
 {
-    // Performs read operation on fd for one character at a time.
-    if(!readDataBytes)
+    // Hands out one character at a time, but reads from the port as much as is
+    // available (up to TW_READ_BUFFER_SIZE) whenever the buffer is empty.
+    if(!twSock || !readDataBytes)
     {
         return '\0';
     }
     *readDataBytes = 0;
-    char byte = '\0';
-    errno = 0;
-    *readDataBytes = read(fd, &byte, sizeof(byte));
-    if(*readDataBytes < 0)
+    if(twSock->bufferStart == twSock->bufferEnd)
     {
-        OIC_LOG_V(ERROR, TAG, "\tCould not read from port. Errno is: %d\n", errno);
-        return '\0';
+        twSock->bufferStart = 0;
+        twSock->bufferEnd = 0;
+        errno = 0;
+        ssize_t bytes = read(twSock->fd, twSock->buffer, TW_READ_BUFFER_SIZE);
+        if(bytes < 0)
+        {
+            OIC_LOG_V(ERROR, TAG, "\tCould not read from port. Errno is: %d\n", errno);
+            *readDataBytes = bytes;
+            return '\0';
+        }
+        if(bytes == 0)
+        {
+            return '\0';
+        }
+        twSock->bufferEnd = (size_t) bytes;
     }
-    return byte;
+    *readDataBytes = 1;
+    return twSock->buffer[twSock->bufferStart++];
 }
 
 bool isLineIgnored(const char * line, size_t length)
@@ -250,21 +265,25 @@ bool isLineIgnored(const char * line, size_t length)
     return false;
 }
 
-const char * readBufferLine(int fd)
+const char * readBufferLine(TWSock * twSock)
 {
-    char bufferChar = '\0';
-    size_t bufferLoc = 0;
-    ssize_t readDataBytes = 0;
-    char * bufferLineHold = NULL;
-    char * bufferLine = NULL;
-    bool endOfLine1 = false;
-    bool endOfLine2 = false;
-    bool ignore = false;
     while(true)
     {
-        if(!endOfLine1 || !endOfLine2)
+        char * bufferLine = NULL;
+        size_t bufferLineSize = 0;
+        size_t bufferLoc = 0;
+        bool endOfLine1 = false;
+        bool endOfLine2 = false;
+        while(!endOfLine1 || !endOfLine2)
         {
-            bufferChar = readBufferChar(fd, &readDataBytes);
+            ssize_t readDataBytes = 0;
+            char bufferChar = readBufferChar(twSock, &readDataBytes);
+            if(readDataBytes <= 0)
+            {
+                // Nothing more arrived in time; drop the partial line.
+                OICFree(bufferLine);
+                return NULL;
+            }
             if(bufferChar == '\r')
             {
                 endOfLine1 = true;
@@ -275,54 +294,34 @@ const char * readBufferLine(int fd)
                 endOfLine2 = true;
                 continue;
             }
-        }
-        if(readDataBytes != 0 && (!endOfLine1 && !endOfLine2))
-        {
-            size_t bufferLineSize = sizeof(bufferChar)*(bufferLoc+2);
-            bufferLine = (char *) OICRealloc(bufferLineHold, bufferLineSize);
-            if(!bufferLine)
+            if(bufferLoc + 1 >= bufferLineSize)
             {
-                OIC_LOG(ERROR, TAG, "Ran out of memory.");
-                return NULL;
+                // Grow geometrically so long lines don't cost a realloc per char.
+                size_t newSize = bufferLineSize ? bufferLineSize * 2 : 32;
+                char * newLine = (char *) OICRealloc(bufferLine, newSize);
+                if(!newLine)
+                {
+                    OIC_LOG(ERROR, TAG, "Ran out of memory.");
+                    OICFree(bufferLine);
+                    return NULL;
+                }
+                bufferLine = newLine;
+                bufferLineSize = newSize;
             }
-            bufferLine[bufferLoc] = '\0';
-            OICStrcat(bufferLine, bufferLineSize+2, &bufferChar);
-            bufferLoc++;
-            bufferLineHold = bufferLine;
-
-            OIC_LOG_V(DEBUG, TAG, "Incoming: %s", bufferLine);
+            bufferLine[bufferLoc++] = bufferChar;
         }
-        else
+        if(!bufferLine)
         {
-            if(!bufferLine)
-            {
-                return NULL;
-            }
-            size_t bufferLineSize = sizeof(bufferChar)*(bufferLoc+2);
-            bufferLine = (char *) OICRealloc(bufferLineHold, bufferLineSize);
-            if(!bufferLine)
-            {
-                OIC_LOG(ERROR, TAG, "Ran out of memory.");
-                return NULL;
-            }
-            bufferLine[bufferLoc] = '\0';
-            bufferLoc++;
-            bufferLineHold = bufferLine;
-            ignore = isLineIgnored(bufferLine, strlen(bufferLine));
-            if(ignore)
-            {
-                OICFree(bufferLine);
-                return readBufferLine(fd);
-            }
-            if(endOfLine1 && endOfLine2)
-            {
-                return bufferLine;
-            }
-            else
-            {
-                return NULL;
-            }
+            return NULL;
+        }
+        bufferLine[bufferLoc] = '\0';
+        OIC_LOG_V(DEBUG, TAG, "Incoming: %s", bufferLine);
+
+        if(!isLineIgnored(bufferLine, bufferLoc))
+        {
+            return bufferLine;
         }
+        OICFree(bufferLine);
     }
 }
 
@@ -333,12 +332,14 @@ TWResultCode TWAddLineToEntry(const char * line, TWEntry * entry)
         OIC_LOG(ERROR, TAG, "Invalid/NULL parameter(s) received.");
         return TW_RESULT_ERROR_INVALID_PARAMS;
     }
-    TWLine * twLine = (TWLine *) OICCalloc(1, sizeof(TWLine));
-    if(!twLine)
+    TWLine * lines = (TWLine *) OICRealloc(entry->lines, sizeof(TWLine) * (entry->count + 1));
+    if(!lines)
     {
         OIC_LOG(ERROR, TAG, "Ran out of memory.");
         return TW_RESULT_ERROR_NO_MEMORY;
     }
+    entry->lines = lines;
+    TWLine * twLine = &entry->lines[entry->count];
     size_t lineLength = strlen(line);
     twLine->line = line;
     twLine->length = lineLength;
@@ -360,20 +361,12 @@ TWResultCode TWAddLineToEntry(const char * line, TWEntry * entry)
     // Null terminate the string.
     entry->atErrorCode[2] = '\0';
 
-    if(!entry->lines)
-    {
-        entry->lines = twLine;
-    }
-    else
-    {
-        entry->lines[entry->count] = *twLine;
-    }
     entry->count++;
 
     return TW_RESULT_OK;
 }
 
-TWEntry * readEntry(int fd)
+TWEntry * readEntry(TWSock * twSock)
 {
     // Calls readBufferLine().
     // Forms TWEntry from 1-n lines based on the response type.
@@ -395,7 +388,7 @@ TWEntry * readEntry(int fd)
     {
         if(numLines == 0)
         {
-            bufferLine = readBufferLine(fd);
+            bufferLine = readBufferLine(twSock);
             if(!bufferLine)
             {
                 goto exit;
@@ -408,7 +401,7 @@ TWEntry * readEntry(int fd)
         }
         else
         {
-            bufferLine = readBufferLine(fd);
+            bufferLine = readBufferLine(twSock);
         }
         if(bufferLine != NULL)
         {
@@ -447,18 +440,19 @@ TWResultCode TWRetrieveEUI(PIPlugin_Zigbee * plugin, TWSock * twSock)
     }
 
     //Empty buffer
-    char hideBuffer[1] = "";
-    int p = 1;
+    ssize_t p = 1;
     while(p != 0)
     {
         errno = 0;
-        p = read(twSock->fd, hideBuffer, 1);
+        p = read(twSock->fd, twSock->buffer, TW_READ_BUFFER_SIZE);
         if(p < 0)
         {
             OIC_LOG_V(ERROR, TAG, "\tCould not read from port. Errno is: %d\n", errno);
             return TW_RESULT_ERROR;
         }
     }
+    twSock->bufferStart = 0;
+    twSock->bufferEnd = 0;
 
     TWEntry * entry = NULL;
     TWResultCode deleteResult = TW_RESULT_OK;
@@ -472,7 +466,7 @@ TWResultCode TWRetrieveEUI(PIPlugin_Zigbee * plugin, TWSock * twSock)
     {
         return result;
     }
-    entry = readEntry(twSock->fd);
+    entry = readEntry(twSock);
     if(!entry)
     {
         result = TWReleaseMutex(&twSock->mutex);
@@ -602,94 +596,99 @@ void * readForever(/*PIPlugin*/ void * plugin)
     sigemptyset(&action.sa_mask);
     sigaction(EINTR, &action, NULL);
 
+    // Keep the stop signal pending until pselect() unblocks it, so it can't arrive
+    // while the thread is elsewhere in the loop and leave pselect() waiting forever.
+    sigset_t blockMask;
+    sigemptyset(&blockMask);
+    sigaddset(&blockMask, EINTR);
+    pthread_sigmask(SIG_BLOCK, &blockMask, &sigmask);
+    sigdelset(&sigmask, EINTR);
+
     fd_set readFDS;
-    FD_ZERO(&readFDS);
-    FD_SET(twSock->fd, &readFDS);
-    bool haveMutex = false;
     while(true)
     {
-        errno = 0;
-        // 'sigmask' is needed to catch intterupts.
-        // This interrupt happens after call to pthread_exit(..., EINTR).
-        // Once a signal handler is registered, pselect will handle interrupts by returning
-        // with '-1' and setting errno appropriately.
-        int ret = pselect(twSock->fd+1, &readFDS, NULL, NULL, NULL, &sigmask);
-        if(ret < 0)
-        {
-            if(errno == EINTR)
-            {
-                if(twSock->isActive)
-                {
-                    continue;
-                    // This EINTR signal is not for us. Do not handle it.
-                }
-                // Notify other threads waiting for a response that the stack is going down.
-                pthread_cond_signal(&twSock->queueCV);
-                OIC_LOG(DEBUG, TAG, "Thread has been joined. Exiting thread.");
-                pthread_exit(PTHREAD_CANCELED);
-                return NULL;
-            }
-            else
-            {
-                OIC_LOG_V(ERROR, TAG, "Unaccounted error occurred. Exiting thread."
-                                     "Errno is: %d", errno);
-                return NULL;
-            }
-        }
-        else
+        // Bytes already pulled into the socket's buffer won't wake pselect(), so only
+        // block when everything read so far has been parsed.
+        if(twSock->bufferStart == twSock->bufferEnd)
         {
-            ret = FD_ISSET(twSock->fd, &readFDS);
-            if(ret != 0)
+            FD_ZERO(&readFDS);
+            FD_SET(twSock->fd, &readFDS);
+            errno = 0;
+            // 'sigmask' is needed to catch intterupts.
+            // This interrupt happens after call to pthread_exit(..., EINTR).
+            // Once a signal handler is registered, pselect will handle interrupts by returning
+            // with '-1' and setting errno appropriately.
+            int ret = pselect(twSock->fd+1, &readFDS, NULL, NULL, NULL, &sigmask);
+            if(ret < 0)
             {
-                // Valid data on valid socket.
-                // Grab & parse, then pass up to upper layers.
-                if(haveMutex != true)
-                {
-                    result = TWGrabMutex(&twSock->mutex);
-                    if(result != TW_RESULT_OK)
-                    {
-                        OIC_LOG(ERROR, TAG, "Unable to grab mutex.");
-                        return NULL;
-                    }
-                    haveMutex = true;
-                }
-                entry = readEntry(twSock->fd);
-                if(!entry)
+                if(errno == EINTR)
                 {
-                    result = TWReleaseMutex(&twSock->mutex);
-                    if(result != TW_RESULT_OK)
+                    if(twSock->isActive)
                     {
-                        OIC_LOG(ERROR, TAG, "Unable to release mutex.");
-                        return NULL;
+                        continue;
+                        // This EINTR signal is not for us. Do not handle it.
                     }
-                    haveMutex = false;
-                    // This is most likely a parsing error of the received
-                    // response. Not necessarily fatal.
-                    continue;
+                    // Notify other threads waiting for a response that the stack is going down.
+                    pthread_cond_broadcast(&twSock->queueCV);
+                    OIC_LOG(DEBUG, TAG, "Thread has been joined. Exiting thread.");
+                    pthread_exit(PTHREAD_CANCELED);
+                    return NULL;
                 }
-                result = TWEnqueueEntry((PIPlugin_Zigbee *)plugin, entry);
-                if(result != TW_RESULT_OK)
+                else
                 {
-                    OIC_LOG_V(ERROR, TAG, "Could not add TWEntry to queue for"
-                                          "consumption by the application"
-                                          "layer. Error is: %d", result);
-                    TWDeleteEntry((PIPlugin_Zigbee *)plugin, entry);
-                    // This is most likely a FATAL error, such as out of memory.
-                    break;
+                    OIC_LOG_V(ERROR, TAG, "Unaccounted error occurred. Exiting thread."
+                                         "Errno is: %d", errno);
+                    return NULL;
                 }
-
-                // Notify other threads waiting for a response that an entry has been enqueued.
-                pthread_cond_signal(&twSock->queueCV);
-
-                result = TWReleaseMutex(&twSock->mutex);
-                haveMutex = false;
             }
-            else
+            if(FD_ISSET(twSock->fd, &readFDS) == 0)
             {
                 // Unrelated data waiting elsewhere. Continue the loop.
                 continue;
             }
         }
+
+        // Valid data on valid socket.
+        // Parse without holding the mutex so commands can be issued (and earlier
+        // entries dequeued) while a response is still coming in over the wire.
+        entry = readEntry(twSock);
+        if(!entry)
+        {
+            // This is most likely a parsing error of the received
+            // response. Not necessarily fatal.
+            continue;
+        }
+
+        // Grab & pass up to upper layers.
+        result = TWGrabMutex(&twSock->mutex);
+        if(result != TW_RESULT_OK)
+        {
+            OIC_LOG(ERROR, TAG, "Unable to grab mutex.");
+            TWDeleteEntry((PIPlugin_Zigbee *)plugin, entry);
+            return NULL;
+        }
+        result = TWEnqueueEntry((PIPlugin_Zigbee *)plugin, entry);
+        if(result != TW_RESULT_OK)
+        {
+            TWReleaseMutex(&twSock->mutex);
+            OIC_LOG_V(ERROR, TAG, "Could not add TWEntry to queue for"
+                                  "consumption by the application"
+                                  "layer. Error is: %d", result);
+            TWDeleteEntry((PIPlugin_Zigbee *)plugin, entry);
+            // This is most likely a FATAL error, such as out of memory.
+            break;
+        }
+
+        // Notify other threads waiting for a response that an entry has been enqueued.
+        // Every waiter is woken since each one is waiting for its own entry type.
+        pthread_cond_broadcast(&twSock->queueCV);
+
+        result = TWReleaseMutex(&twSock->mutex);
+        if(result != TW_RESULT_OK)
+        {
+            OIC_LOG(ERROR, TAG, "Unable to release mutex.");
+            return NULL;
+        }
     }
 
     return NULL;
@@ -783,6 +782,72 @@ TWResultCode TWEnqueueEntry(PIPlugin_Zigbee * plugin, TWEntry * entry)
     return TW_RESULT_OK;
 }
 
+/**
+ * Finds the first queued entry of the given type. With a matcher, the entry must
+ * also hold a line that the matcher accepts, whose index is returned in lineIndex.
+ * Must be called with the socket mutex held.
+ */
+static TWEntry * TWFindQueuedEntry(TWSock * twSock, TWEntryType type,
+                                   TWLineMatcher match, void * matchCtx, int * lineIndex)
+{
+    TWEntry * out = NULL;
+    LL_FOREACH(twSock->queue, out)
+    {
+        if(out->type != type)
+        {
+            continue;
+        }
+        if(!match)
+        {
+            *lineIndex = -1;
+            return out;
+        }
+        for(int i = 0; i < out->count; i++)
+        {
+            if(match(out->lines[i].line, matchCtx))
+            {
+                *lineIndex = i;
+                return out;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Waits for up to 10 seconds until TWFindQueuedEntry() finds an entry.
+ * Must be called with the socket mutex held.
+ */
+static TWResultCode TWWaitForEntry(TWSock * twSock, TWEntry ** entry, TWEntryType type,
+                                   TWLineMatcher match, void * matchCtx, int * lineIndex)
+{
+    struct timespec abs_time;
+    clock_gettime(CLOCK_REALTIME , &abs_time);
+    abs_time.tv_sec += TIME_OUT_10_SECONDS;
+    while(true)
+    {
+        // Responses to commands issued back-to-back can be queued before their
+        // caller gets here, so look in the queue before waiting for a new entry.
+        *entry = TWFindQueuedEntry(twSock, type, match, matchCtx, lineIndex);
+        if(*entry || twSock->isActive == false)
+        {
+            return TW_RESULT_OK;
+        }
+        struct timespec cur_time;
+        clock_gettime(CLOCK_REALTIME, &cur_time);
+        if(cur_time.tv_sec >= abs_time.tv_sec)
+        {
+            return TW_RESULT_OK;
+        }
+        // Wait for up to 10 seconds for the entry to put into the queue.
+        TWResultCode ret = TWWait(&twSock->queueCV, &twSock->mutex, TIME_OUT_10_SECONDS);
+        if(ret != TW_RESULT_OK)
+        {
+            return ret;
+        }
+    }
+}
+
 TWResultCode TWDequeueEntry(PIPlugin_Zigbee * plugin, TWEntry ** entry, TWEntryType type)
 {
     if(!plugin || !entry)
@@ -811,37 +876,12 @@ TWResultCode TWDequeueEntry(PIPlugin_Zigbee * plugin, TWEntry ** entry, TWEntryT
     *entry = NULL;
     if(type != TW_NONE)
     {
-        struct timespec abs_time;
-        clock_gettime(CLOCK_REALTIME , &abs_time);
-        abs_time.tv_sec += TIME_OUT_10_SECONDS;
-        while(!*entry)
-         {
-            // Wait for up to 10 seconds for the entry to put into the queue.
-            ret = TWWait(&twSock->queueCV, &twSock->mutex, TIME_OUT_10_SECONDS);
-            if(ret != TW_RESULT_OK)
-            {
-                return ret;
-            }
-            if(twSock->isActive == false)
-            {
-                break;
-            }
-            TWEntry * out = NULL;
-            TWEntry * temp = NULL;
-            LL_FOREACH_SAFE(twSock->queue, out, temp)
-             {
-                if(out->type == type)
-                {
-                    *entry = out;
-                    break;
-                }
-            }
-            struct timespec cur_time;
-            clock_gettime(CLOCK_REALTIME, &cur_time);
-            if(cur_time.tv_sec >= abs_time.tv_sec)
-            {
-                break;
-            }
+        int lineIndex = -1;
+        ret = TWWaitForEntry(twSock, entry, type, NULL, NULL, &lineIndex);
+        if(ret != TW_RESULT_OK)
+        {
+            TWReleaseMutex(&twSock->mutex);
+            return ret;
         }
     }
     else
@@ -855,6 +895,71 @@ TWResultCode TWDequeueEntry(PIPlugin_Zigbee * plugin, TWEntry ** entry, TWEntryT
     return TWReleaseMutex(&twSock->mutex);
 }
 
+TWResultCode TWDequeueLine(PIPlugin_Zigbee * plugin, TWEntry ** entry, TWEntryType type,
+                           TWLineMatcher match, void * matchCtx)
+{
+    if(!plugin || !entry || !match || type == TW_NONE)
+    {
+        return TW_RESULT_ERROR_INVALID_PARAMS;
+    }
+    TWSock * twSock = TWGetSock(plugin);
+    if(!twSock)
+    {
+        return TW_RESULT_ERROR;
+    }
+
+    if(twSock->isActive == false)
+    {
+        return TW_RESULT_ERROR;
+    }
+
+    TWResultCode ret = TWGrabMutex(&twSock->mutex);
+    if(ret != TW_RESULT_OK)
+    {
+        return ret;
+    }
+    *entry = NULL;
+    TWEntry * found = NULL;
+    int lineIndex = -1;
+    ret = TWWaitForEntry(twSock, &found, type, match, matchCtx, &lineIndex);
+    if(ret != TW_RESULT_OK || !found)
+    {
+        TWReleaseMutex(&twSock->mutex);
+        return ret;
+    }
+
+    if(found->count == 1)
+    {
+        LL_DELETE(twSock->queue, found);
+        *entry = found;
+        return TWReleaseMutex(&twSock->mutex);
+    }
+
+    // Move the line into an entry of its own; the other lines stay queued.
+    TWEntry * out = (TWEntry *) OICCalloc(1, sizeof(TWEntry));
+    TWLine * line = (TWLine *) OICMalloc(sizeof(TWLine));
+    if(!out || !line)
+    {
+        OIC_LOG(ERROR, TAG, "Ran out of memory.");
+        OICFree(out);
+        OICFree(line);
+        TWReleaseMutex(&twSock->mutex);
+        return TW_RESULT_ERROR_NO_MEMORY;
+    }
+    *line = found->lines[lineIndex];
+    memmove(&found->lines[lineIndex], &found->lines[lineIndex + 1],
+            sizeof(TWLine) * (found->count - lineIndex - 1));
+    found->count--;
+
+    out->lines = line;
+    out->count = 1;
+    out->type = found->type;
+    out->resultCode = found->resultCode;
+    memcpy(out->atErrorCode, found->atErrorCode, sizeof(out->atErrorCode));
+    *entry = out;
+    return TWReleaseMutex(&twSock->mutex);
+}
+
 TWResultCode TWFreeQueue(PIPlugin_Zigbee * plugin)
 {
     if(!plugin)
@@ -919,6 +1024,11 @@ TWResultCode TWDeleteEntry(PIPlugin_Zigbee * plugin, TWEntry * entry)
     }
     ret = TWReleaseMutex(&twSock->mutex);
 
+    for(int i = 0; i < entry->count; i++)
+    {
+        OICFree((char *) entry->lines[i].line);
+    }
+    OICFree(entry->lines);
     OICFree(entry);
 
     return TW_RESULT_OK;
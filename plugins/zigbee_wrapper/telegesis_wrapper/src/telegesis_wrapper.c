@@ -29,6 +29,7 @@
 
 #include <termios.h>
 #include <string.h>
+#include <strings.h>
 #include <errno.h>
 
 #include "oic_string.h"
@@ -63,6 +64,14 @@
 #define RESPONSE_PARAMS_COUNT_ENROLLED                      (3)
 #define RESPONSE_PARAMS_COUNT_ZONESTATUS_4                  (4)
 #define RESPONSE_PARAMS_COUNT_ZONESTATUS_6                  (6)
+#define RESPONSE_PARAMS_COUNT_REPORTATTR                    (6)
+
+// How many attributes a single AT+READATR asks for; larger reads are split up.
+#define MAX_READ_ATTRIBUTES_PER_COMMAND     (5)
+
+#define BIND_TYPE_UNICAST_EUI      "3"
+#define LOCAL_ENDPOINTID           "01"
+#define REPORTING_DIRECTION_SEND   "0"
 
 #define IN_CLUSTER_COUNT_STRING    "05"
 #define OUT_CLUSTER_COUNT_STRING   "00"
@@ -95,6 +104,8 @@
 #define TOKEN_TEMPERATURE_STATUS_CODE               (3)
 #define TOKEN_TEMPERATURE_VALUE                     (4)
 
+#define TOKEN_RESPATTR_NODEID                       (0)
+#define TOKEN_RESPATTR_ATTRIBUTE_ID                 (3)
 #define TOKEN_RESPATTR_STATUS_CODE                  (4)
 #define TOKEN_RESPATTR_ATTRIBUTE_VALUE              (5)
 
@@ -123,6 +134,12 @@
 #define TOKEN_ZONESTATUS_ZONEID                     (4)
 #define TOKEN_ZONESTATUS_DELAY                      (5)
 
+#define TOKEN_REPORTATTR_NODEID                     (0)
+#define TOKEN_REPORTATTR_ENDPOINTID                 (1)
+#define TOKEN_REPORTATTR_CLUSTERID                  (2)
+#define TOKEN_REPORTATTR_ATTRIBUTEID                (3)
+#define TOKEN_REPORTATTR_ATTRIBUTE_VALUE            (5)
+
 
 typedef struct TWContext{
     PIPlugin_Zigbee* g_plugin;
@@ -140,6 +157,7 @@ typedef struct TWContext{
     TWEnrollmentSucceedCallback g_EnrollmentSucceedCallback;
     TWDeviceStatusUpdateCallback g_DeviceStatusUpdateCallback;
     TWDeviceNodeIdChangedCallback g_EndDeviceNodeIdChangedCallback;
+    TWAttributeReportCallback g_AttributeReportCallback;
 
     struct TWContext* next;
 } TWContext;
@@ -174,6 +192,7 @@ static TWResultCode processEntryZoneEnrollRequest(TWEntry* entry, TWContext* ctx
 static TWResultCode processEntryEnrolled(TWEntry* entry, TWContext* ctx);
 static TWResultCode processEntryZoneStatus(TWEntry* entry, TWContext* ctx);
 static TWResultCode processEntryAddressResponse(TWEntry* entry, TWContext* ctx);
+static TWResultCode processEntryReportAttr(TWEntry* entry, TWContext* ctx);
 
 static TWResultCode Reset(TWContext* ctx);
 static TWResultCode GetRemoteEUI(char *nodeId, char* outRemoteEUI, TWContext* ctx);
@@ -181,6 +200,26 @@ static TWResultCode CreatePAN(TWContext* ctx);
 static TWResultCode EnableJoin(bool isKeyEncrypted, TWContext* ctx);
 static TWResultCode FindMatchNodes(TWContext* ctx);
 static TWResultCode FindClusters(char nodeId[], char endpoint[], TWContext* ctx);
+static OCStackResult ReadAttributes(char* nodeId, char* endpointId, char* clusterId,
+                                    char* attributeIds[], uint8_t attributeCount,
+                                    char* outValues[], uint8_t outValueLengths[],
+                                    TWContext* ctx);
+static int FindReadAttributeIndex(const char* line, const char* nodeId,
+                                  char* attributeIds[], char* outValues[],
+                                  uint8_t attributeCount);
+
+/**
+ * The request which IsReadAttributesResponse() matches response lines with.
+ */
+typedef struct
+{
+    const char* nodeId;
+    char** attributeIds;
+    char** outValues;
+    uint8_t attributeCount;
+} ReadAttributesMatch;
+
+static bool IsReadAttributesResponse(const char* line, void* ctx);
 
 static TWResultCode TelNetworkInfoHandler(int count, char* tokens[], TWContext* ctx);
 static TWResultCode TelJpanHandler(int count, char* tokens[], TWContext* ctx);
@@ -197,6 +236,7 @@ static TWResultCode TelSwitchDoorLockStateHandler(int count, char* tokens[], TWC
 static TWResultCode TelZoneEnrollRequestHandler(int count, char* tokens[], TWContext* ctx);
 static TWResultCode TelEnrolledHandler(int count, char* tokens[], TWContext* ctx);
 static TWResultCode TelZoneStatusHandler(int count, char* tokens[], TWContext* ctx);
+static TWResultCode TelReportAttrHandler(int count, char* tokens[], TWContext* ctx);
 
 static TWResultCode AsciiHexToValue(char* hexString, int length, uint64_t* value);
 static int AsciiToHex(char c);
@@ -230,6 +270,7 @@ static TWATResultHandlerPair g_TWATResultHandlerPairArray[] =
     {"ENROLLED:",   TelEnrolledHandler},
     {"ZONESTATUS:", TelZoneStatusHandler},
     {"AddrResp:",   TelAddressResponseHandler},
+    {"REPORTATTR:", TelReportAttrHandler},
     {"Unknown:",    TelNetworkInfoHandler}
 };
 
@@ -255,6 +296,7 @@ void InitializeContext(TWContext* context)
     context->g_EnrollmentSucceedCallback = NULL;
     context->g_DeviceStatusUpdateCallback = NULL;
     context->g_EndDeviceNodeIdChangedCallback = NULL;
+    context->g_AttributeReportCallback = NULL;
 }
 
 /*****************************************************************************/
@@ -489,101 +531,58 @@ OCStackResult TWGetAttribute(char* extendedUniqueId, char* nodeId, char* endpoin
 {
     //Ask:  AT+READATR:FE5A,01,0,0402,0002
 
-    OIC_LOG(INFO, TAG, "Enter TWGetAttribute()");
+    char* attributeIds[] = { attributeId };
+    return TWGetAttributes(extendedUniqueId, nodeId, endpointId, clusterId,
+                           attributeIds, 1, outValue, outValueLength, plugin);
+}
+
+OCStackResult TWGetAttributes(char* extendedUniqueId, char* nodeId, char* endpointId,
+                              char* clusterId, char* attributeIds[], uint8_t attributeCount,
+                              char* outValues[], uint8_t outValueLengths[],
+                              PIPlugin_Zigbee* plugin)
+{
+    //Ask:  AT+READATR:FE5A,01,0,0402,0000,0002
+
+    OIC_LOG(INFO, TAG, "Enter TWGetAttributes()");
 
     TWContext* ctx = GetTWContext(plugin);
-    if (ctx == NULL)
+    if (ctx == NULL || attributeIds == NULL || outValues == NULL || outValueLengths == NULL)
     {
         return OC_STACK_INVALID_PARAM;
     }
 
     (void)extendedUniqueId;
 
-    OCStackResult ret = OC_STACK_ERROR;
-    TWResultCode twRet = TW_RESULT_ERROR;
-
-    int size =  strlen(AT_CMD_READ_ATR) + strlen(nodeId) +
-                SEPARATOR_LENGTH + strlen(endpointId) +
-                SEPARATOR_LENGTH + strlen(SENDMODE) +
-                SEPARATOR_LENGTH + strlen(clusterId) +
-                SEPARATOR_LENGTH + strlen(attributeId) + 1;
-
-    TWEntry* entry = NULL;
-
-    char* cmdString = (char*)OICMalloc(size * sizeof(char));
-    if (cmdString == NULL)
-    {
-        OIC_LOG(ERROR, TAG, "No Memory");
-        ret = OC_STACK_NO_MEMORY;
-        goto exit;
-    }
-    int stringRet = snprintf(cmdString, size, "%s%s%s%s%s%s%s%s%s%s",
-                             AT_CMD_READ_ATR, nodeId,
-                             SEPARATOR, endpointId,
-                             SEPARATOR, SENDMODE,
-                             SEPARATOR, clusterId,
-                             SEPARATOR, attributeId);
-    if(stringRet <= 0)
-    {
-        OIC_LOG(ERROR, TAG, "Build command error.");
-        ret = OC_STACK_ERROR;
-        goto exit;
-    }
-    twRet = TWIssueATCommand(ctx->g_plugin, cmdString);
-    if (twRet != TW_RESULT_OK)
-    {
-        OIC_LOG_V(ERROR, TAG, "Write %s", cmdString);
-        ret = OC_STACK_ERROR;
-        goto exit;
-    }
-    OIC_LOG_V(INFO, TAG, "Write %s", cmdString);
-
-    twRet = TWDequeueEntry(ctx->g_plugin, &entry, TW_RESPATTR);
-    if (twRet != TW_RESULT_OK)
-    {
-        OIC_LOG(ERROR, TAG, "TWDequeueEntry");
-        ret = OC_STACK_ERROR;
-        goto exit;
-    }
-    if (entry == NULL)
+    OCStackResult ret = OC_STACK_OK;
+    uint8_t i = 0;
+    for (i = 0; i < attributeCount; i++)
     {
-        OIC_LOG(INFO, TAG, "TWEntry is NULL");
-        ret = OC_STACK_ERROR;
-        goto exit;
+        outValues[i] = NULL;
+        outValueLengths[i] = 0;
     }
 
-    twRet = processEntry(entry, ctx);
-    if (twRet != TW_RESULT_REMOTE_ATTR_HAS_VALUE)
+    for (i = 0; i < attributeCount && ret == OC_STACK_OK; i += MAX_READ_ATTRIBUTES_PER_COMMAND)
     {
-        OIC_LOG(ERROR, TAG, "processEntry.");
-        ret = OC_STACK_ERROR;
-        goto exit;
+        uint8_t count = attributeCount - i;
+        if (count > MAX_READ_ATTRIBUTES_PER_COMMAND)
+        {
+            count = MAX_READ_ATTRIBUTES_PER_COMMAND;
+        }
+        ret = ReadAttributes(nodeId, endpointId, clusterId, &attributeIds[i], count,
+                             &outValues[i], &outValueLengths[i], ctx);
     }
 
-    size = strlen(ctx->g_ZigBeeStatus.remoteAttributeValueRead) + 1;
-    *outValue = (char*)OICMalloc(sizeof(char) * size);
-    if (*outValue == NULL)
+    if (ret != OC_STACK_OK)
     {
-        OIC_LOG(ERROR, TAG, "No Memory");
-        ret = OC_STACK_NO_MEMORY;
-        goto exit;
+        for (i = 0; i < attributeCount; i++)
+        {
+            OICFree(outValues[i]);
+            outValues[i] = NULL;
+            outValueLengths[i] = 0;
+        }
     }
 
-    OICStrcpy(*outValue, size, ctx->g_ZigBeeStatus.remoteAttributeValueRead);
-    *outValueLength = ctx->g_ZigBeeStatus.remoteAtrributeValueReadLength;
-    OICFree(ctx->g_ZigBeeStatus.remoteAttributeValueRead);
-    ctx->g_ZigBeeStatus.remoteAttributeValueRead = NULL;
-    ctx->g_ZigBeeStatus.remoteAtrributeValueReadLength = 0;
-    OIC_LOG(INFO, TAG, "TWGetAttribute() gets an attribute value.");
-    ret = OC_STACK_OK;
-
-exit:
-    if (entry != NULL)
-    {
-        TWDeleteEntry(ctx->g_plugin, entry);
-    }
-    OICFree(cmdString);
-    OIC_LOG_V(INFO, TAG, "Leave TWGetAttribute() with ret=%d", ret);
+    OIC_LOG_V(INFO, TAG, "Leave TWGetAttributes() with ret=%d", ret);
     return ret;
 }
 
@@ -1080,6 +1079,138 @@ OCStackResult TWListenForStatusUpdates(char* nodeId, char* endpointId, PIPlugin_
     return ret;
 }
 
+OCStackResult TWSetAttributeReportCallback(TWAttributeReportCallback callback,
+                                           PIPlugin_Zigbee* plugin)
+{
+    OIC_LOG(INFO, TAG, "Enter TWSetAttributeReportCallback()");
+
+    OCStackResult ret = OC_STACK_OK;
+
+    TWContext* ctx = GetTWContext(plugin);
+    if (ctx == NULL)
+    {
+        ret = OC_STACK_INVALID_PARAM;
+    }
+    else
+    {
+        ctx->g_AttributeReportCallback = callback;
+    }
+
+    OIC_LOG_V(INFO, TAG, "Leave TWSetAttributeReportCallback() with ret=%d", ret);
+    return ret;
+}
+
+OCStackResult TWConfigureReporting(char* extendedUniqueId, char* nodeId, char* endpointId,
+                                   char* clusterId, char* attributeId, char* attributeType,
+                                   char* reportableChange,
+                                   uint16_t minInterval, uint16_t maxInterval,
+                                   PIPlugin_Zigbee* plugin)
+{
+    //Ask:  AT+BIND:5DA7,3,000D6F0000D59E92,01,0402,000D6F000059474E,01
+    //Ask:  AT+CFGRPT:5DA7,01,0,0402,0,0000,29,0001,012C,0001
+    //      CFGRPTRSP:5DA7,01,0402,00
+
+    OIC_LOG(INFO, TAG, "Enter TWConfigureReporting()");
+
+    TWContext* ctx = GetTWContext(plugin);
+    if (ctx == NULL || !nodeId || !endpointId || !clusterId || !attributeId || !attributeType)
+    {
+        OIC_LOG(ERROR, TAG, "Invalid Param");
+        return OC_STACK_INVALID_PARAM;
+    }
+
+    OCStackResult ret = OC_STACK_ERROR;
+    TWResultCode twRet = TW_RESULT_ERROR;
+    char* cmdString = NULL;
+    int size = 0;
+
+    // Reports go to the binding table of the remote device, so bind the cluster to
+    // this radio first. Devices which report to the coordinator anyway will just
+    // reject the duplicate.
+    if (extendedUniqueId != NULL)
+    {
+        size =  strlen(AT_CMD_BIND) + strlen(nodeId) +
+                SEPARATOR_LENGTH + strlen(BIND_TYPE_UNICAST_EUI) +
+                SEPARATOR_LENGTH + strlen(extendedUniqueId) +
+                SEPARATOR_LENGTH + strlen(endpointId) +
+                SEPARATOR_LENGTH + strlen(clusterId) +
+                SEPARATOR_LENGTH + strlen(ctx->g_LocalEUI) +
+                SEPARATOR_LENGTH + strlen(LOCAL_ENDPOINTID) + 1;
+        cmdString = (char*)OICMalloc(size * sizeof(char));
+        if (cmdString == NULL)
+        {
+            OIC_LOG(ERROR, TAG, "No Memory");
+            ret = OC_STACK_NO_MEMORY;
+            goto exit;
+        }
+        snprintf(cmdString, size, "%s%s,%s,%s,%s,%s,%s,%s",
+                 AT_CMD_BIND, nodeId, BIND_TYPE_UNICAST_EUI, extendedUniqueId,
+                 endpointId, clusterId, ctx->g_LocalEUI, LOCAL_ENDPOINTID);
+
+        twRet = TWIssueATCommand(ctx->g_plugin, cmdString);
+        if (twRet != TW_RESULT_OK)
+        {
+            OIC_LOG_V(ERROR, TAG, "Write %s", cmdString);
+            ret = OC_STACK_ERROR;
+            goto exit;
+        }
+        OIC_LOG_V(INFO, TAG, "Write %s", cmdString);
+        OICFree(cmdString);
+        cmdString = NULL;
+    }
+
+    char minIntervalString[sizeof("FFFF")];
+    char maxIntervalString[sizeof("FFFF")];
+    snprintf(minIntervalString, sizeof(minIntervalString), "%04X", minInterval);
+    snprintf(maxIntervalString, sizeof(maxIntervalString), "%04X", maxInterval);
+
+    size =  strlen(AT_CMD_CONFIGURE_REPORTING) + strlen(nodeId) +
+            SEPARATOR_LENGTH + strlen(endpointId) +
+            SEPARATOR_LENGTH + strlen(SENDMODE) +
+            SEPARATOR_LENGTH + strlen(clusterId) +
+            SEPARATOR_LENGTH + strlen(REPORTING_DIRECTION_SEND) +
+            SEPARATOR_LENGTH + strlen(attributeId) +
+            SEPARATOR_LENGTH + strlen(attributeType) +
+            SEPARATOR_LENGTH + strlen(minIntervalString) +
+            SEPARATOR_LENGTH + strlen(maxIntervalString) + 1;
+    if (reportableChange != NULL)
+    {
+        size += SEPARATOR_LENGTH + strlen(reportableChange);
+    }
+    cmdString = (char*)OICMalloc(size * sizeof(char));
+    if (cmdString == NULL)
+    {
+        OIC_LOG(ERROR, TAG, "No Memory");
+        ret = OC_STACK_NO_MEMORY;
+        goto exit;
+    }
+    snprintf(cmdString, size, "%s%s,%s,%s,%s,%s,%s,%s,%s,%s",
+             AT_CMD_CONFIGURE_REPORTING, nodeId, endpointId, SENDMODE,
+             clusterId, REPORTING_DIRECTION_SEND, attributeId, attributeType,
+             minIntervalString, maxIntervalString);
+    if (reportableChange != NULL)
+    {
+        OICStrcat(cmdString, size, SEPARATOR);
+        OICStrcat(cmdString, size, reportableChange);
+    }
+
+    // The CFGRPTRSP only tells whether the device accepted; nothing waits on it.
+    twRet = TWIssueATCommand(ctx->g_plugin, cmdString);
+    if (twRet != TW_RESULT_OK)
+    {
+        OIC_LOG_V(ERROR, TAG, "Write %s", cmdString);
+        ret = OC_STACK_ERROR;
+        goto exit;
+    }
+    OIC_LOG_V(INFO, TAG, "Write %s", cmdString);
+    ret = OC_STACK_OK;
+
+exit:
+    OICFree(cmdString);
+    OIC_LOG_V(INFO, TAG, "Leave TWConfigureReporting() with ret=%d", ret);
+    return ret;
+}
+
 OCStackResult TWProcess(PIPlugin_Zigbee* plugin)
 {
     if (plugin == NULL)
@@ -1313,6 +1444,13 @@ TWResultCode processEntry(TWEntry *entry, TWContext* ctx)
                 OIC_LOG(ERROR, TAG, "processEntryAddressResponse.");
             }
             break;
+        case TW_REPORTATTR:
+            ret = processEntryReportAttr(entry, ctx);
+            if (ret != TW_RESULT_OK)
+            {
+                OIC_LOG(ERROR, TAG, "processEntryReportAttr.");
+            }
+            break;
         default:
             OIC_LOG(ERROR, TAG, "processEntry() doesn't receive an valid entry.");
             ret = TW_RESULT_ERROR;
@@ -1676,6 +1814,25 @@ TWResultCode processEntryZoneStatus(TWEntry* entry, TWContext* ctx)
     return ret;
 }
 
+TWResultCode processEntryReportAttr(TWEntry* entry, TWContext* ctx)
+{
+    OIC_LOG(INFO, TAG, "Enter processEntryReportAttr()");
+
+    TWResultCode ret = TW_RESULT_UNKNOWN;
+    if (strcmp(entry->atErrorCode, AT_STR_ERROR_EVERYTHING_OK) != 0)
+    {
+        OIC_LOG_V(ERROR, TAG, "TWEntry contains AT_ERROR: %s", entry->atErrorCode);
+        ret = TW_RESULT_ERROR;
+    }
+    else
+    {
+        ret = HandleATResponse(entry,ctx);
+    }
+
+    OIC_LOG_V(INFO, TAG, "Leave processEntryReportAttr() with ret=%d", ret);
+    return ret;
+}
+
 TWResultCode processEntryAddressResponse(TWEntry* entry, TWContext* ctx)
 {
     OIC_LOG(INFO, TAG, "Enter processEntryAddressResponse()");
@@ -2036,6 +2193,175 @@ exit:
     return ret;
 }
 
+OCStackResult ReadAttributes(char* nodeId, char* endpointId, char* clusterId,
+                             char* attributeIds[], uint8_t attributeCount,
+                             char* outValues[], uint8_t outValueLengths[],
+                             TWContext* ctx)
+{
+    //Ask:      AT+READATR:FE5A,01,0,0402,0000,0002
+    //Answer:   RESPATTR:FE5A,01,0402,0000,00,0812
+    //          RESPATTR:FE5A,01,0402,0002,00,0001
+
+    OIC_LOG(INFO, TAG, "Enter ReadAttributes()");
+
+    OCStackResult ret = OC_STACK_ERROR;
+    TWResultCode twRet = TW_RESULT_ERROR;
+    TWEntry* entry = NULL;
+
+    int size =  strlen(AT_CMD_READ_ATR) + strlen(nodeId) +
+                SEPARATOR_LENGTH + strlen(endpointId) +
+                SEPARATOR_LENGTH + strlen(SENDMODE) +
+                SEPARATOR_LENGTH + strlen(clusterId) + 1;
+    uint8_t i = 0;
+    for (i = 0; i < attributeCount; i++)
+    {
+        size += SEPARATOR_LENGTH + strlen(attributeIds[i]);
+    }
+
+    char* cmdString = (char*)OICMalloc(size * sizeof(char));
+    if (cmdString == NULL)
+    {
+        OIC_LOG(ERROR, TAG, "No Memory");
+        ret = OC_STACK_NO_MEMORY;
+        goto exit;
+    }
+    int stringRet = snprintf(cmdString, size, "%s%s%s%s%s%s%s%s",
+                             AT_CMD_READ_ATR, nodeId,
+                             SEPARATOR, endpointId,
+                             SEPARATOR, SENDMODE,
+                             SEPARATOR, clusterId);
+    if(stringRet <= 0)
+    {
+        OIC_LOG(ERROR, TAG, "Build command error.");
+        ret = OC_STACK_ERROR;
+        goto exit;
+    }
+    for (i = 0; i < attributeCount; i++)
+    {
+        OICStrcat(cmdString, size, SEPARATOR);
+        OICStrcat(cmdString, size, attributeIds[i]);
+    }
+
+    twRet = TWIssueATCommand(ctx->g_plugin, cmdString);
+    if (twRet != TW_RESULT_OK)
+    {
+        OIC_LOG_V(ERROR, TAG, "Write %s", cmdString);
+        ret = OC_STACK_ERROR;
+        goto exit;
+    }
+    OIC_LOG_V(INFO, TAG, "Write %s", cmdString);
+
+    // One response line comes back per attribute, either as separate entries or
+    // grouped into one. They are matched to the request by node and attribute id
+    // rather than by order, and lines for other requests stay queued.
+    ReadAttributesMatch match = { nodeId, attributeIds, outValues, attributeCount };
+    uint8_t pending = attributeCount;
+    while (pending > 0)
+    {
+        twRet = TWDequeueLine(ctx->g_plugin, &entry, TW_RESPATTR,
+                              IsReadAttributesResponse, &match);
+        if (twRet != TW_RESULT_OK)
+        {
+            OIC_LOG(ERROR, TAG, "TWDequeueLine");
+            ret = OC_STACK_ERROR;
+            goto exit;
+        }
+        if (entry == NULL)
+        {
+            OIC_LOG(INFO, TAG, "TWEntry is NULL");
+            ret = OC_STACK_ERROR;
+            goto exit;
+        }
+
+        int index = FindReadAttributeIndex(entry->lines[0].line, nodeId,
+                                           attributeIds, outValues, attributeCount);
+        twRet = processEntry(entry, ctx);
+        if (twRet != TW_RESULT_REMOTE_ATTR_HAS_VALUE)
+        {
+            OIC_LOG(ERROR, TAG, "processEntry.");
+            ret = OC_STACK_ERROR;
+            goto exit;
+        }
+
+        // Take over the value read by the handler.
+        outValues[index] = ctx->g_ZigBeeStatus.remoteAttributeValueRead;
+        outValueLengths[index] = ctx->g_ZigBeeStatus.remoteAtrributeValueReadLength;
+        ctx->g_ZigBeeStatus.remoteAttributeValueRead = NULL;
+        ctx->g_ZigBeeStatus.remoteAtrributeValueReadLength = 0;
+        pending--;
+
+        TWDeleteEntry(ctx->g_plugin, entry);
+        entry = NULL;
+    }
+    OIC_LOG(INFO, TAG, "ReadAttributes() gets attribute values.");
+    ret = OC_STACK_OK;
+
+exit:
+    if (entry != NULL)
+    {
+        TWDeleteEntry(ctx->g_plugin, entry);
+    }
+    OICFree(cmdString);
+    OIC_LOG_V(INFO, TAG, "Leave ReadAttributes() with ret=%d", ret);
+    return ret;
+}
+
+bool IsReadAttributesResponse(const char* line, void* ctx)
+{
+    ReadAttributesMatch* match = (ReadAttributesMatch*)ctx;
+    return FindReadAttributeIndex(line, match->nodeId, match->attributeIds,
+                                  match->outValues, match->attributeCount) >= 0;
+}
+
+int FindReadAttributeIndex(const char* line, const char* nodeId,
+                           char* attributeIds[], char* outValues[],
+                           uint8_t attributeCount)
+{
+    int index = -1;
+    uint8_t i = 0;
+
+    if (strncmp(line, "TEMPERATURE:", strlen("TEMPERATURE:")) == 0)
+    {
+        // This prompt doesn't name the attribute, so it answers the first one still missing.
+        for (i = 0; i < attributeCount; i++)
+        {
+            if (outValues[i] == NULL)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+    if (strncmp(line, "RESPATTR:", strlen("RESPATTR:")) != 0)
+    {
+        return -1;
+    }
+
+    char* tokens[ARRAY_LENGTH] = {};
+    int paramCount = Tokenize(line + strlen("RESPATTR:"), ",\r\n", tokens);
+    // A failed read can omit the value; still claim it so the handler reports the error.
+    if (paramCount > TOKEN_RESPATTR_ATTRIBUTE_ID &&
+        strcasecmp(tokens[TOKEN_RESPATTR_NODEID], nodeId) == 0)
+    {
+        for (i = 0; i < attributeCount; i++)
+        {
+            if (outValues[i] == NULL &&
+                strcasecmp(tokens[TOKEN_RESPATTR_ATTRIBUTE_ID], attributeIds[i]) == 0)
+            {
+                index = i;
+                break;
+            }
+        }
+    }
+
+    int n = 0;
+    for (; n < paramCount; n++)
+    {
+        OICFree(tokens[n]);
+    }
+    return index;
+}
+
 TWResultCode GetRemoteEUI(char *nodeId, char* outRemoteEUI, TWContext* ctx)
 {
     //AT+EUIREQ:< Address>,<NodeID>[,XX]
@@ -2715,7 +3041,7 @@ TWResultCode TelReadAttrHandlerTemperature(int count, char* tokens[], TWContext*
     }
     OIC_LOG_V(INFO, TAG, "Read Attribute Value: %s", tokens[TOKEN_TEMPERATURE_VALUE]);
     ctx->g_ZigBeeStatus.remoteAttributeValueRead =
-            (char*)OICMalloc(sizeof(char) * strlen(tokens[TOKEN_TEMPERATURE_VALUE]));
+            (char*)OICMalloc(sizeof(char) * (strlen(tokens[TOKEN_TEMPERATURE_VALUE]) + 1));
     if (ctx->g_ZigBeeStatus.remoteAttributeValueRead == NULL)
     {
         OIC_LOG_V(ERROR, TAG, "No Memory");
@@ -2768,7 +3094,7 @@ TWResultCode TelReadAttrHandler(int count, char* tokens[], TWContext* ctx)
     }
     OIC_LOG_V(INFO, TAG, "Read Attribute Value: %s.", tokens[TOKEN_RESPATTR_ATTRIBUTE_VALUE]);
     ctx->g_ZigBeeStatus.remoteAttributeValueRead =
-            (char*)OICMalloc(sizeof(char) * strlen(tokens[TOKEN_RESPATTR_ATTRIBUTE_VALUE]));
+            (char*)OICMalloc(sizeof(char) * (strlen(tokens[TOKEN_RESPATTR_ATTRIBUTE_VALUE]) + 1));
     if (ctx->g_ZigBeeStatus.remoteAttributeValueRead != NULL)
     {
         strcpy(ctx->g_ZigBeeStatus.remoteAttributeValueRead,
@@ -2974,6 +3300,40 @@ exit:
     return ret;
 }
 
+TWResultCode TelReportAttrHandler(int count, char* tokens[], TWContext* ctx)
+{
+    //REPORTATTR:<NodeID>,<EP>,<ClusterID>,<AttrID>,<Type>,<Value>
+    //REPORTATTR:5DA7,01,0402,0000,29,0812
+
+    OIC_LOG(INFO, TAG, "Enter TelReportAttrHandler()");
+    TWResultCode ret = TW_RESULT_UNKNOWN;
+    if(!tokens || count != RESPONSE_PARAMS_COUNT_REPORTATTR)
+    {
+        OIC_LOG(ERROR, TAG, "Invalid Params");
+        ret = TW_RESULT_ERROR_INVALID_PARAMS;
+        goto exit;
+    }
+
+    TWAttributeReport report;
+    OICStrcpy(report.nodeId, SIZE_NODEID, tokens[TOKEN_REPORTATTR_NODEID]);
+    OICStrcpy(report.endpoint, SIZE_ENDPOINTID, tokens[TOKEN_REPORTATTR_ENDPOINTID]);
+    OICStrcpy(report.clusterId, SIZE_CLUSTERID, tokens[TOKEN_REPORTATTR_CLUSTERID]);
+    OICStrcpy(report.attributeId, SIZE_ATTRIBUTEID, tokens[TOKEN_REPORTATTR_ATTRIBUTEID]);
+    report.value = tokens[TOKEN_REPORTATTR_ATTRIBUTE_VALUE];
+
+    if (ctx->g_AttributeReportCallback != NULL)
+    {
+        OIC_LOG(INFO, TAG, "attribute report - invoke callback");
+        ctx->g_AttributeReportCallback(&report, ctx->g_plugin);
+        OIC_LOG(INFO, TAG, "attribute report - callback done");
+    }
+    ret = TW_RESULT_OK;
+
+exit:
+    OIC_LOG_V(INFO, TAG, "Leave TelReportAttrHandler() with ret=%d", ret);
+    return ret;
+}
+
 //-----------------------------------------------------------------------------
 // Internal functions - Helpers
 //-----------------------------------------------------------------------------
@@ -96,7 +96,14 @@ TWResultCode TWAddTWSock(TWSock * sock, PIPlugin_Zigbee * plugin, const char * f
         return TW_RESULT_ERROR;
     }
 
-    sock->buffer = NULL;
+    sock->buffer = (char *) OICMalloc(TW_READ_BUFFER_SIZE);
+    if(!sock->buffer)
+    {
+        TWCloseTWSock(sock);
+        return TW_RESULT_ERROR_NO_MEMORY;
+    }
+    sock->bufferStart = 0;
+    sock->bufferEnd = 0;
     sock->queue = NULL;
     pthread_mutexattr_t mutexAttr;
     pthread_mutexattr_init(&mutexAttr);
@@ -0,0 +1,261 @@
+//******************************************************************
+//
+// Copyright 2016 Intel Mobile Communications GmbH All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "telegesis_socket.h"
+#include "telegesis_wrapper.h"
+
+namespace
+{
+    const char EUI[] = "000D6F0000F4A123";
+
+    /**
+     * Plays the Telegesis dongle on the master side of a pty. Each command the
+     * wrapper writes is answered with the response set up for it.
+     */
+    class FakeModem
+    {
+    public:
+        FakeModem() : m_master(-1), m_slave(-1), m_running(false)
+        {
+        }
+
+        ~FakeModem()
+        {
+            stop();
+        }
+
+        bool start()
+        {
+            m_master = posix_openpt(O_RDWR | O_NOCTTY);
+            if (m_master < 0 || grantpt(m_master) != 0 || unlockpt(m_master) != 0)
+            {
+                return false;
+            }
+            char name[64];
+            if (ptsname_r(m_master, name, sizeof(name)) != 0)
+            {
+                return false;
+            }
+            m_path = name;
+
+            // Make the line raw like a serial port, so carriage returns reach the reader.
+            // Keeping it open keeps the settings for when the wrapper opens it.
+            m_slave = open(name, O_RDWR | O_NOCTTY);
+            struct termios terminalInfo;
+            if (m_slave < 0 || tcgetattr(m_slave, &terminalInfo) != 0)
+            {
+                return false;
+            }
+            cfmakeraw(&terminalInfo);
+            if (tcsetattr(m_slave, TCSANOW, &terminalInfo) != 0)
+            {
+                return false;
+            }
+
+            m_running = true;
+            m_thread = std::thread(&FakeModem::run, this);
+            return true;
+        }
+
+        void stop()
+        {
+            if (m_running)
+            {
+                m_running = false;
+                m_thread.join();
+            }
+            if (m_slave >= 0)
+            {
+                close(m_slave);
+                m_slave = -1;
+            }
+            if (m_master >= 0)
+            {
+                close(m_master);
+                m_master = -1;
+            }
+        }
+
+        const char * path() const
+        {
+            return m_path.c_str();
+        }
+
+        void respond(const std::string & command, const std::string & response)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_responses[command] = response;
+        }
+
+    private:
+        void run()
+        {
+            std::string command;
+            while (m_running)
+            {
+                struct pollfd fds = { m_master, POLLIN, 0 };
+                if (poll(&fds, 1, 100) <= 0)
+                {
+                    continue;
+                }
+                char c = 0;
+                if (read(m_master, &c, 1) != 1)
+                {
+                    continue;
+                }
+                if (c != '\r')
+                {
+                    command += c;
+                    continue;
+                }
+
+                std::string response;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    response = m_responses[command];
+                }
+                command.clear();
+                // The whole response goes out in one write, as a dongle sends it back-to-back.
+                if (!response.empty() &&
+                    write(m_master, response.data(), response.size()) != (ssize_t) response.size())
+                {
+                    ADD_FAILURE() << "Could not write the response";
+                }
+            }
+        }
+
+        int m_master;
+        int m_slave;
+        std::string m_path;
+        std::atomic<bool> m_running;
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::map<std::string, std::string> m_responses;
+    };
+}
+
+class TelegesisWrapperTest : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        memset(&m_plugin, 0, sizeof(m_plugin));
+        m_modem.respond("ATS04?", std::string(EUI) + "\r\nOK\r\n");
+        m_modem.respond("AT+N", "+N=COO,24,-6,9726,12BB200F073AB573\r\nOK\r\n");
+        ASSERT_TRUE(m_modem.start());
+        ASSERT_EQ(OC_STACK_OK, TWInitialize(&m_plugin, m_modem.path()));
+    }
+
+    virtual void TearDown()
+    {
+        TWUninitialize(&m_plugin);
+        m_modem.stop();
+    }
+
+    OCStackResult getAttributes(char * outValues[], uint8_t outValueLengths[])
+    {
+        char * attributeIds[] = { (char *) "0000", (char *) "0002" };
+        return TWGetAttributes((char *) EUI, (char *) "FE5A", (char *) "01", (char *) "0402",
+                               attributeIds, 2, outValues, outValueLengths, &m_plugin);
+    }
+
+    FakeModem m_modem;
+    PIPlugin_Zigbee m_plugin;
+};
+
+TEST_F(TelegesisWrapperTest, GetEUI)
+{
+    char * eui = NULL;
+    ASSERT_EQ(TW_RESULT_OK, TWGetEUI(&m_plugin, &eui));
+    EXPECT_STREQ(EUI, eui);
+    free(eui);
+}
+
+TEST_F(TelegesisWrapperTest, GetAttributesWithOneCommand)
+{
+    // The responses come back in another order than the attributes were asked for.
+    m_modem.respond("AT+READATR:FE5A,01,0,0402,0000,0002",
+                    "OK\r\n"
+                    "RESPATTR:FE5A,01,0402,0002,00,0001\r\n"
+                    "RESPATTR:FE5A,01,0402,0000,00,0812\r\n");
+
+    char * outValues[2] = { NULL, NULL };
+    uint8_t outValueLengths[2] = { 0, 0 };
+    ASSERT_EQ(OC_STACK_OK, getAttributes(outValues, outValueLengths));
+    EXPECT_STREQ("0812", outValues[0]);
+    EXPECT_EQ(4, outValueLengths[0]);
+    EXPECT_STREQ("0001", outValues[1]);
+    EXPECT_EQ(4, outValueLengths[1]);
+    free(outValues[0]);
+    free(outValues[1]);
+}
+
+TEST_F(TelegesisWrapperTest, GetAttributesKeepsResponsesForOtherRequests)
+{
+    m_modem.respond("AT+READATR:FE5A,01,0,0402,0000,0002",
+                    "OK\r\n"
+                    "RESPATTR:FE5A,01,0402,0000,00,0812\r\n"
+                    "RESPATTR:1234,01,0402,0000,00,0999\r\n"
+                    "RESPATTR:FE5A,01,0402,0002,00,0001\r\n");
+
+    char * outValues[2] = { NULL, NULL };
+    uint8_t outValueLengths[2] = { 0, 0 };
+    ASSERT_EQ(OC_STACK_OK, getAttributes(outValues, outValueLengths));
+    EXPECT_STREQ("0812", outValues[0]);
+    EXPECT_STREQ("0001", outValues[1]);
+    free(outValues[0]);
+    free(outValues[1]);
+
+    TWEntry * entry = NULL;
+    ASSERT_EQ(TW_RESULT_OK, TWDequeueEntry(&m_plugin, &entry, TW_RESPATTR));
+    ASSERT_TRUE(NULL != entry);
+    ASSERT_EQ(1, entry->count);
+    EXPECT_STREQ("RESPATTR:1234,01,0402,0000,00,0999", entry->lines[0].line);
+    TWDeleteEntry(&m_plugin, entry);
+}
+
+TEST_F(TelegesisWrapperTest, GetAttributesFailsOnErrorStatus)
+{
+    m_modem.respond("AT+READATR:FE5A,01,0,0402,0000,0002",
+                    "OK\r\n"
+                    "RESPATTR:FE5A,01,0402,0000,00,0812\r\n"
+                    "RESPATTR:FE5A,01,0402,0002,86\r\n");
+
+    char * outValues[2] = { NULL, NULL };
+    uint8_t outValueLengths[2] = { 0, 0 };
+    EXPECT_EQ(OC_STACK_ERROR, getAttributes(outValues, outValueLengths));
+    EXPECT_TRUE(NULL == outValues[0]);
+    EXPECT_TRUE(NULL == outValues[1]);
+}
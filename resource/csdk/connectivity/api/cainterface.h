@@ -78,6 +78,27 @@ typedef void (*CAKeepAliveConnectionCallback)(const CAEndpoint_t *object, bool i
  */
 void CARegisterKeepAliveHandler(CAKeepAliveConnectionCallback ConnHandler);
 #endif
+
+#ifdef ROUTING_GATEWAY
+/**
+ * Callback function to let the routing manager forward a received packet as it is.
+ * It is called with the raw CoAP PDU before the PDU is parsed.
+ * @param[in]   sender      remote device the packet was received from.
+ * @param[in]   data        received CoAP PDU.
+ * @param[in]   dataLen     length of the PDU.
+ * @param[out]  nextHop     endpoint to forward the PDU to.
+ * @return  true if the PDU has to be sent to nextHop without further processing,
+ *          false if it has to be parsed and handed over to the upper layer.
+ */
+typedef bool (*CAPacketForwardCallback)(const CAEndpoint_t *sender, const void *data,
+                                        uint32_t dataLen, CAEndpoint_t *nextHop);
+
+/**
+ * Register the callback used to forward received packets without parsing them.
+ * @param[in]   forwardHandler  packet forward callback, NULL to unregister.
+ */
+void CARegisterPacketForwardHandler(CAPacketForwardCallback forwardHandler);
+#endif
 /**
  * Initialize the connectivity abstraction module.
  * It will initialize adapters, thread pool and other modules based on the platform
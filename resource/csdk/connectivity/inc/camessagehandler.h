@@ -96,6 +96,14 @@ void CAHandleRequestResponseCallbacks();
  */
 void CASetNetworkMonitorCallback(CANetworkMonitorCallback nwMonitorHandler);
 
+#ifdef ROUTING_GATEWAY
+/**
+ * Setting the callback function to forward received packets without parsing them.
+ * @param[in] forwardHandler    callback for packet forwarding.
+ */
+void CASetPacketForwardCallback(CAPacketForwardCallback forwardHandler);
+#endif
+
 #ifdef WITH_BWT
 /**
  * Add the data to the send queue thread.
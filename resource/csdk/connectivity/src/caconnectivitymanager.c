@@ -604,3 +604,12 @@ void CARegisterKeepAliveHandler(CAKeepAliveConnectionCallback ConnHandler)
     CATCPSetKeepAliveCallbacks(ConnHandler);
 }
 #endif
+
+#ifdef ROUTING_GATEWAY
+void CARegisterPacketForwardHandler(CAPacketForwardCallback forwardHandler)
+{
+    OIC_LOG(DEBUG, TAG, "CARegisterPacketForwardHandler");
+
+    CASetPacketForwardCallback(forwardHandler);
+}
+#endif
@@ -70,6 +70,9 @@ static CARequestCallback g_requestHandler = NULL;
 static CAResponseCallback g_responseHandler = NULL;
 static CAErrorCallback g_errorHandler = NULL;
 static CANetworkMonitorCallback g_nwMonitorHandler = NULL;
+#ifdef ROUTING_GATEWAY
+static CAPacketForwardCallback g_forwardHandler = NULL;
+#endif
 
 static void CAErrorHandler(const CAEndpoint_t *endpoint,
                            const void *data, size_t dataLen,
@@ -731,6 +734,56 @@ static bool CADropSecondMessage(CAHistory_t *history, const CAEndpoint_t *ep, ui
     return ret;
 }
 
+#ifdef ROUTING_GATEWAY
+/*
+ * Let the routing manager look at the route option of a received packet first.
+ * A packet that only passes through this gateway is sent to the next hop as it was
+ * received, without being decoded and encoded again.
+ * Packets with a block option are left to the blockwise transfer by the routing manager.
+ */
+static bool CAForwardReceivedPacket(CAPacketForwardCallback forwardHandler,
+                                    const CAEndpoint_t *sender, const void *data, size_t dataLen)
+{
+    const coap_hdr_udp_t *header = (const coap_hdr_udp_t *) data;
+    if (sizeof(coap_hdr_udp_t) > dataLen || CA_MAX_TOKEN_LEN < header->token_length ||
+        sizeof(coap_hdr_udp_t) + header->token_length > dataLen)
+    {
+        return false;
+    }
+
+    CAEndpoint_t nextHop = { .adapter = CA_DEFAULT_ADAPTER };
+    if (!forwardHandler(sender, data, dataLen, &nextHop))
+    {
+        return false;
+    }
+
+    // code of the CoAP header: requests are 0.01 to 0.31, responses are 2.xx and above.
+    uint8_t code = header->code;
+    CADataType_t dataType = (code && !(code >> 5)) ? CA_REQUEST_DATA : CA_RESPONSE_DATA;
+
+    // Same check as for parsed requests, so that a dual stack copy is not forwarded twice.
+    if (CA_REQUEST_DATA == dataType &&
+        CADropSecondMessage(&caglobals.ca.requestHistory, sender, header->id,
+                            (CAToken_t) header->token, header->token_length))
+    {
+        OIC_LOG(INFO, TAG, "Second Request with same Token, Drop it");
+        return true;
+    }
+
+    /*
+     * When forwarding a packet, do not attempt retransmission as its the responsibility of
+     * packet originator node.
+     */
+    CAResult_t res = CASendUnicastData(&nextHop, data, dataLen, dataType);
+    if (CA_STATUS_OK != res)
+    {
+        OIC_LOG_V(ERROR, TAG, "Failed to forward packet to next hop [%d][%s]",
+                  res, nextHop.addr);
+    }
+    return true;
+}
+#endif
+
 static void CAReceivedPacketCallback(const CASecureEndpoint_t *sep,
                                      const void *data, size_t dataLen)
 {
@@ -746,6 +799,15 @@ static void CAReceivedPacketCallback(const CASecureEndpoint_t *sep,
     uint32_t code = CA_NOT_FOUND;
     CAData_t *cadata = NULL;
 
+#ifdef ROUTING_GATEWAY
+    // The routing manager may unregister the handler while this adapter thread runs.
+    CAPacketForwardCallback forwardHandler = g_forwardHandler;
+    if (forwardHandler && CAForwardReceivedPacket(forwardHandler, &(sep->endpoint), data, dataLen))
+    {
+        return;
+    }
+#endif
+
     coap_pdu_t *pdu = (coap_pdu_t *) CAParsePDU((const char *) data, dataLen, &code,
                                                 &(sep->endpoint));
     if (NULL == pdu)
@@ -1052,6 +1114,13 @@ void CASetNetworkMonitorCallback(CANetworkMonitorCallback nwMonitorHandler)
     g_nwMonitorHandler = nwMonitorHandler;
 }
 
+#ifdef ROUTING_GATEWAY
+void CASetPacketForwardCallback(CAPacketForwardCallback forwardHandler)
+{
+    g_forwardHandler = forwardHandler;
+}
+#endif
+
 CAResult_t CAInitializeMessageHandler()
 {
     CASetPacketReceivedCallback(CAReceivedPacketCallback);
@@ -28,7 +28,8 @@ extern "C" {
 #ifdef RD_SERVER
 
 /**
- * Opens the RD publish database.
+ * Opens the RD publish database and prepares the statements used to update it.
+ * Does nothing if the database is already open.
  *
  * @param path to the database file.
  *
@@ -24,6 +24,7 @@
 #include "sqlite3.h"
 #include "logger.h"
 #include "ocpayload.h"
+#include "ocstack.h"
 #include "octypes.h"
 #include "oic_malloc.h"
 #include "oic_string.h"
@@ -50,6 +51,13 @@ static const uint8_t rt_link_id_index = 2;
 static const uint8_t if_value_index = 1;
 static const uint8_t if_link_id_index = 2;
 
+/** Statements are prepared once in OCRDDatabaseInit and reset after each use. */
+static sqlite3_stmt *gInsertDeviceStmt = NULL;
+static sqlite3_stmt *gInsertLinkStmt = NULL;
+static sqlite3_stmt *gInsertRTStmt = NULL;
+static sqlite3_stmt *gInsertIFStmt = NULL;
+static sqlite3_stmt *gDeleteDeviceStmt = NULL;
+
 #define VERIFY_SQLITE(arg) \
     if (SQLITE_OK != (arg)) \
     { \
@@ -58,6 +66,14 @@ static const uint8_t if_link_id_index = 2;
         return OC_STACK_ERROR; \
     }
 
+/* For functions that have to release state of their own before returning. */
+#define VERIFY_SQLITE_EXIT(arg) \
+    if (SQLITE_OK != (arg)) \
+    { \
+        OIC_LOG_V(ERROR, TAG, "Error in " #arg ", Error Message: %s",  sqlite3_errmsg(gRDDB)); \
+        goto exit; \
+    }
+
 #define CHECK_DATABASE_INIT \
     if (!gRDDB) \
     { \
@@ -97,6 +113,27 @@ static const uint8_t if_link_id_index = 2;
     "FOREIGN KEY("XSTR(LINK_ID)") REFERENCES RD_DEVICE_LINK_LIST("XSTR(OC_RSRVD_INS)") " \
     "ON DELETE CASCADE);"
 
+/*
+ * Discovery filters on rt and if and then collects the rt/if sets of each link;
+ * deleting a device cascades through DEVICE_ID and LINK_ID. Without these
+ * indexes every one of those steps is a full table scan.
+ * Created on every start so that databases from earlier versions get them too.
+ */
+#define RD_INDEXES \
+    "CREATE INDEX IF NOT EXISTS RD_LINK_RT_VALUE ON RD_LINK_RT(" \
+    XSTR(OC_RSRVD_RESOURCE_TYPE) ");" \
+    "CREATE INDEX IF NOT EXISTS RD_LINK_RT_LINK_ID ON RD_LINK_RT(LINK_ID);" \
+    "CREATE INDEX IF NOT EXISTS RD_LINK_IF_VALUE ON RD_LINK_IF(" \
+    XSTR(OC_RSRVD_INTERFACE) ");" \
+    "CREATE INDEX IF NOT EXISTS RD_LINK_IF_LINK_ID ON RD_LINK_IF(LINK_ID);" \
+    "CREATE INDEX IF NOT EXISTS RD_DEVICE_LINK_LIST_DEVICE_ID ON RD_DEVICE_LINK_LIST(DEVICE_ID);"
+
+#define RD_INSERT_DEVICE "INSERT INTO RD_DEVICE_LIST VALUES(?,?,?,?)"
+#define RD_INSERT_LINK "INSERT INTO RD_DEVICE_LINK_LIST VALUES(?,?,?,?,?,?,?,?)"
+#define RD_INSERT_RT "INSERT INTO RD_LINK_RT VALUES(?, ?)"
+#define RD_INSERT_IF "INSERT INTO RD_LINK_IF VALUES(?, ?)"
+#define RD_DELETE_DEVICE "DELETE FROM RD_DEVICE_LIST WHERE "XSTR(OC_RSRVD_DEVICE_ID)" = ?"
+
 static void errorCallback(void *arg, int errCode, const char *errMsg)
 {
     OC_UNUSED(arg);
@@ -105,8 +142,47 @@ static void errorCallback(void *arg, int errCode, const char *errMsg)
     OIC_LOG_V(ERROR, TAG, "SQLLite Error: %s : %d", errMsg, errCode);
 }
 
+static void finalizeStatements()
+{
+    sqlite3_finalize(gInsertDeviceStmt);
+    gInsertDeviceStmt = NULL;
+    sqlite3_finalize(gInsertLinkStmt);
+    gInsertLinkStmt = NULL;
+    sqlite3_finalize(gInsertRTStmt);
+    gInsertRTStmt = NULL;
+    sqlite3_finalize(gInsertIFStmt);
+    gInsertIFStmt = NULL;
+    sqlite3_finalize(gDeleteDeviceStmt);
+    gDeleteDeviceStmt = NULL;
+}
+
+static OCStackResult prepareStatements()
+{
+    VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, RD_INSERT_DEVICE, -1, &gInsertDeviceStmt, NULL));
+    VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, RD_INSERT_LINK, -1, &gInsertLinkStmt, NULL));
+    VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, RD_INSERT_RT, -1, &gInsertRTStmt, NULL));
+    VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, RD_INSERT_IF, -1, &gInsertIFStmt, NULL));
+    VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, RD_DELETE_DEVICE, -1, &gDeleteDeviceStmt, NULL));
+    return OC_STACK_OK;
+}
+
+/* Runs a prepared statement that returns no rows and readies it for the next use. */
+static int stepStatement(sqlite3_stmt *stmt)
+{
+    int res = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return (SQLITE_DONE == res) ? SQLITE_OK : res;
+}
+
 OCStackResult OCRDDatabaseInit(const char *path)
 {
+    if (gRDDB)
+    {
+        // The publish handler calls this for every request.
+        return OC_STACK_OK;
+    }
+
     if (SQLITE_OK == sqlite3_config(SQLITE_CONFIG_LOG, errorCallback))
     {
         OIC_LOG_V(INFO, TAG, "SQLite debugging log initialized.");
@@ -118,246 +194,241 @@ OCStackResult OCRDDatabaseInit(const char *path)
     {
         OIC_LOG(DEBUG, TAG, "RD database file did not open, as no table exists.");
         OIC_LOG(DEBUG, TAG, "RD creating new table.");
+        sqlite3_close(gRDDB);
         sqlRet = sqlite3_open_v2(!path ? RD_PATH : path, &gRDDB,
                                  SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, NULL);
         if (SQLITE_OK == sqlRet)
         {
-            VERIFY_SQLITE(sqlite3_exec(gRDDB, RD_TABLE, NULL, NULL, NULL));
+            VERIFY_SQLITE_EXIT(sqlite3_exec(gRDDB, RD_TABLE, NULL, NULL, NULL));
             OIC_LOG(DEBUG, TAG, "RD created RD_DEVICE_LIST table.");
 
-            VERIFY_SQLITE(sqlite3_exec(gRDDB, RD_LL_TABLE, NULL, NULL, NULL));
+            VERIFY_SQLITE_EXIT(sqlite3_exec(gRDDB, RD_LL_TABLE, NULL, NULL, NULL));
             OIC_LOG(DEBUG, TAG, "RD created RD_DEVICE_LINK_LIST table.");
 
-            VERIFY_SQLITE(sqlite3_exec(gRDDB, RD_RT_TABLE, NULL, NULL, NULL));
+            VERIFY_SQLITE_EXIT(sqlite3_exec(gRDDB, RD_RT_TABLE, NULL, NULL, NULL));
             OIC_LOG(DEBUG, TAG, "RD created RD_LINK_RT table.");
 
-            VERIFY_SQLITE(sqlite3_exec(gRDDB, RD_IF_TABLE, NULL, NULL, NULL));
+            VERIFY_SQLITE_EXIT(sqlite3_exec(gRDDB, RD_IF_TABLE, NULL, NULL, NULL));
             OIC_LOG(DEBUG, TAG, "RD created RD_LINK_IF table.");
             sqlRet = SQLITE_OK;
         }
     }
 
-    if (sqlRet == SQLITE_OK)
+    if (sqlRet != SQLITE_OK)
     {
-        sqlite3_stmt *stmt = 0;
-        VERIFY_SQLITE(sqlite3_prepare_v2 (gRDDB, "PRAGMA foreign_keys = ON;", -1, &stmt, NULL));
+        OIC_LOG_V(ERROR, TAG, "RD database failed to open: %s", sqlite3_errmsg(gRDDB));
+        goto exit;
+    }
 
-        if (SQLITE_DONE != sqlite3_step(stmt))
-        {
-            sqlite3_finalize(stmt);
-            return OC_STACK_ERROR;
-        }
+    VERIFY_SQLITE_EXIT(sqlite3_exec(gRDDB, "PRAGMA foreign_keys = ON;", NULL, NULL, NULL));
 
-        VERIFY_SQLITE(sqlite3_finalize(stmt));
+    // With a write-ahead log, discovery queries from the stack's read-only
+    // connection are not blocked while a publish is being written.
+    VERIFY_SQLITE_EXIT(sqlite3_exec(gRDDB, "PRAGMA journal_mode = WAL;", NULL, NULL, NULL));
+    VERIFY_SQLITE_EXIT(sqlite3_exec(gRDDB, "PRAGMA synchronous = NORMAL;", NULL, NULL, NULL));
+
+    VERIFY_SQLITE_EXIT(sqlite3_exec(gRDDB, RD_INDEXES, NULL, NULL, NULL));
+
+    if (OC_STACK_OK == prepareStatements())
+    {
+        return OC_STACK_OK;
     }
 
-    return OC_STACK_OK;
+exit:
+    // Leave nothing behind, so that the next call starts over instead of
+    // using a half initialized database.
+    finalizeStatements();
+    sqlite3_close(gRDDB);
+    gRDDB = NULL;
+    return OC_STACK_ERROR;
 }
 
 OCStackResult OCRDDatabaseClose()
 {
     CHECK_DATABASE_INIT;
+    finalizeStatements();
     VERIFY_SQLITE(sqlite3_close_v2(gRDDB));
+    gRDDB = NULL;
     return OC_STACK_OK;
 }
 
-static int storeResourceType(char **link, size_t size, uint8_t rowid)
+static OCStackResult storeStrings(sqlite3_stmt *stmt, uint8_t valueIndex, uint8_t linkIdIndex,
+                                  char **values, size_t size, sqlite3_int64 rowid)
 {
-    int res = 1;
-    VERIFY_SQLITE(sqlite3_exec(gRDDB, "BEGIN TRANSACTION", NULL, NULL, NULL));
-
-    const char *insertRT = "INSERT INTO RD_LINK_RT VALUES(?, ?)";
-    sqlite3_stmt *stmtRT = 0;
-
     for (size_t i = 0; i < size; i++)
     {
-        VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, insertRT, strlen(insertRT) + 1, &stmtRT, NULL));
-        if (link[i])
+        if (values[i])
         {
-            VERIFY_SQLITE(sqlite3_bind_text(stmtRT, rt_value_index, link[i],
-                    strlen(link[i])+1, SQLITE_STATIC));
+            VERIFY_SQLITE_EXIT(sqlite3_bind_text(stmt, valueIndex, values[i],
+                    strlen(values[i])+1, SQLITE_STATIC));
 
-            VERIFY_SQLITE(sqlite3_bind_int(stmtRT, rt_link_id_index, rowid));
-        }
-        if (sqlite3_step(stmtRT) != SQLITE_DONE)
-        {
-            sqlite3_finalize(stmtRT);
-            return res;
+            VERIFY_SQLITE_EXIT(sqlite3_bind_int64(stmt, linkIdIndex, rowid));
         }
+        VERIFY_SQLITE_EXIT(stepStatement(stmt));
     }
+    return OC_STACK_OK;
 
-    VERIFY_SQLITE(sqlite3_finalize(stmtRT));
-
-    VERIFY_SQLITE(sqlite3_exec(gRDDB, "COMMIT", NULL, NULL, NULL));
-    res = SQLITE_OK;
-
-    return res;
+exit:
+    // The caller rolls back the transaction.
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return OC_STACK_ERROR;
 }
 
-
-static int storeInterfaceType(char **link, size_t size, uint8_t rowid)
+static void freeStringArray(char **array, size_t size)
 {
-    int res = 1;
-
-    VERIFY_SQLITE(sqlite3_exec(gRDDB, "BEGIN TRANSACTION", NULL, NULL, NULL));
-
-    const char *insertIF = "INSERT INTO RD_LINK_IF VALUES(?, ?)";
-    sqlite3_stmt *stmtIF = 0;
-
     for (size_t i = 0; i < size; i++)
     {
-        VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, insertIF, strlen(insertIF) + 1, &stmtIF, NULL));
-
-        if (link[i])
-        {
-            VERIFY_SQLITE(sqlite3_bind_text(stmtIF, if_value_index, link[i], strlen(link[i])+1, SQLITE_STATIC));
-            VERIFY_SQLITE(sqlite3_bind_int(stmtIF, if_link_id_index, rowid));
-        }
-        if (sqlite3_step(stmtIF) != SQLITE_DONE)
-        {
-            res = sqlite3_finalize(stmtIF);
-            return res;
-        }
+        OICFree(array[i]);
     }
-    VERIFY_SQLITE(sqlite3_finalize(stmtIF));
-
-    VERIFY_SQLITE(sqlite3_exec(gRDDB, "COMMIT", NULL, NULL, NULL));
-    res = SQLITE_OK;
-
-    return res;
+    OICFree(array);
 }
 
-static int storeLinkPayload(OCRepPayload *rdPayload, int64_t rowid)
+static OCStackResult storeLink(OCRepPayload *link, sqlite3_int64 rowid)
 {
-    OCRepPayload **links = NULL;
-    size_t dimensions[MAX_REP_ARRAY_DEPTH];
-    int res = 1 ;
-    size_t j = 0;
-
-    if (OCRepPayloadGetPropObjectArray(rdPayload, OC_RSRVD_LINKS, &links, dimensions))
+    OCStackResult result = OC_STACK_ERROR;
+    sqlite3_stmt *stmt = gInsertLinkStmt;
+
+    char *uri = NULL;
+    OCRepPayload *p = NULL;
+    size_t mtDim[MAX_REP_ARRAY_DEPTH] = {0};
+    char **mediaType = NULL;
+    size_t rtDim[MAX_REP_ARRAY_DEPTH] = {0};
+    char **rt = NULL;
+    size_t itfDim[MAX_REP_ARRAY_DEPTH] = {0};
+    char **itf = NULL;
+
+    if (OCRepPayloadGetPropString(link, OC_RSRVD_HREF, &uri)
+        && SQLITE_OK != sqlite3_bind_text(stmt, uri_index, uri, strlen(uri), SQLITE_STATIC))
     {
-        const char *insertDeviceLLList = "INSERT INTO RD_DEVICE_LINK_LIST VALUES(?,?,?,?,?,?,?,?)";
-        sqlite3_stmt *stmt = 0;
+        goto exit;
+    }
 
-        for (size_t i = 0; i < dimensions[0]; i++)
+    if (OCRepPayloadGetPropObject(link, OC_RSRVD_POLICY, &p))
+    {
+        int64_t bm = 0;
+        if (OCRepPayloadGetPropInt(p, OC_RSRVD_BITMAP, &bm)
+            && SQLITE_OK != sqlite3_bind_int(stmt, p_index, bm))
         {
-            VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, insertDeviceLLList, strlen(insertDeviceLLList) + 1, &stmt, NULL));
-            VERIFY_SQLITE(sqlite3_exec(gRDDB, "BEGIN TRANSACTION", NULL, NULL, NULL));
-
-            OCRepPayload *link = links[i];
-            char *uri = NULL;
-            if (OCRepPayloadGetPropString(link, OC_RSRVD_HREF, &uri))
-            {
-                VERIFY_SQLITE(sqlite3_bind_text(stmt, uri_index, uri, strlen(uri), SQLITE_STATIC));
-            }
+            goto exit;
+        }
+    }
 
-            OCRepPayload *p = NULL;
-            if (OCRepPayloadGetPropObject(link, OC_RSRVD_POLICY, &p))
-            {
-                int64_t bm = 0;
-                if (OCRepPayloadGetPropInt(p, OC_RSRVD_BITMAP, &bm))
-                {
-                    VERIFY_SQLITE(sqlite3_bind_int(stmt, p_index, bm));
-                }
-            }
+    if (OCRepPayloadGetStringArray(link, OC_RSRVD_MEDIA_TYPE, &mediaType, mtDim)
+        && mtDim[0] && mediaType[0]
+        && SQLITE_OK != sqlite3_bind_text(stmt, mt_index, mediaType[0],
+                                          strlen(mediaType[0]), SQLITE_STATIC))
+    {
+        goto exit;
+    }
 
-            size_t mtDim[MAX_REP_ARRAY_DEPTH] = {0};
-            char **mediaType = NULL;
-            if (OCRepPayloadGetStringArray(link, OC_RSRVD_MEDIA_TYPE, &mediaType, mtDim))
-            {
-                VERIFY_SQLITE(sqlite3_bind_text(stmt, mt_index, mediaType[0], mtDim[0], SQLITE_STATIC));
-            }
+    if (SQLITE_OK != sqlite3_bind_int64(stmt, d_index, rowid)
+        || SQLITE_OK != stepStatement(stmt))
+    {
+        goto exit;
+    }
 
-            VERIFY_SQLITE(sqlite3_bind_int(stmt, d_index, rowid));
+    sqlite3_int64 ins = sqlite3_last_insert_rowid(gRDDB);
 
-            size_t rtDim[MAX_REP_ARRAY_DEPTH] = {0};
-            char **rt = NULL;
-            OCRepPayloadGetStringArray(link, OC_RSRVD_RESOURCE_TYPE, &rt, rtDim);
+    OCRepPayloadGetStringArray(link, OC_RSRVD_RESOURCE_TYPE, &rt, rtDim);
+    OCRepPayloadGetStringArray(link, OC_RSRVD_INTERFACE, &itf, itfDim);
 
-            size_t itfDim[MAX_REP_ARRAY_DEPTH] = {0};
-            char **itf = NULL;
-            OCRepPayloadGetStringArray(link, OC_RSRVD_INTERFACE, &itf, itfDim);
+    if (OC_STACK_OK != storeStrings(gInsertRTStmt, rt_value_index, rt_link_id_index,
+                                    rt, rtDim[0], ins)
+        || OC_STACK_OK != storeStrings(gInsertIFStmt, if_value_index, if_link_id_index,
+                                       itf, itfDim[0], ins))
+    {
+        goto exit;
+    }
+    result = OC_STACK_OK;
 
-            if (sqlite3_step(stmt) != SQLITE_DONE)
-            {
-                sqlite3_finalize(stmt);
-                return res;
-            }
-            VERIFY_SQLITE(sqlite3_exec(gRDDB, "COMMIT", NULL, NULL, NULL));
-
-            int64_t ins = sqlite3_last_insert_rowid(gRDDB);
-            VERIFY_SQLITE(storeResourceType(rt, rtDim[0], ins));
-            VERIFY_SQLITE(storeInterfaceType(itf, itfDim[0], ins));
-            OICFree(uri);
-            OCPayloadDestroy((OCPayload *)p);
-            for (j = 0; j < mtDim[0]; j++)
-            {
-                OICFree(mediaType[j]);
-            }
-            OICFree(mediaType);
+exit:
+    if (OC_STACK_OK != result)
+    {
+        OIC_LOG_V(ERROR, TAG, "Failed to store link: %s", sqlite3_errmsg(gRDDB));
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    }
+    OICFree(uri);
+    OCPayloadDestroy((OCPayload *)p);
+    freeStringArray(mediaType, mtDim[0]);
+    freeStringArray(rt, rtDim[0]);
+    freeStringArray(itf, itfDim[0]);
+    return result;
+}
 
-            for (j = 0; j < rtDim[0]; j++)
-            {
-                OICFree(rt[j]);
-            }
-            OICFree(rt);
+static OCStackResult storeLinkPayload(OCRepPayload *rdPayload, sqlite3_int64 rowid)
+{
+    OCRepPayload **links = NULL;
+    size_t dimensions[MAX_REP_ARRAY_DEPTH] = {0};
+    OCStackResult result = OC_STACK_OK;
 
-            for (j = 0; j < itfDim[0]; j++)
+    if (OCRepPayloadGetPropObjectArray(rdPayload, OC_RSRVD_LINKS, &links, dimensions))
+    {
+        for (size_t i = 0; i < dimensions[0]; i++)
+        {
+            if (OC_STACK_OK == result)
             {
-                OICFree(itf[j]);
+                result = storeLink(links[i], rowid);
             }
-            OICFree(itf);
-
+            OCRepPayloadDestroy(links[i]);
         }
-
-        VERIFY_SQLITE(sqlite3_finalize(stmt));
-        res = SQLITE_OK;
+        OICFree(links);
     }
-    return res;
+    return result;
 }
 
 OCStackResult OCRDDatabaseStoreResources(OCRepPayload *payload, const OCDevAddr *address)
 {
     CHECK_DATABASE_INIT;
 
+    // A single transaction for the device and all of its links: one journal
+    // commit per publish instead of one per row.
     VERIFY_SQLITE(sqlite3_exec(gRDDB, "BEGIN TRANSACTION", NULL, NULL, NULL));
-    const char *insertDeviceList = "INSERT INTO RD_DEVICE_LIST VALUES(?,?,?,?)";
-    sqlite3_stmt *stmt = 0;
-    VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, insertDeviceList, strlen(insertDeviceList) + 1, &stmt, NULL));
+    sqlite3_stmt *stmt = gInsertDeviceStmt;
+    OCStackResult result = OC_STACK_ERROR;
 
     char *deviceid = NULL;
     if (OCRepPayloadGetPropString(payload, OC_RSRVD_DEVICE_ID, &deviceid))
     {
-        VERIFY_SQLITE(sqlite3_bind_text(stmt, device_index, deviceid, strlen(deviceid) + 1, SQLITE_STATIC));
+        VERIFY_SQLITE_EXIT(sqlite3_bind_text(stmt, device_index, deviceid, strlen(deviceid) + 1,
+                                             SQLITE_STATIC));
     }
 
     int64_t ttl = 0;
     if (OCRepPayloadGetPropInt(payload, OC_RSRVD_DEVICE_TTL, &ttl))
     {
-        VERIFY_SQLITE(sqlite3_bind_int(stmt, ttl_index, ttl));
+        VERIFY_SQLITE_EXIT(sqlite3_bind_int(stmt, ttl_index, ttl));
     }
 
     char rdAddress[MAX_URI_LENGTH];
     snprintf(rdAddress, MAX_URI_LENGTH, "%s:%d", address->addr, address->port);
     OIC_LOG_V(DEBUG, TAG, "Address: %s", rdAddress);
-    VERIFY_SQLITE(sqlite3_bind_text(stmt, address_index, rdAddress, strlen(rdAddress) + 1, SQLITE_STATIC));
+    VERIFY_SQLITE_EXIT(sqlite3_bind_text(stmt, address_index, rdAddress, strlen(rdAddress) + 1,
+                                         SQLITE_STATIC));
+
+    VERIFY_SQLITE_EXIT(stepStatement(stmt));
 
-    if (sqlite3_step(stmt) != SQLITE_DONE)
+    sqlite3_int64 rowid = sqlite3_last_insert_rowid(gRDDB);
+    if (rowid && OC_STACK_OK != storeLinkPayload(payload, rowid))
     {
-        sqlite3_finalize(stmt);
-        return OC_STACK_ERROR;
+        goto exit;
     }
-    VERIFY_SQLITE(sqlite3_finalize(stmt));
 
-    VERIFY_SQLITE(sqlite3_exec(gRDDB, "COMMIT", NULL, NULL, NULL));
+    VERIFY_SQLITE_EXIT(sqlite3_exec(gRDDB, "COMMIT", NULL, NULL, NULL));
+    OCRDDatabaseDiscoveryInvalidate();
+    result = OC_STACK_OK;
 
-    int64_t rowid = sqlite3_last_insert_rowid(gRDDB);
-    if (rowid)
+exit:
+    if (OC_STACK_OK != result)
     {
-        VERIFY_SQLITE(storeLinkPayload(payload, rowid));
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        sqlite3_exec(gRDDB, "ROLLBACK", NULL, NULL, NULL);
     }
+    // Bound with SQLITE_STATIC, so only freed once the statement is done with it.
     OICFree(deviceid);
-    return OC_STACK_OK;
+    return result;
 }
 
 OCStackResult OCRDDatabaseDeleteDevice(const char *deviceId)
@@ -365,22 +436,22 @@ OCStackResult OCRDDatabaseDeleteDevice(const char *deviceId)
     CHECK_DATABASE_INIT;
     VERIFY_SQLITE(sqlite3_exec(gRDDB, "BEGIN TRANSACTION", NULL, NULL, NULL));
 
-    sqlite3_stmt *stmt = 0;
-    char *delDevice = "DELETE FROM RD_DEVICE_LIST WHERE "XSTR(OC_RSRVD_DEVICE_ID)" = ?";
-    VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, delDevice, strlen(delDevice) + 1, &stmt, NULL));
-
-    VERIFY_SQLITE(sqlite3_bind_text(stmt, 1, deviceId, strlen(deviceId) + 1, SQLITE_STATIC));
+    OCStackResult result = OC_STACK_ERROR;
+    sqlite3_stmt *stmt = gDeleteDeviceStmt;
+    VERIFY_SQLITE_EXIT(sqlite3_bind_text(stmt, 1, deviceId, strlen(deviceId) + 1, SQLITE_STATIC));
+    VERIFY_SQLITE_EXIT(stepStatement(stmt));
+    VERIFY_SQLITE_EXIT(sqlite3_exec(gRDDB, "COMMIT", NULL, NULL, NULL));
+    OCRDDatabaseDiscoveryInvalidate();
+    result = OC_STACK_OK;
 
-    if (sqlite3_step(stmt) != SQLITE_DONE)
+exit:
+    if (OC_STACK_OK != result)
     {
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
         sqlite3_exec(gRDDB, "ROLLBACK", NULL, NULL, NULL);
-        sqlite3_finalize(stmt);
-        return OC_STACK_ERROR;
     }
-    VERIFY_SQLITE(sqlite3_finalize(stmt));
-    VERIFY_SQLITE(sqlite3_exec(gRDDB, "COMMIT", NULL, NULL, NULL));
-
-    return OC_STACK_OK;
+    return result;
 }
 
 #endif
@@ -45,8 +45,11 @@ extern "C"
 #include <stdio.h>
 #include <string.h>
 
+#include <chrono>
 #include <iostream>
 #include <stdint.h>
+#include <string>
+#include <vector>
 
 #include "gtest_helper.h"
 
@@ -91,6 +94,24 @@ TEST_F(RDDatabaseTests, CreateDatabase)
     EXPECT_EQ(OC_STACK_OK, OCRDDatabaseClose());
 }
 
+TEST_F(RDDatabaseTests, CreateDatabaseAfterFailedOpen)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    // Opens fine, but is not a database.
+    const char *path = "RDDatabaseTests.db";
+    FILE *file = fopen(path, "w");
+    ASSERT_TRUE(file != NULL);
+    fputs("not a database, not a database, not a database, not a database", file);
+    fclose(file);
+
+    EXPECT_EQ(OC_STACK_ERROR, OCRDDatabaseInit(path));
+    EXPECT_EQ(OC_STACK_ERROR, OCRDDatabaseClose());
+    unlink(path);
+
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseInit(NULL));
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseClose());
+}
+
 TEST_F(RDDatabaseTests, PublishDatabase)
 {
     // itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
@@ -171,3 +192,182 @@ TEST_F(RDDatabaseTests, PublishDatabase)
     EXPECT_EQ(OC_STACK_OK, OCRDDatabaseDeleteDevice(deviceId));
     EXPECT_EQ(OC_STACK_OK, OCRDDatabaseClose());
 }
+
+static OCRepPayload *createDevicePayload(const std::string &deviceId, size_t linkCount)
+{
+    OCRepPayload *repPayload = OCRepPayloadCreate();
+    OCRepPayloadSetPropString(repPayload, OC_RSRVD_DEVICE_ID, deviceId.c_str());
+    OCRepPayloadSetPropInt(repPayload, OC_RSRVD_DEVICE_TTL, 86400);
+
+    const char *itf[] = { OC_RSRVD_INTERFACE_DEFAULT };
+    size_t itfDim[MAX_REP_ARRAY_DEPTH] = {1, 0, 0};
+    std::vector<OCRepPayload *> links(linkCount);
+    for (size_t i = 0; i < linkCount; i++)
+    {
+        std::string uri = "/a/resource" + std::to_string(i);
+        std::string type = (i % 2) ? "core.light" : "core.fan" + std::to_string(i);
+        const char *rt[] = { type.c_str() };
+        size_t rtDim[MAX_REP_ARRAY_DEPTH] = {1, 0, 0};
+
+        links[i] = OCRepPayloadCreate();
+        OCRepPayloadSetPropString(links[i], OC_RSRVD_HREF, uri.c_str());
+        OCRepPayloadSetStringArray(links[i], OC_RSRVD_RESOURCE_TYPE, rt, rtDim);
+        OCRepPayloadSetStringArray(links[i], OC_RSRVD_INTERFACE, itf, itfDim);
+    }
+    size_t dimensions[MAX_REP_ARRAY_DEPTH] = {linkCount, 0, 0};
+    OCRepPayloadSetPropObjectArray(repPayload, OC_RSRVD_LINKS,
+                                   (const OCRepPayload **)links.data(), dimensions);
+    for (OCRepPayload *link : links)
+    {
+        OCRepPayloadDestroy(link);
+    }
+    return repPayload;
+}
+
+// Links of each device are returned in a payload of their own.
+static size_t getLinkCount(OCDiscoveryPayload *discPayload)
+{
+    size_t count = 0;
+    for (OCDiscoveryPayload *temp = discPayload; temp; temp = temp->next)
+    {
+        count += OCDiscoveryPayloadGetResourceCount(temp);
+    }
+    return count;
+}
+
+TEST_F(RDDatabaseTests, DiscoveryQueryLatency)
+{
+    const size_t deviceCount = 1000;
+    const size_t linksPerDevice = 10;
+
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseInit(NULL));
+    OCDevAddr address;
+    address.port = 54321;
+    OICStrcpy(address.addr, MAX_ADDR_STR_SIZE, "192.168.1.1");
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < deviceCount; i++)
+    {
+        OCRepPayload *repPayload = createDevicePayload("device" + std::to_string(i), linksPerDevice);
+        EXPECT_EQ(OC_STACK_OK, OCRDDatabaseStoreResources(repPayload, &address));
+        OCRepPayloadDestroy(repPayload);
+    }
+    auto published = std::chrono::steady_clock::now();
+
+    const int queries = 100;
+    for (int i = 0; i < queries; i++)
+    {
+        OCDiscoveryPayload *discPayload = OCDiscoveryPayloadCreate();
+        EXPECT_EQ(OC_STACK_OK, OCRDDatabaseCheckResources(NULL, "core.light", discPayload));
+        OCDiscoveryPayloadDestroy(discPayload);
+    }
+    auto queried = std::chrono::steady_clock::now();
+
+    OCDiscoveryPayload *discPayload = OCDiscoveryPayloadCreate();
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseCheckResources(NULL, "core.fan4", discPayload));
+    size_t devices = 0;
+    for (OCDiscoveryPayload *temp = discPayload; temp; temp = temp->next, devices++)
+    {
+        ASSERT_TRUE(temp->sid != NULL);
+        EXPECT_STREQ(("device" + std::to_string(devices)).c_str(), temp->sid);
+        EXPECT_EQ(1u, OCDiscoveryPayloadGetResourceCount(temp));
+    }
+    EXPECT_EQ(deviceCount, devices);
+    OCDiscoveryPayloadDestroy(discPayload);
+
+    std::cout << deviceCount * linksPerDevice << " links published in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(published - start).count()
+              << " ms, rt query "
+              << std::chrono::duration_cast<std::chrono::microseconds>(queried - published).count()
+                 / queries
+              << " us" << std::endl;
+
+    for (size_t i = 0; i < deviceCount; i++)
+    {
+        EXPECT_EQ(OC_STACK_OK, OCRDDatabaseDeleteDevice(("device" + std::to_string(i)).c_str()));
+    }
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseClose());
+}
+
+TEST_F(RDDatabaseTests, DiscoveryResultsFollowDatabaseChanges)
+{
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseInit(NULL));
+    OCDevAddr address;
+    address.port = 54321;
+    OICStrcpy(address.addr, MAX_ADDR_STR_SIZE, "192.168.1.1");
+
+    auto lightCount = [](OCStackResult expected) -> size_t
+    {
+        OCDiscoveryPayload *discPayload = OCDiscoveryPayloadCreate();
+        EXPECT_EQ(expected, OCRDDatabaseCheckResources(NULL, "core.light", discPayload));
+        size_t count = getLinkCount(discPayload);
+        OCDiscoveryPayloadDestroy(discPayload);
+        return count;
+    };
+
+    OCRepPayload *repPayload = createDevicePayload("device0", 2);
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseStoreResources(repPayload, &address));
+    OCRepPayloadDestroy(repPayload);
+    EXPECT_EQ(1u, lightCount(OC_STACK_OK));
+    EXPECT_EQ(1u, lightCount(OC_STACK_OK));
+
+    repPayload = createDevicePayload("device1", 4);
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseStoreResources(repPayload, &address));
+    OCRepPayloadDestroy(repPayload);
+    EXPECT_EQ(3u, lightCount(OC_STACK_OK));
+
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseDeleteDevice("device1"));
+    EXPECT_EQ(1u, lightCount(OC_STACK_OK));
+
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseDeleteDevice("device0"));
+    EXPECT_EQ(0u, lightCount(OC_STACK_NO_RESOURCE));
+    EXPECT_EQ(0u, lightCount(OC_STACK_NO_RESOURCE));
+
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseClose());
+}
+
+TEST_F(RDDatabaseTests, DiscoveryKeepsEachDeviceId)
+{
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseInit(NULL));
+    OCDevAddr address;
+    address.port = 54321;
+    OICStrcpy(address.addr, MAX_ADDR_STR_SIZE, "192.168.1.1");
+
+    OCRepPayload *repPayload = createDevicePayload("device0", 2);
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseStoreResources(repPayload, &address));
+    OCRepPayloadDestroy(repPayload);
+
+    address.port = 54322;
+    repPayload = createDevicePayload("device1", 4);
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseStoreResources(repPayload, &address));
+    OCRepPayloadDestroy(repPayload);
+
+    // The stack hands in a payload that already carries its own device id,
+    // and the same result is returned from the cache on the second query.
+    for (int i = 0; i < 2; i++)
+    {
+        OCDiscoveryPayload *discPayload = OCDiscoveryPayloadCreate();
+        discPayload->sid = OICStrdup("local");
+        EXPECT_EQ(OC_STACK_OK, OCRDDatabaseCheckResources(NULL, "core.light", discPayload));
+        EXPECT_STREQ("local", discPayload->sid);
+        EXPECT_EQ(0u, OCDiscoveryPayloadGetResourceCount(discPayload));
+
+        OCDiscoveryPayload *device0 = discPayload->next;
+        ASSERT_TRUE(device0 != NULL);
+        EXPECT_STREQ("device0", device0->sid);
+        EXPECT_STREQ("192.168.1.1:54321", device0->baseURI);
+        EXPECT_EQ(1u, OCDiscoveryPayloadGetResourceCount(device0));
+
+        OCDiscoveryPayload *device1 = device0->next;
+        ASSERT_TRUE(device1 != NULL);
+        EXPECT_STREQ("device1", device1->sid);
+        EXPECT_STREQ("192.168.1.1:54322", device1->baseURI);
+        EXPECT_EQ(2u, OCDiscoveryPayloadGetResourceCount(device1));
+        EXPECT_TRUE(device1->next == NULL);
+        OCDiscoveryPayloadDestroy(discPayload);
+    }
+
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseDeleteDevice("device0"));
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseDeleteDevice("device1"));
+    EXPECT_EQ(OC_STACK_OK, OCRDDatabaseClose());
+}
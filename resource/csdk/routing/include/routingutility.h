@@ -163,6 +163,21 @@ OCStackResult RMCreateRouteOption(const RMRouteOption_t *optValue, CAHeaderOptio
  */
 OCStackResult RMParseRouteOption(const CAHeaderOption_t *options, RMRouteOption_t *optValue);
 
+/**
+ * To get the routing option from a received CoAP PDU without parsing the whole PDU.
+ * Only the CoAP message format of UDP is supported.
+ * @param[in]    pdu            Received PDU.
+ * @param[in]    pduLength      Length of the PDU.
+ * @param[out]   options        Routing information in the form of Header options.
+ * @param[out]   isGatewayUri   True if the PDU is addressed to the gateway resource.
+ * @param[out]   hasBlockOption True if the PDU carries a Block1 or Block2 option.
+ * @return  ::OC_STACK_OK, ::OC_STACK_NO_RESOURCE if route option is not present or
+ *          Appropriate error code.
+ */
+OCStackResult RMGetRouteOptionFromPDU(const uint8_t *pdu, size_t pduLength,
+                                      CAHeaderOption_t *options, bool *isGatewayUri,
+                                      bool *hasBlockOption);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
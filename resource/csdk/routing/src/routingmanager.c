@@ -30,6 +30,8 @@
 #include "ulinklist.h"
 #include "uarraylist.h"
 #include "ocstackinternal.h"
+#include "octhread.h"
+#include "cainterface.h"
 #include "include/logger.h"
 
 /**
@@ -93,6 +95,13 @@ static uint16_t g_mcastsequenceNumber = 1;
  */
 static bool g_isRMInitialized = false;
 
+/**
+ * Lock for the routing tables.
+ * Tables are modified on the stack thread only, and read without the lock there.
+ * Packets passing through are forwarded from the adapter threads, which read under the lock.
+ */
+static oc_mutex g_routingTableLock = NULL;
+
 /**
  * API to handle the GET request received for a Gateway Resource.
  * @param[in]   request     Request Received.
@@ -141,6 +150,19 @@ OCStackResult RMSendNotificationToAll(const OCRepPayload *payload);
  */
 void RMSendDeleteToNeighbourNodes();
 
+/**
+ * Forward a received packet to the next hop without parsing and regenerating it.
+ * Only unicast packets passing through this gateway, whose route option does not change,
+ * are forwarded here. Everything else goes through ::RMHandlePacket.
+ * @param[in]   sender      Sender of the packet.
+ * @param[in]   data        Received CoAP PDU.
+ * @param[in]   dataLen     Length of the PDU.
+ * @param[out]  nextHop     Endpoint to forward the PDU to.
+ * @return  true if the PDU is to be forwarded to nextHop as it is.
+ */
+static bool RMForwardRawPacket(const CAEndpoint_t *sender, const void *data,
+                               uint32_t dataLen, CAEndpoint_t *nextHop);
+
 OCStackResult RMGenerateGatewayID(uint8_t *id, size_t idLen)
 {
     OIC_LOG(DEBUG, TAG, "RMGenerateGatewayID IN");
@@ -182,22 +204,36 @@ OCStackResult RMInitialize()
 
     OIC_LOG_V(INFO, RM_TAG, "Gateway ID: %u", g_GatewayID);
 
+    g_routingTableLock = oc_mutex_new();
+    if (!g_routingTableLock)
+    {
+        OIC_LOG(ERROR, TAG, "Failed to create routing table lock");
+        return OC_STACK_NO_MEMORY;
+    }
+
     // Initialize the Routing table manager.
     result = RTMInitialize(&g_routingGatewayTable, &g_routingEndpointTable);
     if (OC_STACK_OK != result)
     {
         OIC_LOG_V(ERROR, TAG, "RTMInitialize failed[%d]", result);
+        oc_mutex_free(g_routingTableLock);
+        g_routingTableLock = NULL;
         return result;
     }
 
     g_isRMInitialized = true;
+    CARegisterPacketForwardHandler(RMForwardRawPacket);
 
     // Send a DISCOVER request for the gateway resource.
     result = RMDiscoverGatewayResource();
     if (OC_STACK_OK != result)
     {
         OIC_LOG_V(ERROR, TAG, "RMDiscoverGatewayResource failed[%d]", result);
+        CARegisterPacketForwardHandler(NULL);
+        g_isRMInitialized = false;
         RTMTerminate(&g_routingGatewayTable, &g_routingEndpointTable);
+        oc_mutex_free(g_routingTableLock);
+        g_routingTableLock = NULL;
         return result;
     }
 
@@ -220,13 +256,20 @@ OCStackResult RMTerminate()
     // Send DELETE request to neighbour nodes
     RMSendDeleteToNeighbourNodes();
 
+    // Keep the adapter threads away from the routing table before it and its lock are freed.
+    g_isRMInitialized = false;
+    CARegisterPacketForwardHandler(NULL);
+
+    oc_mutex_lock(g_routingTableLock);
     OCStackResult result = RTMTerminate(&g_routingGatewayTable, &g_routingEndpointTable);
+    oc_mutex_unlock(g_routingTableLock);
+    oc_mutex_free(g_routingTableLock);
+    g_routingTableLock = NULL;
     if (OC_STACK_OK != result)
     {
-        OIC_LOG_V(ERROR, TAG, "CARegisterRoutingMessageHandler failed[%d]", result);
+        OIC_LOG_V(ERROR, TAG, "RTMTerminate failed[%d]", result);
         return result;
     }
-    g_isRMInitialized = false;
     OIC_LOG(DEBUG, TAG, "RMTerminate OUT");
     return result;
 }
@@ -299,7 +342,9 @@ OCStackResult RMHandleRequestPayload(OCDevAddr devAddr, const uint8_t *reqPayloa
     OIC_LOG_V(INFO, TAG, "Add the gateway ID: %u", gatewayId);
     RTMDestIntfInfo_t destInterfaces = {.observerId = 0};
     destInterfaces.destIntfAddr = endpoint;
+    oc_mutex_lock(g_routingTableLock);
     result = RTMAddGatewayEntry(gatewayId, 0, 1, &destInterfaces, &g_routingGatewayTable);
+    oc_mutex_unlock(g_routingTableLock);
 
     if (OC_STACK_OK != result)
     {
@@ -376,8 +421,10 @@ OCStackResult RMHandleResponsePayload(const OCDevAddr *devAddr, const OCRepPaylo
     {
         OIC_LOG_V(DEBUG, TAG, "Sequence Number of Resp payload is %d, Forceupdate: %d",
                  seqNum, isUpdateSeqNum);
+        oc_mutex_lock(g_routingTableLock);
         result = RTMUpdateEntryParameters(gatewayId, seqNum, &destInterfaces,
                                           &g_routingGatewayTable, isUpdateSeqNum);
+        oc_mutex_unlock(g_routingTableLock);
         if (OC_STACK_COMM_ERROR == result)
         {
             OIC_LOG(ERROR, TAG, "Few packet drops are found, sequence number is not matching");
@@ -426,7 +473,9 @@ OCStackResult RMHandleResponsePayload(const OCDevAddr *devAddr, const OCRepPaylo
     if (false == doRemoveEntry)
     {
         OIC_LOG_V(INFO, TAG, "Add the gateway ID: %u", gatewayId);
+        oc_mutex_lock(g_routingTableLock);
         result = RTMAddGatewayEntry(gatewayId, 0, 1, &destInterfaces, &g_routingGatewayTable);
+        oc_mutex_unlock(g_routingTableLock);
         if (OC_STACK_OK == result)
         {
             OIC_LOG(INFO, TAG, "Node was added");
@@ -470,9 +519,11 @@ OCStackResult RMHandleResponsePayload(const OCDevAddr *devAddr, const OCRepPaylo
         {
             // Remove the entry from RTM.
             RTMGatewayEntry_t *existEntry = NULL;
+            oc_mutex_lock(g_routingTableLock);
             result = RTMRemoveGatewayDestEntry(entry->destination->gatewayId, gatewayId,
                                                &destInterfaces, &existEntry,
                                                &g_routingGatewayTable);
+            oc_mutex_unlock(g_routingTableLock);
             if (OC_STACK_OK != result && NULL != existEntry)
             {
                 u_linklist_add(alternativeRouteList, (void *)existEntry);
@@ -482,8 +533,10 @@ OCStackResult RMHandleResponsePayload(const OCDevAddr *devAddr, const OCRepPaylo
         {
             // Add the entry to RTM.
             entry->routeCost = entry->routeCost + 1;
+            oc_mutex_lock(g_routingTableLock);
             result = RTMAddGatewayEntry(entry->destination->gatewayId, gatewayId,
                                         entry->routeCost, NULL, &g_routingGatewayTable);
+            oc_mutex_unlock(g_routingTableLock);
         }
 
         if (OC_STACK_OK == result)
@@ -639,7 +692,9 @@ OCStackResult RMHandleDELETERequest(const OCServerRequest *request, const OCReso
     OIC_LOG_V(INFO, TAG, "Remove the gateway ID: %u", gatewayId);
 
     u_linklist_t *removedGatewayNodes = NULL;
+    oc_mutex_lock(g_routingTableLock);
     result = RTMRemoveGatewayEntry(gatewayId, &removedGatewayNodes, &g_routingGatewayTable);
+    oc_mutex_unlock(g_routingTableLock);
     RM_VERIFY_SUCCESS(result, OC_STACK_OK);
 
     if (0 < u_linklist_length(removedGatewayNodes))
@@ -691,7 +746,9 @@ OCStackResult RMAddObserver(OCServerRequest *request, OCObservationId *obsID)
         OIC_LOG(DEBUG, TAG, "Added observer successfully");
 
         // Add the observer to the list.
+        oc_mutex_lock(g_routingTableLock);
         result = RTMAddObserver(*obsID, endpoint, &g_routingGatewayTable);
+        oc_mutex_unlock(g_routingTableLock);
         if (OC_STACK_OK != result)
         {
             OIC_LOG_V(DEBUG, TAG, "RMAddObserver failed[%d]", result);
@@ -761,7 +818,9 @@ void RMProcess()
         OIC_LOG(DEBUG, TAG, "Validating the routing table");
         u_linklist_t *removedEntries = NULL;
         // Remove the invalid gateway entries.
+        oc_mutex_lock(g_routingTableLock);
         RTMRemoveInvalidGateways(&removedEntries, &g_routingGatewayTable);
+        oc_mutex_unlock(g_routingTableLock);
         if (0 < u_linklist_length(removedEntries))
         {
             OCRepPayload *resPayloads = NULL;
@@ -790,7 +849,9 @@ void RMProcess()
     {
         OIC_LOG_V(DEBUG, TAG, "Refreshing the routing table: %llu", currentTime);
         u_linklist_t* invalidInterfaces = NULL;
+        oc_mutex_lock(g_routingTableLock);
         RTMUpdateDestAddrValidity(&invalidInterfaces, &g_routingGatewayTable);
+        oc_mutex_unlock(g_routingTableLock);
         if (0 < u_linklist_length(invalidInterfaces))
         {
             u_linklist_iterator_t *iterTable = NULL;
@@ -981,7 +1042,9 @@ OCStackResult RMHandlePacket(bool isRequest, void *message, const CAEndpoint_t *
         OIC_LOG(INFO, RM_TAG, "Source missing in option");
         // Packet from end device as Gateway will add source in option.
         uint16_t endpointId = g_EndpointCount + 1;
+        oc_mutex_lock(g_routingTableLock);
         OCStackResult res = RTMAddEndpointEntry(&endpointId, sender, &g_routingEndpointTable);
+        oc_mutex_unlock(g_routingTableLock);
         if (OC_STACK_OK == res)
         {
             g_EndpointCount = endpointId;
@@ -1018,8 +1081,10 @@ OCStackResult RMHandlePacket(bool isRequest, void *message, const CAEndpoint_t *
         }
         else
         {
+            oc_mutex_lock(g_routingTableLock);
             OCStackResult update = RTMUpdateMcastSeqNumber(routeOption.srcGw, routeOption.mSeqNum,
                                                            &g_routingGatewayTable);
+            oc_mutex_unlock(g_routingTableLock);
             if (OC_STACK_OK != update)
             {
                 // this shouldnt have been forwarded. ignore.
@@ -1252,6 +1317,89 @@ rewriteandexit:
     return OC_STACK_OK;
 }
 
+static bool RMForwardRawPacket(const CAEndpoint_t *sender, const void *data,
+                               uint32_t dataLen, CAEndpoint_t *nextHop)
+{
+    if (!g_isRMInitialized || !sender || !data || !nextHop)
+    {
+        return false;
+    }
+
+    // Secured packets are not supported, and CoAP over TCP uses another message format.
+    if ((sender->flags & CA_SECURE) || !(sender->adapter & (CA_ADAPTER_IP |
+        CA_ADAPTER_GATT_BTLE | CA_ADAPTER_RFCOMM_BTEDR)))
+    {
+        return false;
+    }
+
+    /*
+     * Blockwise transfers are reassembled by CA before they are routed, so packets with a
+     * block option also go through RMHandlePacket.
+     */
+    CAHeaderOption_t option = {.optionID = 0};
+    bool isGatewayUri = false;
+    bool hasBlockOption = false;
+    if (OC_STACK_OK != RMGetRouteOptionFromPDU(data, dataLen, &option, &isGatewayUri,
+                                               &hasBlockOption) ||
+        isGatewayUri || hasBlockOption)
+    {
+        return false;
+    }
+
+    RMRouteOption_t routeOption = {.srcGw = 0};
+    if (OC_STACK_OK != RMParseRouteOption(&option, &routeOption))
+    {
+        return false;
+    }
+
+    /*
+     * Only packets which keep their route option as it is can skip the full handling:
+     * the source is already set by another gateway and the destination is a known unicast
+     * destination. Multicast, EMPTY and own packets are left to RMHandlePacket.
+     */
+    if (NOR != routeOption.msgType || 0 == routeOption.srcGw ||
+        g_GatewayID == routeOption.srcGw || 0 == routeOption.destGw ||
+        (g_GatewayID == routeOption.destGw && 0 == routeOption.destEp))
+    {
+        return false;
+    }
+
+    bool isFound = false;
+    oc_mutex_lock(g_routingTableLock);
+    if (g_GatewayID == routeOption.destGw)
+    {
+        CAEndpoint_t *clientInfo = RTMGetEndpointEntry(routeOption.destEp,
+                                                       g_routingEndpointTable);
+        if (clientInfo)
+        {
+            *nextHop = *clientInfo;
+            isFound = true;
+        }
+    }
+    else
+    {
+        RTMGatewayId_t *nextHopGw = RTMGetNextHop(routeOption.destGw, g_routingGatewayTable);
+        RTMDestIntfInfo_t *address = nextHopGw ?
+                                     u_arraylist_get(nextHopGw->destIntfAddr, 0) : NULL;
+        if (address)
+        {
+            *nextHop = address->destIntfAddr;
+            isFound = true;
+        }
+    }
+    oc_mutex_unlock(g_routingTableLock);
+
+    if (!isFound || !(nextHop->adapter & (CA_ADAPTER_IP | CA_ADAPTER_GATT_BTLE |
+        CA_ADAPTER_RFCOMM_BTEDR)))
+    {
+        return false;
+    }
+
+    OIC_LOG_V(DEBUG, RM_TAG, "Forwarding packet as it is: [%u] -> [%u:%u]",
+              routeOption.srcGw, routeOption.destGw, routeOption.destEp);
+    return true;
+}
+
 OCStackResult RMHandleRequest(CARequestInfo_t *message, const CAEndpoint_t *sender,
                               bool *selfDestination, bool *isEmptyMsg)
 {
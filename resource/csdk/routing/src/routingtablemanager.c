@@ -44,6 +44,165 @@
 
 static const uint64_t USECS_PER_SEC = 1000000;
 
+/**
+ * Number of buckets of the routing table indexes. Must be a power of two.
+ */
+#define RTM_INDEX_BUCKETS 128
+
+/**
+ * Entry of a routing table index.
+ */
+typedef struct RTMIndexNode
+{
+    uint32_t key;                           /**< Gateway id, endpoint id or address hash. */
+    void *data;                             /**< Routing table entry. */
+    struct RTMIndexNode *next;              /**< Next entry in the same bucket. */
+} RTMIndexNode_t;
+
+/**
+ * Hash index over the entries of a routing table, so that routed packets do not
+ * need a scan of the table.
+ */
+typedef struct
+{
+    const u_linklist_t *table;              /**< Table the index is kept for. */
+    RTMIndexNode_t *buckets[RTM_INDEX_BUCKETS];
+} RTMIndex_t;
+
+/**
+ * Gateway id to RTMGatewayEntry_t of the gateway routing table.
+ * The entry holds the best known route to the gateway.
+ */
+static RTMIndex_t g_gatewayIndex;
+
+/**
+ * Endpoint id to RTMEndpointEntry_t of the endpoint routing table.
+ */
+static RTMIndex_t g_endpointIndex;
+
+/**
+ * Address and port hash to RTMEndpointEntry_t of the endpoint routing table.
+ */
+static RTMIndex_t g_endpointAddrIndex;
+
+static uint32_t RTMIndexBucket(uint32_t key)
+{
+    return (key * 2654435761u) & (RTM_INDEX_BUCKETS - 1);
+}
+
+static uint32_t RTMGetAddressHash(const CAEndpoint_t *endpoint)
+{
+    uint32_t hash = 2166136261u;
+    for (const char *c = endpoint->addr; *c; c++)
+    {
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+    }
+    return (hash ^ endpoint->port) * 16777619u;
+}
+
+static bool RTMIndexAdd(RTMIndex_t *index, uint32_t key, void *data)
+{
+    RTMIndexNode_t *node = (RTMIndexNode_t *) OICMalloc(sizeof(RTMIndexNode_t));
+    if (NULL == node)
+    {
+        OIC_LOG(ERROR, TAG, "Malloc failed for index node");
+        return false;
+    }
+    uint32_t bucket = RTMIndexBucket(key);
+    node->key = key;
+    node->data = data;
+    node->next = index->buckets[bucket];
+    index->buckets[bucket] = node;
+    return true;
+}
+
+static void RTMIndexRemove(RTMIndex_t *index, uint32_t key, const void *data)
+{
+    RTMIndexNode_t **node = &index->buckets[RTMIndexBucket(key)];
+    while (NULL != *node)
+    {
+        if (key == (*node)->key && data == (*node)->data)
+        {
+            RTMIndexNode_t *removed = *node;
+            *node = removed->next;
+            OICFree(removed);
+            return;
+        }
+        node = &(*node)->next;
+    }
+}
+
+/*
+ * Returns the first node of the bucket of key. The caller has to compare the keys
+ * while walking the bucket.
+ */
+static RTMIndexNode_t *RTMIndexGetBucket(const RTMIndex_t *index, uint32_t key)
+{
+    return index->buckets[RTMIndexBucket(key)];
+}
+
+static void *RTMIndexFind(const RTMIndex_t *index, uint32_t key)
+{
+    for (RTMIndexNode_t *node = RTMIndexGetBucket(index, key); node; node = node->next)
+    {
+        if (key == node->key)
+        {
+            return node->data;
+        }
+    }
+    return NULL;
+}
+
+static void RTMIndexClear(RTMIndex_t *index)
+{
+    for (uint32_t i = 0; i < RTM_INDEX_BUCKETS; i++)
+    {
+        while (NULL != index->buckets[i])
+        {
+            RTMIndexNode_t *node = index->buckets[i];
+            index->buckets[i] = node->next;
+            OICFree(node);
+        }
+    }
+    index->table = NULL;
+}
+
+/*
+ * Finds the entry for a destination gateway, using the index when the table is the
+ * indexed gateway table.
+ */
+static RTMGatewayEntry_t *RTMFindGatewayEntry(uint32_t gatewayId, const u_linklist_t *gatewayTable)
+{
+    if (NULL != gatewayTable && gatewayTable == g_gatewayIndex.table)
+    {
+        return RTMIndexFind(&g_gatewayIndex, gatewayId);
+    }
+
+    u_linklist_iterator_t *iterTable = NULL;
+    u_linklist_init_iterator(gatewayTable, &iterTable);
+    while (NULL != iterTable)
+    {
+        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
+        if (NULL != entry && NULL != entry->destination &&
+            gatewayId == entry->destination->gatewayId)
+        {
+            return entry;
+        }
+        u_linklist_get_next(&iterTable);
+    }
+    return NULL;
+}
+
+static bool RTMIsIndexedGatewayTable(const u_linklist_t *gatewayTable)
+{
+    return NULL != gatewayTable && gatewayTable == g_gatewayIndex.table;
+}
+
+static bool RTMIsIndexedEndpointTable(const u_linklist_t *endpointTable)
+{
+    return NULL != endpointTable && endpointTable == g_endpointIndex.table;
+}
+
 OCStackResult RTMInitialize(u_linklist_t **gatewayTable, u_linklist_t **endpointTable)
 {
     OIC_LOG(DEBUG, TAG, "RTMInitialize IN");
@@ -70,6 +229,38 @@ OCStackResult RTMInitialize(u_linklist_t **gatewayTable, u_linklist_t **endpoint
            return OC_STACK_ERROR;
         }
     }
+
+    // Index the entries of both tables, the tables are expected to be empty here.
+    RTMIndexClear(&g_gatewayIndex);
+    RTMIndexClear(&g_endpointIndex);
+    RTMIndexClear(&g_endpointAddrIndex);
+    g_gatewayIndex.table = *gatewayTable;
+    g_endpointIndex.table = *endpointTable;
+    g_endpointAddrIndex.table = *endpointTable;
+
+    u_linklist_iterator_t *iterTable = NULL;
+    u_linklist_init_iterator(*gatewayTable, &iterTable);
+    while (NULL != iterTable)
+    {
+        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
+        if (NULL != entry && NULL != entry->destination)
+        {
+            RTMIndexAdd(&g_gatewayIndex, entry->destination->gatewayId, entry);
+        }
+        u_linklist_get_next(&iterTable);
+    }
+
+    u_linklist_init_iterator(*endpointTable, &iterTable);
+    while (NULL != iterTable)
+    {
+        RTMEndpointEntry_t *entry = u_linklist_get_data(iterTable);
+        if (NULL != entry)
+        {
+            RTMIndexAdd(&g_endpointIndex, entry->endpointId, entry);
+            RTMIndexAdd(&g_endpointAddrIndex, RTMGetAddressHash(&entry->destIntfAddr), entry);
+        }
+        u_linklist_get_next(&iterTable);
+    }
     OIC_LOG(DEBUG, TAG, "RTMInitialize OUT");
     return OC_STACK_OK;
 }
@@ -85,6 +276,11 @@ OCStackResult RTMFreeGatewayRouteTable(u_linklist_t **gatewayTable)
         return OC_STACK_OK;
     }
 
+    if (RTMIsIndexedGatewayTable(*gatewayTable))
+    {
+        RTMIndexClear(&g_gatewayIndex);
+    }
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(*gatewayTable, &iterTable);
     while (NULL != iterTable)
@@ -129,6 +325,12 @@ OCStackResult RTMFreeEndpointRouteTable(u_linklist_t **endpointTable)
         return OC_STACK_OK;
     }
 
+    if (RTMIsIndexedEndpointTable(*endpointTable))
+    {
+        RTMIndexClear(&g_endpointIndex);
+        RTMIndexClear(&g_endpointAddrIndex);
+    }
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(*endpointTable, &iterTable);
     while (NULL != iterTable)
@@ -259,40 +461,18 @@ OCStackResult RTMAddGatewayEntry(uint32_t gatewayId, uint32_t nextHop, uint32_t
         return OC_STACK_ERROR;
     }
 
-    u_linklist_iterator_t *destNode = NULL;
-    RTMGatewayId_t *gatewayNodeMap = NULL;   // Gateway id ponter can be mapped to NextHop of entry.
+    // Entry with this gateway id, to update it instead of adding a new entry.
+    RTMGatewayEntry_t *destEntry = RTMFindGatewayEntry(gatewayId, *gatewayTable);
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*gatewayTable, &iterTable);
-    // Iterate over gateway list to find if already entry with this gatewayid is present.
-    while (NULL != iterTable)
+    // Gateway id pointer can be mapped to NextHop of entry.
+    RTMGatewayId_t *gatewayNodeMap = NULL;
+    if (0 != nextHop)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-        if (NULL == entry)
+        RTMGatewayEntry_t *nextHopEntry = RTMFindGatewayEntry(nextHop, *gatewayTable);
+        if (NULL != nextHopEntry)
         {
-            break;
-        }
-
-        // To save node with same gateway id (To update entry instead of add new entry).
-        if (NULL == destNode && NULL != entry->destination &&
-            (gatewayId == entry->destination->gatewayId))
-        {
-            destNode = iterTable;
-        }
-
-        // To find pointer of gateway id for a node provided next hop equals to existing gateway id.
-        if (0 != nextHop && NULL != entry->destination &&
-            nextHop == entry->destination->gatewayId)
-        {
-            gatewayNodeMap = entry->destination;
-        }
-
-        if (NULL != destNode && NULL != gatewayNodeMap)
-        {
-            break;
+            gatewayNodeMap = nextHopEntry->destination;
         }
-
-        u_linklist_get_next(&iterTable);
     }
 
     if (1 < routeCost && NULL == gatewayNodeMap)
@@ -302,9 +482,9 @@ OCStackResult RTMAddGatewayEntry(uint32_t gatewayId, uint32_t nextHop, uint32_t
     }
 
     //Logic to update entry if it is already destination present or to add new entry.
-    if (NULL != destNode)
+    if (NULL != destEntry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(destNode);
+        RTMGatewayEntry_t *entry = destEntry;
 
         if (NULL != entry  && 1 == entry->routeCost && 0 == nextHop)
         {
@@ -385,7 +565,17 @@ OCStackResult RTMAddGatewayEntry(uint32_t gatewayId, uint32_t nextHop, uint32_t
         }
 
         // Logic to add updated node to Head of list as route cost is 1.
-        if (1 == routeCost && NULL != entry)
+        u_linklist_iterator_t *destNode = NULL;
+        if (1 == routeCost)
+        {
+            u_linklist_init_iterator(*gatewayTable, &destNode);
+            while (NULL != destNode && entry != u_linklist_get_data(destNode))
+            {
+                u_linklist_get_next(&destNode);
+            }
+        }
+
+        if (1 == routeCost && NULL != destNode)
         {
             OCStackResult res = u_linklist_remove(*gatewayTable, &destNode);
             if (OC_STACK_OK != res)
@@ -494,6 +684,21 @@ OCStackResult RTMAddGatewayEntry(uint32_t gatewayId, uint32_t nextHop, uint32_t
             OICFree(hopEntry);
             return OC_STACK_ERROR;
         }
+
+        if (RTMIsIndexedGatewayTable(*gatewayTable) &&
+            !RTMIndexAdd(&g_gatewayIndex, gatewayId, hopEntry))
+        {
+            u_linklist_iterator_t *newNode = NULL;
+            u_linklist_init_iterator(*gatewayTable, &newNode);
+            while (NULL != newNode && hopEntry != u_linklist_get_data(newNode))
+            {
+                u_linklist_get_next(&newNode);
+            }
+            u_linklist_remove(*gatewayTable, &newNode);
+            RTMFreeGateway(hopEntry->destination, gatewayTable);
+            OICFree(hopEntry);
+            return OC_STACK_NO_MEMORY;
+        }
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
@@ -516,23 +721,43 @@ OCStackResult RTMAddEndpointEntry(uint16_t *endpointId, const CAEndpoint_t *dest
         }
     }
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*endpointTable, &iterTable);
-    // Iterate over gateway list to find if already entry with this gatewayid is present.
-    while (NULL != iterTable)
+    bool isIndexed = RTMIsIndexedEndpointTable(*endpointTable);
+    uint32_t addrHash = RTMGetAddressHash(destAddr);
+    if (isIndexed)
     {
-        RTMEndpointEntry_t *entry =
-            (RTMEndpointEntry_t *) u_linklist_get_data(iterTable);
-
-        if (NULL != entry && (0 == memcmp(destAddr->addr, entry->destIntfAddr.addr,
-                              strlen(entry->destIntfAddr.addr)))
-            && destAddr->port == entry->destIntfAddr.port)
+        for (RTMIndexNode_t *node = RTMIndexGetBucket(&g_endpointAddrIndex, addrHash);
+             node; node = node->next)
         {
-            *endpointId = entry->endpointId;
-            OIC_LOG(ERROR, TAG, "Adding failed as Enpoint Entry Already present in Table");
-            return OC_STACK_DUPLICATE_REQUEST;
+            RTMEndpointEntry_t *entry = node->data;
+            if (addrHash == node->key && 0 == strcmp(destAddr->addr, entry->destIntfAddr.addr)
+                && destAddr->port == entry->destIntfAddr.port)
+            {
+                *endpointId = entry->endpointId;
+                OIC_LOG(ERROR, TAG, "Adding failed as Enpoint Entry Already present in Table");
+                return OC_STACK_DUPLICATE_REQUEST;
+            }
+        }
+    }
+    else
+    {
+        u_linklist_iterator_t *iterTable = NULL;
+        u_linklist_init_iterator(*endpointTable, &iterTable);
+        // Iterate over endpoint list to find if already entry with this address is present.
+        while (NULL != iterTable)
+        {
+            RTMEndpointEntry_t *entry =
+                (RTMEndpointEntry_t *) u_linklist_get_data(iterTable);
+
+            if (NULL != entry && (0 == memcmp(destAddr->addr, entry->destIntfAddr.addr,
+                                  strlen(entry->destIntfAddr.addr)))
+                && destAddr->port == entry->destIntfAddr.port)
+            {
+                *endpointId = entry->endpointId;
+                OIC_LOG(ERROR, TAG, "Adding failed as Enpoint Entry Already present in Table");
+                return OC_STACK_DUPLICATE_REQUEST;
+            }
+            u_linklist_get_next(&iterTable);
         }
-        u_linklist_get_next(&iterTable);
     }
 
     // Filling Entry.
@@ -547,10 +772,30 @@ OCStackResult RTMAddEndpointEntry(uint16_t *endpointId, const CAEndpoint_t *dest
     hopEntry->endpointId = *endpointId;
     hopEntry->destIntfAddr = *destAddr;
 
+    if (isIndexed)
+    {
+        if (!RTMIndexAdd(&g_endpointIndex, hopEntry->endpointId, hopEntry))
+        {
+            OICFree(hopEntry);
+            return OC_STACK_NO_MEMORY;
+        }
+        if (!RTMIndexAdd(&g_endpointAddrIndex, addrHash, hopEntry))
+        {
+            RTMIndexRemove(&g_endpointIndex, hopEntry->endpointId, hopEntry);
+            OICFree(hopEntry);
+            return OC_STACK_NO_MEMORY;
+        }
+    }
+
     OCStackResult ret = u_linklist_add(*endpointTable, (void *)hopEntry);
     if (OC_STACK_OK != ret)
     {
        OIC_LOG(ERROR, TAG, "Adding Enpoint Entry to Routing Table failed");
+       if (isIndexed)
+       {
+           RTMIndexRemove(&g_endpointIndex, hopEntry->endpointId, hopEntry);
+           RTMIndexRemove(&g_endpointAddrIndex, addrHash, hopEntry);
+       }
        OICFree(hopEntry);
        return OC_STACK_ERROR;
     }
@@ -675,6 +920,10 @@ OCStackResult RTMRemoveGatewayEntry(uint32_t gatewayId, u_linklist_t **removedGa
             }
             else
             {
+                if (RTMIsIndexedGatewayTable(*gatewayTable))
+                {
+                    RTMIndexRemove(&g_gatewayIndex, entry->destination->gatewayId, entry);
+                }
                 u_linklist_add(*removedGatewayNodes, (void *)entry);
             }
         }
@@ -741,6 +990,10 @@ OCStackResult RTMRemoveGatewayDestEntry(uint32_t gatewayId, uint32_t nextHop,
                    OIC_LOG(ERROR, TAG, "Deleting Entry from Routing Table failed");
                    return OC_STACK_ERROR;
                 }
+                if (RTMIsIndexedGatewayTable(*gatewayTable))
+                {
+                    RTMIndexRemove(&g_gatewayIndex, gatewayId, entry);
+                }
                 OICFree(entry);
                 return OC_STACK_OK;
             }
@@ -775,6 +1028,12 @@ OCStackResult RTMRemoveEndpointEntry(uint16_t endpointId, u_linklist_t **endpoin
                OIC_LOG(ERROR, TAG, "Deleting Entry from Routing Table failed");
                return OC_STACK_ERROR;
             }
+            if (RTMIsIndexedEndpointTable(*endpointTable))
+            {
+                RTMIndexRemove(&g_endpointIndex, endpointId, entry);
+                RTMIndexRemove(&g_endpointAddrIndex,
+                               RTMGetAddressHash(&entry->destIntfAddr), entry);
+            }
             OICFree(entry);
         }
         else
@@ -888,22 +1147,16 @@ RTMGatewayId_t *RTMGetNextHop(uint32_t gatewayId, const u_linklist_t *gatewayTab
         return NULL;
     }
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(gatewayTable, &iterTable);
-    while (NULL != iterTable)
+    RTMGatewayEntry_t *entry = RTMFindGatewayEntry(gatewayId, gatewayTable);
+    if (NULL != entry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-        if (NULL != entry && gatewayId == entry->destination->gatewayId)
+        if (1 == entry->routeCost)
         {
-            if (1 == entry->routeCost)
-            {
-                OIC_LOG(DEBUG, TAG, "OUT");
-                return entry->destination;
-            }
             OIC_LOG(DEBUG, TAG, "OUT");
-            return entry->nextHop;
+            return entry->destination;
         }
-        u_linklist_get_next(&iterTable);
+        OIC_LOG(DEBUG, TAG, "OUT");
+        return entry->nextHop;
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return NULL;
@@ -918,6 +1171,13 @@ CAEndpoint_t *RTMGetEndpointEntry(uint16_t endpointId, const u_linklist_t *endpo
         return NULL;
     }
 
+    if (RTMIsIndexedEndpointTable(endpointTable))
+    {
+        RTMEndpointEntry_t *entry = RTMIndexFind(&g_endpointIndex, endpointId);
+        OIC_LOG(DEBUG, TAG, "OUT");
+        return entry ? &(entry->destIntfAddr) : NULL;
+    }
+
     u_linklist_iterator_t *iterTable = NULL;
     u_linklist_init_iterator(endpointTable, &iterTable);
 
@@ -989,79 +1249,72 @@ OCStackResult RTMUpdateDestinationIntfAdr(uint32_t gatewayId, RTMDestIntfInfo_t
     RM_NULL_CHECK_WITH_RET(gatewayTable, TAG, "gatewayTable");
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*gatewayTable, &iterTable);
-    while (NULL != iterTable)
+    RTMGatewayEntry_t *entry = RTMFindGatewayEntry(gatewayId, *gatewayTable);
+    if (NULL != entry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-        if (NULL != entry && NULL != entry->destination &&
-            gatewayId == entry->destination->gatewayId)
+        if (addAdr)
         {
-            if (addAdr)
+            for (uint32_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
             {
-                for (uint32_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
+                RTMDestIntfInfo_t *destCheck =
+                    u_arraylist_get(entry->destination->destIntfAddr, i);
+                if (NULL == destCheck)
                 {
-                    RTMDestIntfInfo_t *destCheck =
-                        u_arraylist_get(entry->destination->destIntfAddr, i);
-                    if (NULL == destCheck)
-                    {
-                        OIC_LOG(ERROR, TAG, "Destination adr get failed");
-                        continue;
-                    }
-
-                    if (0 == memcmp(destCheck->destIntfAddr.addr, destInterfaces.destIntfAddr.addr,
-                        strlen(destInterfaces.destIntfAddr.addr))
-                        && destInterfaces.destIntfAddr.port == destCheck->destIntfAddr.port)
-                    {
-                        destCheck->timeElapsed = RTMGetCurrentTime();
-                        destCheck->isValid = true;
-                        OIC_LOG(ERROR, TAG, "destInterfaces already present");
-                        return OC_STACK_ERROR;
-                    }
+                    OIC_LOG(ERROR, TAG, "Destination adr get failed");
+                    continue;
                 }
 
-                RTMDestIntfInfo_t *destAdr =
-                        (RTMDestIntfInfo_t *) OICCalloc(1, sizeof(RTMDestIntfInfo_t));
-                if (NULL == destAdr)
-                {
-                    OIC_LOG(ERROR, TAG, "Calloc destAdr failed");
-                    return OC_STACK_ERROR;
-                }
-                *destAdr = destInterfaces;
-                destAdr->timeElapsed = RTMGetCurrentTime();
-                destAdr->isValid = true;
-                bool result =
-                    u_arraylist_add(entry->destination->destIntfAddr, (void *)destAdr);
-                if (!result)
+                if (0 == memcmp(destCheck->destIntfAddr.addr, destInterfaces.destIntfAddr.addr,
+                    strlen(destInterfaces.destIntfAddr.addr))
+                    && destInterfaces.destIntfAddr.port == destCheck->destIntfAddr.port)
                 {
-                    OIC_LOG(ERROR, TAG, "Updating Destinterface address failed");
-                    OICFree(destAdr);
+                    destCheck->timeElapsed = RTMGetCurrentTime();
+                    destCheck->isValid = true;
+                    OIC_LOG(ERROR, TAG, "destInterfaces already present");
                     return OC_STACK_ERROR;
                 }
-                OIC_LOG(DEBUG, TAG, "OUT");
-                return OC_STACK_DUPLICATE_REQUEST;
             }
 
-            for (uint32_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
+            RTMDestIntfInfo_t *destAdr =
+                    (RTMDestIntfInfo_t *) OICCalloc(1, sizeof(RTMDestIntfInfo_t));
+            if (NULL == destAdr)
             {
-                RTMDestIntfInfo_t *removeAdr =
-                    u_arraylist_get(entry->destination->destIntfAddr, i);
-                if (!removeAdr)
-                {
-                    continue;
-                }
-                if (0 == memcmp(removeAdr->destIntfAddr.addr, destInterfaces.destIntfAddr.addr,
-                    strlen(destInterfaces.destIntfAddr.addr))
-                    && destInterfaces.destIntfAddr.port == removeAdr->destIntfAddr.port)
-                {
-                    RTMDestIntfInfo_t *data =
-                        u_arraylist_remove(entry->destination->destIntfAddr, i);
-                    OICFree(data);
-                    break;
-                }
+                OIC_LOG(ERROR, TAG, "Calloc destAdr failed");
+                return OC_STACK_ERROR;
+            }
+            *destAdr = destInterfaces;
+            destAdr->timeElapsed = RTMGetCurrentTime();
+            destAdr->isValid = true;
+            bool result =
+                u_arraylist_add(entry->destination->destIntfAddr, (void *)destAdr);
+            if (!result)
+            {
+                OIC_LOG(ERROR, TAG, "Updating Destinterface address failed");
+                OICFree(destAdr);
+                return OC_STACK_ERROR;
+            }
+            OIC_LOG(DEBUG, TAG, "OUT");
+            return OC_STACK_DUPLICATE_REQUEST;
+        }
+
+        for (uint32_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
+        {
+            RTMDestIntfInfo_t *removeAdr =
+                u_arraylist_get(entry->destination->destIntfAddr, i);
+            if (!removeAdr)
+            {
+                continue;
+            }
+            if (0 == memcmp(removeAdr->destIntfAddr.addr, destInterfaces.destIntfAddr.addr,
+                strlen(destInterfaces.destIntfAddr.addr))
+                && destInterfaces.destIntfAddr.port == removeAdr->destIntfAddr.port)
+            {
+                RTMDestIntfInfo_t *data =
+                    u_arraylist_remove(entry->destination->destIntfAddr, i);
+                OICFree(data);
+                break;
             }
         }
-        u_linklist_get_next(&iterTable);
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
@@ -1074,29 +1327,22 @@ OCStackResult RTMUpdateMcastSeqNumber(uint32_t gatewayId, uint16_t seqNum,
     RM_NULL_CHECK_WITH_RET(gatewayTable, TAG, "gatewayTable");
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*gatewayTable, &iterTable);
-    while (NULL != iterTable)
+    RTMGatewayEntry_t *entry = RTMFindGatewayEntry(gatewayId, *gatewayTable);
+    if (NULL != entry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-        if (NULL != entry && NULL != entry->destination &&
-            gatewayId == entry->destination->gatewayId)
+        if (0 == entry->mcastMessageSeqNum || entry->mcastMessageSeqNum < seqNum)
         {
-            if (0 == entry->mcastMessageSeqNum || entry->mcastMessageSeqNum < seqNum)
-            {
-                entry->mcastMessageSeqNum = seqNum;
-                return OC_STACK_OK;
-            }
-            else if (entry->mcastMessageSeqNum == seqNum)
-            {
-                return OC_STACK_DUPLICATE_REQUEST;
-            }
-            else
-            {
-                return OC_STACK_COMM_ERROR;
-            }
+            entry->mcastMessageSeqNum = seqNum;
+            return OC_STACK_OK;
+        }
+        else if (entry->mcastMessageSeqNum == seqNum)
+        {
+            return OC_STACK_DUPLICATE_REQUEST;
+        }
+        else
+        {
+            return OC_STACK_COMM_ERROR;
         }
-        u_linklist_get_next(&iterTable);
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
@@ -1257,49 +1503,37 @@ OCStackResult RTMUpdateEntryParameters(uint32_t gatewayId, uint32_t seqNum,
     RM_NULL_CHECK_WITH_RET(*gatewayTable, TAG, "*gatewayTable");
     RM_NULL_CHECK_WITH_RET(destAdr, TAG, "destAdr");
 
-    u_linklist_iterator_t *iterTable = NULL;
-    u_linklist_init_iterator(*gatewayTable, &iterTable);
-    while (NULL != iterTable)
+    RTMGatewayEntry_t *entry = RTMFindGatewayEntry(gatewayId, *gatewayTable);
+    if (NULL != entry)
     {
-        RTMGatewayEntry_t *entry = u_linklist_get_data(iterTable);
-
-        if (NULL == entry)
-        {
-            u_linklist_get_next(&iterTable);
-            continue;
-        }
-        if (NULL != entry->destination && gatewayId == entry->destination->gatewayId)
+        for (uint32_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
         {
-            for (uint32_t i = 0; i < u_arraylist_length(entry->destination->destIntfAddr); i++)
+            RTMDestIntfInfo_t *destCheck =
+                u_arraylist_get(entry->destination->destIntfAddr, i);
+            if (NULL != destCheck &&
+                (0 == memcmp(destCheck->destIntfAddr.addr, destAdr->destIntfAddr.addr,
+                 strlen(destAdr->destIntfAddr.addr)))
+                 && destAdr->destIntfAddr.port == destCheck->destIntfAddr.port)
             {
-                RTMDestIntfInfo_t *destCheck =
-                    u_arraylist_get(entry->destination->destIntfAddr, i);
-                if (NULL != destCheck &&
-                    (0 == memcmp(destCheck->destIntfAddr.addr, destAdr->destIntfAddr.addr,
-                     strlen(destAdr->destIntfAddr.addr)))
-                     && destAdr->destIntfAddr.port == destCheck->destIntfAddr.port)
-                {
-                    destCheck->timeElapsed = RTMGetCurrentTime();
-                    destCheck->isValid = true;
-                }
+                destCheck->timeElapsed = RTMGetCurrentTime();
+                destCheck->isValid = true;
             }
+        }
 
-            if (0 != entry->seqNum && seqNum == entry->seqNum)
-            {
-                return OC_STACK_DUPLICATE_REQUEST;
-            }
-            else if (0 != entry->seqNum && seqNum != ((entry->seqNum) + 1) && !forceUpdate)
-            {
-                return OC_STACK_COMM_ERROR;
-            }
-            else
-            {
-                entry->seqNum = seqNum;
-                OIC_LOG(DEBUG, TAG, "OUT");
-                return OC_STACK_OK;
-            }
+        if (0 != entry->seqNum && seqNum == entry->seqNum)
+        {
+            return OC_STACK_DUPLICATE_REQUEST;
+        }
+        else if (0 != entry->seqNum && seqNum != ((entry->seqNum) + 1) && !forceUpdate)
+        {
+            return OC_STACK_COMM_ERROR;
+        }
+        else
+        {
+            entry->seqNum = seqNum;
+            OIC_LOG(DEBUG, TAG, "OUT");
+            return OC_STACK_OK;
         }
-        u_linklist_get_next(&iterTable);
     }
     OIC_LOG(DEBUG, TAG, "OUT");
     return OC_STACK_OK;
@@ -66,6 +66,27 @@
  */
 #define NORMAL_MESSAGE_TYPE (3 << 6)
 
+/**
+ * Length of the fixed CoAP header in the UDP message format.
+ */
+#define COAP_PDU_HEADER_LEN 4
+
+/**
+ * CoAP Uri-Path option number.
+ */
+#define COAP_PDU_OPTION_URI_PATH 11
+
+/**
+ * CoAP Block2 and Block1 option numbers.
+ */
+#define COAP_PDU_OPTION_BLOCK2 23
+#define COAP_PDU_OPTION_BLOCK1 27
+
+/**
+ * CoAP marker between the options and the payload.
+ */
+#define COAP_PDU_PAYLOAD_MARKER 0xFF
+
 /**
  * Stack mode.
  */
@@ -507,3 +528,110 @@ OCStackResult RMParseRouteOption(const CAHeaderOption_t *options, RMRouteOption_
     OIC_LOG(DEBUG, RM_TAG, "OUT");
     return OC_STACK_OK;
 }
+
+/*
+ * Reads the extended delta or length of a CoAP option.
+ * Returns false if the PDU is malformed.
+ */
+static bool RMReadOptionNibble(const uint8_t *pdu, size_t pduLength, size_t *offset,
+                               uint32_t *value)
+{
+    if (13 == *value)
+    {
+        if (*offset + 1 > pduLength)
+        {
+            return false;
+        }
+        *value = 13 + pdu[*offset];
+        *offset += 1;
+    }
+    else if (14 == *value)
+    {
+        if (*offset + 2 > pduLength)
+        {
+            return false;
+        }
+        *value = 269 + ((pdu[*offset] << 8) | pdu[*offset + 1]);
+        *offset += 2;
+    }
+    else if (15 == *value)
+    {
+        return false;
+    }
+    return true;
+}
+
+OCStackResult RMGetRouteOptionFromPDU(const uint8_t *pdu, size_t pduLength,
+                                      CAHeaderOption_t *options, bool *isGatewayUri,
+                                      bool *hasBlockOption)
+{
+    RM_NULL_CHECK_WITH_RET(pdu, RM_TAG, "pdu");
+    RM_NULL_CHECK_WITH_RET(options, RM_TAG, "options");
+    RM_NULL_CHECK_WITH_RET(isGatewayUri, RM_TAG, "isGatewayUri");
+    RM_NULL_CHECK_WITH_RET(hasBlockOption, RM_TAG, "hasBlockOption");
+
+    if (COAP_PDU_HEADER_LEN > pduLength)
+    {
+        OIC_LOG(ERROR, RM_TAG, "PDU is too short");
+        return OC_STACK_ERROR;
+    }
+
+    // The Uri-Path segments are joined here only to compare them with the gateway URI.
+    char uri[sizeof(OC_RSRVD_GATEWAY_URI) + 1] = { 0 };
+    size_t uriLength = 0;
+    bool isUriTooLong = false;
+    bool isOptionFound = false;
+    *hasBlockOption = false;
+
+    uint32_t optionNumber = 0;
+    size_t offset = COAP_PDU_HEADER_LEN + (pdu[0] & 0x0F);
+    while (offset < pduLength && COAP_PDU_PAYLOAD_MARKER != pdu[offset])
+    {
+        uint32_t delta = pdu[offset] >> 4;
+        uint32_t length = pdu[offset] & 0x0F;
+        offset++;
+
+        if (!RMReadOptionNibble(pdu, pduLength, &offset, &delta) ||
+            !RMReadOptionNibble(pdu, pduLength, &offset, &length) ||
+            offset + length > pduLength)
+        {
+            OIC_LOG(ERROR, RM_TAG, "Malformed option in PDU");
+            return OC_STACK_ERROR;
+        }
+
+        optionNumber += delta;
+        if (RM_OPTION_MESSAGE_SWITCHING == optionNumber)
+        {
+            if (CA_MAX_HEADER_OPTION_DATA_LENGTH < length)
+            {
+                OIC_LOG(ERROR, RM_TAG, "Route option is too long");
+                return OC_STACK_ERROR;
+            }
+            memcpy(options->optionData, pdu + offset, length);
+            options->optionID = RM_OPTION_MESSAGE_SWITCHING;
+            options->optionLength = length;
+            isOptionFound = true;
+        }
+        else if (COAP_PDU_OPTION_BLOCK2 == optionNumber || COAP_PDU_OPTION_BLOCK1 == optionNumber)
+        {
+            *hasBlockOption = true;
+        }
+        else if (COAP_PDU_OPTION_URI_PATH == optionNumber && !isUriTooLong)
+        {
+            if (uriLength + 1 + length >= sizeof(uri))
+            {
+                isUriTooLong = true;
+            }
+            else
+            {
+                uri[uriLength++] = '/';
+                memcpy(uri + uriLength, pdu + offset, length);
+                uriLength += length;
+            }
+        }
+        offset += length;
+    }
+
+    *isGatewayUri = !isUriTooLong && (0 == strcmp(uri, OC_RSRVD_GATEWAY_URI));
+    return isOptionFound ? OC_STACK_OK : OC_STACK_NO_RESOURCE;
+}
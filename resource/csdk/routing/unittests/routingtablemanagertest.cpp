@@ -0,0 +1,171 @@
+//******************************************************************
+//
+// Copyright 2016 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+
+#include "routingtablemanager.h"
+
+class RoutingTableManagerTest : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        m_gatewayTable = NULL;
+        m_endpointTable = NULL;
+        ASSERT_EQ(OC_STACK_OK, RTMInitialize(&m_gatewayTable, &m_endpointTable));
+    }
+
+    virtual void TearDown()
+    {
+        RTMTerminate(&m_gatewayTable, &m_endpointTable);
+    }
+
+    // Adds a gateway which is reachable directly.
+    OCStackResult addNeighbour(uint32_t gatewayId)
+    {
+        RTMDestIntfInfo_t destInterfaces;
+        memset(&destInterfaces, 0, sizeof(destInterfaces));
+        destInterfaces.destIntfAddr.adapter = CA_ADAPTER_IP;
+        snprintf(destInterfaces.destIntfAddr.addr, sizeof(destInterfaces.destIntfAddr.addr),
+                 "10.0.%u.%u", (gatewayId >> 8) & 0xFF, gatewayId & 0xFF);
+        destInterfaces.destIntfAddr.port = 5683;
+        return RTMAddGatewayEntry(gatewayId, 0, 1, &destInterfaces, &m_gatewayTable);
+    }
+
+    OCStackResult addRoute(uint32_t gatewayId, uint32_t nextHop, uint32_t routeCost)
+    {
+        return RTMAddGatewayEntry(gatewayId, nextHop, routeCost, NULL, &m_gatewayTable);
+    }
+
+    uint32_t getNextHop(uint32_t gatewayId)
+    {
+        RTMGatewayId_t *nextHop = RTMGetNextHop(gatewayId, m_gatewayTable);
+        return nextHop ? nextHop->gatewayId : 0;
+    }
+
+    u_linklist_t *m_gatewayTable;
+    u_linklist_t *m_endpointTable;
+};
+
+TEST_F(RoutingTableManagerTest, NextHopOfNeighbourIsNeighbour)
+{
+    ASSERT_EQ(OC_STACK_OK, addNeighbour(10));
+
+    EXPECT_EQ(10u, getNextHop(10));
+    EXPECT_EQ(0u, getNextHop(20));
+}
+
+TEST_F(RoutingTableManagerTest, NextHopUsesCheapestRoute)
+{
+    ASSERT_EQ(OC_STACK_OK, addNeighbour(10));
+    ASSERT_EQ(OC_STACK_OK, addNeighbour(11));
+
+    ASSERT_EQ(OC_STACK_OK, addRoute(20, 10, 3));
+    EXPECT_EQ(10u, getNextHop(20));
+
+    ASSERT_EQ(OC_STACK_OK, addRoute(20, 11, 2));
+    EXPECT_EQ(11u, getNextHop(20));
+
+    // A more expensive route does not replace the best one.
+    EXPECT_NE(OC_STACK_OK, addRoute(20, 10, 3));
+    EXPECT_EQ(11u, getNextHop(20));
+
+    // One entry per destination, which holds the best route.
+    EXPECT_EQ(3u, u_linklist_length(m_gatewayTable));
+}
+
+TEST_F(RoutingTableManagerTest, NextHopOfGatewayWhichBecameNeighbour)
+{
+    ASSERT_EQ(OC_STACK_OK, addNeighbour(10));
+    ASSERT_EQ(OC_STACK_OK, addRoute(20, 10, 2));
+    EXPECT_EQ(10u, getNextHop(20));
+
+    ASSERT_EQ(OC_STACK_OK, addNeighbour(20));
+    EXPECT_EQ(20u, getNextHop(20));
+    EXPECT_EQ(2u, u_linklist_length(m_gatewayTable));
+}
+
+TEST_F(RoutingTableManagerTest, NoNextHopAfterRemovingGateway)
+{
+    ASSERT_EQ(OC_STACK_OK, addNeighbour(10));
+    ASSERT_EQ(OC_STACK_OK, addNeighbour(11));
+    ASSERT_EQ(OC_STACK_OK, addRoute(20, 10, 2));
+
+    u_linklist_t *removedGateways = NULL;
+    ASSERT_EQ(OC_STACK_OK, RTMRemoveGatewayEntry(10, &removedGateways, &m_gatewayTable));
+    EXPECT_EQ(2u, u_linklist_length(removedGateways));
+    RTMFreeGatewayRouteTable(&removedGateways);
+
+    EXPECT_EQ(0u, getNextHop(10));
+    EXPECT_EQ(0u, getNextHop(20));
+    EXPECT_EQ(11u, getNextHop(11));
+
+    // The gateway can be added again after removal.
+    ASSERT_EQ(OC_STACK_OK, addRoute(20, 11, 2));
+    EXPECT_EQ(11u, getNextHop(20));
+}
+
+TEST_F(RoutingTableManagerTest, NextHopOfManyGateways)
+{
+    const uint32_t numOfNeighbours = 300;
+    for (uint32_t i = 1; i <= numOfNeighbours; i++)
+    {
+        ASSERT_EQ(OC_STACK_OK, addNeighbour(i));
+    }
+    for (uint32_t i = 1; i <= numOfNeighbours; i++)
+    {
+        ASSERT_EQ(OC_STACK_OK, addRoute(1000 + i, i, 2));
+    }
+
+    for (uint32_t i = 1; i <= numOfNeighbours; i++)
+    {
+        EXPECT_EQ(i, getNextHop(i));
+        EXPECT_EQ(i, getNextHop(1000 + i));
+    }
+}
+
+TEST_F(RoutingTableManagerTest, GetEndpointEntry)
+{
+    CAEndpoint_t endpoint;
+    memset(&endpoint, 0, sizeof(endpoint));
+    endpoint.adapter = CA_ADAPTER_IP;
+    strcpy(endpoint.addr, "192.168.0.2");
+    endpoint.port = 5683;
+
+    uint16_t endpointId = 1;
+    ASSERT_EQ(OC_STACK_OK, RTMAddEndpointEntry(&endpointId, &endpoint, &m_endpointTable));
+
+    // The same address keeps its endpoint id.
+    uint16_t duplicateId = 2;
+    EXPECT_EQ(OC_STACK_DUPLICATE_REQUEST,
+              RTMAddEndpointEntry(&duplicateId, &endpoint, &m_endpointTable));
+    EXPECT_EQ(endpointId, duplicateId);
+
+    CAEndpoint_t *entry = RTMGetEndpointEntry(endpointId, m_endpointTable);
+    ASSERT_TRUE(NULL != entry);
+    EXPECT_STREQ(endpoint.addr, entry->addr);
+    EXPECT_EQ(endpoint.port, entry->port);
+
+    ASSERT_EQ(OC_STACK_OK, RTMRemoveEndpointEntry(endpointId, &m_endpointTable));
+    EXPECT_TRUE(NULL == RTMGetEndpointEntry(endpointId, m_endpointTable));
+}
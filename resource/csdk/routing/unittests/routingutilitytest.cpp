@@ -0,0 +1,240 @@
+//******************************************************************
+//
+// Copyright 2016 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "routingutility.h"
+
+namespace {
+
+const uint16_t URI_PATH = 11;
+const uint16_t BLOCK2 = 23;
+
+class CoAPOption
+{
+public:
+    uint16_t number;
+    std::vector<uint8_t> value;
+};
+
+void appendNibbleExtension(std::vector<uint8_t> &pdu, size_t value)
+{
+    if (13 <= value && 269 > value)
+    {
+        pdu.push_back(value - 13);
+    }
+    else if (269 <= value)
+    {
+        pdu.push_back((value - 269) >> 8);
+        pdu.push_back((value - 269) & 0xFF);
+    }
+}
+
+uint8_t getNibble(size_t value)
+{
+    return (13 > value) ? value : ((269 > value) ? 13 : 14);
+}
+
+/**
+ * Builds a CoAP PDU in the UDP message format.
+ *
+ * @param options options sorted by option number.
+ * @param payload payload after the payload marker, none if empty.
+ */
+std::vector<uint8_t> buildPDU(const std::vector<CoAPOption> &options,
+                              const std::string &payload = std::string())
+{
+    // Confirmable GET with message id 0x1234 and a two byte token.
+    std::vector<uint8_t> pdu = { 0x42, 0x01, 0x12, 0x34, 0xAB, 0xCD };
+
+    uint16_t number = 0;
+    for (const CoAPOption &option : options)
+    {
+        size_t delta = option.number - number;
+        size_t length = option.value.size();
+        pdu.push_back((getNibble(delta) << 4) | getNibble(length));
+        appendNibbleExtension(pdu, delta);
+        appendNibbleExtension(pdu, length);
+        pdu.insert(pdu.end(), option.value.begin(), option.value.end());
+        number = option.number;
+    }
+
+    if (!payload.empty())
+    {
+        pdu.push_back(0xFF);
+        pdu.insert(pdu.end(), payload.begin(), payload.end());
+    }
+    return pdu;
+}
+
+CoAPOption uriPath(const std::string &segment)
+{
+    return CoAPOption{ URI_PATH, std::vector<uint8_t>(segment.begin(), segment.end()) };
+}
+
+CoAPOption routeOption(const CAHeaderOption_t &option)
+{
+    const uint8_t *data = (const uint8_t *) option.optionData;
+    return CoAPOption{ RM_OPTION_MESSAGE_SWITCHING,
+                       std::vector<uint8_t>(data, data + option.optionLength) };
+}
+
+} // namespace
+
+class RoutingUtilityTest : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        RMRouteOption_t value;
+        memset(&value, 0, sizeof(value));
+        value.srcGw = 1234;
+        value.destGw = 5678;
+        ASSERT_EQ(OC_STACK_OK, RMCreateRouteOption(&value, &m_routeOption));
+    }
+
+    OCStackResult getRouteOption(const std::vector<uint8_t> &pdu)
+    {
+        memset(&m_option, 0, sizeof(m_option));
+        m_isGatewayUri = true;
+        m_hasBlockOption = true;
+        return RMGetRouteOptionFromPDU(pdu.data(), pdu.size(), &m_option,
+                                       &m_isGatewayUri, &m_hasBlockOption);
+    }
+
+    CAHeaderOption_t m_routeOption;
+    CAHeaderOption_t m_option;
+    bool m_isGatewayUri;
+    bool m_hasBlockOption;
+};
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromPDU)
+{
+    std::vector<uint8_t> pdu = buildPDU({ uriPath("a"), routeOption(m_routeOption) }, "{}");
+
+    ASSERT_EQ(OC_STACK_OK, getRouteOption(pdu));
+    EXPECT_EQ(RM_OPTION_MESSAGE_SWITCHING, m_option.optionID);
+    ASSERT_EQ(m_routeOption.optionLength, m_option.optionLength);
+    EXPECT_EQ(0, memcmp(m_routeOption.optionData, m_option.optionData, m_option.optionLength));
+    EXPECT_FALSE(m_isGatewayUri);
+    EXPECT_FALSE(m_hasBlockOption);
+
+    RMRouteOption_t value;
+    memset(&value, 0, sizeof(value));
+    ASSERT_EQ(OC_STACK_OK, RMParseRouteOption(&m_option, &value));
+    EXPECT_EQ(1234u, value.srcGw);
+    EXPECT_EQ(5678u, value.destGw);
+}
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromPDUWithGatewayUri)
+{
+    std::vector<uint8_t> pdu = buildPDU({ uriPath("oic"), uriPath("gateway"),
+                                          routeOption(m_routeOption) });
+
+    ASSERT_EQ(OC_STACK_OK, getRouteOption(pdu));
+    EXPECT_TRUE(m_isGatewayUri);
+}
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromPDUWithBlockOption)
+{
+    std::vector<uint8_t> pdu = buildPDU({ uriPath("a"),
+                                          CoAPOption{ BLOCK2, { 0x06 } },
+                                          routeOption(m_routeOption) });
+
+    ASSERT_EQ(OC_STACK_OK, getRouteOption(pdu));
+    EXPECT_TRUE(m_hasBlockOption);
+}
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromPDUWithoutRouteOption)
+{
+    std::vector<uint8_t> pdu = buildPDU({ uriPath("a") });
+
+    EXPECT_EQ(OC_STACK_NO_RESOURCE, getRouteOption(pdu));
+}
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromPDUIgnoresPayload)
+{
+    // The payload looks like a route option, but comes after the payload marker.
+    std::vector<uint8_t> option = buildPDU({ routeOption(m_routeOption) });
+    std::string payload(option.begin() + 6, option.end());
+    std::vector<uint8_t> pdu = buildPDU({ uriPath("a") }, payload);
+
+    EXPECT_EQ(OC_STACK_NO_RESOURCE, getRouteOption(pdu));
+}
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromTruncatedHeader)
+{
+    std::vector<uint8_t> pdu = { 0x40, 0x01, 0x12 };
+
+    EXPECT_EQ(OC_STACK_ERROR, getRouteOption(pdu));
+}
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromTruncatedOptionValue)
+{
+    std::vector<uint8_t> pdu = buildPDU({ uriPath("a"), routeOption(m_routeOption) });
+    pdu.pop_back();
+
+    EXPECT_EQ(OC_STACK_ERROR, getRouteOption(pdu));
+}
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromTruncatedOptionDelta)
+{
+    // The route option number needs a two byte delta, of which only one is left.
+    std::vector<uint8_t> pdu = buildPDU({ routeOption(m_routeOption) });
+    pdu.resize(6 + 2);
+
+    EXPECT_EQ(OC_STACK_ERROR, getRouteOption(pdu));
+}
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromPDUWithReservedOptionDelta)
+{
+    std::vector<uint8_t> pdu = buildPDU({ uriPath("a") });
+    pdu.push_back(0xF1);
+    pdu.push_back('b');
+
+    EXPECT_EQ(OC_STACK_ERROR, getRouteOption(pdu));
+}
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromPDUWithOversizedRouteOption)
+{
+    CoAPOption option{ RM_OPTION_MESSAGE_SWITCHING,
+                       std::vector<uint8_t>(CA_MAX_HEADER_OPTION_DATA_LENGTH + 1, 0xC0) };
+    std::vector<uint8_t> pdu = buildPDU({ option });
+
+    EXPECT_EQ(OC_STACK_ERROR, getRouteOption(pdu));
+}
+
+TEST_F(RoutingUtilityTest, GetRouteOptionFromPDUWithInvalidParams)
+{
+    std::vector<uint8_t> pdu = buildPDU({ routeOption(m_routeOption) });
+    bool flag = false;
+
+    EXPECT_EQ(OC_STACK_INVALID_PARAM,
+              RMGetRouteOptionFromPDU(NULL, pdu.size(), &m_option, &flag, &flag));
+    EXPECT_EQ(OC_STACK_INVALID_PARAM,
+              RMGetRouteOptionFromPDU(pdu.data(), pdu.size(), NULL, &flag, &flag));
+    EXPECT_EQ(OC_STACK_INVALID_PARAM,
+              RMGetRouteOptionFromPDU(pdu.data(), pdu.size(), &m_option, NULL, &flag));
+    EXPECT_EQ(OC_STACK_INVALID_PARAM,
+              RMGetRouteOptionFromPDU(pdu.data(), pdu.size(), &m_option, &flag, NULL));
+}
@@ -38,6 +38,7 @@
 #include "ocpayloadcbor.h"
 #include "cainterface.h"
 #include "ocserverrequest.h"
+#include "ocresourcehandler.h"
 #include "resourcemanager.h"
 #include "doxmresource.h"
 #include "pstatresource.h"
@@ -855,7 +856,12 @@ static void updateWriteableProperty(const OicSecDoxm_t* src, OicSecDoxm_t* dst)
         memcpy(&(dst->rownerID), &(src->rownerID), sizeof(OicUuid_t));
 
         //update deviceuuid
-        memcpy(&(dst->deviceID), &(src->deviceID), sizeof(OicUuid_t));
+        if (0 != memcmp(&(dst->deviceID), &(src->deviceID), sizeof(OicUuid_t)))
+        {
+            memcpy(&(dst->deviceID), &(src->deviceID), sizeof(OicUuid_t));
+            // Discovery responses carry the device ID
+            InvalidateDiscoveryCache();
+        }
 
         //Update owned status
         if(dst->owned != src->owned)
@@ -1792,6 +1798,9 @@ OCStackResult SetDoxmDeviceID(const OicUuid_t *deviceID)
         OIC_LOG(ERROR, TAG, "Failed to update persistent storage");
         return OC_STACK_ERROR;
     }
+
+    // Discovery responses carry the device ID
+    InvalidateDiscoveryCache();
     return OC_STACK_OK;
 }
 
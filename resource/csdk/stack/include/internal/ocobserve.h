@@ -91,6 +91,9 @@ typedef struct ResourceObserver
     /** next node in this list.*/
     struct ResourceObserver *next;
 
+    /** next node in the same bucket of the observation ID index.*/
+    struct ResourceObserver *idNext;
+
     /** requested payload encoding format. */
     OCPayloadFormat acceptFormat;
 
@@ -131,14 +134,14 @@ OCStackResult SendAllObserverNotification (OCMethod method, OCResource *resPtr,
  * @param resource                  Observed resource.
  * @param obsIdList                 List of observation ids that need to be notified.
  * @param numberOfIds               Number of observation ids included in obsIdList.
- * @param notificationJSONPayload   JSON encoded payload to send in notification.
+ * @param payload                   Payload to send in notification.
  * @param maxAge                    Time To Live (in seconds) of observation.
  * @param qos                       Desired quality of service of the observation notifications.
  *
  * @return ::OC_STACK_OK on success, some other value upon failure.
  */
 OCStackResult SendListObserverNotification (OCResource * resource,
-        OCObservationId  *obsIdList, uint8_t numberOfIds,
+        const OCObservationId *obsIdList, size_t numberOfIds,
         const OCRepPayload *payload, uint32_t maxAge,
         OCQualityOfService qos);
 
@@ -149,6 +152,9 @@ void DeleteObserverList();
 
 /**
  * Create a unique observation ID.
+ * IDs are handed out in increasing order and are not reused until the
+ * 32 bit ID space wraps around, so a stale ID held by an application does
+ * not address a newer observer.
  *
  * @param observationId           Pointer to generated ID.
  *
@@ -212,7 +218,8 @@ OCStackResult DeleteObserverUsingDevAddr(const OCDevAddr *devAddr);
 ResourceObserver* GetObserverUsingToken (const CAToken_t token, uint8_t tokenLength);
 
 /**
- * Search the list of observers for the specified observe ID.
+ * Look up the observer with the specified observe ID.
+ * The lookup goes through a hash index and does not scan the observer list.
  *
  * @param observeId        Observer ID to search for.
  *
@@ -188,6 +188,17 @@ void DeleteDeviceInfo();
 OCStackResult BuildResponseRepresentation(const OCResource *resourcePtr,
                     OCRepPayload** payload, OCDevAddr *devAddr);
 
+/**
+ * Internal API used to mark all cached discovery responses as outdated.
+ * Called whenever a resource, its types, interfaces, properties or endpoints change.
+ */
+void InvalidateDiscoveryCache();
+
+/**
+ * Internal API used to free the cached discovery responses.
+ */
+void DeleteDiscoveryCache();
+
 /**
  * A helper function that Maps an @ref OCEntityHandlerResult type to an
  * @ref OCStackResult type.
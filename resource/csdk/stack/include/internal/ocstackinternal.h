@@ -329,6 +329,14 @@ OCStackResult OCUpdateResourceInsWithResponse(const char *requestUri,
                                               const OCClientResponse *response);
 #endif
 
+#ifdef RD_SERVER
+/**
+ * Closes the connection used to answer discovery queries from the RD database
+ * and drops the cached query results.
+ */
+void OCRDDatabaseDiscoveryClose();
+#endif
+
 /**
  * Delete all of the dynamically allocated elements that were created for the resource attributes.
  *
@@ -235,6 +235,11 @@ OCDiscoveryPayload* OCDiscoveryPayloadCreate();
 OCSecurityPayload* OCSecurityPayloadCreate(const uint8_t* securityData, size_t size);
 void OCSecurityPayloadDestroy(OCSecurityPayload* payload);
 
+// Pre-encoded Payload
+OCEncodedPayload* OCEncodedPayloadCreate(const uint8_t* payload, size_t size);
+OCEncodedPayload* OCEncodedPayloadCreateAsOwner(uint8_t* payload, size_t size);
+void OCEncodedPayloadDestroy(OCEncodedPayload* payload);
+
 #ifndef TCP_ADAPTER
 void OCDiscoveryPayloadAddResource(OCDiscoveryPayload* payload, const OCResource* res,
                                    uint16_t securePort);
@@ -553,6 +553,27 @@ OCNotifyListOfObservers (OCResourceHandle handle,
                          const OCRepPayload *payload,
                          OCQualityOfService qos);
 
+/**
+ * Notify specific observers with updated value of representation.
+ * Same as ::OCNotifyListOfObservers, but for lists of any length.
+ *
+ * @param handle                    Handle of resource.
+ * @param obsIdList                 List of observation IDs that need to be notified.
+ * @param numberOfIds               Number of observation IDs included in obsIdList.
+ * @param payload                   Object representing the notification
+ * @param qos                       Desired quality of service of the observation notifications.
+ *
+ * @note: The memory for obsIdList and payload is managed by the entity invoking the API.
+ *
+ * @return ::OC_STACK_OK on success, some other value upon failure.
+ */
+OCStackResult
+OCNotifyListOfObserversWithCount (OCResourceHandle handle,
+                                  const OCObservationId *obsIdList,
+                                  size_t numberOfIds,
+                                  const OCRepPayload *payload,
+                                  OCQualityOfService qos);
+
 
 /**
  * This function sends a response to a request.
@@ -651,6 +672,14 @@ OCResourceHandle OCGetResourceHandleAtUri(const char *uri);
 */
 OCStackResult OCRDDatabaseCheckResources(const char *interfaceType, const char *resourceType,
     OCDiscoveryPayload *discPayload);
+
+/**
+* Tells the stack that the RD database has changed. Results of earlier
+* discovery queries, which ::OCRDDatabaseCheckResources keeps in memory,
+* are read again from the database, and cached discovery responses of the
+* stack are rebuilt.
+*/
+void OCRDDatabaseDiscoveryInvalidate();
 #endif
 //#endif // DIRECT_PAIRING
 
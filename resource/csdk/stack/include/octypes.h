@@ -1049,9 +1049,9 @@ typedef void * OCRequestHandle;
  * Unique identifier for each observation request. Used when observations are
  * registered or de-registered. Used by entity handler to signal specific
  * observers to be notified of resource changes.
- * There can be maximum of 256 observations per server.
+ * The value 0 never identifies an observation.
  */
-typedef uint8_t OCObservationId;
+typedef uint32_t OCObservationId;
 
 /**
  * Sequence number is a 24 bit field,
@@ -1314,7 +1314,9 @@ typedef enum
     /** The payload is an OCSecurityPayload */
     PAYLOAD_TYPE_SECURITY,
     /** The payload is an OCPresencePayload */
-    PAYLOAD_TYPE_PRESENCE
+    PAYLOAD_TYPE_PRESENCE,
+    /** The payload is an OCEncodedPayload */
+    PAYLOAD_TYPE_ENCODED
 } OCPayloadType;
 
 /**
@@ -1467,6 +1469,16 @@ typedef struct
     size_t payloadSize;
 } OCSecurityPayload;
 
+/**
+ * Payload which is already CBOR encoded and is sent as is.
+ */
+typedef struct
+{
+    OCPayload base;
+    uint8_t* payload;
+    size_t payloadSize;
+} OCEncodedPayload;
+
 #ifdef WITH_PRESENCE
 typedef struct
 {
@@ -333,6 +333,10 @@ INLINE_API void OCPayloadLog(LogLevel level, OCPayload* payload)
         case PAYLOAD_TYPE_SECURITY:
             OCPayloadLogSecurity(level, (OCSecurityPayload*)payload);
             break;
+        case PAYLOAD_TYPE_ENCODED:
+            OIC_LOG_V(level, PL_TAG, "Payload Type: Encoded, %zu bytes",
+                      ((OCEncodedPayload*)payload)->payloadSize);
+            break;
         default:
             OIC_LOG_V(level, PL_TAG, "Unknown Payload Type: %d", payload->type);
             break;
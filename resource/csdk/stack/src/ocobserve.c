@@ -24,7 +24,6 @@
 #include "ocstackinternal.h"
 #include "ocobserve.h"
 #include "ocresourcehandler.h"
-#include "ocrandom.h"
 #include "oic_malloc.h"
 #include "oic_string.h"
 #include "ocpayload.h"
@@ -42,7 +41,110 @@
 
 #define VERIFY_NON_NULL(arg) { if (!arg) {OIC_LOG(FATAL, TAG, #arg " is NULL"); goto exit;} }
 
+/** Initial number of buckets of the observation ID index, a power of two. */
+#define OBSERVER_ID_INDEX_MIN_SIZE (16)
+
 static struct ResourceObserver * g_serverObsList = NULL;
+
+/** Observation ID index: buckets of observers chained through idNext. */
+static struct ResourceObserver ** g_obsIdIndex = NULL;
+static size_t g_obsIdIndexSize = 0;
+static size_t g_obsCount = 0;
+
+/** Last observation ID handed out by GenerateObserverId. */
+static OCObservationId g_lastObserverId = 0;
+
+static size_t ObserverIdBucket(OCObservationId observeId, size_t indexSize)
+{
+    // IDs are handed out sequentially, so the low bits spread them evenly.
+    return (size_t)observeId & (indexSize - 1);
+}
+
+static ResourceObserver *FindObserverInIndex(OCObservationId observeId)
+{
+    if (!g_obsIdIndex)
+    {
+        return NULL;
+    }
+
+    ResourceObserver *out = g_obsIdIndex[ObserverIdBucket(observeId, g_obsIdIndexSize)];
+    while (out && out->observeId != observeId)
+    {
+        out = out->idNext;
+    }
+    return out;
+}
+
+/*
+ * Double the number of buckets once the index holds as many observers as it
+ * has buckets, which keeps the chains short.
+ */
+static bool GrowObserverIndex()
+{
+    size_t newSize = g_obsIdIndexSize ? g_obsIdIndexSize * 2 : OBSERVER_ID_INDEX_MIN_SIZE;
+    ResourceObserver **newIndex =
+        (ResourceObserver **) OICCalloc(newSize, sizeof(ResourceObserver *));
+    if (!newIndex)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < g_obsIdIndexSize; i++)
+    {
+        ResourceObserver *out = g_obsIdIndex[i];
+        while (out)
+        {
+            ResourceObserver *next = out->idNext;
+            size_t bucket = ObserverIdBucket(out->observeId, newSize);
+            out->idNext = newIndex[bucket];
+            newIndex[bucket] = out;
+            out = next;
+        }
+    }
+
+    OICFree(g_obsIdIndex);
+    g_obsIdIndex = newIndex;
+    g_obsIdIndexSize = newSize;
+    return true;
+}
+
+static bool AddObserverToIndex(ResourceObserver *observer)
+{
+    // A full index only lengthens the chains, growing it is not mandatory.
+    if (g_obsCount >= g_obsIdIndexSize && !GrowObserverIndex() && !g_obsIdIndex)
+    {
+        return false;
+    }
+
+    size_t bucket = ObserverIdBucket(observer->observeId, g_obsIdIndexSize);
+    observer->idNext = g_obsIdIndex[bucket];
+    g_obsIdIndex[bucket] = observer;
+    g_obsCount++;
+    return true;
+}
+
+static void RemoveObserverFromIndex(ResourceObserver *observer)
+{
+    if (!g_obsIdIndex)
+    {
+        return;
+    }
+
+    ResourceObserver **link = &g_obsIdIndex[ObserverIdBucket(observer->observeId,
+                                                               g_obsIdIndexSize)];
+    while (*link)
+    {
+        if (*link == observer)
+        {
+            *link = observer->idNext;
+            observer->idNext = NULL;
+            g_obsCount--;
+            return;
+        }
+        link = &(*link)->idNext;
+    }
+}
+
 /**
  * Determine observe QOS based on the QOS of the request.
  * The qos passed as a parameter overrides what the client requested.
@@ -157,6 +259,45 @@ static OCStackResult SendObserveNotification(ResourceObserver *observer,
     return result;
 }
 
+/*
+ * This function checks if the node is past its time to live and
+ * deletes it if timed-out. Calling this function with a  presence callback
+ * with ttl set to 0 will not delete anything as presence nodes have
+ * their own mechanisms for timeouts. A null argument will cause the function to
+ * silently return.
+ */
+static void CheckTimedOutObserver(ResourceObserver* observer)
+{
+    if (!observer || observer->TTL == 0)
+    {
+        return;
+    }
+
+    coap_tick_t now = 0;
+    coap_ticks(&now);
+
+    if (observer->TTL < now)
+    {
+        // Send confirmable notification message to observer.
+        OIC_LOG(INFO, TAG, "Sending High-QoS notification to observer");
+        SendObserveNotification(observer, OC_HIGH_QOS);
+    }
+}
+
+/*
+ * Runs the time-to-live check over every observer. Lookups by id go through
+ * the index and no longer walk the list, so expiry gets its own pass.
+ */
+static void CheckTimedOutObservers()
+{
+    ResourceObserver *observer = NULL;
+    ResourceObserver *tmp = NULL;
+    LL_FOREACH_SAFE (g_serverObsList, observer, tmp)
+    {
+        CheckTimedOutObserver(observer);
+    }
+}
+
 #ifdef WITH_PRESENCE
 OCStackResult SendAllObserverNotification (OCMethod method, OCResource *resPtr, uint32_t maxAge,
         OCPresenceTrigger trigger, OCResourceType *resourceType, OCQualityOfService qos)
@@ -173,7 +314,7 @@ OCStackResult SendAllObserverNotification (OCMethod method, OCResource *resPtr,
 
     OCStackResult result = OC_STACK_ERROR;
     ResourceObserver * resourceObserver = g_serverObsList;
-    uint8_t numObs = 0;
+    size_t numObs = 0;
     OCServerRequest * request = NULL;
     bool observeErrorFlag = false;
 
@@ -238,6 +379,10 @@ OCStackResult SendAllObserverNotification (OCMethod method, OCResource *resPtr,
                 observeErrorFlag = true;
             }
         }
+        else
+        {
+            CheckTimedOutObserver(resourceObserver);
+        }
         resourceObserver = resourceObserver->next;
     }
 
@@ -255,7 +400,7 @@ OCStackResult SendAllObserverNotification (OCMethod method, OCResource *resPtr,
 }
 
 OCStackResult SendListObserverNotification (OCResource * resource,
-        OCObservationId  *obsIdList, uint8_t numberOfIds,
+        const OCObservationId *obsIdList, size_t numberOfIds,
         const OCRepPayload *payload,
         uint32_t maxAge,
         OCQualityOfService qos)
@@ -266,17 +411,17 @@ OCStackResult SendListObserverNotification (OCResource * resource,
         return OC_STACK_INVALID_PARAM;
     }
 
-    uint8_t numIds = numberOfIds;
     ResourceObserver *observer = NULL;
-    uint8_t numSentNotification = 0;
+    size_t numSentNotification = 0;
     OCServerRequest * request = NULL;
     OCStackResult result = OC_STACK_ERROR;
     bool observeErrorFlag = false;
 
     OIC_LOG(INFO, TAG, "Entering SendListObserverNotification");
-    while(numIds)
+    CheckTimedOutObservers();
+    for (size_t i = 0; i < numberOfIds; i++)
     {
-        observer = GetObserverUsingId (*obsIdList);
+        observer = GetObserverUsingId (obsIdList[i]);
         if (observer)
         {
             // Found observer - verify if it matches the resource handle
@@ -302,6 +447,7 @@ OCStackResult SendListObserverNotification (OCResource * resource,
                         if (!ehResponse.payload)
                         {
                             FindAndDeleteServerRequest(request);
+                            observeErrorFlag = true;
                             continue;
                         }
                         memcpy(ehResponse.payload, payload, sizeof(*payload));
@@ -311,7 +457,7 @@ OCStackResult SendListObserverNotification (OCResource * resource,
                         result = OCDoResponse(&ehResponse);
                         if (result == OC_STACK_OK)
                         {
-                            OIC_LOG_V(INFO, TAG, "Observer id %d notified.", *obsIdList);
+                            OIC_LOG_V(INFO, TAG, "Observer id %u notified.", obsIdList[i]);
 
                             // Increment only if OCDoResponse is successful
                             numSentNotification++;
@@ -320,7 +466,7 @@ OCStackResult SendListObserverNotification (OCResource * resource,
                         }
                         else
                         {
-                            OIC_LOG_V(INFO, TAG, "Error notifying observer id %d.", *obsIdList);
+                            OIC_LOG_V(INFO, TAG, "Error notifying observer id %u.", obsIdList[i]);
                         }
                         // Reset Observer TTL.
                         observer->TTL =
@@ -339,8 +485,6 @@ OCStackResult SendListObserverNotification (OCResource * resource,
                 }
             }
         }
-        obsIdList++;
-        numIds--;
     }
 
     if (numSentNotification == numberOfIds && !observeErrorFlag)
@@ -360,23 +504,17 @@ OCStackResult SendListObserverNotification (OCResource * resource,
 
 OCStackResult GenerateObserverId (OCObservationId *observationId)
 {
-    ResourceObserver *resObs = NULL;
-
     OIC_LOG(INFO, TAG, "Entering GenerateObserverId");
     VERIFY_NON_NULL (observationId);
 
+    // 0 is never a valid ID. Only after the ID space wraps around can the
+    // next ID still be in use, in which case it is skipped.
     do
     {
-        if (!OCGetRandomBytes((uint8_t*)observationId, sizeof(OCObservationId)))
-        {
-            OIC_LOG_V(ERROR, TAG, "Failed to generate random observationId");
-            goto exit;
-        }
-
-        // Check if observation Id already exists
-        resObs = GetObserverUsingId (*observationId);
-    } while (NULL != resObs);
+        g_lastObserverId++;
+    } while (0 == g_lastObserverId || FindObserverInIndex(g_lastObserverId));
 
+    *observationId = g_lastObserverId;
     OIC_LOG_V(INFO, TAG, "GeneratedObservation ID is %u", *observationId);
 
     return OC_STACK_OK;
@@ -446,6 +584,11 @@ OCStackResult AddObserver (const char         *resUri,
             obsNode->TTL = GetTicks(MAX_OBSERVER_TTL_SECONDS * MILLISECONDS_PER_SECOND);
         }
 
+        if (!AddObserverToIndex(obsNode))
+        {
+            OICFree(obsNode->token);
+            goto exit;
+        }
         LL_APPEND (g_serverObsList, obsNode);
 
         return OC_STACK_OK;
@@ -461,44 +604,16 @@ exit:
     return OC_STACK_NO_MEMORY;
 }
 
-/*
- * This function checks if the node is past its time to live and
- * deletes it if timed-out. Calling this function with a  presence callback
- * with ttl set to 0 will not delete anything as presence nodes have
- * their own mechanisms for timeouts. A null argument will cause the function to
- * silently return.
- */
-static void CheckTimedOutObserver(ResourceObserver* observer)
-{
-    if (!observer || observer->TTL == 0)
-    {
-        return;
-    }
-
-    coap_tick_t now = 0;
-    coap_ticks(&now);
-
-    if (observer->TTL < now)
-    {
-        // Send confirmable notification message to observer.
-        OIC_LOG(INFO, TAG, "Sending High-QoS notification to observer");
-        SendObserveNotification(observer, OC_HIGH_QOS);
-    }
-}
-
 ResourceObserver* GetObserverUsingId (const OCObservationId observeId)
 {
     ResourceObserver *out = NULL;
 
     if (observeId)
     {
-        LL_FOREACH (g_serverObsList, out)
+        out = FindObserverInIndex(observeId);
+        if (out)
         {
-            if (out->observeId == observeId)
-            {
-                return out;
-            }
-            CheckTimedOutObserver(out);
+            return out;
         }
     }
     OIC_LOG(INFO, TAG, "Observer node not found!!");
@@ -547,6 +662,7 @@ OCStackResult DeleteObserverUsingToken (CAToken_t token, uint8_t tokenLength)
         OIC_LOG_V(INFO, TAG, "deleting observer id  %u with token", obsNode->observeId);
         OIC_LOG_BUFFER(INFO, TAG, (const uint8_t *)obsNode->token, tokenLength);
         LL_DELETE (g_serverObsList, obsNode);
+        RemoveObserverFromIndex(obsNode);
         OICFree(obsNode->resUri);
         OICFree(obsNode->query);
         OICFree(obsNode->token);
@@ -594,6 +710,11 @@ void DeleteObserverList()
         }
     }
     g_serverObsList = NULL;
+
+    OICFree(g_obsIdIndex);
+    g_obsIdIndex = NULL;
+    g_obsIdIndexSize = 0;
+    g_obsCount = 0;
 }
 
 /*
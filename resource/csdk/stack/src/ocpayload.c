@@ -60,6 +60,9 @@ void OCPayloadDestroy(OCPayload* payload)
         case PAYLOAD_TYPE_SECURITY:
             OCSecurityPayloadDestroy((OCSecurityPayload*)payload);
             break;
+        case PAYLOAD_TYPE_ENCODED:
+            OCEncodedPayloadDestroy((OCEncodedPayload*)payload);
+            break;
         default:
             OIC_LOG_V(ERROR, TAG, "Unsupported payload type in destroy: %d", payload->type);
             OICFree(payload);
@@ -1669,6 +1672,50 @@ void OCSecurityPayloadDestroy(OCSecurityPayload* payload)
     OICFree(payload);
 }
 
+OCEncodedPayload* OCEncodedPayloadCreateAsOwner(uint8_t* payload, size_t size)
+{
+    OCEncodedPayload* encoded = (OCEncodedPayload*)OICCalloc(1, sizeof(OCEncodedPayload));
+
+    if (!encoded)
+    {
+        return NULL;
+    }
+
+    encoded->base.type = PAYLOAD_TYPE_ENCODED;
+    encoded->payload = payload;
+    encoded->payloadSize = size;
+
+    return encoded;
+}
+
+OCEncodedPayload* OCEncodedPayloadCreate(const uint8_t* payload, size_t size)
+{
+    uint8_t* copy = (uint8_t *)OICMalloc(size ? size : 1);
+    if (!copy)
+    {
+        return NULL;
+    }
+    memcpy(copy, payload, size);
+
+    OCEncodedPayload* encoded = OCEncodedPayloadCreateAsOwner(copy, size);
+    if (!encoded)
+    {
+        OICFree(copy);
+    }
+    return encoded;
+}
+
+void OCEncodedPayloadDestroy(OCEncodedPayload* payload)
+{
+    if (!payload)
+    {
+        return;
+    }
+
+    OICFree(payload->payload);
+    OICFree(payload);
+}
+
 size_t OCDiscoveryPayloadGetResourceCount(OCDiscoveryPayload* payload)
 {
     size_t i = 0;
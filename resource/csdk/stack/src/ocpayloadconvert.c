@@ -86,6 +86,17 @@ OCStackResult OCConvertPayload(OCPayload* payload, uint8_t** outPayload, size_t*
     VERIFY_PARAM_NON_NULL(TAG, size, "size parameter is NULL");
 
     OIC_LOG_V(INFO, TAG, "Converting payload of type %d", payload->type);
+    if (PAYLOAD_TYPE_ENCODED == payload->type)
+    {
+        // Already encoded, only a copy for the caller to own is needed
+        OCEncodedPayload *encoded = (OCEncodedPayload *)payload;
+        out = (uint8_t *)OICMalloc(encoded->payloadSize ? encoded->payloadSize : 1);
+        VERIFY_PARAM_NON_NULL(TAG, out, "Failed to allocate encoded payload");
+        memcpy(out, encoded->payload, encoded->payloadSize);
+        *outPayload = out;
+        *size = encoded->payloadSize;
+        return OC_STACK_OK;
+    }
     if (PAYLOAD_TYPE_SECURITY == payload->type)
     {
         size_t securityPayloadSize = ((OCSecurityPayload *)payload)->payloadSize;
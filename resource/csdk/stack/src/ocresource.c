@@ -45,6 +45,7 @@
 #include "oic_string.h"
 #include "logger.h"
 #include "ocpayload.h"
+#include "ocpayloadcbor.h"
 #include "secureresourcemanager.h"
 #include "cacommon.h"
 #include "cainterface.h"
@@ -66,6 +67,38 @@
 
 extern OCResource *headResource;
 
+/**
+ * Number of encoded /oic/res responses kept, one per query and requester's connectivity.
+ */
+#define MAX_DISCOVERY_CACHE_ENTRIES (8)
+
+/**
+ * Encoded /oic/res response. The entry is valid as long as its generation matches
+ * the current one and the network information it was built with did not change.
+ */
+typedef struct
+{
+    uint32_t generation;            /**< 0 for an unused entry. */
+    uint32_t lastUsed;
+    OCVirtualResources uri;
+    char *interfaceQuery;
+    char *resourceTypeQuery;
+    OCTransportAdapter adapter;
+    OCTransportFlags flags;
+    uint32_t ifindex;
+    CAEndpoint_t *networkInfo;
+    uint32_t infoSize;
+    uint8_t *payload;
+    size_t payloadSize;
+} OCDiscoveryCacheEntry;
+
+static OCDiscoveryCacheEntry g_discoveryCache[MAX_DISCOVERY_CACHE_ENTRIES];
+
+/** Bumped whenever anything included in a discovery response changes. */
+static uint32_t g_discoveryGeneration = 1;
+
+static uint32_t g_discoveryCacheClock = 0;
+
 /**
  * Prepares a Payload for response.
  */
@@ -961,6 +994,193 @@ exit:
     return OC_STACK_NO_MEMORY;
 }
 
+void InvalidateDiscoveryCache()
+{
+    g_discoveryGeneration++;
+    if (0 == g_discoveryGeneration)
+    {
+        g_discoveryGeneration = 1;
+    }
+}
+
+static void clearDiscoveryCacheEntry(OCDiscoveryCacheEntry *entry)
+{
+    OICFree(entry->interfaceQuery);
+    OICFree(entry->resourceTypeQuery);
+    OICFree(entry->networkInfo);
+    OICFree(entry->payload);
+    memset(entry, 0, sizeof(*entry));
+}
+
+void DeleteDiscoveryCache()
+{
+    for (size_t i = 0; i < MAX_DISCOVERY_CACHE_ENTRIES; i++)
+    {
+        clearDiscoveryCacheEntry(&g_discoveryCache[i]);
+    }
+    InvalidateDiscoveryCache();
+}
+
+static bool queryMatches(const char *cached, const char *query)
+{
+    if (!cached || !query)
+    {
+        return cached == query;
+    }
+    return 0 == strcmp(cached, query);
+}
+
+static bool networkInfoMatches(const OCDiscoveryCacheEntry *entry,
+                               const CAEndpoint_t *networkInfo, uint32_t infoSize)
+{
+    if (entry->infoSize != infoSize)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < infoSize; i++)
+    {
+        const CAEndpoint_t *cached = &entry->networkInfo[i];
+        const CAEndpoint_t *info = &networkInfo[i];
+        if (cached->adapter != info->adapter || cached->flags != info->flags ||
+            cached->port != info->port || cached->ifindex != info->ifindex ||
+            0 != strncmp(cached->addr, info->addr, sizeof(cached->addr)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Secure and TCP ports and the endpoints of a discovery response depend on the
+ * transport, IP version and interface of the requester.
+ */
+static OCTransportFlags discoveryCacheFlags(const OCDevAddr *devAddr)
+{
+    return (OCTransportFlags)(devAddr->flags & (OC_IP_USE_V6 | OC_IP_USE_V4));
+}
+
+static OCDiscoveryCacheEntry *findDiscoveryCacheEntry(OCVirtualResources uri,
+                                                      const char *interfaceQuery,
+                                                      const char *resourceTypeQuery,
+                                                      const OCDevAddr *devAddr,
+                                                      const CAEndpoint_t *networkInfo,
+                                                      uint32_t infoSize)
+{
+    for (size_t i = 0; i < MAX_DISCOVERY_CACHE_ENTRIES; i++)
+    {
+        OCDiscoveryCacheEntry *entry = &g_discoveryCache[i];
+        if (entry->generation == g_discoveryGeneration &&
+            entry->uri == uri &&
+            entry->adapter == devAddr->adapter &&
+            entry->flags == discoveryCacheFlags(devAddr) &&
+            entry->ifindex == devAddr->ifindex &&
+            queryMatches(entry->interfaceQuery, interfaceQuery) &&
+            queryMatches(entry->resourceTypeQuery, resourceTypeQuery) &&
+            networkInfoMatches(entry, networkInfo, infoSize))
+        {
+            entry->lastUsed = ++g_discoveryCacheClock;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Stores the encoded response, taking ownership of @p payload.
+ */
+static void addDiscoveryCacheEntry(OCVirtualResources uri,
+                                   const char *interfaceQuery,
+                                   const char *resourceTypeQuery,
+                                   const OCDevAddr *devAddr,
+                                   const CAEndpoint_t *networkInfo,
+                                   uint32_t infoSize,
+                                   uint8_t *payload,
+                                   size_t payloadSize)
+{
+    // Reuse an unused or outdated entry, otherwise the least recently used one
+    OCDiscoveryCacheEntry *entry = &g_discoveryCache[0];
+    for (size_t i = 0; i < MAX_DISCOVERY_CACHE_ENTRIES; i++)
+    {
+        OCDiscoveryCacheEntry *candidate = &g_discoveryCache[i];
+        if (candidate->generation != g_discoveryGeneration)
+        {
+            entry = candidate;
+            break;
+        }
+        if (candidate->lastUsed < entry->lastUsed)
+        {
+            entry = candidate;
+        }
+    }
+    clearDiscoveryCacheEntry(entry);
+
+    entry->networkInfo = (CAEndpoint_t *)OICMalloc(infoSize * sizeof(CAEndpoint_t));
+    VERIFY_PARAM_NON_NULL(TAG, entry->networkInfo, "Failed allocating discovery cache entry");
+    memcpy(entry->networkInfo, networkInfo, infoSize * sizeof(CAEndpoint_t));
+    entry->infoSize = infoSize;
+
+    if (interfaceQuery)
+    {
+        entry->interfaceQuery = OICStrdup(interfaceQuery);
+        VERIFY_PARAM_NON_NULL(TAG, entry->interfaceQuery, "Failed allocating discovery cache entry");
+    }
+    if (resourceTypeQuery)
+    {
+        entry->resourceTypeQuery = OICStrdup(resourceTypeQuery);
+        VERIFY_PARAM_NON_NULL(TAG, entry->resourceTypeQuery,
+                              "Failed allocating discovery cache entry");
+    }
+
+    entry->uri = uri;
+    entry->adapter = devAddr->adapter;
+    entry->flags = discoveryCacheFlags(devAddr);
+    entry->ifindex = devAddr->ifindex;
+    entry->payload = payload;
+    entry->payloadSize = payloadSize;
+    entry->lastUsed = ++g_discoveryCacheClock;
+    entry->generation = g_discoveryGeneration;
+    return;
+
+exit:
+    clearDiscoveryCacheEntry(entry);
+    OICFree(payload);
+}
+
+/**
+ * Encodes the discovery payload once, keeps the encoding in the cache and replaces
+ * @p payload with a pre-encoded copy of it to be sent.
+ */
+static void cacheDiscoveryPayload(OCVirtualResources uri,
+                                  const char *interfaceQuery,
+                                  const char *resourceTypeQuery,
+                                  const OCDevAddr *devAddr,
+                                  const CAEndpoint_t *networkInfo,
+                                  uint32_t infoSize,
+                                  OCPayload **payload)
+{
+    uint8_t *cbor = NULL;
+    size_t cborSize = 0;
+    if (OC_STACK_OK != OCConvertPayload(*payload, &cbor, &cborSize))
+    {
+        OIC_LOG(ERROR, TAG, "Failed encoding discovery payload for the cache");
+        return;
+    }
+
+    OCPayload *encoded = (OCPayload *)OCEncodedPayloadCreate(cbor, cborSize);
+    if (!encoded)
+    {
+        OICFree(cbor);
+        return;
+    }
+
+    OCPayloadDestroy(*payload);
+    *payload = encoded;
+    addDiscoveryCacheEntry(uri, interfaceQuery, resourceTypeQuery, devAddr,
+                           networkInfo, infoSize, cbor, cborSize);
+}
+
 static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource* resource)
 {
     if (!request || !resource)
@@ -1011,9 +1231,6 @@ static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource
             goto exit;
         }
 
-        char *interfaceQuery = NULL;
-        char *resourceTypeQuery = NULL;
-
         CAEndpoint_t *networkInfo = NULL;
         uint32_t infoSize = 0;
 
@@ -1039,6 +1256,23 @@ static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource
             baselineQuery = true;
         }
 
+        // Repeated discovery of an unchanged resource set is answered from the cache
+        OCDiscoveryCacheEntry *cacheEntry = findDiscoveryCacheEntry(virtualUriInRequest,
+                interfaceQuery, resourceTypeQuery, &request->devAddr, networkInfo, infoSize);
+        if (cacheEntry)
+        {
+            payload = (OCPayload *)OCEncodedPayloadCreate(cacheEntry->payload,
+                                                          cacheEntry->payloadSize);
+            if (payload)
+            {
+                OIC_LOG(DEBUG, TAG, "Sending cached discovery response");
+                OICFree(networkInfo);
+                discoveryResult = OC_STACK_OK;
+                resource = NULL;
+                goto send;
+            }
+        }
+
         discoveryResult = discoveryPayloadCreateAndAddDeviceId(&payload);
         VERIFY_PARAM_NON_NULL(TAG, payload, "Failed creating Discovery Payload.");
         VERIFY_SUCCESS(discoveryResult);
@@ -1085,11 +1319,24 @@ static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource
                 }
             }
         }
-        if (discPayload->resources == NULL)
+        // Links found at the RD are carried by one payload per device after this one.
+        bool hasResources = false;
+        for (OCDiscoveryPayload *temp = discPayload; temp && !hasResources; temp = temp->next)
+        {
+            hasResources = (NULL != temp->resources);
+        }
+        if (!hasResources)
         {
             discoveryResult = OC_STACK_NO_RESOURCE;
         }
 
+        if (OC_STACK_OK == discoveryResult)
+        {
+            OIC_LOG_PAYLOAD(DEBUG, payload);
+            cacheDiscoveryPayload(virtualUriInRequest, interfaceQuery, resourceTypeQuery,
+                                  &request->devAddr, networkInfo, infoSize, &payload);
+        }
+
         if (networkInfo)
         {
             OICFree(networkInfo);
@@ -1129,6 +1376,7 @@ static OCStackResult HandleVirtualResource (OCServerRequest *request, OCResource
      * 4)If Server does not have any 'DISCOVERABLE' resources and discovery
      *   request is unicast, it should send an error(RESOURCE_NOT_FOUND - 404) response.
      */
+send:
 
 #ifdef WITH_PRESENCE
     if ((virtualUriInRequest == OC_PRESENCE) &&
@@ -1655,6 +1903,8 @@ OCStackResult OCSetAttribute(OCResource* resource, const char* attribute, const
     }
     VERIFY_PARAM_NON_NULL(TAG, resAttrib->attrValue, "Failed allocating attribute value");
 
+    // Device name is part of baseline discovery responses
+    InvalidateDiscoveryCache();
     return OC_STACK_OK;
 
 exit:
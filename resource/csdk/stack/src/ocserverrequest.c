@@ -758,14 +758,39 @@ OCStackResult HandleAggregateResponse(OCEntityHandlerResponse * ehResponse)
             VERIFY_NON_NULL(serverResponse);
         }
 
-        if(ehResponse->payload->type != PAYLOAD_TYPE_REPRESENTATION)
+        OCPayload *repPayload = ehResponse->payload;
+
+        // Pre-encoded representations need decoding before they can be aggregated
+        if (repPayload->type == PAYLOAD_TYPE_ENCODED)
+        {
+            OCEncodedPayload *encoded = (OCEncodedPayload *)repPayload;
+            repPayload = NULL;
+            if (OC_STACK_OK != OCParsePayload(&repPayload, PAYLOAD_TYPE_REPRESENTATION,
+                                              encoded->payload, encoded->payloadSize))
+            {
+                OCPayloadDestroy(repPayload);
+                stackRet = OC_STACK_ERROR;
+                OIC_LOG(ERROR, TAG, "Error decoding pre-encoded payload");
+                goto exit;
+            }
+        }
+
+        if(!repPayload || repPayload->type != PAYLOAD_TYPE_REPRESENTATION)
         {
+            if (repPayload != ehResponse->payload)
+            {
+                OCPayloadDestroy(repPayload);
+            }
             stackRet = OC_STACK_ERROR;
             OIC_LOG(ERROR, TAG, "Error adding payload, as it was the incorrect type");
             goto exit;
         }
 
-        OCRepPayload *newPayload = OCRepPayloadBatchClone((OCRepPayload *)ehResponse->payload);
+        OCRepPayload *newPayload = OCRepPayloadBatchClone((OCRepPayload *)repPayload);
+        if (repPayload != ehResponse->payload)
+        {
+            OCPayloadDestroy(repPayload);
+        }
 
         if(!serverResponse->payload)
         {
@@ -2337,6 +2337,10 @@ OCStackResult OCStop()
     // Remove all the client callbacks
     DeleteClientCBList();
 
+#ifdef RD_SERVER
+    OCRDDatabaseDiscoveryClose();
+#endif
+
     // De-init the SRM Policy Engine
     // TODO after BeachHead delivery: consolidate into single SRMDeInit()
     SRMDeInitPolicyEngine();
@@ -3754,6 +3758,7 @@ OCStackResult BindTpsTypeToResource(OCResource* resource,
 
     OIC_LOG_V(INFO, TAG, "Binding %d TPS flags to %s", supportedTps, resource->uri);
     resource->endpointType = supportedTps;
+    InvalidateDiscoveryCache();
     return result;
 }
 
@@ -4134,7 +4139,17 @@ OCNotifyListOfObservers (OCResourceHandle handle,
                          const OCRepPayload       *payload,
                          OCQualityOfService qos)
 {
-    OIC_LOG(INFO, TAG, "Entering OCNotifyListOfObservers");
+    return OCNotifyListOfObserversWithCount(handle, obsIdList, numberOfIds, payload, qos);
+}
+
+OCStackResult
+OCNotifyListOfObserversWithCount (OCResourceHandle handle,
+                                  const OCObservationId *obsIdList,
+                                  size_t numberOfIds,
+                                  const OCRepPayload *payload,
+                                  OCQualityOfService qos)
+{
+    OIC_LOG(INFO, TAG, "Entering OCNotifyListOfObserversWithCount");
 
     OCResource *resPtr = NULL;
     //TODO: we should allow the server to define this
@@ -4260,6 +4275,7 @@ OCStackResult OCChangeResourceProperty(OCResourceProperty * inputProperty,
     {
         *inputProperty = (OCResourceProperty) (*inputProperty | resourceProperties);
     }
+    InvalidateDiscoveryCache();
     return OC_STACK_OK;
 }
 #endif
@@ -4342,6 +4358,7 @@ void insertResource(OCResource *resource)
         tailResource = resource;
     }
     resource->next = NULL;
+    InvalidateDiscoveryCache();
 }
 
 OCResource *findResource(OCResource *resource)
@@ -4391,6 +4408,8 @@ void deleteAllResources()
     deleteResource((OCResource *) presenceResource.handle);
     memset(&presenceResource, 0, sizeof(presenceResource));
 #endif // WITH_PRESENCE
+
+    DeleteDiscoveryCache();
 }
 
 OCStackResult deleteResource(OCResource *resource)
@@ -4450,6 +4469,7 @@ OCStackResult deleteResource(OCResource *resource)
 
             deleteResourceElements(temp);
             OICFree(temp);
+            InvalidateDiscoveryCache();
             return OC_STACK_OK;
         }
         else
@@ -4530,8 +4550,11 @@ void insertResourceType(OCResource *resource, OCResourceType *resourceType)
     {
         return;
     }
+
+    InvalidateDiscoveryCache();
+
     // resource type list is empty.
-    else if (!resource->rsrcType)
+    if (!resource->rsrcType)
     {
         resource->rsrcType = resourceType;
     }
@@ -4621,6 +4644,7 @@ void insertResourceInterface(OCResource *resource, OCResourceInterface *newInter
     OCResourceInterface *previous = NULL;
 
     newInterface->next = NULL;
+    InvalidateDiscoveryCache();
 
     OCResourceInterface **firstInterface = &(resource->rsrcInterface);
 
@@ -4930,6 +4954,7 @@ OCStackResult OCBindResourceInsToResource(OCResourceHandle handle, uint8_t ins)
     }
 
     resource->ins = ins;
+    InvalidateDiscoveryCache();
 
     return OC_STACK_OK;
 }
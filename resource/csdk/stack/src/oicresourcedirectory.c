@@ -27,6 +27,8 @@
 
 #include "octypes.h"
 #include "ocstack.h"
+#include "ocstackinternal.h"
+#include "ocresourcehandler.h"
 #include "logger.h"
 #include "ocpayload.h"
 #include "oic_malloc.h"
@@ -43,16 +45,40 @@
 
 static sqlite3 *gRDDB = NULL;
 
-static const uint8_t uri_index = 2;
-static const uint8_t p_index = 5;
-static const uint8_t mt_index = 7;
-static const uint8_t d_index = 8;
+/** Discovery statements, prepared when the database is first queried. */
+static sqlite3_stmt *gResourceTypeStmt = NULL;
+static sqlite3_stmt *gInterfaceStmt = NULL;
+static sqlite3_stmt *gResourceTypeInterfaceStmt = NULL;
 
-static const uint8_t rt_value_index = 1;
-static const uint8_t rt_link_id_index = 2;
+/**
+ * Discovery storms repeat the same few rt/if filters, so the results of recent
+ * queries are kept until the next change to the database.
+ */
+#define RD_DISCOVERY_CACHE_SIZE 16
 
-static const uint8_t if_value_index = 1;
-static const uint8_t if_link_id_index = 2;
+typedef struct RDDiscoveryCacheEntry
+{
+    char *resourceType;
+    char *interfaceType;
+    /** Database version the result was read at. */
+    uint32_t version;
+    OCStackResult result;
+    /** One payload per device, chained through next. */
+    OCDiscoveryPayload *devices;
+    struct RDDiscoveryCacheEntry *next;
+} RDDiscoveryCacheEntry;
+
+/** Most recently used first. */
+static RDDiscoveryCacheEntry *gDiscoveryCache = NULL;
+static uint32_t gDatabaseVersion = 0;
+
+static const uint8_t ins_column = 0;
+static const uint8_t href_column = 1;
+static const uint8_t bm_column = 2;
+static const uint8_t di_column = 3;
+static const uint8_t address_column = 4;
+static const uint8_t rt_column = 5;
+static const uint8_t if_column = 6;
 
 #define VERIFY_SQLITE(arg) \
 if (SQLITE_OK != (arg)) \
@@ -62,6 +88,40 @@ if (SQLITE_OK != (arg)) \
     return OC_STACK_ERROR; \
 }
 
+#define STR(a) #a
+#define XSTR(a) STR(a)
+
+/*
+ * One row per link and (rt, if) pair, so a single query returns every matching
+ * link with its device and its complete rt and if sets, grouped by device. The
+ * filtered table drives the join through its value index; the rest are LINK_ID/ID
+ * lookups.
+ */
+#define RD_LINK_SELECT \
+    "SELECT L." XSTR(OC_RSRVD_INS) ", L." XSTR(OC_RSRVD_HREF) ", L." XSTR(OC_RSRVD_BITMAP) ", " \
+    "D." XSTR(OC_RSRVD_DEVICE_ID) ", D.ADDRESS, " \
+    "RT." XSTR(OC_RSRVD_RESOURCE_TYPE) ", ITF." XSTR(OC_RSRVD_INTERFACE) " "
+
+#define RD_LINK_JOIN \
+    "INNER JOIN RD_DEVICE_LINK_LIST AS L ON L." XSTR(OC_RSRVD_INS) " = F.LINK_ID " \
+    "INNER JOIN RD_DEVICE_LIST AS D ON D.ID = L.DEVICE_ID " \
+    "LEFT JOIN RD_LINK_RT AS RT ON RT.LINK_ID = L." XSTR(OC_RSRVD_INS) " " \
+    "LEFT JOIN RD_LINK_IF AS ITF ON ITF.LINK_ID = L." XSTR(OC_RSRVD_INS) " "
+
+#define RD_SEARCH_RT \
+    RD_LINK_SELECT "FROM RD_LINK_RT AS F " RD_LINK_JOIN \
+    "WHERE F." XSTR(OC_RSRVD_RESOURCE_TYPE) " = ?1 ORDER BY L.DEVICE_ID, L." XSTR(OC_RSRVD_INS)
+
+#define RD_SEARCH_IF \
+    RD_LINK_SELECT "FROM RD_LINK_IF AS F " RD_LINK_JOIN \
+    "WHERE F." XSTR(OC_RSRVD_INTERFACE) " = ?2 ORDER BY L.DEVICE_ID, L." XSTR(OC_RSRVD_INS)
+
+#define RD_SEARCH_RT_IF \
+    RD_LINK_SELECT "FROM RD_LINK_RT AS F " RD_LINK_JOIN \
+    "WHERE F." XSTR(OC_RSRVD_RESOURCE_TYPE) " = ?1 AND L." XSTR(OC_RSRVD_INS) " IN " \
+    "(SELECT LINK_ID FROM RD_LINK_IF WHERE " XSTR(OC_RSRVD_INTERFACE) " = ?2) " \
+    "ORDER BY L.DEVICE_ID, L." XSTR(OC_RSRVD_INS)
+
 static void errorCallback(void *arg, int errCode, const char *errMsg)
 {
     OC_UNUSED(arg);
@@ -70,8 +130,59 @@ static void errorCallback(void *arg, int errCode, const char *errMsg)
     OIC_LOG_V(ERROR, TAG, "SQLLite Error: %s : %d", errMsg, errCode);
 }
 
+static void freeCacheEntryResult(RDDiscoveryCacheEntry *entry)
+{
+    OCDiscoveryPayloadDestroy(entry->devices);
+    entry->devices = NULL;
+}
+
+static void freeCacheEntry(RDDiscoveryCacheEntry *entry)
+{
+    freeCacheEntryResult(entry);
+    OICFree(entry->resourceType);
+    OICFree(entry->interfaceType);
+    OICFree(entry);
+}
+
+static void clearDiscoveryCache()
+{
+    while (gDiscoveryCache)
+    {
+        RDDiscoveryCacheEntry *next = gDiscoveryCache->next;
+        freeCacheEntry(gDiscoveryCache);
+        gDiscoveryCache = next;
+    }
+}
+
+void OCRDDatabaseDiscoveryInvalidate()
+{
+    // Entries are refreshed when next hit, or fall off the end of the list.
+    gDatabaseVersion++;
+    // Discovery responses cached by the stack include links read from the database.
+    InvalidateDiscoveryCache();
+}
+
+void OCRDDatabaseDiscoveryClose()
+{
+    clearDiscoveryCache();
+
+    sqlite3_finalize(gResourceTypeStmt);
+    gResourceTypeStmt = NULL;
+    sqlite3_finalize(gInterfaceStmt);
+    gInterfaceStmt = NULL;
+    sqlite3_finalize(gResourceTypeInterfaceStmt);
+    gResourceTypeInterfaceStmt = NULL;
+    sqlite3_close_v2(gRDDB);
+    gRDDB = NULL;
+}
+
 static OCStackResult initializeDatabase(const char *path)
 {
+    if (gRDDB)
+    {
+        return OC_STACK_OK;
+    }
+
     if (SQLITE_OK == sqlite3_config(SQLITE_CONFIG_LOG, errorCallback))
     {
         OIC_LOG_V(INFO, TAG, "SQLite debugging log initialized.");
@@ -82,6 +193,18 @@ static OCStackResult initializeDatabase(const char *path)
     {
         return OC_STACK_ERROR;
     }
+
+    // The tables only exist once the RD server has created them, so keep
+    // retrying on later queries until the statements can be prepared.
+    if (SQLITE_OK != sqlite3_prepare_v2(gRDDB, RD_SEARCH_RT, -1, &gResourceTypeStmt, NULL)
+        || SQLITE_OK != sqlite3_prepare_v2(gRDDB, RD_SEARCH_IF, -1, &gInterfaceStmt, NULL)
+        || SQLITE_OK != sqlite3_prepare_v2(gRDDB, RD_SEARCH_RT_IF, -1,
+                                           &gResourceTypeInterfaceStmt, NULL))
+    {
+        OIC_LOG_V(ERROR, TAG, "RD database is not ready: %s", sqlite3_errmsg(gRDDB));
+        OCRDDatabaseDiscoveryClose();
+        return OC_STACK_ERROR;
+    }
     return OC_STACK_OK;
 }
 
@@ -95,6 +218,7 @@ static OCStackResult appendStringLL(OCStringLL **type, const unsigned char *valu
     temp->value = OICStrdup((char *)value);
     if (!temp->value)
     {
+        OICFree(temp);
         return OC_STACK_NO_MEMORY;
     }
     temp->next = NULL;
@@ -112,158 +236,383 @@ static OCStackResult appendStringLL(OCStringLL **type, const unsigned char *valu
     return OC_STACK_OK;
 }
 
-OCStackResult OCRDDatabaseCheckResources(const char *interfaceType, const char *resourceType,
-    OCDiscoveryPayload *discPayload)
+/* The join repeats each rt for every if of a link and vice versa. */
+static OCStackResult appendUniqueStringLL(OCStringLL **type, const unsigned char *value)
 {
-    if (initializeDatabase(NULL) != OC_STACK_OK)
+    if (!value)
     {
-        return OC_STACK_INTERNAL_SERVER_ERROR;
+        return OC_STACK_OK;
     }
-    if (!interfaceType && !resourceType)
+    for (OCStringLL *tmp = *type; tmp; tmp = tmp->next)
     {
-        return OC_STACK_INVALID_QUERY;
+        if (0 == strcmp(tmp->value, (const char *)value))
+        {
+            return OC_STACK_OK;
+        }
     }
-    OCResourcePayload *resourcePayload = (OCResourcePayload *)OICCalloc(1, sizeof(OCResourcePayload));
-    if (!resourcePayload)
+    return appendStringLL(type, value);
+}
+
+/*
+ * The payloads found for each device are appended after the ones handed in by the
+ * stack. Rows come grouped by device, so a device is either the current one, one
+ * of the payloads handed in, or not seen yet.
+ */
+typedef struct
+{
+    OCDiscoveryPayload *head;
+    /** First payload appended here, NULL until then. */
+    OCDiscoveryPayload *added;
+    OCDiscoveryPayload *last;
+    OCDiscoveryPayload *current;
+} RDDevicePayloads;
+
+static void initDevicePayloads(RDDevicePayloads *devices, OCDiscoveryPayload *discPayload)
+{
+    devices->head = discPayload;
+    devices->added = NULL;
+    devices->last = discPayload;
+    while (devices->last->next)
     {
-        return OC_STACK_NO_MEMORY;
+        devices->last = devices->last->next;
     }
+    devices->current = NULL;
+}
 
-    if (resourceType)
+/* Returns the payload that carries the links of device di. */
+static OCDiscoveryPayload *getDevicePayload(RDDevicePayloads *devices, const char *di,
+                                            const char *address)
+{
+    if (!di)
+    {
+        return NULL;
+    }
+    if (devices->current && 0 == strcmp(devices->current->sid, di))
+    {
+        return devices->current;
+    }
+
+    for (OCDiscoveryPayload *temp = devices->head; temp && temp != devices->added;
+         temp = temp->next)
     {
-        sqlite3_stmt *stmt = 0;
-        const char *input = "SELECT * FROM RD_DEVICE_LINK_LIST INNER JOIN RD_LINK_RT ON " \
-        "RD_DEVICE_LINK_LIST.INS=RD_LINK_RT.LINK_ID WHERE RD_LINK_RT.rt LIKE ? ";
+        if (temp->sid && 0 == strcmp(temp->sid, di))
+        {
+            devices->current = temp;
+            return temp;
+        }
+    }
 
-        VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, input, -1, &stmt, NULL));
-        VERIFY_SQLITE(sqlite3_bind_text(stmt, 1, resourceType, strlen(resourceType) + 1, SQLITE_STATIC));
+    OCDiscoveryPayload *devicePayload = devices->head;
+    if (devicePayload->sid)
+    {
+        devicePayload = OCDiscoveryPayloadCreate();
+        if (!devicePayload)
+        {
+            return NULL;
+        }
+    }
+    devicePayload->sid = OICStrdup(di);
+    devicePayload->baseURI = address ? OICStrdup(address) : NULL;
+    if (!devicePayload->sid || (address && !devicePayload->baseURI))
+    {
+        OICFree(devicePayload->sid);
+        devicePayload->sid = NULL;
+        OICFree(devicePayload->baseURI);
+        devicePayload->baseURI = NULL;
+        if (devicePayload != devices->head)
+        {
+            OCDiscoveryPayloadDestroy(devicePayload);
+        }
+        return NULL;
+    }
+    if (devicePayload != devices->head)
+    {
+        devices->last->next = devicePayload;
+        devices->last = devicePayload;
+        if (!devices->added)
+        {
+            devices->added = devicePayload;
+        }
+    }
+    devices->current = devicePayload;
+    return devicePayload;
+}
 
-        int res = sqlite3_step (stmt);
-        if (res == SQLITE_ROW || res == SQLITE_DONE)
+static OCStackResult addResources(sqlite3_stmt *stmt, OCDiscoveryPayload *discPayload)
+{
+    OCStackResult result = OC_STACK_NO_RESOURCE;
+    OCResourcePayload *resourcePayload = NULL;
+    OCDiscoveryPayload *devicePayload = NULL;
+    sqlite3_int64 currentIns = -1;
+    int res;
+
+    RDDevicePayloads devices;
+    initDevicePayloads(&devices, discPayload);
+
+    while (SQLITE_ROW == (res = sqlite3_step(stmt)))
+    {
+        sqlite3_int64 ins = sqlite3_column_int64(stmt, ins_column);
+        if (!resourcePayload || ins != currentIns)
         {
-            int id = sqlite3_column_int(stmt, 0);
-            const unsigned char *uri = sqlite3_column_text(stmt, uri_index - 1);
-            int bitmap = sqlite3_column_int(stmt, p_index - 1);
-            int deviceId = sqlite3_column_int(stmt, d_index - 1);
-            OIC_LOG_V(DEBUG, TAG, " %s %d", uri, deviceId);
-            resourcePayload->uri = OICStrdup((char *)uri);
-            if (!resourcePayload->uri)
+            if (resourcePayload)
             {
-                OCDiscoveryResourceDestroy(resourcePayload);
-                return OC_STACK_NO_MEMORY;
+                OCDiscoveryPayloadAddNewResource(devicePayload, resourcePayload);
+                resourcePayload = NULL;
             }
-            res = sqlite3_reset(stmt);
-            VERIFY_SQLITE(res);
-
-            sqlite3_stmt *stmtRT = 0;
-            const char *rt = "SELECT rt FROM RD_LINK_RT WHERE LINK_ID=?";
-            VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, rt, -1, &stmtRT, NULL));
-            VERIFY_SQLITE(sqlite3_bind_int(stmtRT, 1, id));
-            while (SQLITE_ROW == sqlite3_step(stmtRT))
+            currentIns = ins;
+
+            const unsigned char *di = sqlite3_column_text(stmt, di_column);
+            const unsigned char *address = sqlite3_column_text(stmt, address_column);
+            OIC_LOG_V(DEBUG, TAG, " %s %s", di, address);
+            devicePayload = getDevicePayload(&devices, (const char *)di, (const char *)address);
+            if (!devicePayload)
             {
-                const unsigned char *rt1 = sqlite3_column_text(stmtRT, (rt_value_index - 1));
-                appendStringLL(&resourcePayload->types, rt1);
+                result = di ? OC_STACK_NO_MEMORY : OC_STACK_ERROR;
+                break;
             }
 
-            sqlite3_stmt *stmtIF = 0;
-            const char *itf = "SELECT if FROM RD_LINK_IF WHERE LINK_ID=?";
-            VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, itf, -1, &stmtIF, NULL));
-            VERIFY_SQLITE(sqlite3_bind_int(stmtIF, 1, id));
-            while (SQLITE_ROW == sqlite3_step(stmtIF))
+            const unsigned char *uri = sqlite3_column_text(stmt, href_column);
+            int bitmap = sqlite3_column_int(stmt, bm_column);
+            OIC_LOG_V(DEBUG, TAG, " %s %lld", uri, (long long)ins);
+
+            resourcePayload = (OCResourcePayload *)OICCalloc(1, sizeof(OCResourcePayload));
+            if (!resourcePayload)
             {
-                const unsigned char *itf = sqlite3_column_text(stmtIF, (if_value_index - 1));
-                appendStringLL(&resourcePayload->interfaces, itf);
+                result = OC_STACK_NO_MEMORY;
+                break;
+            }
+            resourcePayload->uri = OICStrdup((char *)uri);
+            if (!resourcePayload->uri)
+            {
+                result = OC_STACK_NO_MEMORY;
+                break;
             }
-
             resourcePayload->bitmap = bitmap & (OC_OBSERVABLE | OC_DISCOVERABLE);
-            resourcePayload->secure = (bitmap & OC_SECURE) != 0;
+            resourcePayload->secure = ((bitmap & OC_SECURE) != 0);
+            result = OC_STACK_OK;
+        }
+
+        if (OC_STACK_OK != appendUniqueStringLL(&resourcePayload->types,
+                                                sqlite3_column_text(stmt, rt_column))
+            || OC_STACK_OK != appendUniqueStringLL(&resourcePayload->interfaces,
+                                                   sqlite3_column_text(stmt, if_column)))
+        {
+            result = OC_STACK_NO_MEMORY;
+            break;
+        }
+    }
+
+    if (OC_STACK_OK == result && SQLITE_DONE != res)
+    {
+        OIC_LOG_V(ERROR, TAG, "RD query failed: %s", sqlite3_errmsg(gRDDB));
+        result = OC_STACK_ERROR;
+    }
+
+    if (resourcePayload)
+    {
+        if (OC_STACK_OK == result)
+        {
+            OCDiscoveryPayloadAddNewResource(devicePayload, resourcePayload);
+        }
+        else
+        {
+            OCDiscoveryResourceDestroy(resourcePayload);
+        }
+    }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    return result;
+}
+
+static bool filterEquals(const char *lhs, const char *rhs)
+{
+    return (!lhs || !rhs) ? (lhs == rhs) : (0 == strcmp(lhs, rhs));
+}
 
-            const char *address = "SELECT di, address FROM RD_DEVICE_LIST INNER JOIN RD_DEVICE_LINK_LIST ON " \
-            "RD_DEVICE_LINK_LIST.DEVICE_ID = RD_DEVICE_LIST.ID WHERE RD_DEVICE_LINK_LIST.DEVICE_ID=?";
+/* Returns the entry for the filter, moved to the front of the cache, or a new one. */
+static RDDiscoveryCacheEntry *getCacheEntry(const char *interfaceType, const char *resourceType)
+{
+    RDDiscoveryCacheEntry *prev = NULL;
+    RDDiscoveryCacheEntry *entry = gDiscoveryCache;
 
-            sqlite3_stmt *stmt1 = 0;
-            VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, address, -1, &stmt1, NULL));
-            VERIFY_SQLITE(sqlite3_bind_int(stmt1, 1, deviceId));
-            // TODO: Right now, we have a bug where discovery payload can only send one device information.
-            res = sqlite3_step(stmt1);
-            if (res == SQLITE_ROW || res == SQLITE_DONE)
+    for (; entry; prev = entry, entry = entry->next)
+    {
+        if (filterEquals(entry->resourceType, resourceType)
+            && filterEquals(entry->interfaceType, interfaceType))
+        {
+            if (prev)
             {
-                const unsigned char *di = sqlite3_column_text(stmt1, 0);
-                const unsigned char *address = sqlite3_column_text(stmt1, 1);
-                OIC_LOG_V(DEBUG, TAG, " %s %s", di, address);
-                (discPayload)->baseURI = OICStrdup((char *)address);
-                (discPayload)->sid = OICStrdup((char *)di);
+                prev->next = entry->next;
+                entry->next = gDiscoveryCache;
+                gDiscoveryCache = entry;
             }
-            OCDiscoveryPayloadAddNewResource(discPayload, resourcePayload);
+            return entry;
         }
     }
-    if (interfaceType)
+
+    entry = (RDDiscoveryCacheEntry *)OICCalloc(1, sizeof(RDDiscoveryCacheEntry));
+    if (!entry)
+    {
+        return NULL;
+    }
+    entry->resourceType = resourceType ? OICStrdup(resourceType) : NULL;
+    entry->interfaceType = interfaceType ? OICStrdup(interfaceType) : NULL;
+    if ((resourceType && !entry->resourceType) || (interfaceType && !entry->interfaceType))
     {
-        sqlite3_stmt *stmt = 0;
-        const char *input = "SELECT * FROM RD_DEVICE_LINK_LIST INNER JOIN RD_LINK_IF ON " \
-        "RD_DEVICE_LINK_LIST.INS=RD_LINK_IF.LINK_ID WHERE RD_LINK_IF.if LIKE ? ";
+        freeCacheEntry(entry);
+        return NULL;
+    }
+    // Never matches the current version until a result has been stored.
+    entry->version = gDatabaseVersion - 1;
+    entry->next = gDiscoveryCache;
+    gDiscoveryCache = entry;
+
+    // Drop the least recently used entries beyond the cache size.
+    size_t count = 1;
+    for (prev = entry; prev->next && count < RD_DISCOVERY_CACHE_SIZE; prev = prev->next)
+    {
+        count++;
+    }
+    while (prev->next)
+    {
+        RDDiscoveryCacheEntry *next = prev->next->next;
+        freeCacheEntry(prev->next);
+        prev->next = next;
+    }
+    return entry;
+}
 
-        VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, input, -1, &stmt, NULL));
-        VERIFY_SQLITE(sqlite3_bind_text(stmt, 1, interfaceType, strlen(interfaceType) + 1, SQLITE_STATIC));
+static OCResourcePayload *cloneResource(const OCResourcePayload *resource)
+{
+    OCResourcePayload *clone = (OCResourcePayload *)OICCalloc(1, sizeof(OCResourcePayload));
+    if (!clone)
+    {
+        return NULL;
+    }
+    clone->uri = OICStrdup(resource->uri);
+    clone->types = CloneOCStringLL(resource->types);
+    clone->interfaces = CloneOCStringLL(resource->interfaces);
+    clone->bitmap = resource->bitmap;
+    clone->secure = resource->secure;
+    clone->port = resource->port;
+    if (!clone->uri || (resource->types && !clone->types)
+        || (resource->interfaces && !clone->interfaces))
+    {
+        OCDiscoveryResourceDestroy(clone);
+        return NULL;
+    }
+    return clone;
+}
 
-        int res = sqlite3_step (stmt);
-        if (res == SQLITE_ROW || res == SQLITE_DONE)
+static OCStackResult applyCacheEntry(const RDDiscoveryCacheEntry *entry,
+                                     OCDiscoveryPayload *discPayload)
+{
+    if (OC_STACK_OK != entry->result)
+    {
+        return entry->result;
+    }
+
+    RDDevicePayloads devices;
+    initDevicePayloads(&devices, discPayload);
+
+    for (const OCDiscoveryPayload *device = entry->devices; device; device = device->next)
+    {
+        if (!device->resources)
         {
-            int id = sqlite3_column_int(stmt, 0);
-            const unsigned char *uri = sqlite3_column_text(stmt, uri_index - 1);
-            int bitmap = sqlite3_column_int(stmt, p_index - 1);
-            int deviceId = sqlite3_column_int(stmt, d_index - 1);
-            OIC_LOG_V(DEBUG, TAG, " %s %d", uri, deviceId);
-            resourcePayload->uri = OICStrdup((char *)uri);
-            if (!resourcePayload->uri)
+            continue;
+        }
+        OCDiscoveryPayload *devicePayload = getDevicePayload(&devices, device->sid,
+                                                             device->baseURI);
+        if (!devicePayload)
+        {
+            return OC_STACK_NO_MEMORY;
+        }
+        for (const OCResourcePayload *res = device->resources; res; res = res->next)
+        {
+            OCResourcePayload *clone = cloneResource(res);
+            if (!clone)
             {
-                OCDiscoveryResourceDestroy(resourcePayload);
                 return OC_STACK_NO_MEMORY;
             }
-            VERIFY_SQLITE(sqlite3_reset(stmt));
+            OCDiscoveryPayloadAddNewResource(devicePayload, clone);
+        }
+    }
+    return OC_STACK_OK;
+}
 
-            sqlite3_stmt *stmtRT = 0;
-            const char *rt = "SELECT rt FROM RD_LINK_RT WHERE LINK_ID=?";
-            VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, rt, -1, &stmtRT, NULL));
-            VERIFY_SQLITE(sqlite3_bind_int(stmtRT, 1, id));
-            while (SQLITE_ROW == sqlite3_step(stmtRT))
-            {
-                const unsigned char *rt1 = sqlite3_column_text(stmtRT, (rt_value_index - 1));
-                appendStringLL(&resourcePayload->types, rt1);
-            }
+/* Runs the query for the filter and keeps its result in the cache entry. */
+static OCStackResult refreshCacheEntry(RDDiscoveryCacheEntry *entry, sqlite3_stmt *stmt)
+{
+    freeCacheEntryResult(entry);
 
-            sqlite3_stmt *stmtIF = 0;
-            const char *itf = "SELECT if FROM RD_LINK_IF WHERE LINK_ID=?";
-            VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, itf, -1, &stmtIF, NULL));
-            VERIFY_SQLITE(sqlite3_bind_int(stmtIF, 1, id));
-            while (SQLITE_ROW == sqlite3_step (stmtIF))
-            {
-                const unsigned char *itf = sqlite3_column_text(stmtIF, (if_value_index - 1));
-                appendStringLL(&resourcePayload->interfaces, itf);
-            }
+    OCDiscoveryPayload *result = OCDiscoveryPayloadCreate();
+    if (!result)
+    {
+        return OC_STACK_NO_MEMORY;
+    }
 
-            resourcePayload->bitmap = bitmap & (OC_OBSERVABLE | OC_DISCOVERABLE);
-            resourcePayload->secure = ((bitmap & OC_SECURE) != 0);
+    entry->result = addResources(stmt, result);
+    if (OC_STACK_OK == entry->result || OC_STACK_NO_RESOURCE == entry->result)
+    {
+        entry->devices = result;
+        entry->version = gDatabaseVersion;
+        return entry->result;
+    }
+    OCDiscoveryPayloadDestroy(result);
+    return entry->result;
+}
 
-            const char *address = "SELECT di, address FROM RD_DEVICE_LIST INNER JOIN RD_DEVICE_LINK_LIST ON " \
-            "RD_DEVICE_LINK_LIST.DEVICE_ID = RD_DEVICE_LIST.ID WHERE RD_DEVICE_LINK_LIST.DEVICE_ID=?";
+OCStackResult OCRDDatabaseCheckResources(const char *interfaceType, const char *resourceType,
+    OCDiscoveryPayload *discPayload)
+{
+    if (initializeDatabase(NULL) != OC_STACK_OK)
+    {
+        return OC_STACK_INTERNAL_SERVER_ERROR;
+    }
+    if (!interfaceType && !resourceType)
+    {
+        return OC_STACK_INVALID_QUERY;
+    }
 
-            sqlite3_stmt *stmt1 = 0;
-            VERIFY_SQLITE(sqlite3_prepare_v2(gRDDB, address, -1, &stmt1, NULL));
-            VERIFY_SQLITE(sqlite3_bind_int(stmt1, 1, deviceId));
+    sqlite3_stmt *stmt = NULL;
+    if (resourceType && interfaceType)
+    {
+        stmt = gResourceTypeInterfaceStmt;
+    }
+    else if (resourceType)
+    {
+        stmt = gResourceTypeStmt;
+    }
+    else
+    {
+        stmt = gInterfaceStmt;
+    }
 
-            res = sqlite3_step(stmt1);
-            if (res == SQLITE_ROW || res == SQLITE_DONE)
-            {
-                const unsigned char *di = sqlite3_column_text(stmt1, 0);
-                const unsigned char *address = sqlite3_column_text(stmt1, 1);
-                OIC_LOG_V(DEBUG, TAG, " %s %s", di, address);
-                (discPayload)->baseURI = OICStrdup((char *)address);
-                (discPayload)->sid = OICStrdup((char *)di);
-            }
-            OCDiscoveryPayloadAddNewResource(discPayload, resourcePayload);
-        }
+    RDDiscoveryCacheEntry *entry = getCacheEntry(interfaceType, resourceType);
+    if (entry && entry->version == gDatabaseVersion)
+    {
+        return applyCacheEntry(entry, discPayload);
     }
-    return OC_STACK_OK;
+
+    // Values are stored with their terminating NUL, see rd_database.c.
+    if (resourceType)
+    {
+        VERIFY_SQLITE(sqlite3_bind_text(stmt, 1, resourceType, strlen(resourceType) + 1,
+                                        SQLITE_STATIC));
+    }
+    if (interfaceType)
+    {
+        VERIFY_SQLITE(sqlite3_bind_text(stmt, 2, interfaceType, strlen(interfaceType) + 1,
+                                        SQLITE_STATIC));
+    }
+
+    if (!entry)
+    {
+        return addResources(stmt, discPayload);
+    }
+
+    refreshCacheEntry(entry, stmt);
+    return applyCacheEntry(entry, discPayload);
 }
 #endif
@@ -24,6 +24,8 @@ extern "C"
     #include "ocpayload.h"
     #include "ocstack.h"
     #include "ocstackinternal.h"
+    #include "ocobserve.h"
+    #include "ocresourcehandler.h"
     #include "logger.h"
     #include "oic_malloc.h"
     #include "oic_string.h"
@@ -46,6 +48,8 @@ extern "C"
 #include <string.h>
 
 #include <iostream>
+#include <set>
+#include <vector>
 #include <stdint.h>
 
 #include "gtest_helper.h"
@@ -70,6 +74,7 @@ static char pinNumber;
 static OCDPDev_t peer;
 
 std::chrono::seconds const SHORT_TEST_TIMEOUT = std::chrono::seconds(5);
+std::chrono::seconds const LONG_TEST_TIMEOUT = std::chrono::seconds(60);
 
 //-----------------------------------------------------------------------------
 // Callback functions
@@ -2187,6 +2192,63 @@ TEST(StackUri, Rfc6874_NoOverflow_2)
     EXPECT_EQ(OC_STACK_ERROR, result);
 }
 
+TEST(StackObserve, ManyObservers)
+{
+    itst::DeadmanTimer killSwitch(LONG_TEST_TIMEOUT);
+    OIC_LOG(INFO, TAG, "Starting ManyObservers test");
+    InitStack(OC_SERVER);
+
+    OCResourceHandle handle;
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(&handle,
+                                            "core.led",
+                                            "core.rw",
+                                            "/a/led",
+                                            0,
+                                            NULL,
+                                            OC_DISCOVERABLE|OC_OBSERVABLE));
+
+    OCDevAddr devAddr = {};
+    devAddr.adapter = OC_ADAPTER_IP;
+    OICStrcpy(devAddr.addr, sizeof(devAddr.addr), "127.0.0.1");
+
+    const uint32_t observerCount = 10000;
+    std::vector<OCObservationId> ids;
+    std::set<OCObservationId> uniqueIds;
+
+    for (uint32_t i = 0; i < observerCount; i++)
+    {
+        OCObservationId id = 0;
+        EXPECT_EQ(OC_STACK_OK, GenerateObserverId(&id));
+        EXPECT_NE(0u, id);
+        devAddr.port = (uint16_t)(i % 60000 + 1);
+        EXPECT_EQ(OC_STACK_OK, AddObserver("/a/led", NULL, id, (CAToken_t)&i, sizeof(i),
+                                           (OCResource *)handle, OC_LOW_QOS, OC_FORMAT_CBOR,
+                                           &devAddr));
+        ids.push_back(id);
+        uniqueIds.insert(id);
+    }
+    EXPECT_EQ(observerCount, uniqueIds.size());
+
+    for (OCObservationId id : ids)
+    {
+        ResourceObserver *observer = GetObserverUsingId(id);
+        ASSERT_TRUE(NULL != observer);
+        EXPECT_EQ(id, observer->observeId);
+    }
+
+    // Drop every other observer, the remaining ones must still be found by ID.
+    for (uint32_t i = 0; i < observerCount; i += 2)
+    {
+        EXPECT_EQ(OC_STACK_OK, DeleteObserverUsingToken((CAToken_t)&i, sizeof(i)));
+    }
+    for (uint32_t i = 0; i < observerCount; i++)
+    {
+        EXPECT_EQ(i % 2 == 1, NULL != GetObserverUsingId(ids[i]));
+    }
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
 TEST(StackHeaderOption, setHeaderOption)
 {
     uint8_t optionValue1[MAX_HEADER_OPTION_DATA_LENGTH] =
@@ -2244,3 +2306,225 @@ TEST(StackEndpoints, OCGetSupportedEndpointTpsFlags)
 
     EXPECT_EQ(OC_STACK_OK, OCStop());
 }
+
+static bool g_discoveryDone = false;
+static std::set<std::string> g_discoveredUris;
+
+extern "C" OCStackApplicationResult discoveryCacheCallback(void* /*ctx*/,
+        OCDoHandle /*handle*/, OCClientResponse * clientResponse)
+{
+    EXPECT_EQ(OC_STACK_OK, clientResponse->result);
+    if (clientResponse->payload && PAYLOAD_TYPE_DISCOVERY == clientResponse->payload->type)
+    {
+        OCDiscoveryPayload *discoveryPayload = (OCDiscoveryPayload *)clientResponse->payload;
+        for (OCResourcePayload *res = discoveryPayload->resources; res; res = res->next)
+        {
+            g_discoveredUris.insert(res->uri);
+        }
+    }
+    g_discoveryDone = true;
+    return OC_STACK_DELETE_TRANSACTION;
+}
+
+// Discovers the resources of the stack itself through its unicast IPv4 endpoint,
+// returns the URIs of the discovered resources.
+static std::set<std::string> discoverResources()
+{
+    CAEndpoint_t *networkInfo = NULL;
+    uint32_t infoSize = 0;
+    EXPECT_EQ(CA_STATUS_OK, CAGetNetworkInformation(&networkInfo, &infoSize));
+
+    OCDevAddr server;
+    memset(&server, 0, sizeof(server));
+    for (uint32_t i = 0; i < infoSize; i++)
+    {
+        if (CA_ADAPTER_IP == networkInfo[i].adapter && (networkInfo[i].flags & CA_IPV4))
+        {
+            server.adapter = OC_ADAPTER_IP;
+            server.flags = OC_IP_USE_V4;
+            server.port = networkInfo[i].port;
+            OICStrcpy(server.addr, sizeof(server.addr), networkInfo[i].addr);
+            break;
+        }
+    }
+    OICFree(networkInfo);
+    EXPECT_NE(0, server.port);
+
+    g_discoveryDone = false;
+    g_discoveredUris.clear();
+
+    OCCallbackData cbData;
+    cbData.cb = discoveryCacheCallback;
+    cbData.context = NULL;
+    cbData.cd = NULL;
+    EXPECT_EQ(OC_STACK_OK, OCDoResource(NULL,
+                                        OC_REST_GET,
+                                        OC_RSRVD_WELL_KNOWN_URI,
+                                        &server,
+                                        NULL,
+                                        CT_ADAPTER_IP,
+                                        OC_LOW_QOS,
+                                        &cbData,
+                                        NULL,
+                                        0));
+    // The deadman timer of the test fails it if no response arrives.
+    while (!g_discoveryDone)
+    {
+        EXPECT_EQ(OC_STACK_OK, OCProcess());
+        usleep(10 * 1000);
+    }
+    return g_discoveredUris;
+}
+
+// Changes the URI of a resource without telling the stack, so only a discovery response
+// built after the change carries the new URI. Returns the previous URI.
+static char *swapResourceUri(OCResourceHandle handle, char *uri)
+{
+    OCResource *resource = (OCResource *)handle;
+    char *previous = resource->uri;
+    resource->uri = uri;
+    return previous;
+}
+
+static void createDiscoverableResource(OCResourceHandle *handle, const char *uri)
+{
+    EXPECT_EQ(OC_STACK_OK, OCCreateResource(handle,
+                                            "core.led",
+                                            "core.rw",
+                                            uri,
+                                            0,
+                                            NULL,
+                                            OC_DISCOVERABLE|OC_OBSERVABLE));
+}
+
+TEST(StackDiscoveryCache, RepeatedDiscoveryHitsCache)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    InitStack(OC_CLIENT_SERVER);
+
+    OCResourceHandle handle;
+    createDiscoverableResource(&handle, "/a/led");
+    EXPECT_EQ(1u, discoverResources().count("/a/led"));
+
+    char *uri = swapResourceUri(handle, OICStrdup("/a/renamed"));
+    std::set<std::string> uris = discoverResources();
+    EXPECT_EQ(1u, uris.count("/a/led"));
+    EXPECT_EQ(0u, uris.count("/a/renamed"));
+    OICFree(swapResourceUri(handle, uri));
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+TEST(StackDiscoveryCache, CreateResourceMissesCache)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    InitStack(OC_CLIENT_SERVER);
+
+    OCResourceHandle handle1;
+    createDiscoverableResource(&handle1, "/a/led1");
+    EXPECT_EQ(1u, discoverResources().count("/a/led1"));
+
+    char *uri = swapResourceUri(handle1, OICStrdup("/a/renamed"));
+    OCResourceHandle handle2;
+    createDiscoverableResource(&handle2, "/a/led2");
+    std::set<std::string> uris = discoverResources();
+    EXPECT_EQ(1u, uris.count("/a/renamed"));
+    EXPECT_EQ(1u, uris.count("/a/led2"));
+    OICFree(swapResourceUri(handle1, uri));
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+TEST(StackDiscoveryCache, DeleteResourceMissesCache)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    InitStack(OC_CLIENT_SERVER);
+
+    OCResourceHandle handle1;
+    createDiscoverableResource(&handle1, "/a/led1");
+    OCResourceHandle handle2;
+    createDiscoverableResource(&handle2, "/a/led2");
+    EXPECT_EQ(1u, discoverResources().count("/a/led2"));
+
+    char *uri = swapResourceUri(handle1, OICStrdup("/a/renamed"));
+    EXPECT_EQ(OC_STACK_OK, OCDeleteResource(handle2));
+    std::set<std::string> uris = discoverResources();
+    EXPECT_EQ(1u, uris.count("/a/renamed"));
+    EXPECT_EQ(0u, uris.count("/a/led2"));
+    OICFree(swapResourceUri(handle1, uri));
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+TEST(StackDiscoveryCache, BindResourceTypeMissesCache)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    InitStack(OC_CLIENT_SERVER);
+
+    OCResourceHandle handle;
+    createDiscoverableResource(&handle, "/a/led");
+    EXPECT_EQ(1u, discoverResources().count("/a/led"));
+
+    char *uri = swapResourceUri(handle, OICStrdup("/a/renamed"));
+    EXPECT_EQ(OC_STACK_OK, OCBindResourceTypeToResource(handle, "core.brightled"));
+    EXPECT_EQ(1u, discoverResources().count("/a/renamed"));
+    OICFree(swapResourceUri(handle, uri));
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+TEST(StackDiscoveryCache, SetAttributeMissesCache)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+    InitStack(OC_CLIENT_SERVER);
+
+    OCResourceHandle handle;
+    createDiscoverableResource(&handle, "/a/led");
+    EXPECT_EQ(1u, discoverResources().count("/a/led"));
+
+    char *uri = swapResourceUri(handle, OICStrdup("/a/renamed"));
+    // Sets the attribute of the device resource through OCSetAttribute
+    EXPECT_EQ(OC_STACK_OK, OCSetPropertyValue(PAYLOAD_TYPE_DEVICE, OC_RSRVD_DEVICE_NAME,
+                                              "discoverycache"));
+    EXPECT_EQ(1u, discoverResources().count("/a/renamed"));
+    OICFree(swapResourceUri(handle, uri));
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+}
+
+// The device ID is kept in persistent storage, which is redirected to a file of the test.
+static const char DISCOVERY_CACHE_SVR_DB[] = "discovery_cache_svr_db.dat";
+
+static FILE *openTestDatabase(const char * /*path*/, const char *mode)
+{
+    return fopen(DISCOVERY_CACHE_SVR_DB, mode);
+}
+
+static int unlinkTestDatabase(const char * /*path*/)
+{
+    return unlink(DISCOVERY_CACHE_SVR_DB);
+}
+
+TEST(StackDiscoveryCache, SetDeviceIdMissesCache)
+{
+    itst::DeadmanTimer killSwitch(SHORT_TEST_TIMEOUT);
+
+    static OCPersistentStorage ps = { openTestDatabase, fread, fwrite, fclose,
+                                      unlinkTestDatabase };
+    EXPECT_EQ(OC_STACK_OK, OCRegisterPersistentStorageHandler(&ps));
+    InitStack(OC_CLIENT_SERVER);
+
+    OCResourceHandle handle;
+    createDiscoverableResource(&handle, "/a/led");
+    EXPECT_EQ(1u, discoverResources().count("/a/led"));
+
+    char *uri = swapResourceUri(handle, OICStrdup("/a/renamed"));
+    OCUUIdentity deviceId = {{ 0xfe, 0x3f, 0x9a, 0x68, 0x49, 0x31, 0x4c, 0xb0,
+                               0x9e, 0xa4, 0x81, 0x70, 0x2b, 0x43, 0x11, 0x6d }};
+    EXPECT_EQ(OC_STACK_OK, OCSetDeviceId(&deviceId));
+    EXPECT_EQ(1u, discoverResources().count("/a/renamed"));
+    OICFree(swapResourceUri(handle, uri));
+
+    EXPECT_EQ(OC_STACK_OK, OCStop());
+    unlink(DISCOVERY_CACHE_SVR_DB);
+}
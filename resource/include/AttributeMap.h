@@ -0,0 +1,183 @@
+//******************************************************************
+//
+// Copyright 2016 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+/**
+ * @file
+ *
+ * This file contains the definition of the internally used type
+ * AttributeMap, the attribute storage of OCRepresentation.
+ */
+
+#ifndef OC_ATTRIBUTEMAP_H_
+#define OC_ATTRIBUTEMAP_H_
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace OC
+{
+    /**
+     * Associative container with the interface of std::map<std::string, T>,
+     * stored as a vector of pairs sorted by name.
+     *
+     * A representation typically carries a few dozen attributes at most, so a
+     * contiguous array beats a node based tree: one allocation for all entries
+     * instead of one per entry, and lookups and iteration stay in cache.
+     * Names short enough for the small-string buffer of std::string are stored
+     * inline with their value.
+     *
+     * Unlike std::map, inserting or erasing an entry invalidates iterators
+     * and references to other entries.
+     */
+    template <typename T>
+    class AttributeMap
+    {
+        public:
+            typedef std::string key_type;
+            typedef T mapped_type;
+            typedef std::pair<std::string, T> value_type;
+            typedef typename std::vector<value_type>::size_type size_type;
+            typedef typename std::vector<value_type>::iterator iterator;
+            typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+            AttributeMap() = default;
+            AttributeMap(const AttributeMap&) = default;
+            AttributeMap(AttributeMap&&) = default;
+            AttributeMap& operator=(const AttributeMap&) = default;
+            AttributeMap& operator=(AttributeMap&&) = default;
+
+            iterator begin() { return m_items.begin(); }
+            const_iterator begin() const { return m_items.begin(); }
+            const_iterator cbegin() const { return m_items.cbegin(); }
+            iterator end() { return m_items.end(); }
+            const_iterator end() const { return m_items.end(); }
+            const_iterator cend() const { return m_items.cend(); }
+
+            size_type size() const { return m_items.size(); }
+            bool empty() const { return m_items.empty(); }
+            void clear() { m_items.clear(); }
+            void reserve(size_type count) { m_items.reserve(count); }
+
+            iterator find(const std::string& key)
+            {
+                iterator it = lowerBound(key);
+                return (it != m_items.end() && it->first == key) ? it : m_items.end();
+            }
+
+            const_iterator find(const std::string& key) const
+            {
+                const_iterator it = lowerBound(key);
+                return (it != m_items.end() && it->first == key) ? it : m_items.end();
+            }
+
+            size_type count(const std::string& key) const
+            {
+                return find(key) != m_items.end() ? 1 : 0;
+            }
+
+            T& operator[](const std::string& key)
+            {
+                // Attributes mostly arrive in name order, from the wire or from
+                // another representation, so check for an append first.
+                if (m_items.empty() || m_items.back().first < key)
+                {
+                    m_items.emplace_back(key, T());
+                    return m_items.back().second;
+                }
+
+                iterator it = lowerBound(key);
+                if (it == m_items.end() || it->first != key)
+                {
+                    it = m_items.emplace(it, key, T());
+                }
+                return it->second;
+            }
+
+            T& operator[](std::string&& key)
+            {
+                if (m_items.empty() || m_items.back().first < key)
+                {
+                    m_items.emplace_back(std::move(key), T());
+                    return m_items.back().second;
+                }
+
+                iterator it = lowerBound(key);
+                if (it == m_items.end() || it->first != key)
+                {
+                    it = m_items.emplace(it, std::move(key), T());
+                }
+                return it->second;
+            }
+
+            iterator erase(iterator pos)
+            {
+                return m_items.erase(pos);
+            }
+
+            size_type erase(const std::string& key)
+            {
+                iterator it = find(key);
+                if (it == m_items.end())
+                {
+                    return 0;
+                }
+                m_items.erase(it);
+                return 1;
+            }
+
+            operator std::map<std::string, T>() const
+            {
+                return std::map<std::string, T>(m_items.begin(), m_items.end());
+            }
+
+            friend bool operator==(const AttributeMap& lhs, const AttributeMap& rhs)
+            {
+                return lhs.m_items == rhs.m_items;
+            }
+
+            friend bool operator!=(const AttributeMap& lhs, const AttributeMap& rhs)
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            iterator lowerBound(const std::string& key)
+            {
+                return std::lower_bound(m_items.begin(), m_items.end(), key, keyLess);
+            }
+
+            const_iterator lowerBound(const std::string& key) const
+            {
+                return std::lower_bound(m_items.begin(), m_items.end(), key, keyLess);
+            }
+
+            static bool keyLess(const value_type& item, const std::string& key)
+            {
+                return item.first < key;
+            }
+
+        private:
+            std::vector<value_type> m_items;
+    };
+}
+#endif // OC_ATTRIBUTEMAP_H_
@@ -158,6 +158,9 @@ namespace OC
         /** persistant storage Handler structure (open/read/write/close/unlink). */
         OCPersistentStorage        *ps;
 
+        /** encode outgoing representations straight to CBOR, bypassing OCRepPayload. */
+        bool                       directPayloadEncoding;
+
         public:
             PlatformConfig()
                 : serviceType(ServiceType::InProc),
@@ -167,7 +170,8 @@ namespace OC
                 ipAddress("0.0.0.0"),
                 port(0),
                 QoS(QualityOfService::NaQos),
-                ps(nullptr)
+                ps(nullptr),
+                directPayloadEncoding(false)
         {}
             PlatformConfig(const ServiceType serviceType_,
             const ModeType mode_,
@@ -182,7 +186,8 @@ namespace OC
                 ipAddress(""),
                 port(0),
                 QoS(QoS_),
-                ps(ps_)
+                ps(ps_),
+                directPayloadEncoding(false)
         {}
             // for backward compatibility
             PlatformConfig(const ServiceType serviceType_,
@@ -198,7 +203,8 @@ namespace OC
                 ipAddress(ipAddress_),
                 port(port_),
                 QoS(QoS_),
-                ps(ps_)
+                ps(ps_),
+                directPayloadEncoding(false)
         {}
     };
 
@@ -34,6 +34,7 @@
 #include <map>
 
 #include <AttributeValue.h>
+#include <AttributeMap.h>
 #include <StringConstants.h>
 
 #ifdef __ANDROID__
@@ -44,6 +45,7 @@
 
 namespace OC
 {
+    typedef AttributeMap<AttributeValue> AttributeValueMap;
 
     enum class InterfaceType
     {
@@ -65,10 +67,48 @@ namespace OC
 
             OCRepPayload* getPayload() const;
 
+            /**
+             * Same as getPayload(), for @p rep followed by its children,
+             * which avoids copying them into a MessageContainer first.
+             */
+            static OCRepPayload* createPayload(const OCRepresentation& rep);
+
+            /**
+             * Decodes a CBOR message straight into OCRepresentation objects,
+             * without building an intermediate OCRepPayload tree.
+             *
+             * @param payload CBOR encoded representation(s).
+             * @param size Size of the payload in bytes.
+             */
+            void setEncodedPayload(const uint8_t* payload, size_t size);
+
+            /**
+             * Encodes the contained representations straight into CBOR,
+             * without building an intermediate OCRepPayload tree.
+             *
+             * @return Pre-encoded payload which the stack transmits as is.
+             *         Ownership is transferred to the caller.
+             */
+            OCPayload* getEncodedPayload() const;
+
+            /**
+             * Same as getEncodedPayload(), for @p rep followed by its children,
+             * which avoids copying them into a MessageContainer first.
+             */
+            static OCPayload* encodePayload(const OCRepresentation& rep);
+
             const std::vector<OCRepresentation>& representations() const;
 
             void addRepresentation(const OCRepresentation& rep);
 
+            void addRepresentation(OCRepresentation&& rep);
+
+            /**
+             * Moves the contained representations out of this container,
+             * leaving it empty.
+             */
+            std::vector<OCRepresentation> releaseRepresentations();
+
             const OCRepresentation& operator[](int index) const
             {
                 return m_reps[index];
@@ -127,12 +167,16 @@ namespace OC
 
             void addChild(const OCRepresentation&);
 
+            void addChild(OCRepresentation&&);
+
             void clearChildren();
 
             const std::vector<OCRepresentation>& getChildren() const;
 
             void setChildren(const std::vector<OCRepresentation>& children);
 
+            void setChildren(std::vector<OCRepresentation>&& children);
+
             void setUri(const char* uri);
 
             void setUri(const std::string& uri);
@@ -174,7 +218,7 @@ namespace OC
                 m_values[str] = std::forward<T>(val);
             }
 
-            const std::map<std::string, AttributeValue>& getValues() const {
+            const AttributeValueMap& getValues() const {
                 return m_values;
             }
 
@@ -373,10 +417,10 @@ namespace OC
 
                 private:
                     AttributeItem(const std::string& name,
-                            std::map<std::string, AttributeValue>& vals);
+                            AttributeValueMap& vals);
                     AttributeItem(const AttributeItem&) = default;
                     std::string m_attrName;
-                    std::map<std::string, AttributeValue>& m_values;
+                    AttributeValueMap& m_values;
             };
 
             // Iterator to allow iteration via STL containers/methods
@@ -403,11 +447,11 @@ namespace OC
                     reference operator*();
                     pointer operator->();
                 private:
-                    iterator(std::map<std::string, AttributeValue>::iterator&& itr,
-                            std::map<std::string, AttributeValue>& vals)
+                    iterator(AttributeValueMap::iterator&& itr,
+                            AttributeValueMap& vals)
                         : m_iterator(std::move(itr)),
                         m_item(m_iterator != vals.end() ? m_iterator->first:"", vals){}
-                    std::map<std::string, AttributeValue>::iterator m_iterator;
+                    AttributeValueMap::iterator m_iterator;
                     AttributeItem m_item;
             };
 
@@ -436,11 +480,11 @@ namespace OC
                     const_reference operator*() const;
                     const_pointer operator->() const;
                 private:
-                    const_iterator(std::map<std::string, AttributeValue>::const_iterator&& itr,
-                            std::map<std::string, AttributeValue>& vals)
+                    const_iterator(AttributeValueMap::const_iterator&& itr,
+                            AttributeValueMap& vals)
                         : m_iterator(std::move(itr)),
                         m_item(m_iterator != vals.end() ? m_iterator->first: "", vals){}
-                    std::map<std::string, AttributeValue>::const_iterator m_iterator;
+                    AttributeValueMap::const_iterator m_iterator;
                     AttributeItem m_item;
             };
 
@@ -497,7 +541,7 @@ namespace OC
         private:
             std::string m_uri;
             std::vector<OCRepresentation> m_children;
-            mutable std::map<std::string, AttributeValue> m_values;
+            mutable AttributeValueMap m_values;
             std::vector<std::string> m_resourceTypes;
             std::vector<std::string> m_interfaces;
             std::vector<std::string> m_dataModelVersions;
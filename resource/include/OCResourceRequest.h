@@ -242,6 +242,11 @@ namespace OC
             m_headerOptions = headerOptions;
         }
 
+        void setHeaderOptions(HeaderOptions&& headerOptions)
+        {
+            m_headerOptions = std::move(headerOptions);
+        }
+
         /**
         * This API allows to set request handle
         * @param requestHandle - OCRequestHandle type used to set the
@@ -110,6 +110,15 @@ namespace OC
             m_headerOptions = headerOptions;
         }
 
+        /**
+        * This API allows to set headerOptions in the response
+        * @param headerOptions HeaderOptions vector to be moved into the response
+        */
+        void setHeaderOptions(HeaderOptions&& headerOptions)
+        {
+            m_headerOptions = std::move(headerOptions);
+        }
+
         /**
         * This API allows to set request handle
         *
@@ -145,8 +154,8 @@ namespace OC
         *  @param rep reference to the resource's representation
         *  @param interface specifies the interface
         */
-        void setResourceRepresentation(OCRepresentation& rep, std::string iface) {
-            m_interface = iface;
+        void setResourceRepresentation(const OCRepresentation& rep, std::string iface) {
+            m_interface = std::move(iface);
             m_representation = rep;
         }
 
@@ -156,14 +165,15 @@ namespace OC
         *  @param interface specifies the interface
         */
         void setResourceRepresentation(OCRepresentation&& rep, std::string iface) {
-            setResourceRepresentation(rep, iface);
+            m_interface = std::move(iface);
+            m_representation = std::move(rep);
         }
 
         /**
         *  API to set the entire resource attribute representation
         *  @param rep reference to the resource's representation
         */
-        void setResourceRepresentation(OCRepresentation& rep) {
+        void setResourceRepresentation(const OCRepresentation& rep) {
             // Call the default
             m_interface = DEFAULT_INTERFACE;
             m_representation = rep;
@@ -174,8 +184,8 @@ namespace OC
         *  @param rep rvalue reference to the resource's representation
         */
         void setResourceRepresentation(OCRepresentation&& rep) {
-            // Call the above function
-            setResourceRepresentation(rep);
+            m_interface = DEFAULT_INTERFACE;
+            m_representation = std::move(rep);
         }
     private:
         std::string m_newResourceUri;
@@ -189,48 +199,17 @@ namespace OC
     private:
         friend class InProcServerWrapper;
 
+        // The interface type of a representation only affects emptyData(),
+        // not its payload, so the representations are converted without copies.
         OCRepPayload* getPayload() const
         {
-            MessageContainer inf;
-            OCRepresentation first(m_representation);
-
-            if(m_interface==LINK_INTERFACE)
-            {
-                first.setInterfaceType(InterfaceType::LinkParent);
-            }
-            else if(m_interface==BATCH_INTERFACE)
-            {
-                first.setInterfaceType(InterfaceType::BatchParent);
-            }
-            else
-            {
-                first.setInterfaceType(InterfaceType::DefaultParent);
-            }
-
-            inf.addRepresentation(first);
-
-            for(const OCRepresentation& rep : m_representation.getChildren())
-            {
-                OCRepresentation cur(rep);
-
-                if(m_interface==LINK_INTERFACE)
-                {
-                    cur.setInterfaceType(InterfaceType::LinkChild);
-                }
-                else if(m_interface==BATCH_INTERFACE)
-                {
-                    cur.setInterfaceType(InterfaceType::BatchChild);
-                }
-                else
-                {
-                    cur.setInterfaceType(InterfaceType::DefaultChild);
-                }
-
-                inf.addRepresentation(cur);
-
-            }
+            return MessageContainer::createPayload(m_representation);
+        }
 
-            return inf.getPayload();
+        // Same message as getPayload(), encoded straight to CBOR.
+        OCPayload* getEncodedPayload() const
+        {
+            return MessageContainer::encodePayload(m_representation);
         }
     public:
 
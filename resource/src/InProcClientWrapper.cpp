@@ -146,21 +146,22 @@ namespace OC
         oc.setPayload(clientResponse->payload);
         //OCPayloadDestroy(clientResponse->payload);
 
-        std::vector<OCRepresentation>::const_iterator it = oc.representations().begin();
-        if (it == oc.representations().end())
+        std::vector<OCRepresentation> reps = oc.releaseRepresentations();
+        std::vector<OCRepresentation>::iterator it = reps.begin();
+        if (it == reps.end())
         {
             return OCRepresentation();
         }
 
         // first one is considered the root, everything else is considered a child of this one.
-        OCRepresentation root = *it;
+        OCRepresentation root = std::move(*it);
         root.setDevAddr(clientResponse->devAddr);
         root.setUri(clientResponse->resourceUri);
         ++it;
 
-        std::for_each(it, oc.representations().end(),
-                [&root](const OCRepresentation& repItr)
-                {root.addChild(repItr);});
+        std::for_each(it, reps.end(),
+                [&root](OCRepresentation& repItr)
+                {root.addChild(std::move(repItr));});
         return root;
 
     }
@@ -563,7 +564,7 @@ namespace OC
         try
         {
             OCRepresentation rep = parseGetSetCallback(clientResponse);
-            std::thread exec(context->callback, rep);
+            std::thread exec(context->callback, std::move(rep));
             exec.detach();
         }
         catch(OC::OCException& e)
@@ -617,6 +618,13 @@ namespace OC
         return result;
     }
 
+    // ETag and Max-Age are opaque bytes on the wire and are not NUL terminated.
+    bool isBinaryHeaderOption(uint16_t optionID)
+    {
+        return optionID == HeaderOption::ETAG_OPTION_ID
+                || optionID == HeaderOption::MAX_AGE_OPTION_ID;
+    }
+
     void parseServerHeaderOptions(OCClientResponse* clientResponse,
                     HeaderOptions& serverHeaderOptions)
     {
@@ -626,13 +634,23 @@ namespace OC
             uint16_t optionID;
             std::string optionData;
 
+            serverHeaderOptions.reserve(serverHeaderOptions.size() +
+                    clientResponse->numRcvdVendorSpecificHeaderOptions);
             for(int i = 0; i < clientResponse->numRcvdVendorSpecificHeaderOptions; i++)
             {
-                optionID = clientResponse->rcvdVendorSpecificHeaderOptions[i].optionID;
-                optionData = reinterpret_cast<const char*>
-                                (clientResponse->rcvdVendorSpecificHeaderOptions[i].optionData);
-                HeaderOption::OCHeaderOption headerOption(optionID, optionData);
-                serverHeaderOptions.push_back(headerOption);
+                const OCHeaderOption& option = clientResponse->rcvdVendorSpecificHeaderOptions[i];
+                optionID = option.optionID;
+                if (isBinaryHeaderOption(optionID))
+                {
+                    optionData.assign(reinterpret_cast<const char*>(option.optionData),
+                                      std::min<size_t>(option.optionLength,
+                                                       sizeof(option.optionData)));
+                }
+                else
+                {
+                    optionData = reinterpret_cast<const char*>(option.optionData);
+                }
+                serverHeaderOptions.emplace_back(optionID, optionData);
             }
         }
         else
@@ -790,7 +808,8 @@ namespace OC
             result = e.code();
         }
 
-        std::thread exec(context->callback, serverHeaderOptions, rep, result);
+        std::thread exec(context->callback, std::move(serverHeaderOptions), std::move(rep),
+                result);
         exec.detach();
         return OC_STACK_DELETE_TRANSACTION;
     }
@@ -864,7 +883,8 @@ namespace OC
             result = e.code();
         }
 
-        std::thread exec(context->callback, serverHeaderOptions, attrs, result);
+        std::thread exec(context->callback, std::move(serverHeaderOptions), std::move(attrs),
+                result);
         exec.detach();
         return OC_STACK_DELETE_TRANSACTION;
     }
@@ -950,6 +970,11 @@ namespace OC
 
     OCPayload* InProcClientWrapper::assembleSetResourcePayload(const OCRepresentation& rep)
     {
+        if (m_cfg.directPayloadEncoding)
+        {
+            return MessageContainer::encodePayload(rep);
+        }
+
         MessageContainer ocInfo;
         ocInfo.addRepresentation(rep);
         for(const OCRepresentation& r : rep.getChildren())
@@ -1064,7 +1089,8 @@ namespace OC
 
         parseServerHeaderOptions(clientResponse, serverHeaderOptions);
 
-        std::thread exec(context->callback, serverHeaderOptions, clientResponse->result);
+        std::thread exec(context->callback, std::move(serverHeaderOptions),
+                clientResponse->result);
         exec.detach();
         return OC_STACK_DELETE_TRANSACTION;
     }
@@ -1137,7 +1163,7 @@ namespace OC
             result = e.code();
         }
 
-        std::thread exec(context->callback, serverHeaderOptions, attrs,
+        std::thread exec(context->callback, std::move(serverHeaderOptions), std::move(attrs),
                     result, sequenceNumber);
         exec.detach();
         if (sequenceNumber == MAX_SEQUENCE_NUMBER + 1)
@@ -1382,8 +1408,18 @@ namespace OC
             options[i] = OCHeaderOption();
             options[i].protocolID = OC_COAP_ID;
             options[i].optionID = it->getOptionID();
-            options[i].optionLength = it->getOptionData().length() + 1;
-            strcpy((char*)options[i].optionData, (it->getOptionData().c_str()));
+            if (isBinaryHeaderOption(options[i].optionID))
+            {
+                options[i].optionLength = std::min<size_t>(it->getOptionData().length(),
+                                                           sizeof(options[i].optionData));
+                memcpy(options[i].optionData, it->getOptionData().data(),
+                       options[i].optionLength);
+            }
+            else
+            {
+                options[i].optionLength = it->getOptionData().length() + 1;
+                strcpy((char*)options[i].optionData, (it->getOptionData().c_str()));
+            }
             i++;
         }
 
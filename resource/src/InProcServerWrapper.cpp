@@ -89,6 +89,7 @@ void formResourceRequest(OCEntityHandlerFlag flag,
                 uint16_t optionID;
                 std::string optionData;
                 HeaderOptions headerOptions;
+                headerOptions.reserve(entityHandlerRequest->numRcvdVendorSpecificHeaderOptions);
 
                 for(int i = 0;
                     i < entityHandlerRequest->numRcvdVendorSpecificHeaderOptions;
@@ -97,10 +98,9 @@ void formResourceRequest(OCEntityHandlerFlag flag,
                     optionID = entityHandlerRequest->rcvdVendorSpecificHeaderOptions[i].optionID;
                     optionData = reinterpret_cast<const char*>
                              (entityHandlerRequest->rcvdVendorSpecificHeaderOptions[i].optionData);
-                    HeaderOption::OCHeaderOption headerOption(optionID, optionData);
-                    headerOptions.push_back(headerOption);
+                    headerOptions.emplace_back(optionID, optionData);
                 }
-                pRequest->setHeaderOptions(headerOptions);
+                pRequest->setHeaderOptions(std::move(headerOptions));
             }
 
             if(OC_REST_GET == entityHandlerRequest->method)
@@ -605,13 +605,20 @@ namespace OC
         {
             OCEntityHandlerResponse response;
 //            OCRepPayload* payLoad = pResponse->getPayload();
-            HeaderOptions serverHeaderOptions = pResponse->getHeaderOptions();
+            const HeaderOptions& serverHeaderOptions = pResponse->getHeaderOptions();
 
             response.requestHandle = pResponse->getRequestHandle();
             response.resourceHandle = pResponse->getResourceHandle();
             response.ehResult = pResponse->getResponseResult();
 
-            response.payload = reinterpret_cast<OCPayload*>(pResponse->getPayload());
+            if (m_cfg.directPayloadEncoding)
+            {
+                response.payload = pResponse->getEncodedPayload();
+            }
+            else
+            {
+                response.payload = reinterpret_cast<OCPayload*>(pResponse->getPayload());
+            }
 
             response.persistentBufferFlag = 0;
 
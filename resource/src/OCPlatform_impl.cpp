@@ -222,8 +222,8 @@ namespace OC
 
         OCRepPayload* pl = pResponse->getResourceRepresentation().getPayload();
         OCStackResult result =
-                   OCNotifyListOfObservers(resourceHandle,
-                            &observationIds[0], observationIds.size(),
+                   OCNotifyListOfObserversWithCount(resourceHandle,
+                            observationIds.data(), observationIds.size(),
                             pl,
                             static_cast<OCQualityOfService>(QoS));
         OCRepPayloadDestroy(pl);
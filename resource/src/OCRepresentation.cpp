@@ -55,6 +55,12 @@ namespace OC
             case PAYLOAD_TYPE_REPRESENTATION:
                 setPayload(reinterpret_cast<const OCRepPayload*>(rep));
                 break;
+            case PAYLOAD_TYPE_ENCODED:
+                {
+                    const OCEncodedPayload* pl = reinterpret_cast<const OCEncodedPayload*>(rep);
+                    setEncodedPayload(pl->payload, pl->payloadSize);
+                }
+                break;
             default:
                 throw OC::OCException("Invalid Payload type in setPayload");
                 break;
@@ -70,7 +76,7 @@ namespace OC
             cur.setPayload(pl);
 
             pl = pl->next;
-            this->addRepresentation(cur);
+            this->addRepresentation(std::move(cur));
         }
     }
 
@@ -92,6 +98,17 @@ namespace OC
         return root;
     }
 
+    OCRepPayload* MessageContainer::createPayload(const OCRepresentation& rep)
+    {
+        OCRepPayload* root = rep.getPayload();
+        for(const auto& child : rep.getChildren())
+        {
+            OCRepPayloadAppend(root, child.getPayload());
+        }
+
+        return root;
+    }
+
     const std::vector<OCRepresentation>& MessageContainer::representations() const
     {
         return m_reps;
@@ -101,6 +118,18 @@ namespace OC
     {
         m_reps.push_back(rep);
     }
+
+    void MessageContainer::addRepresentation(OCRepresentation&& rep)
+    {
+        m_reps.push_back(std::move(rep));
+    }
+
+    std::vector<OCRepresentation> MessageContainer::releaseRepresentations()
+    {
+        std::vector<OCRepresentation> reps;
+        reps.swap(m_reps);
+        return reps;
+    }
 }
 
 namespace OC
@@ -567,6 +596,13 @@ namespace OC
             ll = ll->next;
         }
 
+        size_t count = 0;
+        for (const OCRepPayloadValue* v = pl->values; v; v = v->next)
+        {
+            ++count;
+        }
+        m_values.reserve(m_values.size() + count);
+
         OCRepPayloadValue* val = pl->values;
 
         while(val)
@@ -618,6 +654,11 @@ namespace OC
         m_children.push_back(rep);
     }
 
+    void OCRepresentation::addChild(OCRepresentation&& rep)
+    {
+        m_children.push_back(std::move(rep));
+    }
+
     void OCRepresentation::clearChildren()
     {
         m_children.clear();
@@ -633,6 +674,11 @@ namespace OC
         m_children = children;
     }
 
+    void OCRepresentation::setChildren(std::vector<OCRepresentation>&& children)
+    {
+        m_children = std::move(children);
+    }
+
     void OCRepresentation::setDevAddr(const OCDevAddr m_devAddr)
     {
         std::ostringstream ss;
@@ -844,7 +890,7 @@ namespace OC
 namespace OC
 {
     OCRepresentation::AttributeItem::AttributeItem(const std::string& name,
-            std::map<std::string, AttributeValue>& vals):
+            AttributeValueMap& vals):
             m_attrName(name), m_values(vals){}
 
     OCRepresentation::AttributeItem OCRepresentation::operator[](const std::string& key)
@@ -0,0 +1,917 @@
+//******************************************************************
+//
+// Copyright 2016 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+/**
+ * @file
+ *
+ * This file contains the direct OCRepresentation <-> CBOR codec used by
+ * MessageContainer.  It uses the wire format of OCConvertPayload() and
+ * OCParsePayload() for representation payloads, but skips the intermediate
+ * OCRepPayload tree.  Unlike OCConvertPayload() it keeps the href of a
+ * single representation and the shape of jagged arrays.  Encoded messages
+ * are handed to the stack as an OCEncodedPayload, which it sends verbatim.
+ */
+
+#include <OCRepresentation.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "cbor.h"
+#include "ocpayload.h"
+#include "oic_malloc.h"
+
+namespace OC
+{
+    namespace
+    {
+        // Same initial buffer size as OCConvertPayload
+        const size_t INIT_PAYLOAD_SIZE = 255;
+
+        int64_t encodeObject(CborEncoder* parent, const OCRepresentation& rep);
+
+        int64_t encodeArrayElement(CborEncoder* array, int item)
+        {
+            return cbor_encode_int(array, item);
+        }
+
+        int64_t encodeArrayElement(CborEncoder* array, double item)
+        {
+            return cbor_encode_double(array, item);
+        }
+
+        int64_t encodeArrayElement(CborEncoder* array, bool item)
+        {
+            return cbor_encode_boolean(array, item);
+        }
+
+        int64_t encodeArrayElement(CborEncoder* array, const std::string& item)
+        {
+            return cbor_encode_text_string(array, item.c_str(), item.length());
+        }
+
+        int64_t encodeArrayElement(CborEncoder* array, const OCByteString& item)
+        {
+            return item.len ? cbor_encode_byte_string(array, item.bytes, item.len)
+                            : cbor_encode_null(array);
+        }
+
+        int64_t encodeArrayElement(CborEncoder* array, const OCRepresentation& item)
+        {
+            return encodeObject(array, item);
+        }
+
+        template<typename T>
+        int64_t encodeArray(CborEncoder* parent, const std::vector<T>& arr);
+
+        template<typename T>
+        int64_t encodeArrayElement(CborEncoder* array, const std::vector<T>& item)
+        {
+            return encodeArray(array, item);
+        }
+
+        // Unlike OCRepPayload, which needs rectangular arrays, each row keeps
+        // its own length, so jagged arrays arrive with their original shape.
+        template<typename T>
+        int64_t encodeArray(CborEncoder* parent, const std::vector<T>& arr)
+        {
+            CborEncoder array;
+            int64_t err = cbor_encoder_create_array(parent, &array, arr.size());
+
+            for (const auto& item : arr)
+            {
+                err |= encodeArrayElement(&array, item);
+            }
+
+            err |= cbor_encoder_close_container(parent, &array);
+            return err;
+        }
+
+        struct encode_value_visitor : boost::static_visitor<int64_t>
+        {
+            explicit encode_value_visitor(CborEncoder* encoder) : m_encoder(encoder) {}
+
+            int64_t operator()(const NullType&) const
+            {
+                return cbor_encode_null(m_encoder);
+            }
+
+            int64_t operator()(int item) const
+            {
+                return cbor_encode_int(m_encoder, item);
+            }
+
+            int64_t operator()(double item) const
+            {
+                return cbor_encode_double(m_encoder, item);
+            }
+
+            int64_t operator()(bool item) const
+            {
+                return cbor_encode_boolean(m_encoder, item);
+            }
+
+            int64_t operator()(const std::string& item) const
+            {
+                return cbor_encode_text_string(m_encoder, item.c_str(), item.length());
+            }
+
+            int64_t operator()(const OCByteString& item) const
+            {
+                return cbor_encode_byte_string(m_encoder, item.bytes, item.len);
+            }
+
+            int64_t operator()(const OCRepresentation& item) const
+            {
+                return encodeObject(m_encoder, item);
+            }
+
+            int64_t operator()(const std::vector<uint8_t>& item) const
+            {
+                return cbor_encode_byte_string(m_encoder, item.data(), item.size());
+            }
+
+            template<typename T>
+            int64_t operator()(const std::vector<T>& item) const
+            {
+                return encodeArray(m_encoder, item);
+            }
+
+            CborEncoder* m_encoder;
+        };
+
+        int64_t encodeValues(CborEncoder* map, const OCRepresentation& rep)
+        {
+            int64_t err = CborNoError;
+            encode_value_visitor vis(map);
+
+            for (const auto& value : rep.getValues())
+            {
+                err |= cbor_encode_text_string(map, value.first.c_str(), value.first.length());
+                err |= boost::apply_visitor(vis, value.second);
+                if (err != CborNoError && err != CborErrorOutOfMemory)
+                {
+                    break;
+                }
+            }
+            return err;
+        }
+
+        int64_t encodeObject(CborEncoder* parent, const OCRepresentation& rep)
+        {
+            const AttributeValueMap& values = rep.getValues();
+            CborEncoder encoder;
+            int64_t err = CborNoError;
+
+            // Like OCConvertRepMap, send objects whose attribute names are
+            // consecutive non-negative integers as an array.
+            size_t arrayLength = 0;
+            auto it = values.begin();
+            for (; it != values.end(); ++it)
+            {
+                char* endp;
+                long i = strtol(it->first.c_str(), &endp, 0);
+                if (*endp != '\0' || i < 0 || arrayLength != static_cast<size_t>(i))
+                {
+                    break;
+                }
+                ++arrayLength;
+            }
+
+            if (it != values.end())
+            {
+                err |= cbor_encoder_create_map(parent, &encoder, CborIndefiniteLength);
+                err |= encodeValues(&encoder, rep);
+            }
+            else
+            {
+                encode_value_visitor vis(&encoder);
+                err |= cbor_encoder_create_array(parent, &encoder, arrayLength);
+                for (const auto& value : values)
+                {
+                    err |= boost::apply_visitor(vis, value.second);
+                }
+            }
+            err |= cbor_encoder_close_container(parent, &encoder);
+            return err;
+        }
+
+        int64_t encodeStringList(CborEncoder* map, const char* key,
+                const std::vector<std::string>& list)
+        {
+            if (list.empty())
+            {
+                return CborNoError;
+            }
+
+            CborEncoder array;
+            int64_t err = cbor_encode_text_string(map, key, strlen(key));
+            err |= cbor_encoder_create_array(map, &array, list.size());
+            for (const std::string& item : list)
+            {
+                err |= cbor_encode_text_string(&array, item.c_str(), item.length());
+            }
+            err |= cbor_encoder_close_container(map, &array);
+            return err;
+        }
+
+        int64_t encodeRoot(CborEncoder* parent, const OCRepresentation& rep)
+        {
+            CborEncoder rootMap;
+            int64_t err = cbor_encoder_create_map(parent, &rootMap, CborIndefiniteLength);
+
+            // OCParsePayload reads href for single representations as well
+            if (!rep.getUri().empty())
+            {
+                const std::string uri = rep.getUri();
+                err |= cbor_encode_text_string(&rootMap, OC_RSRVD_HREF,
+                        sizeof(OC_RSRVD_HREF) - 1);
+                err |= cbor_encode_text_string(&rootMap, uri.c_str(), uri.length());
+            }
+            err |= encodeStringList(&rootMap, OC_RSRVD_RESOURCE_TYPE, rep.getResourceTypes());
+            err |= encodeStringList(&rootMap, OC_RSRVD_INTERFACE, rep.getResourceInterfaces());
+            err |= encodeValues(&rootMap, rep);
+
+            err |= cbor_encoder_close_container(parent, &rootMap);
+            return err;
+        }
+
+        int64_t encodeMessage(const std::vector<const OCRepresentation*>& reps,
+                uint8_t* outPayload, size_t* size)
+        {
+            CborEncoder encoder;
+            int64_t err = CborNoError;
+
+            cbor_encoder_init(&encoder, outPayload, *size, 0);
+
+            if (reps.size() == 1)
+            {
+                err |= encodeRoot(&encoder, *reps.front());
+            }
+            else
+            {
+                CborEncoder rootArray;
+                err |= cbor_encoder_create_array(&encoder, &rootArray, reps.size());
+                for (const OCRepresentation* rep : reps)
+                {
+                    err |= encodeRoot(&rootArray, *rep);
+                }
+                err |= cbor_encoder_close_container(&encoder, &rootArray);
+            }
+
+            if (err == CborErrorOutOfMemory)
+            {
+                *size += cbor_encoder_get_extra_bytes_needed(&encoder);
+            }
+            else if (err == CborNoError)
+            {
+                *size = cbor_encoder_get_buffer_size(&encoder, outPayload);
+            }
+            return err;
+        }
+
+        OCPayload* encodeRepresentations(const std::vector<const OCRepresentation*>& reps)
+        {
+            size_t size = INIT_PAYLOAD_SIZE;
+            uint8_t* out = static_cast<uint8_t*>(OICMalloc(size));
+            if (!out)
+            {
+                throw std::bad_alloc();
+            }
+
+            int64_t err = encodeMessage(reps, out, &size);
+            while (err == CborErrorOutOfMemory)
+            {
+                uint8_t* out2 = static_cast<uint8_t*>(OICRealloc(out, size));
+                if (!out2)
+                {
+                    OICFree(out);
+                    throw std::bad_alloc();
+                }
+                out = out2;
+                err = encodeMessage(reps, out, &size);
+            }
+
+            if (err != CborNoError)
+            {
+                OICFree(out);
+                throw OCException("Failed to encode representation", OC_STACK_ERROR);
+            }
+
+            OCEncodedPayload* payload = OCEncodedPayloadCreateAsOwner(out, size);
+            if (!payload)
+            {
+                OICFree(out);
+                throw std::bad_alloc();
+            }
+
+            return reinterpret_cast<OCPayload*>(payload);
+        }
+    }
+
+    OCPayload* MessageContainer::getEncodedPayload() const
+    {
+        std::vector<const OCRepresentation*> reps;
+        reps.reserve(m_reps.size());
+        for (const OCRepresentation& rep : m_reps)
+        {
+            reps.push_back(&rep);
+        }
+
+        return reps.empty() ? nullptr : encodeRepresentations(reps);
+    }
+
+    OCPayload* MessageContainer::encodePayload(const OCRepresentation& rep)
+    {
+        std::vector<const OCRepresentation*> reps;
+        reps.reserve(rep.getChildren().size() + 1);
+        reps.push_back(&rep);
+        for (const OCRepresentation& child : rep.getChildren())
+        {
+            reps.push_back(&child);
+        }
+
+        return encodeRepresentations(reps);
+    }
+}
+
+namespace OC
+{
+    namespace
+    {
+        enum class ArrayType
+        {
+            Null,
+            Integer,
+            Double,
+            Boolean,
+            String,
+            ByteString,
+            Object,
+            Array
+        };
+
+        ArrayType decodeArrayType(CborType type)
+        {
+            switch (type)
+            {
+                case CborIntegerType:
+                    return ArrayType::Integer;
+                case CborDoubleType:
+                case CborFloatType:
+                    return ArrayType::Double;
+                case CborBooleanType:
+                    return ArrayType::Boolean;
+                case CborTextStringType:
+                    return ArrayType::String;
+                case CborByteStringType:
+                    return ArrayType::ByteString;
+                case CborMapType:
+                    return ArrayType::Object;
+                case CborArrayType:
+                    return ArrayType::Array;
+                default:
+                    return ArrayType::Null;
+            }
+        }
+
+        CborError decodeObject(CborValue* value, OCRepresentation& rep);
+
+        CborError decodeString(CborValue* value, std::string& out)
+        {
+            size_t len = 0;
+            CborError err = cbor_value_calculate_string_length(value, &len);
+            if (err != CborNoError)
+            {
+                return err;
+            }
+
+            // tinycbor appends a terminator when there is room for one
+            out.resize(len + 1);
+            len = out.size();
+            err = cbor_value_copy_text_string(value, &out[0], &len, nullptr);
+            if (err != CborNoError)
+            {
+                return err;
+            }
+            out.resize(len);
+
+            return cbor_value_advance(value);
+        }
+
+        CborError decodeByteString(CborValue* value, std::vector<uint8_t>& out)
+        {
+            size_t len = 0;
+            CborError err = cbor_value_calculate_string_length(value, &len);
+            if (err != CborNoError)
+            {
+                return err;
+            }
+
+            out.resize(len + 1);
+            len = out.size();
+            err = cbor_value_copy_byte_string(value, out.data(), &len, nullptr);
+            if (err != CborNoError)
+            {
+                return err;
+            }
+            out.resize(len);
+
+            return cbor_value_advance(value);
+        }
+
+        CborError decodeArrayItem(CborValue* value, int& out)
+        {
+            if (!cbor_value_is_integer(value))
+            {
+                return CborErrorIllegalType;
+            }
+            int64_t intval = 0;
+            CborError err = cbor_value_get_int64(value, &intval);
+            out = static_cast<int>(intval);
+            return err != CborNoError ? err : cbor_value_advance_fixed(value);
+        }
+
+        CborError decodeArrayItem(CborValue* value, double& out)
+        {
+            CborError err;
+            if (cbor_value_is_double(value))
+            {
+                err = cbor_value_get_double(value, &out);
+            }
+            else if (!cbor_value_is_float(value))
+            {
+                return CborErrorIllegalType;
+            }
+            else
+            {
+                float f = 0;
+                err = cbor_value_get_float(value, &f);
+                out = f;
+            }
+            return err != CborNoError ? err : cbor_value_advance_fixed(value);
+        }
+
+        CborError decodeArrayItem(CborValue* value, bool& out)
+        {
+            if (!cbor_value_is_boolean(value))
+            {
+                return CborErrorIllegalType;
+            }
+            CborError err = cbor_value_get_boolean(value, &out);
+            return err != CborNoError ? err : cbor_value_advance_fixed(value);
+        }
+
+        CborError decodeArrayItem(CborValue* value, std::string& out)
+        {
+            if (!cbor_value_is_text_string(value))
+            {
+                return CborErrorIllegalType;
+            }
+            return decodeString(value, out);
+        }
+
+        CborError decodeArrayItem(CborValue* value, OCRepresentation& out)
+        {
+            return decodeObject(value, out);
+        }
+
+        // Null entries keep their default value, like the zero-filled arrays
+        // of OCParsePayload. Rows keep the length they were sent with.
+        template<typename T>
+        CborError fillArray(const CborValue* array, std::vector<T>& out)
+        {
+            size_t length = 0;
+            CborError err = cbor_value_get_array_length(array, &length);
+            if (err == CborNoError)
+            {
+                out.reserve(length);
+            }
+
+            CborValue item;
+            err = cbor_value_enter_container(array, &item);
+
+            while (err == CborNoError && cbor_value_is_valid(&item))
+            {
+                // a temporary, since std::vector<bool> does not hand out bool&
+                T val = T();
+                if (cbor_value_is_null(&item))
+                {
+                    err = cbor_value_advance(&item);
+                }
+                else
+                {
+                    err = decodeArrayItem(&item, val);
+                }
+                out.push_back(std::move(val));
+            }
+            return err;
+        }
+
+        template<typename T>
+        CborError fillArray(const CborValue* array, std::vector<std::vector<T>>& out)
+        {
+            CborValue item;
+            CborError err = cbor_value_enter_container(array, &item);
+
+            while (err == CborNoError && cbor_value_is_valid(&item))
+            {
+                out.emplace_back();
+                if (cbor_value_is_array(&item))
+                {
+                    err = fillArray(&item, out.back());
+                }
+                else if (!cbor_value_is_null(&item))
+                {
+                    return CborErrorIllegalType;
+                }
+
+                if (err == CborNoError)
+                {
+                    err = cbor_value_advance(&item);
+                }
+            }
+            return err;
+        }
+
+        CborError findArrayDimensions(const CborValue* array,
+                size_t dimensions[MAX_REP_ARRAY_DEPTH], ArrayType* type)
+        {
+            CborValue item;
+            *type = ArrayType::Null;
+            dimensions[0] = dimensions[1] = dimensions[2] = 0;
+
+            CborError err = cbor_value_enter_container(array, &item);
+
+            while (err == CborNoError && cbor_value_is_valid(&item))
+            {
+                ArrayType itemType = decodeArrayType(cbor_value_get_type(&item));
+
+                if (itemType == ArrayType::Array)
+                {
+                    size_t subdim[MAX_REP_ARRAY_DEPTH];
+                    err = findArrayDimensions(&item, subdim, &itemType);
+                    if (err != CborNoError)
+                    {
+                        return err;
+                    }
+                    if (subdim[2] != 0)
+                    {
+                        return CborErrorNestingTooDeep;
+                    }
+
+                    dimensions[1] = std::max(dimensions[1], subdim[0]);
+                    dimensions[2] = std::max(dimensions[2], subdim[1]);
+                }
+
+                if (*type == ArrayType::Null)
+                {
+                    *type = itemType;
+                }
+                else if (itemType != ArrayType::Null && *type != itemType)
+                {
+                    // mixed arrays are decoded as objects by the caller
+                    return CborUnknownError;
+                }
+
+                ++dimensions[0];
+                err = cbor_value_advance(&item);
+            }
+            return err;
+        }
+
+        template<typename T>
+        CborError decodeTypedArray(const CborValue* array, const size_t* dimensions,
+                OCRepresentation& rep, const std::string& name)
+        {
+            CborError err;
+            if (dimensions[1] == 0)
+            {
+                std::vector<T> val;
+                err = fillArray(array, val);
+                if (err == CborNoError)
+                {
+                    rep.setValue(name, std::move(val));
+                }
+            }
+            else if (dimensions[2] == 0)
+            {
+                std::vector<std::vector<T>> val;
+                err = fillArray(array, val);
+                if (err == CborNoError)
+                {
+                    rep.setValue(name, std::move(val));
+                }
+            }
+            else
+            {
+                std::vector<std::vector<std::vector<T>>> val;
+                err = fillArray(array, val);
+                if (err == CborNoError)
+                {
+                    rep.setValue(name, std::move(val));
+                }
+            }
+            return err;
+        }
+
+        CborError decodeArray(CborValue* array, OCRepresentation& rep, const std::string& name)
+        {
+            size_t dimensions[MAX_REP_ARRAY_DEPTH];
+            ArrayType type = ArrayType::Null;
+
+            CborError err = findArrayDimensions(array, dimensions, &type);
+            if (err == CborUnknownError)
+            {
+                OCRepresentation val;
+                err = decodeObject(array, val);
+                if (err == CborNoError)
+                {
+                    rep.setValue(name, std::move(val));
+                }
+                return err;
+            }
+            else if (err != CborNoError)
+            {
+                return err;
+            }
+
+            switch (type)
+            {
+                case ArrayType::Null:
+                    rep.setNULL(name);
+                    break;
+                case ArrayType::Integer:
+                    err = decodeTypedArray<int>(array, dimensions, rep, name);
+                    break;
+                case ArrayType::Double:
+                    err = decodeTypedArray<double>(array, dimensions, rep, name);
+                    break;
+                case ArrayType::Boolean:
+                    err = decodeTypedArray<bool>(array, dimensions, rep, name);
+                    break;
+                case ArrayType::String:
+                    err = decodeTypedArray<std::string>(array, dimensions, rep, name);
+                    break;
+                case ArrayType::Object:
+                    err = decodeTypedArray<OCRepresentation>(array, dimensions, rep, name);
+                    break;
+                default:
+                    // OCByteString does not own its bytes, so byte string arrays
+                    // can only be delivered through OCRepPayload.
+                    return CborErrorUnsupportedType;
+            }
+
+            return err != CborNoError ? err : cbor_value_advance(array);
+        }
+
+        CborError decodeValue(CborValue* value, OCRepresentation& rep, const std::string& name)
+        {
+            CborError err = CborNoError;
+
+            switch (cbor_value_get_type(value))
+            {
+                case CborNullType:
+                    rep.setNULL(name);
+                    err = cbor_value_advance_fixed(value);
+                    break;
+                case CborIntegerType:
+                    {
+                        int val = 0;
+                        err = decodeArrayItem(value, val);
+                        rep.setValue(name, val);
+                    }
+                    break;
+                case CborDoubleType:
+                case CborFloatType:
+                    {
+                        double val = 0;
+                        err = decodeArrayItem(value, val);
+                        rep.setValue(name, val);
+                    }
+                    break;
+                case CborBooleanType:
+                    {
+                        bool val = false;
+                        err = decodeArrayItem(value, val);
+                        rep.setValue(name, val);
+                    }
+                    break;
+                case CborTextStringType:
+                    {
+                        std::string val;
+                        err = decodeString(value, val);
+                        rep.setValue(name, std::move(val));
+                    }
+                    break;
+                case CborByteStringType:
+                    {
+                        std::vector<uint8_t> val;
+                        err = decodeByteString(value, val);
+                        rep.setValue(name, std::move(val));
+                    }
+                    break;
+                case CborMapType:
+                    {
+                        OCRepresentation val;
+                        err = decodeObject(value, val);
+                        rep.setValue(name, std::move(val));
+                    }
+                    break;
+                case CborArrayType:
+                    err = decodeArray(value, rep, name);
+                    break;
+                default:
+                    err = CborErrorUnknownType;
+                    break;
+            }
+            return err;
+        }
+
+        CborError decodeObject(CborValue* value, OCRepresentation& rep)
+        {
+            if (!cbor_value_is_map(value) && !cbor_value_is_array(value))
+            {
+                return CborErrorIllegalType;
+            }
+
+            const bool isMap = cbor_value_is_map(value);
+            CborValue item;
+            CborError err = cbor_value_enter_container(value, &item);
+            std::string name;
+
+            for (size_t index = 0; err == CborNoError && cbor_value_is_valid(&item); ++index)
+            {
+                if (isMap)
+                {
+                    if (!cbor_value_is_text_string(&item))
+                    {
+                        return CborErrorIllegalType;
+                    }
+                    err = decodeString(&item, name);
+                }
+                else
+                {
+                    name = std::to_string(index);
+                }
+
+                if (err == CborNoError)
+                {
+                    err = decodeValue(&item, rep, name);
+                }
+            }
+
+            return err != CborNoError ? err : cbor_value_leave_container(value, &item);
+        }
+
+        CborError decodeStringList(CborValue* value, std::vector<std::string>& out)
+        {
+            if (!cbor_value_is_array(value))
+            {
+                return cbor_value_advance(value);
+            }
+
+            CborValue item;
+            CborError err = cbor_value_enter_container(value, &item);
+            std::string str;
+
+            while (err == CborNoError && cbor_value_is_text_string(&item))
+            {
+                err = decodeString(&item, str);
+
+                // Like OCParsePayload, split space separated lists and trim them
+                size_t pos = 0;
+                while (err == CborNoError && pos < str.length())
+                {
+                    size_t start = str.find_first_not_of(' ', pos);
+                    if (start == std::string::npos)
+                    {
+                        break;
+                    }
+                    size_t end = str.find(' ', start);
+                    if (end == std::string::npos)
+                    {
+                        end = str.length();
+                    }
+                    out.push_back(str.substr(start, end - start));
+                    pos = end;
+                }
+            }
+
+            return err != CborNoError ? err : cbor_value_advance(value);
+        }
+
+        CborError decodeRoot(CborValue* value, OCRepresentation& rep)
+        {
+            CborValue item;
+            CborError err = cbor_value_enter_container(value, &item);
+            std::string name;
+
+            while (err == CborNoError && cbor_value_is_valid(&item))
+            {
+                if (!cbor_value_is_text_string(&item))
+                {
+                    return CborErrorIllegalType;
+                }
+                err = decodeString(&item, name);
+                if (err != CborNoError)
+                {
+                    break;
+                }
+
+                if (name == OC_RSRVD_HREF)
+                {
+                    std::string uri;
+                    if (!cbor_value_is_text_string(&item))
+                    {
+                        return CborErrorIllegalType;
+                    }
+                    err = decodeString(&item, uri);
+                    rep.setUri(uri);
+                }
+                else if (name == OC_RSRVD_RESOURCE_TYPE)
+                {
+                    std::vector<std::string> types;
+                    err = decodeStringList(&item, types);
+                    rep.setResourceTypes(types);
+                }
+                else if (name == OC_RSRVD_INTERFACE)
+                {
+                    std::vector<std::string> interfaces;
+                    err = decodeStringList(&item, interfaces);
+                    rep.setResourceInterfaces(interfaces);
+                }
+                else
+                {
+                    err = decodeValue(&item, rep, name);
+                }
+            }
+
+            return err != CborNoError ? err : cbor_value_leave_container(value, &item);
+        }
+    }
+
+    void MessageContainer::setEncodedPayload(const uint8_t* payload, size_t size)
+    {
+        if (!payload || size == 0)
+        {
+            return;
+        }
+
+        CborParser parser;
+        CborValue root;
+        CborError err = cbor_parser_init(payload, size, 0, &parser, &root);
+
+        CborValue rootMap = root;
+        if (err == CborNoError && cbor_value_is_array(&root))
+        {
+            err = cbor_value_enter_container(&root, &rootMap);
+        }
+
+        while (err == CborNoError && cbor_value_is_valid(&rootMap))
+        {
+            OCRepresentation cur;
+            if (cbor_value_is_map(&rootMap))
+            {
+                err = decodeRoot(&rootMap, cur);
+            }
+            else if (cbor_value_is_array(&rootMap))
+            {
+                err = cbor_value_advance(&rootMap);
+            }
+            else
+            {
+                err = CborErrorIllegalType;
+            }
+
+            if (err == CborNoError)
+            {
+                m_reps.push_back(std::move(cur));
+            }
+        }
+
+        if (err != CborNoError)
+        {
+            throw OCException(std::string("Failed to decode representation: ") +
+                    cbor_error_string(err), OC_STACK_MALFORMED_RESPONSE);
+        }
+    }
+}
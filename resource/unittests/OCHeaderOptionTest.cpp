@@ -49,8 +49,10 @@ namespace OC
                 for(uint16_t i = 0; i < HeaderOption::MIN_HEADER_OPTIONID; ++i)
                 {
                     if (HeaderOption::IF_MATCH_OPTION_ID != i
+                            && HeaderOption::ETAG_OPTION_ID != i
                             && HeaderOption::IF_NONE_MATCH_OPTION_ID != i
                             && HeaderOption::LOCATION_PATH_OPTION_ID != i
+                            && HeaderOption::MAX_AGE_OPTION_ID != i
                             && HeaderOption::LOCATION_QUERY_OPTION_ID != i)
                     {
                         ASSERT_THROW(
@@ -83,6 +85,17 @@ namespace OC
                 EXPECT_EQ(optionData, opt.getOptionData());
             }
 
+            TEST(OCHeaderOptionTest, BinaryOptionDataTest)
+            {
+                std::string etag {"\x01\x00\x7f", 3};
+                HeaderOption::OCHeaderOption opt {HeaderOption::ETAG_OPTION_ID, etag};
+                EXPECT_EQ(HeaderOption::ETAG_OPTION_ID, opt.getOptionID());
+                EXPECT_EQ(etag, opt.getOptionData());
+
+                EXPECT_NO_THROW(HeaderOption::OCHeaderOption(HeaderOption::MAX_AGE_OPTION_ID,
+                                                             std::string{"\x3c", 1}));
+            }
+
         } //namespace OCHeaderOptionTests
     } //namespace test
 } //namespace OC
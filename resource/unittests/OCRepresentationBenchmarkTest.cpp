@@ -0,0 +1,224 @@
+//******************************************************************
+//
+// Copyright 2016 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <gtest/gtest.h>
+#include <OCApi.h>
+#include <OCRepresentation.h>
+#include <OCResourceResponse.h>
+#include <ocpayload.h>
+#include <ocpayloadcbor.h>
+#include <oic_malloc.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+// Counts C++ heap allocations so the two encoding paths can be compared.
+// The OCRepPayload tree is allocated through OICMalloc and is not counted, so
+// the numbers understate what the payload path really costs.
+namespace
+{
+    std::atomic<size_t> g_allocations(0);
+}
+
+void* operator new(std::size_t size)
+{
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+namespace OCRepresentationBenchmarkTest
+{
+    const int ITERATIONS = 1000;
+
+    OC::OCRepresentation makeMessage()
+    {
+        OC::OCRepresentation rep;
+        rep.setUri("/a/light");
+        rep.addResourceType("core.light");
+        rep.addResourceInterface("oic.if.baseline");
+        rep["power"] = 42;
+        rep["state"] = true;
+        rep["name"] = std::string("living room");
+        rep["levels"] = std::vector<int>(32, 7);
+        rep["matrix"] = std::vector<std::vector<double>>(8, std::vector<double>(8, 0.5));
+        return rep;
+    }
+
+    // OCRepresentation -> OCRepPayload -> CBOR -> OCRepPayload -> OCRepresentation
+    size_t runPayloadPath(const OC::OCRepresentation& rep)
+    {
+        size_t before = g_allocations;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            OC::MessageContainer out;
+            out.addRepresentation(rep);
+            OCRepPayload* payload = out.getPayload();
+
+            uint8_t* cborData = nullptr;
+            size_t cborSize = 0;
+            EXPECT_EQ(OC_STACK_OK, OCConvertPayload((OCPayload*)payload, &cborData, &cborSize));
+            OCPayloadDestroy((OCPayload*)payload);
+
+            OCPayload* parsed = nullptr;
+            EXPECT_EQ(OC_STACK_OK, OCParsePayload(&parsed, PAYLOAD_TYPE_REPRESENTATION,
+                        cborData, cborSize));
+            OICFree(cborData);
+
+            OC::MessageContainer in;
+            in.setPayload(parsed);
+            OCPayloadDestroy(parsed);
+        }
+        return g_allocations - before;
+    }
+
+    // OCRepresentation -> CBOR -> OCRepresentation
+    size_t runDirectPath(const OC::OCRepresentation& rep)
+    {
+        size_t before = g_allocations;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            OCPayload* encoded = OC::MessageContainer::encodePayload(rep);
+            EXPECT_NE(nullptr, encoded);
+
+            OC::MessageContainer in;
+            in.setPayload(encoded);
+            OCPayloadDestroy(encoded);
+        }
+        return g_allocations - before;
+    }
+
+    template <typename Map>
+    size_t runAttributeAccess(const std::vector<std::string>& names)
+    {
+        size_t before = g_allocations;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            Map values;
+            for (const auto& name : names)
+            {
+                values[name] = i;
+            }
+            for (const auto& name : names)
+            {
+                EXPECT_NE(values.end(), values.find(name));
+            }
+            for (const auto& value : values)
+            {
+                EXPECT_EQ(i, boost::get<int>(value.second));
+            }
+        }
+        return g_allocations - before;
+    }
+
+    TEST(RepresentationBenchmark, FlatAttributeStorage)
+    {
+        for (size_t count : {5, 15, 30})
+        {
+            std::vector<std::string> names;
+            for (size_t i = 0; i < count; ++i)
+            {
+                names.push_back("attr" + std::to_string(count - i));
+            }
+
+            size_t tree = runAttributeAccess<std::map<std::string, OC::AttributeValue>>(names);
+            size_t flat = runAttributeAccess<OC::AttributeValueMap>(names);
+
+            EXPECT_LT(flat, tree);
+        }
+    }
+
+    TEST(RepresentationBenchmark, DirectCodecAllocatesLess)
+    {
+        OC::OCRepresentation rep = makeMessage();
+
+        size_t payloadPath = runPayloadPath(rep);
+        size_t directPath = runDirectPath(rep);
+
+        EXPECT_LT(directPath, payloadPath);
+    }
+
+    TEST(RepresentationBenchmark, ResponseTakesRepresentationByMove)
+    {
+        size_t before = g_allocations;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            OC::OCRepresentation rep = makeMessage();
+            OC::OCResourceResponse response;
+            response.setResourceRepresentation(rep, OC::DEFAULT_INTERFACE);
+        }
+        size_t copied = g_allocations - before;
+
+        before = g_allocations;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            OC::OCRepresentation rep = makeMessage();
+            OC::OCResourceResponse response;
+            response.setResourceRepresentation(std::move(rep), OC::DEFAULT_INTERFACE);
+        }
+        size_t moved = g_allocations - before;
+
+        EXPECT_LT(moved, copied);
+    }
+
+    TEST(RepresentationBenchmark, RequestTakesRepresentationsFromContainer)
+    {
+        OC::MessageContainer out;
+        out.addRepresentation(makeMessage());
+        out.addRepresentation(makeMessage());
+        OCRepPayload* payload = out.getPayload();
+
+        size_t before = g_allocations;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            OC::MessageContainer in;
+            in.setPayload(payload);
+            OC::OCRepresentation root = in.representations()[0];
+            root.addChild(in.representations()[1]);
+        }
+        size_t copied = g_allocations - before;
+
+        before = g_allocations;
+        for (int i = 0; i < ITERATIONS; ++i)
+        {
+            OC::MessageContainer in;
+            in.setPayload(payload);
+            std::vector<OC::OCRepresentation> reps = in.releaseRepresentations();
+            OC::OCRepresentation root = std::move(reps[0]);
+            root.addChild(std::move(reps[1]));
+        }
+        size_t moved = g_allocations - before;
+        OCPayloadDestroy((OCPayload*)payload);
+
+        EXPECT_LT(moved, copied);
+    }
+}
@@ -1627,4 +1627,149 @@ namespace OCRepresentationEncodingTest
         OCRepPayloadDestroy(repPayload);
         OCPayloadDestroy(cparsed);
     }
+
+    // Direct OCRepresentation<->CBOR codec, bypassing OCRepPayload
+    // Nested representations carry no href on either path, so subRep has no uri.
+    OC::OCRepresentation makeCodecRepresentation()
+    {
+        OC::OCRepresentation subRep;
+        subRep["intAttr"] = 5;
+        subRep["stringAttr"] = std::string("sub string");
+
+        OC::OCRepresentation rep;
+        rep.setUri("/this/is/a/uri");
+        rep.addResourceType("core.light");
+        rep.addResourceType("core.brightlight");
+        rep.addResourceInterface("oic.if.baseline");
+        rep["boolAttr"] = true;
+        rep["intAttr"] = 77;
+        rep["doubleAttr"] = 3.25;
+        rep["stringAttr"] = std::string("string attr");
+        rep.setNULL("nullAttr");
+        rep["repAttr"] = subRep;
+        rep["intArr"] = std::vector<int>{1, 2, 3, 4};
+        rep["stringArr"] = std::vector<std::string>{"a", "bb", "ccc"};
+        rep["jaggedArr"] = std::vector<std::vector<double>>{{1.5, 2.5}, {3.5}};
+        rep["repArr"] = std::vector<OC::OCRepresentation>{subRep, subRep};
+        return rep;
+    }
+
+    TEST(DirectCodec, RoundTrip)
+    {
+        OC::OCRepresentation startRep = makeCodecRepresentation();
+
+        OCPayload* encoded = OC::MessageContainer::encodePayload(startRep);
+        ASSERT_NE(nullptr, encoded);
+        EXPECT_EQ(PAYLOAD_TYPE_ENCODED, encoded->type);
+
+        OC::MessageContainer mc;
+        mc.setPayload(encoded);
+        OCPayloadDestroy(encoded);
+
+        ASSERT_EQ(1u, mc.representations().size());
+        const OC::OCRepresentation& r = mc.representations()[0];
+        EXPECT_EQ(startRep.getUri(), r.getUri());
+        EXPECT_EQ(startRep.getResourceTypes(), r.getResourceTypes());
+        EXPECT_EQ(startRep.getResourceInterfaces(), r.getResourceInterfaces());
+        EXPECT_TRUE(r.getValue<bool>("boolAttr"));
+        EXPECT_EQ(77, r.getValue<int>("intAttr"));
+        EXPECT_EQ(3.25, r.getValue<double>("doubleAttr"));
+        EXPECT_EQ("string attr", r.getValue<std::string>("stringAttr"));
+        EXPECT_TRUE(r.isNULL("nullAttr"));
+        EXPECT_EQ(5, r.getValue<OC::OCRepresentation>("repAttr").getValue<int>("intAttr"));
+        EXPECT_EQ((std::vector<int>{1, 2, 3, 4}), r.getValue<std::vector<int>>("intArr"));
+        EXPECT_EQ((std::vector<std::string>{"a", "bb", "ccc"}),
+                r.getValue<std::vector<std::string>>("stringArr"));
+        EXPECT_EQ((std::vector<std::vector<double>>{{1.5, 2.5}, {3.5}}),
+                r.getValue<std::vector<std::vector<double>>>("jaggedArr"));
+        EXPECT_EQ(2u, r.getValue<std::vector<OC::OCRepresentation>>("repArr").size());
+        EXPECT_EQ(startRep, r);
+    }
+
+    TEST(DirectCodec, RoundTripCollection)
+    {
+        OC::OCRepresentation startRep = makeCodecRepresentation();
+        OC::OCRepresentation child;
+        child.setUri("/this/is/a/child/uri");
+        child["intAttr"] = 6;
+        startRep.addChild(child);
+
+        OCPayload* encoded = OC::MessageContainer::encodePayload(startRep);
+        ASSERT_NE(nullptr, encoded);
+
+        OC::MessageContainer mc;
+        mc.setPayload(encoded);
+        OCPayloadDestroy(encoded);
+
+        ASSERT_EQ(2u, mc.representations().size());
+        startRep.clearChildren();
+        EXPECT_EQ(startRep, mc.representations()[0]);
+        EXPECT_EQ(child, mc.representations()[1]);
+    }
+
+    TEST(DirectCodec, EncodedIsReadableByStack)
+    {
+        OC::OCRepresentation startRep = makeCodecRepresentation();
+
+        OCPayload* encoded = OC::MessageContainer::encodePayload(startRep);
+        ASSERT_NE(nullptr, encoded);
+        OCEncodedPayload* enc = reinterpret_cast<OCEncodedPayload*>(encoded);
+
+        OCPayload* cparsed = nullptr;
+        EXPECT_EQ(OC_STACK_OK, OCParsePayload(&cparsed, PAYLOAD_TYPE_REPRESENTATION,
+                    enc->payload, enc->payloadSize));
+        OCPayloadDestroy(encoded);
+
+        OC::MessageContainer mc;
+        mc.setPayload(cparsed);
+        OCPayloadDestroy(cparsed);
+
+        ASSERT_EQ(1u, mc.representations().size());
+        OC::OCRepresentation r = mc.representations()[0];
+
+        // OCRepPayload arrays are rectangular, so the jagged row gets backfilled
+        EXPECT_EQ((std::vector<std::vector<double>>{{1.5, 2.5}, {3.5, 0}}),
+                r.getValue<std::vector<std::vector<double>>>("jaggedArr"));
+        r.erase("jaggedArr");
+        startRep.erase("jaggedArr");
+        EXPECT_EQ(startRep, r);
+    }
+
+    TEST(DirectCodec, StackEncodedIsReadable)
+    {
+        OC::OCRepresentation startRep = makeCodecRepresentation();
+
+        OC::MessageContainer mc1;
+        mc1.addRepresentation(startRep);
+        OCRepPayload* cstart = mc1.getPayload();
+
+        uint8_t* cborData;
+        size_t cborSize;
+        EXPECT_EQ(OC_STACK_OK, OCConvertPayload((OCPayload*)cstart, &cborData, &cborSize));
+        OCPayloadDestroy((OCPayload*)cstart);
+
+        OC::MessageContainer mc2;
+        mc2.setEncodedPayload(cborData, cborSize);
+        OICFree(cborData);
+
+        ASSERT_EQ(1u, mc2.representations().size());
+        OC::OCRepresentation r = mc2.representations()[0];
+
+        // OCConvertPayload sends no href for a single representation and
+        // backfills jagged arrays
+        EXPECT_TRUE(r.getUri().empty());
+        EXPECT_EQ((std::vector<std::vector<double>>{{1.5, 2.5}, {3.5, 0}}),
+                r.getValue<std::vector<std::vector<double>>>("jaggedArr"));
+        r.erase("jaggedArr");
+        startRep.erase("jaggedArr");
+        startRep.setUri(std::string());
+        EXPECT_EQ(startRep, r);
+    }
+
+    TEST(DirectCodec, MalformedThrows)
+    {
+        const uint8_t garbage[] = { 0xff, 0x01, 0x02 };
+        OC::MessageContainer mc;
+        EXPECT_THROW(mc.setEncodedPayload(garbage, sizeof(garbage)), OC::OCException);
+    }
 }
@@ -1448,6 +1448,31 @@ namespace OCRepresentationTest
         }
     }
 
+    TEST(OCRepresentationIterator, NameOrderIndependentOfInsertion)
+    {
+        OCRepresentation rep;
+        rep["zeta"] = 1;
+        rep["alpha"] = 2;
+        rep["mu"] = 3;
+        rep["beta"] = 4;
+        rep["alpha"] = 5;
+
+        std::vector<std::string> names;
+        for (const auto& cur : rep)
+        {
+            names.push_back(cur.attrname());
+        }
+
+        EXPECT_EQ((std::vector<std::string>{"alpha", "beta", "mu", "zeta"}), names);
+        EXPECT_EQ(5, rep.getValue<int>("alpha"));
+
+        EXPECT_TRUE(rep.erase("mu"));
+        EXPECT_FALSE(rep.erase("mu"));
+        EXPECT_EQ(3, rep.numberOfAttributes());
+        EXPECT_EQ(1, rep.getValue<int>("zeta"));
+        EXPECT_FALSE(rep.hasAttribute("mu"));
+    }
+
     TEST(OCRepresentationHostTest, ValidHost)
     {
         OCDevAddr addr = {OC_DEFAULT_ADAPTER, OC_IP_USE_V6};
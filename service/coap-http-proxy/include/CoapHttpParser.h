@@ -50,6 +50,7 @@ extern "C"
 #define HTTP_OPTION_CONTENT_TYPE    "content-type"
 #define HTTP_OPTION_CONTENT_LENGTH  "content-length"
 #define HTTP_OPTION_EXPIRES         "expires"
+#define HTTP_OPTION_AUTHORIZATION   "authorization"
 
 /**
  * @enum HttpResponseResult_t
@@ -126,6 +127,7 @@ typedef struct HttpResponse_t
     char dataFormat[CHP_MAX_HF_DATA_LENGTH];
     void *payload;
     size_t payloadLength;
+    bool payloadTranscoded;     /**< Payload was transcoded from JSON to CBOR. **/
 }HttpResponse_t;
 
 typedef void (*CHPResponseCallback)(const HttpResponse_t *response, void *context);
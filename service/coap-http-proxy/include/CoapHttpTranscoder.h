@@ -0,0 +1,100 @@
+/* ****************************************************************
+ *
+ * Copyright 2016 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/**
+ * @file
+ * This file contains the streaming JSON to CBOR and CBOR to JSON transcoders
+ * used for HTTP payloads.
+ */
+
+#ifndef COAP_HTTP_TRANSCODER_H_
+#define COAP_HTTP_TRANSCODER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include "octypes.h"
+
+/**
+ * Maximum nesting depth of objects and arrays accepted by the transcoders.
+ * The state kept while transcoding grows with the depth, not with the payload.
+ */
+#define CHP_MAX_NESTING_DEPTH (16)
+
+/**
+ * Opaque state of a JSON to CBOR transcoder.
+ */
+typedef struct CHPJsonTranscoder CHPJsonTranscoder_t;
+
+/**
+ * Function to create a JSON to CBOR transcoder.
+ * @return Transcoder or NULL if out of memory.
+ */
+CHPJsonTranscoder_t *CHPJsonTranscoderCreate();
+
+/**
+ * Function to feed the next chunk of a JSON document to the transcoder.
+ * Chunks may split the document at any byte.
+ * @param[in]   transcoder        Transcoder.
+ * @param[in]   data              Chunk of JSON text.
+ * @param[in]   length            Length of the chunk.
+ * @return ::OC_STACK_OK or appropriate error code.
+ */
+OCStackResult CHPJsonTranscoderFeed(CHPJsonTranscoder_t *transcoder, const char *data,
+                                    size_t length);
+
+/**
+ * Function to complete transcoding once the whole JSON document has been fed.
+ * The document must be a single JSON object, which becomes a CBOR representation map.
+ * On success the caller owns the CBOR buffer and shall free it with OICFree().
+ * @param[in]   transcoder        Transcoder.
+ * @param[out]  cbor              CBOR encoded payload.
+ * @param[out]  cborLength        Length of the CBOR payload.
+ * @return ::OC_STACK_OK or appropriate error code.
+ */
+OCStackResult CHPJsonTranscoderFinish(CHPJsonTranscoder_t *transcoder, uint8_t **cbor,
+                                      size_t *cborLength);
+
+/**
+ * Function to free a JSON to CBOR transcoder.
+ * @param[in]   transcoder        Transcoder.
+ */
+void CHPJsonTranscoderDestroy(CHPJsonTranscoder_t *transcoder);
+
+/**
+ * Function to convert a CBOR payload to JSON text without building an intermediate tree.
+ * On success the caller owns the NUL terminated JSON text and shall free it with OICFree().
+ * @param[in]   cbor              CBOR encoded payload.
+ * @param[in]   cborLength        Length of the CBOR payload.
+ * @param[out]  json              JSON text.
+ * @param[out]  jsonLength        Length of the JSON text excluding the terminator.
+ * @return ::OC_STACK_OK or appropriate error code.
+ */
+OCStackResult CHPCborToJson(const uint8_t *cbor, size_t cborLength, char **json,
+                            size_t *jsonLength);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
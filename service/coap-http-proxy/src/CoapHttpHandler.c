@@ -24,10 +24,11 @@
 #include "logger.h"
 #include <coap/pdu.h>
 #include "ocpayload.h"
+#include "ocpayloadcbor.h"
 #include "uarraylist.h"
 #include "CoapHttpParser.h"
 #include "CoapHttpMap.h"
-#include "cJSON.h"
+#include "CoapHttpTranscoder.h"
 
 #define TAG "CHPHandler"
 
@@ -315,8 +316,18 @@ void CHPHandleHttpResponse(const HttpResponse_t *httpResponse, void *context)
         {
             case OC_FORMAT_CBOR:
                 OIC_LOG(DEBUG, TAG, "Payload format is CBOR");
-                result = OCParsePayload(&response.payload, PAYLOAD_TYPE_REPRESENTATION,
-                                        httpResponse->payload, httpResponse->payloadLength);
+                if (httpResponse->payloadTranscoded)
+                {
+                    // Encoded by the parser from a JSON payload, send it as it is.
+                    response.payload = (OCPayload *)OCEncodedPayloadCreate(
+                                            httpResponse->payload, httpResponse->payloadLength);
+                    result = response.payload ? OC_STACK_OK : OC_STACK_NO_MEMORY;
+                }
+                else
+                {
+                    result = OCParsePayload(&response.payload, PAYLOAD_TYPE_REPRESENTATION,
+                                            httpResponse->payload, httpResponse->payloadLength);
+                }
                 if (result != OC_STACK_OK)
                 {
                     OIC_LOG(ERROR, TAG, "Error parsing payload");
@@ -329,34 +340,15 @@ void CHPHandleHttpResponse(const HttpResponse_t *httpResponse, void *context)
                 }
                 break;
             case OC_FORMAT_JSON:
-                OIC_LOG(DEBUG, TAG, "Payload format is JSON");
-                cJSON *payloadJson = cJSON_Parse((char *)httpResponse->payload);
-                if (!payloadJson)
-                {
-                    OIC_LOG(ERROR, TAG, "Unable to parse json response");
-                    response.ehResult = OC_EH_INTERNAL_SERVER_ERROR;
-                    if (OCDoResponse(&response) != OC_STACK_OK)
-                    {
-                        OIC_LOG(ERROR, TAG, "Error sending response");
-                    }
-                    return;
-                }
-                OCRepPayload* payloadCbor = OCRepPayloadCreate();
-                if (!payloadCbor)
+                // The parser transcodes JSON payloads to CBOR while receiving them, so a
+                // payload still in JSON could not be transcoded.
+                OIC_LOG(ERROR, TAG, "Unable to parse json response");
+                response.ehResult = OC_EH_INTERNAL_SERVER_ERROR;
+                if (OCDoResponse(&response) != OC_STACK_OK)
                 {
-                    response.ehResult = OC_EH_INTERNAL_SERVER_ERROR;
-                    if (OCDoResponse(&response) != OC_STACK_OK)
-                    {
-                        OIC_LOG(ERROR, TAG, "Error sending response");
-                    }
-                    cJSON_Delete(payloadJson);
-                    return;
+                    OIC_LOG(ERROR, TAG, "Error sending response");
                 }
-
-                CHPJsonToRepPayload(payloadJson, payloadCbor);
-                response.payload = (OCPayload *)payloadCbor;
-                cJSON_Delete(payloadJson);
-                break;
+                return;
             default:
                 OIC_LOG(ERROR, TAG, "Payload format is not supported");
                 response.ehResult = OC_EH_INTERNAL_SERVER_ERROR;
@@ -394,7 +386,7 @@ void CHPHandleHttpResponse(const HttpResponse_t *httpResponse, void *context)
         OIC_LOG(ERROR, TAG, "Error sending response");
     }
 
-    //OICFree(coapResponseInfo.info.payload);
+    OCPayloadDestroy(response.payload);
     OIC_LOG_V(DEBUG, TAG, "%s OUT", __func__);
 }
 
@@ -444,8 +436,16 @@ OCStackResult CHPHandleOCFRequest(const OCEntityHandlerRequest* requestInfo,
     if (requestInfo->payload && requestInfo->payload->type == PAYLOAD_TYPE_REPRESENTATION)
     {
         // Conversion from cbor to json.
-        cJSON *payloadJson = CHPRepPayloadToJson((OCRepPayload *)requestInfo->payload);
-        if (!payloadJson)
+        uint8_t *cborPayload = NULL;
+        size_t cborLength = 0;
+        result = OCConvertPayload(requestInfo->payload, &cborPayload, &cborLength);
+        if (OC_STACK_OK == result)
+        {
+            result = CHPCborToJson(cborPayload, cborLength, (char **)&httpRequest.payload,
+                                   &httpRequest.payloadLength);
+        }
+        OICFree(cborPayload);
+        if (OC_STACK_OK != result)
         {
             response.ehResult = OC_EH_BAD_REQ;
             if (OCDoResponse(&response) != OC_STACK_OK)
@@ -456,11 +456,8 @@ OCStackResult CHPHandleOCFRequest(const OCEntityHandlerRequest* requestInfo,
             return OC_STACK_ERROR;
 
         }
-        httpRequest.payload = (void *)cJSON_Print(payloadJson);
-        httpRequest.payloadLength = strlen(httpRequest.payload);
         OICStrcpy(httpRequest.payloadFormat, sizeof(httpRequest.payloadFormat),
-                  CBOR_CONTENT_TYPE);
-        cJSON_Delete(payloadJson);
+                  JSON_CONTENT_TYPE);
     }
 
     OICStrcpy(httpRequest.acceptFormat, sizeof(httpRequest.acceptFormat),
@@ -23,12 +23,17 @@
 #include <stdint.h>
 
 #include "CoapHttpParser.h"
+#include "CoapHttpMap.h"
+#include "CoapHttpTranscoder.h"
 #include "oic_malloc.h"
 #include "oic_string.h"
+#include "oic_time.h"
 #include "uarraylist.h"
 #include "logger.h"
 
 #include <string.h>
+#include <strings.h>
+#include <limits.h>
 #include <curl/curl.h>
 #ifdef HAVE_PTHREAD_H
 #include <pthread.h>
@@ -39,7 +44,11 @@
 #include <sys/types.h>
 #include <fcntl.h>
 #if !defined(_WIN32)
-#include <sys/select.h>
+#include <poll.h>
+#else
+/* struct pollfd is declared by winsock2.h, which curl.h includes */
+typedef ULONG nfds_t;
+#define poll(fds, count, timeout) WSAPoll((fds), (ULONG)(count), (timeout))
 #endif //!defined(_WIN32)
 #include <errno.h>
 
@@ -47,8 +56,19 @@
 
 #define DEFAULT_USER_AGENT "IoTivity"
 #define MAX_PAYLOAD_SIZE (1048576U) // 1 MB
+#define MAX_IDLE_EASY_HANDLES (8)
+#define MAX_CACHE_ENTRIES (32)
+#define MAX_CACHED_PAYLOAD_SIZE (65536U)
 
-typedef struct
+/* Request waiting for the response to an identical request in flight */
+typedef struct CHPWaiter_t
+{
+    void* context;
+    CHPResponseCallback cb;
+    struct CHPWaiter_t *next;
+} CHPWaiter_t;
+
+typedef struct CHPContext_t
 {
     void* context;
     CHPResponseCallback cb;
@@ -60,18 +80,68 @@ typedef struct
     size_t readOffset;
     /* To track multiple write_callbacks from curl */
     size_t writeOffset;
+    /* JSON response payloads are transcoded to CBOR as they are received */
+    CHPJsonTranscoder_t *transcoder;
     /* libcurl related */
     CURL* easyHandle;
     /* libcurl does not copy header options passed to a request */
     struct curl_slist *list;
+    /* GET requests are coalesced and their responses cached by uri and accept */
+    char uri[CHP_MAX_HF_DATA_LENGTH];
+    char accept[CHP_MAX_HF_DATA_LENGTH];
+    bool cacheable;
+    /* ETag of the stale cache entry this request revalidates */
+    char etag[CHP_MAX_HF_DATA_LENGTH];
+    CHPWaiter_t *waiters;
+    struct CHPContext_t *next;
 } CHPContext_t;
 
+typedef struct CHPCacheEntry_t
+{
+    char uri[CHP_MAX_HF_DATA_LENGTH];
+    char accept[CHP_MAX_HF_DATA_LENGTH];
+    HttpResponse_t resp;
+    char etag[CHP_MAX_HF_DATA_LENGTH];
+    uint64_t expiresMs;
+    struct CHPCacheEntry_t *next;
+} CHPCacheEntry_t;
+
+/* Socket libcurl asked to be monitored */
+typedef struct
+{
+    curl_socket_t fd;
+    int what;
+} CHPSocket_t;
+
 /* A curl mutihandle is not threadsafe so we require mutexes to add new easy
  * handles to multihandle.
  */
 static CURLM *g_multiHandle;
 static int g_activeConnections;
 
+/* Following state is guarded by g_multiHandleMutex as well. */
+
+/* Requests in flight, to coalesce identical GET requests */
+static CHPContext_t *g_activeRequests;
+
+/* Requests served from the cache, delivered by the multi_handle thread */
+static CHPContext_t *g_completedRequests;
+
+/* Response cache, most recently used first */
+static CHPCacheEntry_t *g_cache;
+static size_t g_cacheCount;
+
+/* Easy handles kept for reuse once their transfer is done */
+static CURL *g_idleHandles[MAX_IDLE_EASY_HANDLES];
+static size_t g_idleHandleCount;
+
+/* Sockets and timeout libcurl asked to be monitored */
+static CHPSocket_t *g_sockets;
+static size_t g_socketCount;
+static size_t g_socketSize;
+static bool g_timerSet;
+static uint64_t g_timerExpiryMs;
+
 /*  Mutex code is taken from CA.
  *  General utility functions shall be placed in common location
  *  so that all modules can use them.
@@ -84,9 +154,9 @@ static int g_shutdownFds[2];
 static bool g_terminateParser;
 
 /*
- * Fds used to signal fdset to be refreshed.
- * When a new easy_handle is added to multi_handle,
- * existing fd_set has to be updated.
+ * Fds used to signal the monitored sockets to be refreshed.
+ * When a new easy_handle is added to multi_handle or a response is
+ * served from the cache, the multi_handle thread has to wake up.
  */
 static int g_refreshFds[2];
 
@@ -110,6 +180,29 @@ static void CHPParserResetHeaderOptions(u_arraylist_t** headerOptions)
     u_arraylist_free(headerOptions);
 }
 
+/* Called with g_multiHandleMutex held */
+static CURL *CHPParserAcquireEasyHandle()
+{
+    if (g_idleHandleCount)
+    {
+        return g_idleHandles[--g_idleHandleCount];
+    }
+    return curl_easy_init();
+}
+
+/* Called with g_multiHandleMutex held */
+static void CHPParserReleaseEasyHandle(CURL *easyHandle)
+{
+    if (g_idleHandleCount < MAX_IDLE_EASY_HANDLES && !g_terminateParser)
+    {
+        curl_easy_reset(easyHandle);
+        g_idleHandles[g_idleHandleCount++] = easyHandle;
+        return;
+    }
+    curl_easy_cleanup(easyHandle);
+}
+
+/* Called with g_multiHandleMutex held */
 static void CHPFreeContext(CHPContext_t *ctxt)
 {
     VERIFY_NON_NULL_VOID(ctxt, TAG, "ctxt is NULL");
@@ -120,174 +213,691 @@ static void CHPFreeContext(CHPContext_t *ctxt)
 
     if(ctxt->easyHandle)
     {
-        curl_easy_cleanup(ctxt->easyHandle);
+        CHPParserReleaseEasyHandle(ctxt->easyHandle);
+    }
+
+    while (ctxt->waiters)
+    {
+        CHPWaiter_t *waiter = ctxt->waiters;
+        ctxt->waiters = waiter->next;
+        OICFree(waiter);
     }
 
     CHPParserResetHeaderOptions(&(ctxt->resp.headerOptions));
+    CHPJsonTranscoderDestroy(ctxt->transcoder);
     OICFree(ctxt->resp.payload);
     OICFree(ctxt->payload);
     OICFree(ctxt);
 }
 
-static void *CHPParserExecuteMultiHandle(void* data)
+static void CHPParserStartTranscoding(CHPContext_t *ctxt)
 {
-    OIC_LOG_V(DEBUG, TAG, "%s IN", __func__);
-    OC_UNUSED(data);
-    /*
-     * These fd sets will be fetched from curl multi handle and monitored to execute
-     * curl_multi_perform()
-     */
-    fd_set fdread;
-    fd_set fdwrite;
-    fd_set fdexcep;
-    int maxfd;
-    struct timeval timeout;
-    struct timeval *tv;
-    int activeCon;
-    int activeEasyHandle;
-    bool goForSelect;
-    int retValue;
+    char *contentType = NULL;
+    curl_easy_getinfo(ctxt->easyHandle, CURLINFO_CONTENT_TYPE, &contentType);
+    if (!contentType)
+    {
+        return;
+    }
 
-    /* When active connections exist, curl_multi_perform() shall be called within
-     * curlMultiTimeout seconds regardless of whether select returned successfull or not.
-     */
-    long curlMultiTimeout;
-    while (!g_terminateParser)
+    OICStrcpy(ctxt->resp.dataFormat, sizeof(ctxt->resp.dataFormat), contentType);
+    if (OC_FORMAT_JSON == CHPGetOCContentType(ctxt->resp.dataFormat))
     {
-        // Required everytime before calling curl_multi_fdset()
-        FD_ZERO(&fdread);
-        FD_ZERO(&fdwrite);
-        FD_ZERO(&fdexcep);
-        maxfd = -1;
-        goForSelect = true;
+        ctxt->transcoder = CHPJsonTranscoderCreate();
+    }
+}
 
-        // Get currently active transfer fds from curl
-        CHPParserLockMutex();
-        curl_multi_fdset(g_multiHandle, &fdread, &fdwrite, &fdexcep, &maxfd);
-        curl_multi_timeout(g_multiHandle, &curlMultiTimeout);
-        activeCon = g_activeConnections;
-        CHPParserUnlockMutex();
+static void CHPParserFinishTranscoding(CHPContext_t *ctxt)
+{
+    HttpResponse_t *resp = &(ctxt->resp);
+    uint8_t *cbor = NULL;
+    size_t cborLength = 0;
+
+    if (OC_STACK_OK == CHPJsonTranscoderFinish(ctxt->transcoder, &cbor, &cborLength))
+    {
+        OICFree(resp->payload);
+        resp->payload = cbor;
+        resp->payloadLength = cborLength;
+        resp->payloadTranscoded = true;
+        OICStrcpy(resp->dataFormat, sizeof(resp->dataFormat), CBOR_CONTENT_TYPE);
+    }
+    else
+    {
+        // Response stays an empty JSON payload, which the response handler rejects.
+        OIC_LOG(ERROR, TAG, "JSON payload transcoding failed");
+    }
+
+    CHPJsonTranscoderDestroy(ctxt->transcoder);
+    ctxt->transcoder = NULL;
+}
+
+static void CHPParserClearResponse(HttpResponse_t *resp)
+{
+    CHPParserResetHeaderOptions(&(resp->headerOptions));
+    OICFree(resp->payload);
+    resp->payload = NULL;
+    resp->payloadLength = 0;
+}
+
+static bool CHPParserCopyResponse(HttpResponse_t *dst, const HttpResponse_t *src)
+{
+    *dst = *src;
+    dst->headerOptions = NULL;
+    dst->payload = NULL;
+
+    if (src->payloadLength)
+    {
+        dst->payload = OICMalloc(src->payloadLength);
+        if (!dst->payload)
+        {
+            OIC_LOG(ERROR, TAG, "Memory failed!");
+            return false;
+        }
+        memcpy(dst->payload, src->payload, src->payloadLength);
+    }
+
+    uint32_t optionCount = u_arraylist_length(src->headerOptions);
+    if (optionCount)
+    {
+        dst->headerOptions = u_arraylist_create();
+        if (!dst->headerOptions || !u_arraylist_reserve(dst->headerOptions, optionCount))
+        {
+            OIC_LOG(ERROR, TAG, "Memory failed!");
+            CHPParserClearResponse(dst);
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < optionCount; i++)
+    {
+        HttpHeaderOption_t *option = OICMalloc(sizeof(HttpHeaderOption_t));
+        if (!option)
+        {
+            OIC_LOG(ERROR, TAG, "Memory failed!");
+            CHPParserClearResponse(dst);
+            return false;
+        }
+        memcpy(option, u_arraylist_get(src->headerOptions, i), sizeof(HttpHeaderOption_t));
+        u_arraylist_add(dst->headerOptions, option);
+    }
+    return true;
+}
 
-        // A 0 represent curl_multi_perform() shall be called.
-        if(curlMultiTimeout < 0)
+static const HttpHeaderOption_t *CHPParserFindOption(u_arraylist_t *options, const char *name)
+{
+    uint32_t optionCount = u_arraylist_length(options);
+    for (uint32_t i = 0; i < optionCount; i++)
+    {
+        HttpHeaderOption_t *option = u_arraylist_get(options, i);
+        if (option && 0 == strcasecmp(option->optionName, name))
         {
-            curlMultiTimeout = 1000;
+            return option;
         }
+    }
+    return NULL;
+}
 
-        if(maxfd == -1)
+/*
+ * Computes how long a response stays fresh from its Cache-Control or Expires header.
+ * Returns false if the response shall not be stored at all.
+ */
+static bool CHPParserGetFreshness(const HttpResponse_t *resp, uint64_t *lifetimeMs)
+{
+    *lifetimeMs = 0;
+
+    const HttpHeaderOption_t *option = CHPParserFindOption(resp->headerOptions,
+                                                           HTTP_OPTION_CACHE_CONTROL);
+    if (option)
+    {
+        char directives[CHP_MAX_HF_DATA_LENGTH];
+        OICStrcpy(directives, sizeof(directives), option->optionData);
+
+        bool noCache = false;
+        bool sharedMaxAge = false;
+        char *savePtr = NULL;
+        for (char *directive = strtok_r(directives, ", ", &savePtr); directive;
+             directive = strtok_r(NULL, ", ", &savePtr))
         {
-            /* Nothing to monitor from libcurl.
-             * This mean that no active sockets exist either because
-             * there are no transfer taking place or sockets are not in a
-             * state that could be monitored (connecting, retry etc.)
-             */
-            if(!activeCon)
+            if (0 == strcasecmp(directive, "no-store") || 0 == strcasecmp(directive, "private"))
             {
-                // wait until something received on shutdown or refresh fd
-                // with no timeout.
-                curlMultiTimeout = -1;
+                return false;
             }
-            else
+            else if (0 == strcasecmp(directive, "no-cache"))
+            {
+                noCache = true;
+            }
+            else if (0 == strncasecmp(directive, "s-maxage=", 9))
             {
-                // libcurl recommend doing this.
-                usleep(100000);
-                // dont select() and directly call curl_multi_perform()
-                goForSelect = false;
+                *lifetimeMs = strtoull(directive + 9, NULL, 10) * MS_PER_SEC;
+                sharedMaxAge = true;
+            }
+            else if (0 == strncasecmp(directive, "max-age=", 8) && !sharedMaxAge)
+            {
+                *lifetimeMs = strtoull(directive + 8, NULL, 10) * MS_PER_SEC;
             }
         }
 
-        if(goForSelect)
+        if (noCache)
         {
-            FD_SET(g_shutdownFds[0], &fdread);
-            if (maxfd < g_shutdownFds[0])
+            // Stored, but revalidated before each use.
+            *lifetimeMs = 0;
+        }
+        return true;
+    }
+
+    option = CHPParserFindOption(resp->headerOptions, HTTP_OPTION_EXPIRES);
+    if (option)
+    {
+        time_t expires = curl_getdate(option->optionData, NULL);
+        time_t now = time(NULL);
+        if (expires > now)
+        {
+            *lifetimeMs = (uint64_t)(expires - now) * MS_PER_SEC;
+        }
+    }
+    return true;
+}
+
+/* Called with g_multiHandleMutex held */
+static CHPCacheEntry_t *CHPParserFindCacheEntry(const char *uri, const char *accept,
+                                                CHPCacheEntry_t **previous)
+{
+    *previous = NULL;
+    for (CHPCacheEntry_t *entry = g_cache; entry; entry = entry->next)
+    {
+        if (0 == strcmp(entry->uri, uri) && 0 == strcmp(entry->accept, accept))
+        {
+            return entry;
+        }
+        *previous = entry;
+    }
+    return NULL;
+}
+
+/* Called with g_multiHandleMutex held */
+static void CHPParserRemoveCacheEntry(const char *uri, const char *accept)
+{
+    CHPCacheEntry_t *previous = NULL;
+    CHPCacheEntry_t *entry = CHPParserFindCacheEntry(uri, accept, &previous);
+    if (!entry)
+    {
+        return;
+    }
+
+    if (previous)
+    {
+        previous->next = entry->next;
+    }
+    else
+    {
+        g_cache = entry->next;
+    }
+    g_cacheCount--;
+    CHPParserClearResponse(&entry->resp);
+    OICFree(entry);
+}
+
+/* Removes the cached responses for all accepted formats of a uri. */
+static void CHPParserRemoveCacheEntries(const char *uri)
+{
+    CHPCacheEntry_t **ptr = &g_cache;
+    while (*ptr)
+    {
+        CHPCacheEntry_t *entry = *ptr;
+        if (0 != strcmp(entry->uri, uri))
+        {
+            ptr = &(entry->next);
+            continue;
+        }
+
+        *ptr = entry->next;
+        g_cacheCount--;
+        CHPParserClearResponse(&entry->resp);
+        OICFree(entry);
+    }
+}
+
+/* Looks up a cache entry and marks it as most recently used. */
+static CHPCacheEntry_t *CHPParserUseCacheEntry(const char *uri, const char *accept)
+{
+    CHPCacheEntry_t *previous = NULL;
+    CHPCacheEntry_t *entry = CHPParserFindCacheEntry(uri, accept, &previous);
+    if (entry && previous)
+    {
+        previous->next = entry->next;
+        entry->next = g_cache;
+        g_cache = entry;
+    }
+    return entry;
+}
+
+/* Called with g_multiHandleMutex held */
+static void CHPParserClearCache()
+{
+    while (g_cache)
+    {
+        CHPCacheEntry_t *entry = g_cache;
+        g_cache = entry->next;
+        CHPParserClearResponse(&entry->resp);
+        OICFree(entry);
+    }
+    g_cacheCount = 0;
+}
+
+/* Called with g_multiHandleMutex held */
+static void CHPParserStoreResponse(const CHPContext_t *ctxt)
+{
+    const HttpResponse_t *resp = &(ctxt->resp);
+    const HttpHeaderOption_t *etag = CHPParserFindOption(resp->headerOptions, HTTP_OPTION_ETAG);
+    uint64_t lifetimeMs = 0;
+
+    if (!CHPParserGetFreshness(resp, &lifetimeMs) || (!lifetimeMs && !etag) ||
+        resp->payloadLength > MAX_CACHED_PAYLOAD_SIZE)
+    {
+        CHPParserRemoveCacheEntry(ctxt->uri, ctxt->accept);
+        return;
+    }
+
+    CHPCacheEntry_t *entry = CHPParserUseCacheEntry(ctxt->uri, ctxt->accept);
+    if (entry)
+    {
+        CHPParserClearResponse(&entry->resp);
+    }
+    else
+    {
+        if (MAX_CACHE_ENTRIES == g_cacheCount)
+        {
+            // Evict the least recently used entry, the last one.
+            CHPCacheEntry_t *last = g_cache;
+            while (last->next)
             {
-                maxfd = g_shutdownFds[0];
+                last = last->next;
             }
+            CHPParserRemoveCacheEntry(last->uri, last->accept);
+        }
 
-            FD_SET(g_refreshFds[0], &fdread);
-            if (maxfd < g_refreshFds[0])
+        entry = OICCalloc(1, sizeof(CHPCacheEntry_t));
+        if (!entry)
+        {
+            OIC_LOG(ERROR, TAG, "Memory failed!");
+            return;
+        }
+        OICStrcpy(entry->uri, sizeof(entry->uri), ctxt->uri);
+        OICStrcpy(entry->accept, sizeof(entry->accept), ctxt->accept);
+        entry->next = g_cache;
+        g_cache = entry;
+        g_cacheCount++;
+    }
+
+    if (!CHPParserCopyResponse(&entry->resp, resp))
+    {
+        CHPParserRemoveCacheEntry(ctxt->uri, ctxt->accept);
+        return;
+    }
+    OICStrcpy(entry->etag, sizeof(entry->etag), etag ? etag->optionData : "");
+    entry->expiresMs = OICGetCurrentTime(TIME_IN_MS) + lifetimeMs;
+    OIC_LOG_V(DEBUG, TAG, "Cached response for %s", ctxt->uri);
+}
+
+/*
+ * Updates the cache with the response to a cacheable request. A 304 response
+ * to a revalidation is replaced by the cached response it refreshes.
+ * Called with g_multiHandleMutex held.
+ */
+static void CHPParserUpdateCache(CHPContext_t *ctxt)
+{
+    if (CHP_NOT_MODIFIED == ctxt->resp.status && ctxt->etag[0])
+    {
+        CHPCacheEntry_t *entry = CHPParserUseCacheEntry(ctxt->uri, ctxt->accept);
+        uint64_t lifetimeMs = 0;
+        if (!entry || !CHPParserGetFreshness(&ctxt->resp, &lifetimeMs))
+        {
+            CHPParserRemoveCacheEntry(ctxt->uri, ctxt->accept);
+            return;
+        }
+
+        HttpResponse_t cached;
+        if (!CHPParserCopyResponse(&cached, &entry->resp))
+        {
+            return;
+        }
+        CHPParserClearResponse(&ctxt->resp);
+        ctxt->resp = cached;
+        entry->expiresMs = OICGetCurrentTime(TIME_IN_MS) + lifetimeMs;
+        OIC_LOG_V(DEBUG, TAG, "Revalidated cached response for %s", ctxt->uri);
+        return;
+    }
+
+    if (CHP_SUCCESS == ctxt->resp.status)
+    {
+        CHPParserStoreResponse(ctxt);
+    }
+}
+
+/*
+ * Queues a fresh cached response for delivery by the multi_handle thread.
+ * Responses are never delivered from the caller's thread as the caller may
+ * still be in the entity handler.
+ * Called with g_multiHandleMutex held.
+ */
+static bool CHPParserServeFromCache(const char *uri, const char *accept,
+                                    CHPResponseCallback httpcb, void *context)
+{
+    CHPCacheEntry_t *entry = CHPParserUseCacheEntry(uri, accept);
+    if (!entry || entry->expiresMs <= OICGetCurrentTime(TIME_IN_MS))
+    {
+        return false;
+    }
+
+    CHPContext_t *ctxt = OICCalloc(1, sizeof(CHPContext_t));
+    if (!ctxt)
+    {
+        OIC_LOG(ERROR, TAG, "Memory failed!");
+        return false;
+    }
+
+    if (!CHPParserCopyResponse(&ctxt->resp, &entry->resp))
+    {
+        OICFree(ctxt);
+        return false;
+    }
+
+    ctxt->cb = httpcb;
+    ctxt->context = context;
+    ctxt->next = g_completedRequests;
+    g_completedRequests = ctxt;
+    OIC_LOG_V(DEBUG, TAG, "Serving %s from cache", uri);
+    return true;
+}
+
+/* Called with g_multiHandleMutex held */
+static bool CHPParserJoinActiveRequest(const char *uri, const char *accept,
+                                       CHPResponseCallback httpcb, void *context)
+{
+    for (CHPContext_t *active = g_activeRequests; active; active = active->next)
+    {
+        if (!active->cacheable || 0 != strcmp(active->uri, uri) ||
+            0 != strcmp(active->accept, accept))
+        {
+            continue;
+        }
+
+        CHPWaiter_t *waiter = OICCalloc(1, sizeof(CHPWaiter_t));
+        if (!waiter)
+        {
+            OIC_LOG(ERROR, TAG, "Memory failed!");
+            return false;
+        }
+        waiter->cb = httpcb;
+        waiter->context = context;
+        waiter->next = active->waiters;
+        active->waiters = waiter;
+        OIC_LOG_V(DEBUG, TAG, "Joining request in flight for %s", uri);
+        return true;
+    }
+    return false;
+}
+
+/* Called with g_multiHandleMutex held */
+static void CHPParserUnlinkActiveRequest(CHPContext_t *ctxt)
+{
+    for (CHPContext_t **ptr = &g_activeRequests; *ptr; ptr = &((*ptr)->next))
+    {
+        if (*ptr == ctxt)
+        {
+            *ptr = ctxt->next;
+            ctxt->next = NULL;
+            return;
+        }
+    }
+}
+
+/* Called with g_multiHandleMutex held */
+static void CHPParserDeliverResponse(CHPContext_t *ctxt)
+{
+    ctxt->cb(&(ctxt->resp), ctxt->context);
+    for (CHPWaiter_t *waiter = ctxt->waiters; waiter; waiter = waiter->next)
+    {
+        waiter->cb(&(ctxt->resp), waiter->context);
+    }
+    CHPFreeContext(ctxt);
+}
+
+/* Called with g_multiHandleMutex held */
+static void CHPParserCompleteTransfer(CURL *easyHandle)
+{
+    g_activeConnections--;
+    curl_multi_remove_handle(g_multiHandle, easyHandle);
+
+    CHPContext_t *ptr;
+    char *uri = NULL;
+    char *contentType = NULL;
+    long responseCode;
+
+    curl_easy_getinfo(easyHandle, CURLINFO_PRIVATE, &ptr);
+    curl_easy_getinfo(easyHandle, CURLINFO_EFFECTIVE_URL, &uri);
+    curl_easy_getinfo(easyHandle, CURLINFO_RESPONSE_CODE, &responseCode);
+    curl_easy_getinfo(easyHandle, CURLINFO_CONTENT_TYPE, &contentType);
+
+    ptr->resp.status = responseCode;
+    OICStrcpy(ptr->resp.dataFormat, sizeof(ptr->resp.dataFormat), contentType);
+    if (ptr->transcoder)
+    {
+        CHPParserFinishTranscoding(ptr);
+    }
+    OIC_LOG_V(DEBUG, TAG, "Transfer completed %d uri: %s, %s", g_activeConnections,
+                                                           uri, contentType);
+
+    CHPParserUnlinkActiveRequest(ptr);
+    if (ptr->cacheable)
+    {
+        CHPParserUpdateCache(ptr);
+    }
+    CHPParserDeliverResponse(ptr);
+}
+
+static int CHPParserSocketCb(CURL *easyHandle, curl_socket_t fd, int what, void *userp,
+                             void *socketp)
+{
+    OC_UNUSED(easyHandle);
+    OC_UNUSED(userp);
+    OC_UNUSED(socketp);
+
+    size_t index = 0;
+    while (index < g_socketCount && g_sockets[index].fd != fd)
+    {
+        index++;
+    }
+
+    if (CURL_POLL_REMOVE == what)
+    {
+        if (index < g_socketCount)
+        {
+            g_sockets[index] = g_sockets[--g_socketCount];
+        }
+        return 0;
+    }
+
+    if (index == g_socketCount)
+    {
+        if (g_socketCount == g_socketSize)
+        {
+            size_t newSize = g_socketSize ? 2 * g_socketSize : 8;
+            CHPSocket_t *sockets = OICRealloc(g_sockets, newSize * sizeof(CHPSocket_t));
+            if (!sockets)
             {
-                maxfd = g_refreshFds[0];
+                OIC_LOG(ERROR, TAG, "Memory failed!");
+                return -1;
             }
+            g_sockets = sockets;
+            g_socketSize = newSize;
+        }
+        g_sockets[g_socketCount++].fd = fd;
+    }
+    g_sockets[index].what = what;
+    return 0;
+}
+
+static int CHPParserTimerCb(CURLM *multiHandle, long timeoutMs, void *userp)
+{
+    OC_UNUSED(multiHandle);
+    OC_UNUSED(userp);
 
-            if(curlMultiTimeout == -1)
+    g_timerSet = (timeoutMs >= 0);
+    if (g_timerSet)
+    {
+        g_timerExpiryMs = OICGetCurrentTime(TIME_IN_MS) + timeoutMs;
+    }
+    return 0;
+}
+
+/* Delivers the responses served from the cache. Called with g_multiHandleMutex held. */
+static void CHPParserDeliverCompletedRequests()
+{
+    while (g_completedRequests)
+    {
+        CHPContext_t *ctxt = g_completedRequests;
+        g_completedRequests = ctxt->next;
+        CHPParserDeliverResponse(ctxt);
+    }
+}
+
+static void *CHPParserExecuteMultiHandle(void* data)
+{
+    OIC_LOG_V(DEBUG, TAG, "%s IN", __func__);
+    OC_UNUSED(data);
+    /*
+     * Sockets to poll: shutdown and refresh fds followed by the sockets libcurl
+     * asked for through CHPParserSocketCb().
+     */
+    struct pollfd *fds = NULL;
+    size_t fdsSize = 0;
+    nfds_t fdCount;
+    int timeout;
+    int retValue;
+    int activeEasyHandle;
+
+    while (!g_terminateParser)
+    {
+        CHPParserLockMutex();
+        CHPParserDeliverCompletedRequests();
+
+        if (fdsSize < g_socketCount + 2)
+        {
+            struct pollfd *newFds = OICRealloc(fds, (g_socketCount + 2) * sizeof(struct pollfd));
+            if (newFds)
             {
-                tv = NULL;
+                fds = newFds;
+                fdsSize = g_socketCount + 2;
             }
             else
             {
-                timeout.tv_sec = curlMultiTimeout / 1000;
-                timeout.tv_usec = 0;
-                tv = &timeout;
-            }
-
-            // Select here
-            retValue = select(maxfd + 1, &fdread, &fdwrite, &fdexcep, tv);
-            if(retValue == -1)
-            {
-                OIC_LOG_V(ERROR, TAG, "Error in select. %s", strerror(errno));
-                continue;
+                OIC_LOG(ERROR, TAG, "Memory failed! Only timeouts are processed");
             }
+        }
 
-            // Some sockets are available for operations, check if shutdown or refresh fds are
-            // among them. In any case, go ahead and call curl_multi_perform()
-            if(retValue)
+        fdCount = 0;
+        if (fds)
+        {
+            fds[0].fd = g_shutdownFds[0];
+            fds[0].events = POLLIN;
+            fds[1].fd = g_refreshFds[0];
+            fds[1].events = POLLIN;
+            fdCount = 2;
+            for (size_t i = 0; i < g_socketCount && fdCount < fdsSize; i++, fdCount++)
             {
-                if (FD_ISSET(g_shutdownFds[0], &fdread))
+                fds[fdCount].fd = g_sockets[i].fd;
+                fds[fdCount].events = 0;
+                if (g_sockets[i].what & CURL_POLL_IN)
                 {
-                    OIC_LOG(ERROR, TAG, "Shutdown requested. multi_handle returning");
-                    break;
+                    fds[fdCount].events |= POLLIN;
                 }
-                else if(FD_ISSET(g_refreshFds[0], &fdread))
+                if (g_sockets[i].what & CURL_POLL_OUT)
                 {
-                    char buf[20] = {0};
-                    ssize_t len = read(g_refreshFds[0], buf, sizeof(buf));
-                    OC_UNUSED(len);
-                    // new easy handles added, call multi_perform and refresh fds.
-                    OIC_LOG(ERROR, TAG, "New easy handle added");
+                    fds[fdCount].events |= POLLOUT;
                 }
             }
         }
 
-        CURLMcode ret;
+        // Without a timer set by libcurl wait until something is received on the sockets.
+        timeout = -1;
+        if (g_timerSet)
+        {
+            uint64_t now = OICGetCurrentTime(TIME_IN_MS);
+            uint64_t remaining = g_timerExpiryMs > now ? g_timerExpiryMs - now : 0;
+            timeout = remaining > INT_MAX ? INT_MAX : (int)remaining;
+        }
+        CHPParserUnlockMutex();
+
+        retValue = poll(fds, fdCount, fdCount ? timeout : 100);
+        if (retValue == -1)
+        {
+            if (errno != EINTR)
+            {
+                OIC_LOG_V(ERROR, TAG, "Error in poll. %s", strerror(errno));
+            }
+            continue;
+        }
+
+        if (fdCount && fds[0].revents)
+        {
+            OIC_LOG(ERROR, TAG, "Shutdown requested. multi_handle returning");
+            break;
+        }
+
+        if (fdCount && (fds[1].revents & POLLIN))
+        {
+            char buf[20] = {0};
+            ssize_t len = read(g_refreshFds[0], buf, sizeof(buf));
+            OC_UNUSED(len);
+            // New easy handles added or cached responses queued.
+            OIC_LOG(DEBUG, TAG, "multi_handle refresh requested");
+        }
+
         CHPParserLockMutex();
+        for (nfds_t i = 2; i < fdCount && !g_terminateParser; i++)
+        {
+            if (!fds[i].revents)
+            {
+                continue;
+            }
+
+            int action = 0;
+            if (fds[i].revents & POLLIN)
+            {
+                action |= CURL_CSELECT_IN;
+            }
+            if (fds[i].revents & POLLOUT)
+            {
+                action |= CURL_CSELECT_OUT;
+            }
+            if (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL))
+            {
+                action |= CURL_CSELECT_ERR;
+            }
+            curl_multi_socket_action(g_multiHandle, fds[i].fd, action, &activeEasyHandle);
+        }
+
+        if (g_timerSet && g_timerExpiryMs <= OICGetCurrentTime(TIME_IN_MS))
+        {
+            g_timerSet = false;
+            curl_multi_socket_action(g_multiHandle, CURL_SOCKET_TIMEOUT, 0, &activeEasyHandle);
+        }
+
+        struct CURLMsg *cmsg;
+        int cmsgq;
         do
         {
-            ret = curl_multi_perform(g_multiHandle, &activeEasyHandle);
-            struct CURLMsg *cmsg;
-            int cmsgq;
-            do
+            cmsgq = 0;
+            cmsg = curl_multi_info_read(g_multiHandle, &cmsgq);
+            if(cmsg && (cmsg->msg == CURLMSG_DONE))
             {
-                cmsgq = 0;
-                cmsg = curl_multi_info_read(g_multiHandle, &cmsgq);
-                if(cmsg && (cmsg->msg == CURLMSG_DONE))
-                {
-                    CURL *easyHandle = cmsg->easy_handle;
-                    g_activeConnections--;
-                    curl_multi_remove_handle(g_multiHandle, easyHandle);
-
-                    CHPContext_t *ptr;
-                    char *uri = NULL;
-                    char *contentType = NULL;
-                    long responseCode;
-
-                    curl_easy_getinfo(easyHandle, CURLINFO_PRIVATE, &ptr);
-                    curl_easy_getinfo(easyHandle, CURLINFO_EFFECTIVE_URL, &uri);
-                    curl_easy_getinfo(easyHandle, CURLINFO_RESPONSE_CODE, &responseCode);
-                    curl_easy_getinfo(easyHandle, CURLINFO_CONTENT_TYPE, &contentType);
-
-                    ptr->resp.status = responseCode;
-                    OICStrcpy(ptr->resp.dataFormat, sizeof(ptr->resp.dataFormat), contentType);
-                    OIC_LOG_V(DEBUG, TAG, "Transfer completed %d uri: %s, %s", g_activeConnections,
-                                                                           uri, contentType);
-                    ptr->cb(&(ptr->resp), ptr->context);
-                    CHPFreeContext(ptr);
-                }
-            } while(cmsg && !g_terminateParser);
-        }while (ret == CURLM_CALL_MULTI_PERFORM && !g_terminateParser);
+                CHPParserCompleteTransfer(cmsg->easy_handle);
+            }
+        } while(cmsg && !g_terminateParser);
         CHPParserUnlockMutex();
     }
 
+    OICFree(fds);
     if (g_terminateParser)
     {
         OIC_LOG_V(DEBUG, TAG, "Shutdown request received.");
@@ -407,6 +1017,10 @@ static OCStackResult CHPParserInitializeMultiHandle()
         return OC_STACK_ERROR;
     }
 
+    /* libcurl tells which sockets to monitor and when to time out through callbacks */
+    curl_multi_setopt(g_multiHandle, CURLMOPT_SOCKETFUNCTION, CHPParserSocketCb);
+    curl_multi_setopt(g_multiHandle, CURLMOPT_TIMERFUNCTION, CHPParserTimerCb);
+
     CHPParserUnlockMutex();
     return OC_STACK_OK;
 }
@@ -421,6 +1035,34 @@ static OCStackResult CHPParserTerminateMultiHandle()
         return OC_STACK_OK;
     }
 
+    // Requests still pending are dropped without a response.
+    while (g_activeRequests)
+    {
+        CHPContext_t *ctxt = g_activeRequests;
+        g_activeRequests = ctxt->next;
+        curl_multi_remove_handle(g_multiHandle, ctxt->easyHandle);
+        CHPFreeContext(ctxt);
+    }
+
+    while (g_completedRequests)
+    {
+        CHPContext_t *ctxt = g_completedRequests;
+        g_completedRequests = ctxt->next;
+        CHPFreeContext(ctxt);
+    }
+
+    while (g_idleHandleCount)
+    {
+        curl_easy_cleanup(g_idleHandles[--g_idleHandleCount]);
+    }
+
+    CHPParserClearCache();
+    OICFree(g_sockets);
+    g_sockets = NULL;
+    g_socketCount = 0;
+    g_socketSize = 0;
+    g_timerSet = false;
+
     curl_multi_cleanup(g_multiHandle);
     g_multiHandle = NULL;
     CHPParserUnlockMutex();
@@ -462,6 +1104,7 @@ OCStackResult CHPParserInitialize()
     }
 
     // Launch multi_handle processor thread
+    g_terminateParser = false;
     int result = pthread_create(&g_multiHandleThread, NULL, CHPParserExecuteMultiHandle, NULL);
     if(result != 0)
     {
@@ -470,7 +1113,6 @@ OCStackResult CHPParserInitialize()
         return OC_STACK_ERROR;
     }
 
-    g_terminateParser = false;
     CHPParserLockMutex();
     g_activeConnections = 0;
     CHPParserUnlockMutex();
@@ -536,6 +1178,22 @@ static size_t CHPEasyHandleWriteCb(char *buffer, size_t size, size_t num, void *
         return 0;
     }
 
+    if (!ctx->writeOffset && !ctx->transcoder)
+    {
+        CHPParserStartTranscoding(ctx);
+    }
+
+    if (ctx->transcoder)
+    {
+        if (OC_STACK_OK != CHPJsonTranscoderFeed(ctx->transcoder, buffer, dataToWrite))
+        {
+            OIC_LOG_V(ERROR, TAG, "%s Invalid JSON payload", __func__);
+            return 0;
+        }
+        ctx->writeOffset += dataToWrite;
+        return dataToWrite;
+    }
+
     if (!resp->payload)
     {
         resp->payload = OICMalloc(dataToWrite);
@@ -619,6 +1277,8 @@ static size_t CHPEasyHandleHeaderCb(char *buffer, size_t size, size_t num, void
             ctx->writeOffset = 0;
             OICFree(resp->payload);
             resp->payload = NULL;
+            CHPJsonTranscoderDestroy(ctx->transcoder);
+            ctx->transcoder = NULL;
             CHPParserResetHeaderOptions(&(resp->headerOptions));
             // This is a status line. We are only interested in header options.
             return dataToWrite;
@@ -709,6 +1369,7 @@ static size_t CHPEasyHandleHeaderCb(char *buffer, size_t size, size_t num, void
     return dataToWrite;
 }
 
+/* Called with g_multiHandleMutex held */
 static OCStackResult CHPInitializeEasyHandle(CURL** easyHandle, HttpRequest_t *req,
                                              CHPContext_t* handleContext)
 {
@@ -717,7 +1378,7 @@ static OCStackResult CHPInitializeEasyHandle(CURL** easyHandle, HttpRequest_t *r
     VERIFY_NON_NULL_RET(easyHandle, TAG, "easyHandle", OC_STACK_INVALID_PARAM);
     VERIFY_NON_NULL_RET(handleContext, TAG, "handleContext", OC_STACK_INVALID_PARAM);
 
-    CURL *e = curl_easy_init();
+    CURL *e = CHPParserAcquireEasyHandle();
     if(!e)
     {
         OIC_LOG(ERROR, TAG, "easy init failed!");
@@ -747,8 +1408,10 @@ static OCStackResult CHPInitializeEasyHandle(CURL** easyHandle, HttpRequest_t *r
     curl_easy_setopt(e, CURLOPT_LOW_SPEED_LIMIT, 1024L);
     curl_easy_setopt(e, CURLOPT_LOW_SPEED_TIME, 60L);
     curl_easy_setopt(e, CURLOPT_USERAGENT, DEFAULT_USER_AGENT);
-    /* Close connection once done with transaction */
-    curl_easy_setopt(e, CURLOPT_FORBID_REUSE, 1L);
+    /* Connections stay in the multi handle's cache to be reused by later requests */
+#if LIBCURL_VERSION_NUM >= 0x071900
+    curl_easy_setopt(e, CURLOPT_TCP_KEEPALIVE, 1L);
+#endif
     /* Allow redirect */
     curl_easy_setopt(e, CURLOPT_FOLLOWLOCATION, 1L);
     /* Only redirect to http servers */
@@ -788,6 +1451,7 @@ static OCStackResult CHPInitializeEasyHandle(CURL** easyHandle, HttpRequest_t *r
             curl_easy_setopt(e, CURLOPT_CUSTOMREQUEST, "DELETE");
             break;
         default:
+            CHPParserReleaseEasyHandle(e);
             return OC_STACK_INVALID_METHOD;
     }
 
@@ -811,17 +1475,70 @@ static OCStackResult CHPInitializeEasyHandle(CURL** easyHandle, HttpRequest_t *r
         }
     }
 
+    /* Revalidate a stale cached response instead of fetching it again */
+    if (handleContext->etag[0])
+    {
+        snprintf(buffer, sizeof(buffer), "If-None-Match: %s", handleContext->etag);
+        list = curl_slist_append(list, buffer);
+    }
+
     /* Add content-type and accept header */
     snprintf(buffer, sizeof(buffer), "Accept: %s", req->acceptFormat);
     list = curl_slist_append(list, buffer);
-    snprintf(buffer, sizeof(buffer), "Content-Type: %s", req->payloadFormat);
+    if (req->payloadFormat[0])
+    {
+        snprintf(buffer, sizeof(buffer), "Content-Type: %s", req->payloadFormat);
+        list = curl_slist_append(list, buffer);
+    }
     curl_easy_setopt(e, CURLOPT_HTTPHEADER, list);
+    handleContext->list = list;
 
     *easyHandle = e;
     OIC_LOG_V(DEBUG, TAG, "%s OUT", __func__);
     return OC_STACK_OK;
 }
 
+/*
+ * GET requests without conditions of their own may be served from the cache.
+ * Responses to authorized requests may differ per client and are never shared.
+ */
+static bool CHPParserIsCacheable(const HttpRequest_t *req)
+{
+    return CHP_GET == req->method &&
+           !CHPParserFindOption(req->headerOptions, HTTP_OPTION_IF_MATCH) &&
+           !CHPParserFindOption(req->headerOptions, HTTP_OPTION_IF_NONE_MATCH) &&
+           !CHPParserFindOption(req->headerOptions, HTTP_OPTION_AUTHORIZATION);
+}
+
+/* Formats the accept headers sent with a request, which select the cached variant. */
+static void CHPParserGetAccept(const HttpRequest_t *req, char *accept, size_t size)
+{
+    const HttpHeaderOption_t *option = CHPParserFindOption(req->headerOptions,
+                                                           HTTP_OPTION_ACCEPT);
+    if (option)
+    {
+        snprintf(accept, size, "%s, %s", option->optionData, req->acceptFormat);
+    }
+    else
+    {
+        OICStrcpy(accept, size, req->acceptFormat);
+    }
+}
+
+static void CHPParserNotifyRefresh()
+{
+    ssize_t len = 0;
+    do
+    {
+        len = write(g_refreshFds[1], "w", 1);
+    } while ((len == -1) && (errno == EINTR));
+
+    if ((len == -1) && (errno != EINTR) && (errno != EPIPE))
+    {
+        OIC_LOG_V(DEBUG, TAG, "refresh failed: %s", strerror(errno));
+    }
+}
+
 OCStackResult CHPPostHttpRequest(HttpRequest_t *req, CHPResponseCallback httpcb,
                                  void *context)
 {
@@ -829,41 +1546,73 @@ OCStackResult CHPPostHttpRequest(HttpRequest_t *req, CHPResponseCallback httpcb,
     VERIFY_NON_NULL_RET(req, TAG, "req", OC_STACK_INVALID_PARAM);
     VERIFY_NON_NULL_RET(httpcb, TAG, "httpcb", OC_STACK_INVALID_PARAM);
 
+    char accept[CHP_MAX_HF_DATA_LENGTH];
+    CHPParserGetAccept(req, accept, sizeof(accept));
+
+    CHPParserLockMutex();
+    bool cacheable = CHPParserIsCacheable(req);
+    if (cacheable)
+    {
+        if (CHPParserServeFromCache(req->resourceUri, accept, httpcb, context))
+        {
+            CHPParserUnlockMutex();
+            CHPParserNotifyRefresh();
+            return OC_STACK_OK;
+        }
+
+        if (CHPParserJoinActiveRequest(req->resourceUri, accept, httpcb, context))
+        {
+            CHPParserUnlockMutex();
+            return OC_STACK_OK;
+        }
+    }
+    else if (CHP_GET != req->method)
+    {
+        // Requests modifying the resource make the cached responses outdated.
+        CHPParserRemoveCacheEntries(req->resourceUri);
+    }
+
     CHPContext_t *ctxt = OICCalloc(1, sizeof(CHPContext_t));
     if (!ctxt)
     {
         OIC_LOG(ERROR, TAG, "Memory failed!");
+        CHPParserUnlockMutex();
         return OC_STACK_NO_MEMORY;
     }
 
     ctxt->cb = httpcb;
     ctxt->context = context;
+    ctxt->cacheable = cacheable;
+    OICStrcpy(ctxt->uri, sizeof(ctxt->uri), req->resourceUri);
+    OICStrcpy(ctxt->accept, sizeof(ctxt->accept), accept);
+    if (cacheable)
+    {
+        CHPCacheEntry_t *previous = NULL;
+        CHPCacheEntry_t *entry = CHPParserFindCacheEntry(req->resourceUri, accept, &previous);
+        if (entry)
+        {
+            OICStrcpy(ctxt->etag, sizeof(ctxt->etag), entry->etag);
+        }
+    }
+
     OCStackResult ret = CHPInitializeEasyHandle(&ctxt->easyHandle, req, ctxt);
     if(ret != OC_STACK_OK)
     {
         OIC_LOG_V(ERROR, TAG, "Failed to initialize easy handle [%d]", ret);
-        OICFree(ctxt);
+        CHPFreeContext(ctxt);
+        CHPParserUnlockMutex();
         return ret;
     }
 
     // Add easy_handle to multi_handle
-    CHPParserLockMutex();
     curl_multi_add_handle(g_multiHandle, ctxt->easyHandle);
     g_activeConnections++;
+    ctxt->next = g_activeRequests;
+    g_activeRequests = ctxt;
     CHPParserUnlockMutex();
     // Notify refreshfd
-    ssize_t len = 0;
-    do
-    {
-        len = write(g_refreshFds[1], "w", 1);
-    } while ((len == -1) && (errno == EINTR));
-
-    if ((len == -1) && (errno != EINTR) && (errno != EPIPE))
-    {
-        OIC_LOG_V(DEBUG, TAG, "refresh failed: %s", strerror(errno));
-    }
+    CHPParserNotifyRefresh();
 
     OIC_LOG_V(DEBUG, TAG, "%s OUT", __func__);
     return OC_STACK_OK;
 }
-
@@ -0,0 +1,1073 @@
+/* ****************************************************************
+ *
+ * Copyright 2016 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "CoapHttpTranscoder.h"
+#include "CoapHttpParser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <inttypes.h>
+#include "cbor.h"
+#include "oic_malloc.h"
+#include "logger.h"
+
+#define TAG "CHPTranscoder"
+
+#define CHP_BUFFER_INITIAL_SIZE (256)
+
+/* Largest CBOR head: initial byte followed by an 8 byte argument */
+#define CHP_CBOR_HEAD_SIZE (9)
+
+/* Break code closing an indefinite length container. tinycbor only writes it through the
+ * container encoder, which cannot be kept across chunks as the output buffer moves. */
+#define CHP_CBOR_BREAK_BYTE (0xff)
+
+/* Largest double which still converts to an int64_t */
+#define CHP_MAX_INTEGRAL_DOUBLE (9223372036854774784.0)
+
+/* Longest text of a number written by CHPCborToJson */
+#define CHP_MAX_NUMBER_LENGTH (32)
+
+typedef enum
+{
+    CHP_LEX_NONE = 0,
+    CHP_LEX_STRING,
+    CHP_LEX_STRING_ESCAPE,
+    CHP_LEX_STRING_UNICODE,
+    CHP_LEX_NUMBER,
+    CHP_LEX_LITERAL
+} CHPJsonLexState_t;
+
+typedef enum
+{
+    CHP_EXPECT_VALUE = 0,
+    CHP_EXPECT_VALUE_OR_END,    /* Right after '[' */
+    CHP_EXPECT_KEY,
+    CHP_EXPECT_KEY_OR_END,      /* Right after '{' */
+    CHP_EXPECT_COLON,
+    CHP_EXPECT_COMMA_OR_END,
+    CHP_EXPECT_NOTHING          /* Root object complete */
+} CHPJsonExpect_t;
+
+/* OCF arrays are homogeneous, so array elements are typed by the first non null element. */
+typedef enum
+{
+    CHP_ELEMENT_NULL = 0,
+    CHP_ELEMENT_INT,
+    CHP_ELEMENT_DOUBLE,
+    CHP_ELEMENT_BOOL,
+    CHP_ELEMENT_STRING,
+    CHP_ELEMENT_OBJECT,
+    CHP_ELEMENT_ARRAY
+} CHPElementType_t;
+
+typedef struct
+{
+    bool isObject;
+    /* Container is dropped because it does not match the type of its parent array */
+    bool skip;
+    /* Type of the elements of an array */
+    CHPElementType_t elementType;
+    /* Type of the elements of the arrays nested in an array */
+    CHPElementType_t nestedElementType;
+} CHPJsonFrame_t;
+
+struct CHPJsonTranscoder
+{
+    CHPJsonLexState_t lexState;
+    CHPJsonExpect_t expect;
+    bool failed;
+
+    /* Unescaped string, number or literal being read, which may span chunks */
+    char *token;
+    size_t tokenLength;
+    size_t tokenSize;
+    bool tokenIsKey;
+
+    /* \uXXXX escape being read */
+    uint32_t codePoint;
+    uint8_t hexDigits;
+    uint32_t highSurrogate;
+
+    CHPJsonFrame_t frames[CHP_MAX_NESTING_DEPTH];
+    size_t depth;
+
+    uint8_t *out;
+    size_t outLength;
+    size_t outSize;
+};
+
+typedef struct
+{
+    char *buffer;
+    size_t length;
+    size_t size;
+} CHPJsonWriter_t;
+
+static bool CHPGrowBuffer(void **buffer, size_t *size, size_t used, size_t needed)
+{
+    if (*size - used >= needed)
+    {
+        return true;
+    }
+
+    size_t newSize = *size ? *size : CHP_BUFFER_INITIAL_SIZE;
+    while (newSize - used < needed)
+    {
+        newSize *= 2;
+    }
+
+    void *newBuffer = OICRealloc(*buffer, newSize);
+    if (!newBuffer)
+    {
+        OIC_LOG(ERROR, TAG, "Memory allocation failed");
+        return false;
+    }
+
+    *buffer = newBuffer;
+    *size = newSize;
+    return true;
+}
+
+static bool CHPJsonAppendToken(CHPJsonTranscoder_t *t, const char *data, size_t length)
+{
+    // Keep room for the terminator needed by strtod() and strtoll()
+    if (!CHPGrowBuffer((void **)&t->token, &t->tokenSize, t->tokenLength, length + 1))
+    {
+        return false;
+    }
+
+    memcpy(t->token + t->tokenLength, data, length);
+    t->tokenLength += length;
+    t->token[t->tokenLength] = '\0';
+    return true;
+}
+
+static bool CHPJsonAppendCodePoint(CHPJsonTranscoder_t *t, uint32_t codePoint)
+{
+    char utf8[4];
+    size_t length;
+
+    if (codePoint < 0x80)
+    {
+        utf8[0] = (char)codePoint;
+        length = 1;
+    }
+    else if (codePoint < 0x800)
+    {
+        utf8[0] = (char)(0xC0 | (codePoint >> 6));
+        utf8[1] = (char)(0x80 | (codePoint & 0x3F));
+        length = 2;
+    }
+    else if (codePoint < 0x10000)
+    {
+        utf8[0] = (char)(0xE0 | (codePoint >> 12));
+        utf8[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[2] = (char)(0x80 | (codePoint & 0x3F));
+        length = 3;
+    }
+    else
+    {
+        utf8[0] = (char)(0xF0 | (codePoint >> 18));
+        utf8[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+        utf8[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[3] = (char)(0x80 | (codePoint & 0x3F));
+        length = 4;
+    }
+
+    return CHPJsonAppendToken(t, utf8, length);
+}
+
+/* A high surrogate not followed by a low surrogate is replaced by U+FFFD */
+static bool CHPJsonFlushSurrogate(CHPJsonTranscoder_t *t)
+{
+    if (!t->highSurrogate)
+    {
+        return true;
+    }
+
+    t->highSurrogate = 0;
+    return CHPJsonAppendCodePoint(t, 0xFFFD);
+}
+
+static bool CHPJsonAppendEscape(CHPJsonTranscoder_t *t)
+{
+    uint32_t codePoint = t->codePoint;
+    if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+    {
+        if (!CHPJsonFlushSurrogate(t))
+        {
+            return false;
+        }
+        t->highSurrogate = codePoint;
+        return true;
+    }
+
+    if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+    {
+        if (!t->highSurrogate)
+        {
+            return CHPJsonAppendCodePoint(t, 0xFFFD);
+        }
+        codePoint = 0x10000 + ((t->highSurrogate - 0xD800) << 10) + (codePoint - 0xDC00);
+        t->highSurrogate = 0;
+        return CHPJsonAppendCodePoint(t, codePoint);
+    }
+
+    return CHPJsonFlushSurrogate(t) && CHPJsonAppendCodePoint(t, codePoint);
+}
+
+static bool CHPJsonBeginOutput(CHPJsonTranscoder_t *t, size_t needed, CborEncoder *encoder)
+{
+    if (!CHPGrowBuffer((void **)&t->out, &t->outSize, t->outLength, needed))
+    {
+        return false;
+    }
+
+    cbor_encoder_init(encoder, t->out + t->outLength, t->outSize - t->outLength, 0);
+    return true;
+}
+
+static bool CHPJsonEndOutput(CHPJsonTranscoder_t *t, const CborEncoder *encoder, CborError err)
+{
+    if (CborNoError != err)
+    {
+        OIC_LOG_V(ERROR, TAG, "CBOR encoding failed: %s", cbor_error_string(err));
+        return false;
+    }
+
+    t->outLength += cbor_encoder_get_buffer_size(encoder, t->out + t->outLength);
+    return true;
+}
+
+static bool CHPJsonEncodeText(CHPJsonTranscoder_t *t, const char *text, size_t length)
+{
+    CborEncoder encoder;
+    if (!CHPJsonBeginOutput(t, CHP_CBOR_HEAD_SIZE + length, &encoder))
+    {
+        return false;
+    }
+    return CHPJsonEndOutput(t, &encoder, cbor_encode_text_string(&encoder, text, length));
+}
+
+static bool CHPJsonEncodeScalar(CHPJsonTranscoder_t *t, CHPElementType_t type,
+                                int64_t intValue, double doubleValue)
+{
+    CborEncoder encoder;
+    if (!CHPJsonBeginOutput(t, CHP_CBOR_HEAD_SIZE, &encoder))
+    {
+        return false;
+    }
+
+    CborError err;
+    switch (type)
+    {
+        case CHP_ELEMENT_INT:
+            err = cbor_encode_int(&encoder, intValue);
+            break;
+        case CHP_ELEMENT_DOUBLE:
+            err = cbor_encode_double(&encoder, doubleValue);
+            break;
+        case CHP_ELEMENT_BOOL:
+            err = cbor_encode_boolean(&encoder, intValue != 0);
+            break;
+        default:
+            err = cbor_encode_null(&encoder);
+            break;
+    }
+    return CHPJsonEndOutput(t, &encoder, err);
+}
+
+/*
+ * Checks a value against the container it is added to. Values of a type other than the
+ * element type of their array are dropped, the way CHPJsonToRepPayload() drops them.
+ * Integers added to an array of doubles are converted.
+ */
+static bool CHPJsonAcceptValue(CHPJsonTranscoder_t *t, CHPElementType_t *type)
+{
+    if (0 == t->depth)
+    {
+        return true;
+    }
+
+    CHPJsonFrame_t *frame = &t->frames[t->depth - 1];
+    if (frame->skip)
+    {
+        return false;
+    }
+
+    if (frame->isObject || CHP_ELEMENT_NULL == *type)
+    {
+        return true;
+    }
+
+    if (CHP_ELEMENT_NULL == frame->elementType)
+    {
+        frame->elementType = *type;
+        if (t->depth >= 2 && !t->frames[t->depth - 2].isObject)
+        {
+            t->frames[t->depth - 2].nestedElementType = *type;
+        }
+        return true;
+    }
+
+    if (CHP_ELEMENT_DOUBLE == frame->elementType && CHP_ELEMENT_INT == *type)
+    {
+        *type = CHP_ELEMENT_DOUBLE;
+        return true;
+    }
+
+    if (frame->elementType != *type)
+    {
+        OIC_LOG(DEBUG, TAG, "Dropping array element of mismatching type");
+        return false;
+    }
+    return true;
+}
+
+static void CHPJsonValueDone(CHPJsonTranscoder_t *t)
+{
+    t->expect = t->depth ? CHP_EXPECT_COMMA_OR_END : CHP_EXPECT_NOTHING;
+}
+
+static bool CHPJsonOpen(CHPJsonTranscoder_t *t, bool isObject)
+{
+    if (0 == t->depth && !isObject)
+    {
+        OIC_LOG(ERROR, TAG, "JSON payload is not an object");
+        return false;
+    }
+
+    if (CHP_MAX_NESTING_DEPTH == t->depth)
+    {
+        OIC_LOG(ERROR, TAG, "JSON payload nested too deep");
+        return false;
+    }
+
+    CHPElementType_t type = isObject ? CHP_ELEMENT_OBJECT : CHP_ELEMENT_ARRAY;
+    bool emit = CHPJsonAcceptValue(t, &type);
+
+    CHPJsonFrame_t *frame = &t->frames[t->depth];
+    frame->isObject = isObject;
+    frame->skip = !emit;
+    frame->elementType = CHP_ELEMENT_NULL;
+    frame->nestedElementType = CHP_ELEMENT_NULL;
+    if (!isObject && t->depth > 0 && !t->frames[t->depth - 1].isObject)
+    {
+        // Sibling arrays share their element type.
+        frame->elementType = t->frames[t->depth - 1].nestedElementType;
+    }
+    t->depth++;
+    t->expect = isObject ? CHP_EXPECT_KEY_OR_END : CHP_EXPECT_VALUE_OR_END;
+
+    if (!emit)
+    {
+        return true;
+    }
+
+    CborEncoder encoder;
+    CborEncoder container;
+    if (!CHPJsonBeginOutput(t, 1, &encoder))
+    {
+        return false;
+    }
+
+    CborError err = isObject ?
+                    cbor_encoder_create_map(&encoder, &container, CborIndefiniteLength) :
+                    cbor_encoder_create_array(&encoder, &container, CborIndefiniteLength);
+    return CHPJsonEndOutput(t, &container, err);
+}
+
+static bool CHPJsonClose(CHPJsonTranscoder_t *t, bool isObject)
+{
+    if (0 == t->depth || t->frames[t->depth - 1].isObject != isObject)
+    {
+        OIC_LOG(ERROR, TAG, "Mismatched JSON container end");
+        return false;
+    }
+
+    t->depth--;
+    if (!t->frames[t->depth].skip)
+    {
+        if (!CHPGrowBuffer((void **)&t->out, &t->outSize, t->outLength, 1))
+        {
+            return false;
+        }
+        t->out[t->outLength++] = CHP_CBOR_BREAK_BYTE;
+    }
+
+    CHPJsonValueDone(t);
+    return true;
+}
+
+static bool CHPJsonEndString(CHPJsonTranscoder_t *t)
+{
+    if (!CHPJsonFlushSurrogate(t))
+    {
+        return false;
+    }
+
+    if (t->tokenIsKey)
+    {
+        t->expect = CHP_EXPECT_COLON;
+        if (t->frames[t->depth - 1].skip)
+        {
+            return true;
+        }
+        return CHPJsonEncodeText(t, t->token, t->tokenLength);
+    }
+
+    if (0 == t->depth)
+    {
+        OIC_LOG(ERROR, TAG, "JSON payload is not an object");
+        return false;
+    }
+
+    CHPElementType_t type = CHP_ELEMENT_STRING;
+    CHPJsonValueDone(t);
+    if (!CHPJsonAcceptValue(t, &type))
+    {
+        return true;
+    }
+    return CHPJsonEncodeText(t, t->token, t->tokenLength);
+}
+
+static bool CHPJsonEndNumberOrLiteral(CHPJsonTranscoder_t *t)
+{
+    if (0 == t->depth)
+    {
+        OIC_LOG(ERROR, TAG, "JSON payload is not an object");
+        return false;
+    }
+
+    CHPElementType_t type;
+    int64_t intValue = 0;
+    double doubleValue = 0;
+    char *end = NULL;
+
+    if (CHP_LEX_LITERAL == t->lexState)
+    {
+        if (0 == strcmp(t->token, "true"))
+        {
+            type = CHP_ELEMENT_BOOL;
+            intValue = 1;
+        }
+        else if (0 == strcmp(t->token, "false"))
+        {
+            type = CHP_ELEMENT_BOOL;
+        }
+        else if (0 == strcmp(t->token, "null"))
+        {
+            type = CHP_ELEMENT_NULL;
+        }
+        else
+        {
+            OIC_LOG_V(ERROR, TAG, "Invalid JSON literal %s", t->token);
+            return false;
+        }
+    }
+    else
+    {
+        errno = 0;
+        intValue = strtoll(t->token, &end, 10);
+        if (end == t->token + t->tokenLength && 0 == errno)
+        {
+            type = CHP_ELEMENT_INT;
+        }
+        else
+        {
+            doubleValue = strtod(t->token, &end);
+            if (end != t->token + t->tokenLength)
+            {
+                OIC_LOG_V(ERROR, TAG, "Invalid JSON number %s", t->token);
+                return false;
+            }
+
+            // Integral values are sent as integers, as CHPJsonToRepPayload() does.
+            if (fabs(doubleValue) <= CHP_MAX_INTEGRAL_DOUBLE &&
+                doubleValue == (double)(int64_t)doubleValue)
+            {
+                type = CHP_ELEMENT_INT;
+                intValue = (int64_t)doubleValue;
+            }
+            else
+            {
+                type = CHP_ELEMENT_DOUBLE;
+            }
+        }
+    }
+
+    CHPJsonValueDone(t);
+    CHPElementType_t acceptedType = type;
+    if (!CHPJsonAcceptValue(t, &acceptedType))
+    {
+        return true;
+    }
+
+    if (CHP_ELEMENT_DOUBLE == acceptedType && CHP_ELEMENT_INT == type)
+    {
+        doubleValue = (double)intValue;
+    }
+    return CHPJsonEncodeScalar(t, acceptedType, intValue, doubleValue);
+}
+
+static bool CHPJsonLexString(CHPJsonTranscoder_t *t, char c)
+{
+    switch (t->lexState)
+    {
+        case CHP_LEX_STRING:
+            if ('"' == c)
+            {
+                t->lexState = CHP_LEX_NONE;
+                return CHPJsonEndString(t);
+            }
+            if ('\\' == c)
+            {
+                t->lexState = CHP_LEX_STRING_ESCAPE;
+                return true;
+            }
+            if ((unsigned char)c < 0x20)
+            {
+                OIC_LOG(ERROR, TAG, "Control character in JSON string");
+                return false;
+            }
+            return CHPJsonFlushSurrogate(t) && CHPJsonAppendToken(t, &c, 1);
+
+        case CHP_LEX_STRING_ESCAPE:
+        {
+            char unescaped;
+            switch (c)
+            {
+                case '"':
+                case '\\':
+                case '/':
+                    unescaped = c;
+                    break;
+                case 'b':
+                    unescaped = '\b';
+                    break;
+                case 'f':
+                    unescaped = '\f';
+                    break;
+                case 'n':
+                    unescaped = '\n';
+                    break;
+                case 'r':
+                    unescaped = '\r';
+                    break;
+                case 't':
+                    unescaped = '\t';
+                    break;
+                case 'u':
+                    t->lexState = CHP_LEX_STRING_UNICODE;
+                    t->codePoint = 0;
+                    t->hexDigits = 0;
+                    return true;
+                default:
+                    OIC_LOG_V(ERROR, TAG, "Invalid JSON escape \\%c", c);
+                    return false;
+            }
+            t->lexState = CHP_LEX_STRING;
+            return CHPJsonFlushSurrogate(t) && CHPJsonAppendToken(t, &unescaped, 1);
+        }
+
+        case CHP_LEX_STRING_UNICODE:
+        {
+            uint32_t digit;
+            if (c >= '0' && c <= '9')
+            {
+                digit = c - '0';
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                digit = c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                digit = c - 'A' + 10;
+            }
+            else
+            {
+                OIC_LOG(ERROR, TAG, "Invalid JSON unicode escape");
+                return false;
+            }
+
+            t->codePoint = (t->codePoint << 4) | digit;
+            if (++t->hexDigits < 4)
+            {
+                return true;
+            }
+            t->lexState = CHP_LEX_STRING;
+            return CHPJsonAppendEscape(t);
+        }
+
+        default:
+            return false;
+    }
+}
+
+static bool CHPJsonExpectsValue(const CHPJsonTranscoder_t *t)
+{
+    return CHP_EXPECT_VALUE == t->expect || CHP_EXPECT_VALUE_OR_END == t->expect;
+}
+
+static bool CHPJsonLexStructural(CHPJsonTranscoder_t *t, char c)
+{
+    switch (c)
+    {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+            return true;
+        case '{':
+        case '[':
+            if (!CHPJsonExpectsValue(t))
+            {
+                break;
+            }
+            return CHPJsonOpen(t, '{' == c);
+        case '}':
+            if (CHP_EXPECT_COMMA_OR_END != t->expect && CHP_EXPECT_KEY_OR_END != t->expect)
+            {
+                break;
+            }
+            return CHPJsonClose(t, true);
+        case ']':
+            if (CHP_EXPECT_COMMA_OR_END != t->expect && CHP_EXPECT_VALUE_OR_END != t->expect)
+            {
+                break;
+            }
+            return CHPJsonClose(t, false);
+        case ',':
+            if (CHP_EXPECT_COMMA_OR_END != t->expect)
+            {
+                break;
+            }
+            t->expect = t->frames[t->depth - 1].isObject ? CHP_EXPECT_KEY : CHP_EXPECT_VALUE;
+            return true;
+        case ':':
+            if (CHP_EXPECT_COLON != t->expect)
+            {
+                break;
+            }
+            t->expect = CHP_EXPECT_VALUE;
+            return true;
+        case '"':
+            if (CHP_EXPECT_KEY == t->expect || CHP_EXPECT_KEY_OR_END == t->expect)
+            {
+                t->tokenIsKey = true;
+            }
+            else if (CHPJsonExpectsValue(t))
+            {
+                t->tokenIsKey = false;
+            }
+            else
+            {
+                break;
+            }
+            t->lexState = CHP_LEX_STRING;
+            t->tokenLength = 0;
+            return CHPJsonAppendToken(t, "", 0);
+        default:
+            if (!CHPJsonExpectsValue(t))
+            {
+                break;
+            }
+            if ('-' == c || (c >= '0' && c <= '9'))
+            {
+                t->lexState = CHP_LEX_NUMBER;
+            }
+            else if (c >= 'a' && c <= 'z')
+            {
+                t->lexState = CHP_LEX_LITERAL;
+            }
+            else
+            {
+                break;
+            }
+            t->tokenLength = 0;
+            return CHPJsonAppendToken(t, &c, 1);
+    }
+
+    OIC_LOG_V(ERROR, TAG, "Unexpected character '%c' in JSON payload", c);
+    return false;
+}
+
+static bool CHPJsonIsTokenChar(CHPJsonLexState_t state, char c)
+{
+    if (CHP_LEX_NUMBER == state)
+    {
+        return (c >= '0' && c <= '9') || '-' == c || '+' == c || '.' == c ||
+               'e' == c || 'E' == c;
+    }
+    return c >= 'a' && c <= 'z';
+}
+
+CHPJsonTranscoder_t *CHPJsonTranscoderCreate()
+{
+    CHPJsonTranscoder_t *transcoder = OICCalloc(1, sizeof(CHPJsonTranscoder_t));
+    if (!transcoder)
+    {
+        OIC_LOG(ERROR, TAG, "Memory allocation failed");
+    }
+    return transcoder;
+}
+
+OCStackResult CHPJsonTranscoderFeed(CHPJsonTranscoder_t *transcoder, const char *data,
+                                    size_t length)
+{
+    VERIFY_NON_NULL_RET(transcoder, TAG, "transcoder", OC_STACK_INVALID_PARAM);
+    VERIFY_NON_NULL_RET(data, TAG, "data", OC_STACK_INVALID_PARAM);
+
+    CHPJsonTranscoder_t *t = transcoder;
+    size_t i = 0;
+    while (i < length && !t->failed)
+    {
+        char c = data[i];
+        if (CHP_LEX_NUMBER == t->lexState || CHP_LEX_LITERAL == t->lexState)
+        {
+            if (CHPJsonIsTokenChar(t->lexState, c))
+            {
+                t->failed = !CHPJsonAppendToken(t, &c, 1);
+                i++;
+                continue;
+            }
+
+            // The token ends here, the character itself is handled below.
+            t->failed = !CHPJsonEndNumberOrLiteral(t);
+            t->lexState = CHP_LEX_NONE;
+            if (t->failed)
+            {
+                break;
+            }
+        }
+
+        if (CHP_LEX_NONE == t->lexState)
+        {
+            t->failed = !CHPJsonLexStructural(t, c);
+        }
+        else
+        {
+            t->failed = !CHPJsonLexString(t, c);
+        }
+        i++;
+    }
+
+    return t->failed ? OC_STACK_ERROR : OC_STACK_OK;
+}
+
+OCStackResult CHPJsonTranscoderFinish(CHPJsonTranscoder_t *transcoder, uint8_t **cbor,
+                                      size_t *cborLength)
+{
+    VERIFY_NON_NULL_RET(transcoder, TAG, "transcoder", OC_STACK_INVALID_PARAM);
+    VERIFY_NON_NULL_RET(cbor, TAG, "cbor", OC_STACK_INVALID_PARAM);
+    VERIFY_NON_NULL_RET(cborLength, TAG, "cborLength", OC_STACK_INVALID_PARAM);
+
+    if (transcoder->failed || CHP_LEX_NONE != transcoder->lexState ||
+        CHP_EXPECT_NOTHING != transcoder->expect)
+    {
+        OIC_LOG(ERROR, TAG, "Incomplete or invalid JSON payload");
+        return OC_STACK_ERROR;
+    }
+
+    *cbor = transcoder->out;
+    *cborLength = transcoder->outLength;
+    transcoder->out = NULL;
+    transcoder->outLength = 0;
+    transcoder->outSize = 0;
+    return OC_STACK_OK;
+}
+
+void CHPJsonTranscoderDestroy(CHPJsonTranscoder_t *transcoder)
+{
+    if (transcoder)
+    {
+        OICFree(transcoder->token);
+        OICFree(transcoder->out);
+        OICFree(transcoder);
+    }
+}
+
+/* Writes the shortest of %.15g and %.17g which reads back as the same double */
+static void CHPFormatDouble(double value, char *text, size_t size)
+{
+    snprintf(text, size, "%.15g", value);
+    if (strtod(text, NULL) != value)
+    {
+        snprintf(text, size, "%.17g", value);
+    }
+}
+
+static bool CHPJsonWrite(CHPJsonWriter_t *w, const char *data, size_t length)
+{
+    if (!CHPGrowBuffer((void **)&w->buffer, &w->size, w->length, length + 1))
+    {
+        return false;
+    }
+
+    memcpy(w->buffer + w->length, data, length);
+    w->length += length;
+    w->buffer[w->length] = '\0';
+    return true;
+}
+
+static bool CHPJsonWriteString(CHPJsonWriter_t *w, const char *string, size_t length)
+{
+    if (!CHPJsonWrite(w, "\"", 1))
+    {
+        return false;
+    }
+
+    // Copy runs of characters which need no escaping in one go.
+    size_t runStart = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned char c = (unsigned char)string[i];
+        if (c >= 0x20 && '"' != c && '\\' != c)
+        {
+            continue;
+        }
+
+        char escaped[8];
+        switch (c)
+        {
+            case '"':
+                strcpy(escaped, "\\\"");
+                break;
+            case '\\':
+                strcpy(escaped, "\\\\");
+                break;
+            case '\n':
+                strcpy(escaped, "\\n");
+                break;
+            case '\r':
+                strcpy(escaped, "\\r");
+                break;
+            case '\t':
+                strcpy(escaped, "\\t");
+                break;
+            default:
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                break;
+        }
+
+        if (!CHPJsonWrite(w, string + runStart, i - runStart) ||
+            !CHPJsonWrite(w, escaped, strlen(escaped)))
+        {
+            return false;
+        }
+        runStart = i + 1;
+    }
+
+    return CHPJsonWrite(w, string + runStart, length - runStart) && CHPJsonWrite(w, "\"", 1);
+}
+
+static bool CHPJsonWriteCborString(CHPJsonWriter_t *w, CborValue *value, CborError *err)
+{
+    char *string = NULL;
+    size_t length = 0;
+    *err = cbor_value_dup_text_string(value, &string, &length, NULL);
+    if (CborNoError != *err)
+    {
+        return true;
+    }
+
+    bool written = CHPJsonWriteString(w, string, length);
+    OICFree(string);
+    *err = cbor_value_advance(value);
+    return written;
+}
+
+/* Writes a CBOR value other than a container or tag and advances past it */
+static bool CHPJsonWriteCborScalar(CHPJsonWriter_t *w, CborValue *value, CborError *err)
+{
+    char number[CHP_MAX_NUMBER_LENGTH];
+    const char *text = "null";
+
+    *err = CborNoError;
+    switch (cbor_value_get_type(value))
+    {
+        case CborTextStringType:
+            return CHPJsonWriteCborString(w, value, err);
+        case CborIntegerType:
+        {
+            int64_t intValue = 0;
+            *err = cbor_value_get_int64(value, &intValue);
+            snprintf(number, sizeof(number), "%" PRId64, intValue);
+            text = number;
+            break;
+        }
+        case CborBooleanType:
+        {
+            bool boolValue = false;
+            *err = cbor_value_get_boolean(value, &boolValue);
+            text = boolValue ? "true" : "false";
+            break;
+        }
+        case CborDoubleType:
+        case CborFloatType:
+        {
+            double doubleValue = 0;
+            if (cbor_value_is_double(value))
+            {
+                *err = cbor_value_get_double(value, &doubleValue);
+            }
+            else
+            {
+                float floatValue = 0;
+                *err = cbor_value_get_float(value, &floatValue);
+                doubleValue = floatValue;
+            }
+
+            // JSON has no representation for NaN and infinities.
+            if (isfinite(doubleValue))
+            {
+                CHPFormatDouble(doubleValue, number, sizeof(number));
+                text = number;
+            }
+            break;
+        }
+        case CborNullType:
+            break;
+        default:
+            OIC_LOG_V(INFO, TAG, "Unsupported CBOR type %d written as null",
+                      cbor_value_get_type(value));
+            break;
+    }
+
+    if (CborNoError != *err)
+    {
+        return true;
+    }
+
+    *err = cbor_value_advance(value);
+    return CHPJsonWrite(w, text, strlen(text));
+}
+
+OCStackResult CHPCborToJson(const uint8_t *cbor, size_t cborLength, char **json,
+                            size_t *jsonLength)
+{
+    VERIFY_NON_NULL_RET(cbor, TAG, "cbor", OC_STACK_INVALID_PARAM);
+    VERIFY_NON_NULL_RET(json, TAG, "json", OC_STACK_INVALID_PARAM);
+    VERIFY_NON_NULL_RET(jsonLength, TAG, "jsonLength", OC_STACK_INVALID_PARAM);
+
+    CborParser parser;
+    CborValue values[CHP_MAX_NESTING_DEPTH + 1];
+    bool isMap[CHP_MAX_NESTING_DEPTH + 1];
+    bool isFirst[CHP_MAX_NESTING_DEPTH + 1];
+    bool expectKey[CHP_MAX_NESTING_DEPTH + 1];
+    size_t depth = 0;
+    CHPJsonWriter_t writer = { .buffer = NULL };
+    bool written = true;
+
+    CborError err = cbor_parser_init(cbor, cborLength, 0, &parser, &values[0]);
+    if (CborNoError == err && !cbor_value_is_map(&values[0]))
+    {
+        OIC_LOG(ERROR, TAG, "CBOR payload is not a map");
+        err = CborErrorIllegalType;
+    }
+
+    while (CborNoError == err && written)
+    {
+        CborValue *value = &values[depth];
+        if (depth > 0 && cbor_value_at_end(value))
+        {
+            written = CHPJsonWrite(&writer, isMap[depth] ? "}" : "]", 1);
+            err = cbor_value_leave_container(&values[depth - 1], value);
+            if (0 == --depth)
+            {
+                break;
+            }
+            continue;
+        }
+
+        // Tags carry no meaning in JSON, keep only the tagged item.
+        if (CborTagType == cbor_value_get_type(value))
+        {
+            err = cbor_value_advance(value);
+            continue;
+        }
+
+        if (depth > 0)
+        {
+            if (!isMap[depth] || expectKey[depth])
+            {
+                if (!isFirst[depth])
+                {
+                    written = CHPJsonWrite(&writer, ",", 1);
+                }
+                isFirst[depth] = false;
+            }
+
+            if (isMap[depth] && expectKey[depth])
+            {
+                if (!cbor_value_is_text_string(value))
+                {
+                    OIC_LOG(ERROR, TAG, "CBOR map key is not a text string");
+                    err = CborErrorIllegalType;
+                    break;
+                }
+                written = written && CHPJsonWriteCborString(&writer, value, &err) &&
+                          CHPJsonWrite(&writer, ":", 1);
+                expectKey[depth] = false;
+                continue;
+            }
+            expectKey[depth] = true;
+        }
+
+        if (cbor_value_is_container(value))
+        {
+            if (CHP_MAX_NESTING_DEPTH == depth)
+            {
+                OIC_LOG(ERROR, TAG, "CBOR payload nested too deep");
+                err = CborErrorNestingTooDeep;
+                break;
+            }
+
+            bool map = cbor_value_is_map(value);
+            written = written && CHPJsonWrite(&writer, map ? "{" : "[", 1);
+            err = cbor_value_enter_container(value, &values[depth + 1]);
+            depth++;
+            isMap[depth] = map;
+            isFirst[depth] = true;
+            expectKey[depth] = true;
+            continue;
+        }
+
+        written = written && CHPJsonWriteCborScalar(&writer, value, &err);
+    }
+
+    if (!written || CborNoError != err)
+    {
+        if (CborNoError != err)
+        {
+            OIC_LOG_V(ERROR, TAG, "CBOR to JSON failed: %s", cbor_error_string(err));
+        }
+        OICFree(writer.buffer);
+        return written ? OC_STACK_ERROR : OC_STACK_NO_MEMORY;
+    }
+
+    *json = writer.buffer;
+    *jsonLength = writer.length;
+    return OC_STACK_OK;
+}
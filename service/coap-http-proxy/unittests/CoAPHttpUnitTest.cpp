@@ -28,12 +28,23 @@
 #include "uarraylist.h"
 #include "CoapHttpParser.h"
 #include "CoapHttpMap.h"
+#include "CoapHttpTranscoder.h"
 #include "cJSON.h"
 
 #include <signal.h>
 #ifdef HAVE_UNISTD_H
 #include <unistd.h>
 #endif
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 
 typedef struct
@@ -126,3 +137,385 @@ TEST_F(CoApHttpTest, CHPParserTerminate)
     EXPECT_EQ(OC_STACK_OK, (CHPParserTerminate()));
 }
 
+static OCStackResult transcodeJson(const char *json, size_t chunkSize, uint8_t **cbor,
+                                   size_t *cborLength)
+{
+    CHPJsonTranscoder_t *transcoder = CHPJsonTranscoderCreate();
+    OCStackResult result = OC_STACK_OK;
+    size_t length = strlen(json);
+    for (size_t offset = 0; offset < length && OC_STACK_OK == result; offset += chunkSize)
+    {
+        size_t chunk = length - offset < chunkSize ? length - offset : chunkSize;
+        result = CHPJsonTranscoderFeed(transcoder, json + offset, chunk);
+    }
+    if (OC_STACK_OK == result)
+    {
+        result = CHPJsonTranscoderFinish(transcoder, cbor, cborLength);
+    }
+    CHPJsonTranscoderDestroy(transcoder);
+    return result;
+}
+
+TEST_F(CoApHttpTest, CHPJsonTranscoderRoundTrip)
+{
+    const char *json = "{\"int\":-7,\"dbl\":2.5,\"str\":\"a\\\"b\",\"bool\":true,"
+                       "\"null\":null,\"arr\":[1,2,3],\"obj\":{\"x\":[\"y\"]}}";
+    uint8_t *cbor = NULL;
+    size_t cborLength = 0;
+    ASSERT_EQ(OC_STACK_OK, transcodeJson(json, strlen(json), &cbor, &cborLength));
+
+    char *out = NULL;
+    size_t outLength = 0;
+    EXPECT_EQ(OC_STACK_OK, CHPCborToJson(cbor, cborLength, &out, &outLength));
+    EXPECT_STREQ(json, out);
+    EXPECT_EQ(strlen(json), outLength);
+    OICFree(out);
+    OICFree(cbor);
+}
+
+TEST_F(CoApHttpTest, CHPJsonTranscoderChunked)
+{
+    const char *json = "{ \"name\" : \"caf\\u00e9\", \"values\" : [ 1.5, 2, 1e3 ] }";
+    uint8_t *whole = NULL;
+    size_t wholeLength = 0;
+    ASSERT_EQ(OC_STACK_OK, transcodeJson(json, strlen(json), &whole, &wholeLength));
+
+    uint8_t *bytewise = NULL;
+    size_t bytewiseLength = 0;
+    ASSERT_EQ(OC_STACK_OK, transcodeJson(json, 1, &bytewise, &bytewiseLength));
+    ASSERT_EQ(wholeLength, bytewiseLength);
+    EXPECT_EQ(0, memcmp(whole, bytewise, wholeLength));
+
+    char *out = NULL;
+    size_t outLength = 0;
+    EXPECT_EQ(OC_STACK_OK, CHPCborToJson(whole, wholeLength, &out, &outLength));
+    EXPECT_STREQ("{\"name\":\"caf\xc3\xa9\",\"values\":[1.5,2,1000]}", out);
+    OICFree(out);
+    OICFree(bytewise);
+    OICFree(whole);
+}
+
+TEST_F(CoApHttpTest, CHPJsonTranscoderShortestDouble)
+{
+    const char *json = "{\"a\":0.1,\"b\":0.30000000000000004,\"c\":-1.25e+300}";
+    uint8_t *cbor = NULL;
+    size_t cborLength = 0;
+    ASSERT_EQ(OC_STACK_OK, transcodeJson(json, strlen(json), &cbor, &cborLength));
+
+    char *out = NULL;
+    size_t outLength = 0;
+    EXPECT_EQ(OC_STACK_OK, CHPCborToJson(cbor, cborLength, &out, &outLength));
+    EXPECT_STREQ(json, out);
+    OICFree(out);
+    OICFree(cbor);
+}
+
+TEST_F(CoApHttpTest, CHPJsonTranscoderInvalid)
+{
+    uint8_t *cbor = NULL;
+    size_t cborLength = 0;
+    EXPECT_NE(OC_STACK_OK, transcodeJson("[1,2]", 5, &cbor, &cborLength));
+    EXPECT_NE(OC_STACK_OK, transcodeJson("{\"a\":1", 6, &cbor, &cborLength));
+    EXPECT_NE(OC_STACK_OK, transcodeJson("{\"a\":1,}", 8, &cbor, &cborLength));
+    EXPECT_NE(OC_STACK_OK, transcodeJson("{\"a\":[[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]]}", 4,
+                                         &cbor, &cborLength));
+    EXPECT_TRUE(NULL == cbor);
+}
+
+/*
+ * HTTP server on the loopback interface answering one request per connection.
+ * The request headers are recorded and the response is built by the handler.
+ */
+class HttpTestServer
+{
+public:
+    typedef std::function<std::string(const std::string &request)> Handler;
+
+    HttpTestServer(Handler handler) : m_handler(handler), m_port(0)
+    {
+        m_socket = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(addr);
+        if (0 == bind(m_socket, (struct sockaddr *)&addr, length) &&
+            0 == listen(m_socket, 8) &&
+            0 == getsockname(m_socket, (struct sockaddr *)&addr, &length))
+        {
+            m_port = ntohs(addr.sin_port);
+        }
+        m_thread = std::thread(&HttpTestServer::serve, this);
+    }
+
+    ~HttpTestServer()
+    {
+        shutdown(m_socket, SHUT_RDWR);
+        close(m_socket);
+        m_thread.join();
+    }
+
+    std::string url(const char *path) const
+    {
+        return "http://127.0.0.1:" + std::to_string(m_port) + path;
+    }
+
+    std::vector<std::string> requests()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_requests;
+    }
+
+private:
+    void serve()
+    {
+        int client;
+        while (0 <= (client = accept(m_socket, NULL, NULL)))
+        {
+            std::string request;
+            char buffer[512];
+            ssize_t length;
+            while (std::string::npos == request.find("\r\n\r\n") &&
+                   0 < (length = recv(client, buffer, sizeof(buffer), 0)))
+            {
+                request.append(buffer, length);
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_requests.push_back(request);
+            }
+            std::string response = m_handler(request);
+            send(client, response.data(), response.size(), 0);
+            close(client);
+        }
+    }
+
+    Handler m_handler;
+    int m_socket;
+    uint16_t m_port;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::vector<std::string> m_requests;
+};
+
+static std::string httpResponse(const char *status, const char *headers, const char *body)
+{
+    return std::string("HTTP/1.1 ") + status + "\r\nConnection: close\r\n" +
+           "Content-Type: text/plain\r\nContent-Length: " + std::to_string(strlen(body)) +
+           "\r\n" + headers + "\r\n" + body;
+}
+
+/* Collects the responses delivered by the parser. */
+class HttpResponses
+{
+public:
+    static void callback(const HttpResponse_t *response, void *context)
+    {
+        HttpResponses *responses = (HttpResponses *)context;
+        std::lock_guard<std::mutex> lock(responses->m_mutex);
+        responses->m_status.push_back(response->status);
+        responses->m_payloads.push_back(
+            std::string((const char *)response->payload, response->payloadLength));
+        responses->m_condition.notify_all();
+    }
+
+    bool wait(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_condition.wait_for(lock, std::chrono::seconds(5),
+                                    [&] { return m_status.size() >= count; });
+    }
+
+    std::vector<int> m_status;
+    std::vector<std::string> m_payloads;
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+};
+
+class CoApHttpCacheTest: public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(OC_STACK_OK, CHPParserInitialize());
+    }
+
+    void TearDown()
+    {
+        CHPParserTerminate();
+    }
+
+    // Sends a GET request and waits for its response.
+    void get(const std::string &url, HttpResponses &responses, size_t count,
+             u_arraylist_t *headerOptions = NULL, const char *accept = ACCEPT_MEDIA_TYPE)
+    {
+        post(CHP_GET, url, responses, headerOptions, accept);
+        ASSERT_TRUE(responses.wait(count));
+    }
+
+    void post(HttpMethod_t method, const std::string &url, HttpResponses &responses,
+              u_arraylist_t *headerOptions = NULL, const char *accept = ACCEPT_MEDIA_TYPE)
+    {
+        HttpRequest_t request;
+        memset(&request, 0, sizeof(request));
+        request.httpMajor = 1;
+        request.httpMinor = 1;
+        request.method = method;
+        request.headerOptions = headerOptions;
+        OICStrcpy(request.resourceUri, sizeof(request.resourceUri), url.c_str());
+        OICStrcpy(request.acceptFormat, sizeof(request.acceptFormat), accept);
+        EXPECT_EQ(OC_STACK_OK,
+                  CHPPostHttpRequest(&request, HttpResponses::callback, &responses));
+    }
+};
+
+TEST_F(CoApHttpCacheTest, FreshResponseServedFromCache)
+{
+    HttpTestServer server([](const std::string &)
+    {
+        return httpResponse("200 OK", "Cache-Control: public, max-age=60\r\n", "fresh");
+    });
+    HttpResponses responses;
+
+    get(server.url("/fresh"), responses, 1);
+    get(server.url("/fresh"), responses, 2);
+
+    EXPECT_EQ(1u, server.requests().size());
+    EXPECT_EQ(CHP_SUCCESS, responses.m_status[1]);
+    EXPECT_EQ("fresh", responses.m_payloads[1]);
+}
+
+TEST_F(CoApHttpCacheTest, ResponseNotStored)
+{
+    HttpTestServer server([](const std::string &request)
+    {
+        if (std::string::npos != request.find("/private"))
+        {
+            return httpResponse("200 OK", "Cache-Control: private, max-age=60\r\n", "a");
+        }
+        if (std::string::npos != request.find("/expired"))
+        {
+            return httpResponse("200 OK", "Expires: Thu, 01 Jan 1970 00:00:00 GMT\r\n", "b");
+        }
+        return httpResponse("200 OK", "Cache-Control: no-store\r\n", "c");
+    });
+    HttpResponses responses;
+
+    get(server.url("/private"), responses, 1);
+    get(server.url("/private"), responses, 2);
+    get(server.url("/expired"), responses, 3);
+    get(server.url("/expired"), responses, 4);
+    get(server.url("/nostore"), responses, 5);
+    get(server.url("/nostore"), responses, 6);
+
+    EXPECT_EQ(6u, server.requests().size());
+}
+
+TEST_F(CoApHttpCacheTest, StaleResponseRevalidated)
+{
+    HttpTestServer server([](const std::string &request)
+    {
+        if (std::string::npos != request.find("If-None-Match: \"v1\""))
+        {
+            return httpResponse("304 Not Modified", "Cache-Control: max-age=60\r\n", "");
+        }
+        return httpResponse("200 OK", "Cache-Control: no-cache\r\nETag: \"v1\"\r\n", "body");
+    });
+    HttpResponses responses;
+
+    get(server.url("/stale"), responses, 1);
+    get(server.url("/stale"), responses, 2);
+    // The revalidated response is fresh again.
+    get(server.url("/stale"), responses, 3);
+
+    std::vector<std::string> requests = server.requests();
+    ASSERT_EQ(2u, requests.size());
+    EXPECT_EQ(std::string::npos, requests[0].find("If-None-Match"));
+    EXPECT_NE(std::string::npos, requests[1].find("If-None-Match: \"v1\""));
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(CHP_SUCCESS, responses.m_status[i]);
+        EXPECT_EQ("body", responses.m_payloads[i]);
+    }
+}
+
+TEST_F(CoApHttpCacheTest, IdenticalRequestsCoalesced)
+{
+    HttpTestServer server([](const std::string &)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        return httpResponse("200 OK", "Cache-Control: no-store\r\n", "once");
+    });
+    HttpResponses responses;
+
+    post(CHP_GET, server.url("/slow"), responses);
+    post(CHP_GET, server.url("/slow"), responses);
+    // A request for another format is not answered with the same response.
+    post(CHP_GET, server.url("/slow"), responses, NULL, JSON_CONTENT_TYPE);
+    ASSERT_TRUE(responses.wait(3));
+
+    EXPECT_EQ(2u, server.requests().size());
+    EXPECT_EQ("once", responses.m_payloads[0]);
+    EXPECT_EQ("once", responses.m_payloads[1]);
+}
+
+TEST_F(CoApHttpCacheTest, CachedPerAcceptedFormat)
+{
+    HttpTestServer server([](const std::string &)
+    {
+        return httpResponse("200 OK", "Cache-Control: max-age=60\r\n", "variant");
+    });
+    HttpResponses responses;
+
+    get(server.url("/variant"), responses, 1);
+    get(server.url("/variant"), responses, 2, NULL, JSON_CONTENT_TYPE);
+    get(server.url("/variant"), responses, 3, NULL, JSON_CONTENT_TYPE);
+
+    EXPECT_EQ(2u, server.requests().size());
+}
+
+TEST_F(CoApHttpCacheTest, AuthorizedRequestsNotShared)
+{
+    HttpTestServer server([](const std::string &)
+    {
+        return httpResponse("200 OK", "Cache-Control: public, max-age=60\r\n", "secret");
+    });
+    HttpResponses responses;
+
+    HttpHeaderOption_t authorization;
+    memset(&authorization, 0, sizeof(authorization));
+    OICStrcpy(authorization.optionName, sizeof(authorization.optionName),
+              HTTP_OPTION_AUTHORIZATION);
+    OICStrcpy(authorization.optionData, sizeof(authorization.optionData), "Basic dTpw");
+    u_arraylist_t *headerOptions = u_arraylist_create();
+    u_arraylist_add(headerOptions, &authorization);
+
+    get(server.url("/secret"), responses, 1, headerOptions);
+    get(server.url("/secret"), responses, 2, headerOptions);
+    get(server.url("/secret"), responses, 3);
+    get(server.url("/secret"), responses, 4);
+    u_arraylist_free(&headerOptions);
+
+    // Only the responses to the requests without authorization are shared.
+    EXPECT_EQ(3u, server.requests().size());
+}
+
+TEST_F(CoApHttpCacheTest, ModifyingRequestInvalidatesCache)
+{
+    HttpTestServer server([](const std::string &)
+    {
+        return httpResponse("200 OK", "Cache-Control: max-age=60\r\n", "state");
+    });
+    HttpResponses responses;
+
+    get(server.url("/state"), responses, 1);
+    get(server.url("/state"), responses, 2, NULL, JSON_CONTENT_TYPE);
+    post(CHP_DELETE, server.url("/state"), responses);
+    ASSERT_TRUE(responses.wait(3));
+    get(server.url("/state"), responses, 4);
+    get(server.url("/state"), responses, 5, NULL, JSON_CONTENT_TYPE);
+
+    EXPECT_EQ(5u, server.requests().size());
+}
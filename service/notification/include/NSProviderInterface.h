@@ -71,6 +71,27 @@ typedef struct
 
 } NSProviderConfig;
 
+/**
+ *  Statistics of the provider notification queue
+ */
+typedef struct
+{
+    /* Number of messages and sync informations taken from the queue */
+    uint64_t processedTasks;
+    /* Number of tasks waiting in the queue */
+    uint64_t pendingTasks;
+    /* Total and longest time tasks waited in the queue, in microseconds */
+    uint64_t totalLatency;
+    uint64_t maxLatency;
+    /* Same for sync informations only, which are queued ahead of messages */
+    uint64_t syncTasks;
+    uint64_t syncTotalLatency;
+    uint64_t syncMaxLatency;
+    /* Number of batches the messages were sent in */
+    uint64_t batches;
+
+} NSProviderQueueStats;
+
 /**
  * Initialize notification service for provider
  * @param[in]  config   Refer to NSProviderConfig
@@ -183,6 +204,13 @@ NSTopicLL * NSProviderGetConsumerTopics(const char * consumerId);
  */
 NSTopicLL * NSProviderGetTopics();
 
+/**
+ * Get the statistics of the notification queue since the provider was started
+ * @param[out] stats  Statistics of the queue
+ * @return ::NS_OK if the statistics are filled or NS_FAIL if provider is not started
+ */
+NSResult NSProviderGetQueueStats(NSProviderQueueStats * stats);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -75,6 +75,12 @@
 // SCHEDULE //
 #define THREAD_COUNT               5
 
+// Notifications queued together are sent in one pass of the notification
+// scheduler, sharing the observer lookup per topic.
+#define NS_NOTIFICATION_BATCH_SIZE   16
+// Time in milliseconds the scheduler waits for more notifications to join a batch
+#define NS_NOTIFICATION_BATCH_WINDOW 2
+
 // NOTIOBJ //
 #define NOTIOBJ_TITLE_KEY          "title"
 #define NOTIOBJ_ID_KEY             "id"
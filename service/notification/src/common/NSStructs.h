@@ -35,6 +35,7 @@ typedef struct _nsTask
     NSTaskType taskType;
     void * taskData;
     struct _nsTask * nextTask;
+    uint64_t queuedTime;
 
 } NSTask;
 
@@ -78,8 +78,7 @@ void * NSCallbackResponseSchedule(void * ptr)
 
         if (NSHeadMsg[CALLBACK_RESPONSE_SCHEDULER] != NULL)
         {
-            NSTask *node = NSHeadMsg[CALLBACK_RESPONSE_SCHEDULER];
-            NSHeadMsg[CALLBACK_RESPONSE_SCHEDULER] = node->nextTask;
+            NSTask *node = NSPopQueue(CALLBACK_RESPONSE_SCHEDULER);
 
             switch (node->taskType)
             {
@@ -62,8 +62,7 @@ void * NSDiscoverySchedule(void * ptr)
 
         if (NSHeadMsg[DISCOVERY_SCHEDULER] != NULL)
         {
-            NSTask *node = NSHeadMsg[DISCOVERY_SCHEDULER];
-            NSHeadMsg[DISCOVERY_SCHEDULER] = node->nextTask;
+            NSTask *node = NSPopQueue(DISCOVERY_SCHEDULER);
 
             switch (node->taskType)
             {
@@ -504,3 +504,28 @@ NSResult NSProviderUnsetConsumerTopic(const char * consumerId, const char * topi
     NS_LOG(DEBUG, "NSProviderUnselectTopics - OUT");
     return topicSyncResult.result;
 }
+
+
+NSResult NSProviderGetQueueStats(NSProviderQueueStats * stats)
+{
+    NS_LOG(DEBUG, "NSProviderGetQueueStats - IN");
+    pthread_mutex_lock(&nsInitMutex);
+
+    if (!initProvider || !stats)
+    {
+        NS_LOG(ERROR, "Provider is not started or stats is NULL");
+        pthread_mutex_unlock(&nsInitMutex);
+        return NS_FAIL;
+    }
+
+    NSGetQueueStats(NOTIFICATION_SCHEDULER, stats);
+
+    NS_LOG_V(DEBUG, "processed = %llu, pending = %llu, max latency = %llu us",
+            (unsigned long long) stats->processedTasks,
+            (unsigned long long) stats->pendingTasks,
+            (unsigned long long) stats->maxLatency);
+
+    pthread_mutex_unlock(&nsInitMutex);
+    NS_LOG(DEBUG, "NSProviderGetQueueStats - OUT");
+    return NS_OK;
+}
@@ -34,17 +34,293 @@
         } \
     }
 
+#define NS_CACHE_INDEX_MIN_SIZE 16
+
+typedef struct _NSCacheIndexEntry
+{
+    const char * key; // points into the data of the element
+    NSCacheElement * element;
+    struct _NSCacheIndexEntry * next;
+
+} NSCacheIndexEntry;
+
+typedef struct
+{
+    NSCacheIndexEntry ** buckets;
+    size_t size;
+    size_t count;
+
+} NSCacheIndex;
+
+/*
+ * Every list created by NSProviderStorageCreate carries hash indexes behind
+ * the list, so the provider can cast its NSCacheList back to this.
+ * byKey indexes subscribers by consumer ID, registered topics by name and
+ * consumer topics by topic name. byConsumer indexes consumer topics by
+ * consumer ID. Several consumer topics can share a key.
+ */
+typedef struct
+{
+    NSCacheList list;
+    NSCacheIndex byKey;
+    NSCacheIndex byConsumer;
+
+} NSProviderCacheList;
+
+static const char * NSGetCacheKey(NSCacheType type, void * data)
+{
+    switch (type)
+    {
+        case NS_PROVIDER_CACHE_SUBSCRIBER:
+        case NS_PROVIDER_CACHE_SUBSCRIBER_OBSERVE_ID:
+            return ((NSCacheSubData *) data)->id;
+        case NS_PROVIDER_CACHE_REGISTER_TOPIC:
+            return ((NSCacheTopicData *) data)->topicName;
+        case NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME:
+        case NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID:
+            return ((NSCacheTopicSubData *) data)->topicName;
+        default:
+            return NULL;
+    }
+}
+
+static const char * NSGetCacheConsumerKey(NSCacheType type, void * data)
+{
+    if (type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME ||
+            type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID)
+    {
+        return ((NSCacheTopicSubData *) data)->id;
+    }
+
+    return NULL;
+}
+
+/* Whether lookups by ID in a list of this type can use the indexes. */
+static bool NSIsIndexedCacheType(NSCacheType type)
+{
+    return type == NS_PROVIDER_CACHE_SUBSCRIBER || type == NS_PROVIDER_CACHE_REGISTER_TOPIC ||
+            type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME ||
+            type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID;
+}
+
+static size_t NSCacheIndexBucket(const char * key, size_t size)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+
+    while (*key)
+    {
+        hash = (hash ^ (uint8_t) *key++) * 16777619u;
+    }
+
+    return hash & (size - 1);
+}
+
+static bool NSCacheIndexGrow(NSCacheIndex * index)
+{
+    size_t size = index->size ? index->size * 2 : NS_CACHE_INDEX_MIN_SIZE;
+    NSCacheIndexEntry ** buckets =
+            (NSCacheIndexEntry **) OICCalloc(size, sizeof(NSCacheIndexEntry *));
+
+    if (!buckets)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < index->size; i++)
+    {
+        NSCacheIndexEntry * entry = index->buckets[i];
+
+        while (entry)
+        {
+            NSCacheIndexEntry * next = entry->next;
+            size_t bucket = NSCacheIndexBucket(entry->key, size);
+            entry->next = buckets[bucket];
+            buckets[bucket] = entry;
+            entry = next;
+        }
+    }
+
+    OICFree(index->buckets);
+    index->buckets = buckets;
+    index->size = size;
+
+    return true;
+}
+
+static bool NSCacheIndexInsert(NSCacheIndex * index, const char * key, NSCacheElement * element)
+{
+    if (index->count >= index->size && !NSCacheIndexGrow(index) && !index->buckets)
+    {
+        return false;
+    }
+
+    NSCacheIndexEntry * entry = (NSCacheIndexEntry *) OICMalloc(sizeof(NSCacheIndexEntry));
+
+    if (!entry)
+    {
+        return false;
+    }
+
+    size_t bucket = NSCacheIndexBucket(key, index->size);
+    entry->key = key;
+    entry->element = element;
+    entry->next = index->buckets[bucket];
+    index->buckets[bucket] = entry;
+    index->count++;
+
+    return true;
+}
+
+static void NSCacheIndexRemove(NSCacheIndex * index, const char * key, NSCacheElement * element)
+{
+    if (!index->buckets)
+    {
+        return;
+    }
+
+    NSCacheIndexEntry ** link = &index->buckets[NSCacheIndexBucket(key, index->size)];
+
+    while (*link)
+    {
+        NSCacheIndexEntry * entry = *link;
+
+        if (entry->element == element)
+        {
+            *link = entry->next;
+            OICFree(entry);
+            index->count--;
+            return;
+        }
+
+        link = &entry->next;
+    }
+}
+
+/* Returns the first entry with the key, starting at entry. */
+static NSCacheIndexEntry * NSCacheIndexMatch(NSCacheIndexEntry * entry, const char * key)
+{
+    while (entry && strcmp(entry->key, key) != 0)
+    {
+        entry = entry->next;
+    }
+
+    return entry;
+}
+
+static NSCacheIndexEntry * NSCacheIndexFind(NSCacheIndex * index, const char * key)
+{
+    if (!index->buckets || !key)
+    {
+        return NULL;
+    }
+
+    return NSCacheIndexMatch(index->buckets[NSCacheIndexBucket(key, index->size)], key);
+}
+
+static NSCacheIndexEntry * NSCacheIndexFindNext(NSCacheIndexEntry * entry)
+{
+    return NSCacheIndexMatch(entry->next, entry->key);
+}
+
+static void NSCacheIndexClear(NSCacheIndex * index)
+{
+    for (size_t i = 0; i < index->size; i++)
+    {
+        NSCacheIndexEntry * entry = index->buckets[i];
+
+        while (entry)
+        {
+            NSCacheIndexEntry * next = entry->next;
+            OICFree(entry);
+            entry = next;
+        }
+    }
+
+    OICFree(index->buckets);
+    index->buckets = NULL;
+    index->size = index->count = 0;
+}
+
+static NSCacheElement * NSFindConsumerTopic(NSProviderCacheList * cache,
+        const char * cId, const char * topicName)
+{
+    NSCacheIndexEntry * entry = NSCacheIndexFind(&cache->byConsumer, cId);
+
+    for (; entry; entry = NSCacheIndexFindNext(entry))
+    {
+        NSCacheTopicSubData * curr = (NSCacheTopicSubData *) entry->element->data;
+
+        if (strcmp(curr->topicName, topicName) == 0)
+        {
+            return entry->element;
+        }
+    }
+
+    return NULL;
+}
+
+/* Takes the element out of the indexes and the list, and frees it with its data. */
+static void NSRemoveCacheElement(NSProviderCacheList * cache, NSCacheElement * del)
+{
+    NSCacheList * list = &cache->list;
+    NSCacheType type = list->cacheType;
+    const char * key = NSGetCacheKey(type, del->data);
+    const char * consumerKey = NSGetCacheConsumerKey(type, del->data);
+
+    if (key)
+    {
+        NSCacheIndexRemove(&cache->byKey, key, del);
+    }
+
+    if (consumerKey)
+    {
+        NSCacheIndexRemove(&cache->byConsumer, consumerKey, del);
+    }
+
+    if (del == list->head)
+    {
+        list->head = del->next;
+
+        if (del == list->tail)
+        {
+            list->tail = NULL;
+        }
+    }
+    else
+    {
+        NSCacheElement * prev = list->head;
+
+        while (prev->next != del)
+        {
+            prev = prev->next;
+        }
+
+        prev->next = del->next;
+
+        if (del == list->tail)
+        {
+            list->tail = prev;
+        }
+    }
+
+    NSProviderDeleteCacheData(type, del->data);
+    OICFree(del);
+}
+
 NSCacheList * NSProviderStorageCreate()
 {
     pthread_mutex_lock(&NSCacheMutex);
-    NSCacheList * newList = (NSCacheList *) OICMalloc(sizeof(NSCacheList));
+    NSProviderCacheList * newCache =
+            (NSProviderCacheList *) OICCalloc(1, sizeof(NSProviderCacheList));
 
-    if (!newList)
+    if (!newCache)
     {
         pthread_mutex_unlock(&NSCacheMutex);
         return NULL;
     }
 
+    NSCacheList * newList = &newCache->list;
     newList->head = newList->tail = NULL;
 
     pthread_mutex_unlock(&NSCacheMutex);
@@ -62,9 +338,23 @@ NSCacheElement * NSProviderStorageRead(NSCacheList * list, const char * findId)
     NSCacheElement * iter = list->head;
     NSCacheElement * next = NULL;
     NSCacheType type = list->cacheType;
+    NSProviderCacheList * cache = (NSProviderCacheList *) list;
 
     NS_LOG_V(DEBUG, "Find ID - %s", findId);
 
+    if (NSIsIndexedCacheType(type))
+    {
+        NSCacheIndexEntry * entry = (type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID) ?
+                NSCacheIndexFind(&cache->byConsumer, findId) :
+                NSCacheIndexFind(&cache->byKey, findId);
+
+        NS_LOG(DEBUG, entry ? "Found in Cache" : "Not found in Cache");
+        NS_LOG(DEBUG, "NSCacheRead - OUT");
+        pthread_mutex_unlock(&NSCacheMutex);
+
+        return entry ? entry->element : NULL;
+    }
+
     while (iter)
     {
         next = iter->next;
@@ -139,6 +429,7 @@ NSResult NSProviderStorageWrite(NSCacheList * list, NSCacheElement * newObj)
     pthread_mutex_lock(&NSCacheMutex);
 
     NSCacheType type = list->cacheType;
+    NSProviderCacheList * cache = (NSProviderCacheList *) list;
 
     NS_LOG(DEBUG, "NSCacheWrite - IN");
 
@@ -217,23 +508,33 @@ NSResult NSProviderStorageWrite(NSCacheList * list, NSCacheElement * newObj)
 
         NS_PROVIDER_DELETE_REGISTERED_TOPIC_DATA(it, topicData, newObj);
     }
-    else if (type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME)
+    else if (type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME ||
+            type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID)
     {
-        NS_LOG(DEBUG, "Type is REGITSTER TOPIC");
+        NS_LOG(DEBUG, "Type is CONSUMER TOPIC");
 
+        // A consumer subscribes to a topic once, other consumers may subscribe to it as well.
         NSCacheTopicSubData * topicData = (NSCacheTopicSubData *) newObj->data;
-        NSCacheElement * it = NSProviderStorageRead(list, topicData->topicName);
+        NSCacheElement * it = NSFindConsumerTopic(cache, topicData->id, topicData->topicName);
 
         NS_PROVIDER_DELETE_REGISTERED_TOPIC_DATA(it, topicData, newObj);
     }
-    else if (type == NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID)
-    {
-        NS_LOG(DEBUG, "Type is REGITSTER TOPIC");
 
-        NSCacheTopicSubData * topicData = (NSCacheTopicSubData *) newObj->data;
-        NSCacheElement * it = NSProviderStorageRead(list, topicData->id);
+    const char * key = NSGetCacheKey(type, newObj->data);
+    const char * consumerKey = NSGetCacheConsumerKey(type, newObj->data);
 
-        NS_PROVIDER_DELETE_REGISTERED_TOPIC_DATA(it, topicData, newObj);
+    if ((key && !NSCacheIndexInsert(&cache->byKey, key, newObj)) ||
+        (consumerKey && !NSCacheIndexInsert(&cache->byConsumer, consumerKey, newObj)))
+    {
+        NS_LOG(ERROR, "fail to index cache data");
+        if (key)
+        {
+            NSCacheIndexRemove(&cache->byKey, key, newObj);
+        }
+        NSProviderDeleteCacheData(type, newObj->data);
+        OICFree(newObj);
+        pthread_mutex_unlock(&NSCacheMutex);
+        return NS_ERROR;
     }
 
     if (list->head == NULL)
@@ -255,6 +556,7 @@ NSResult NSProviderStorageDestroy(NSCacheList * list)
     NSCacheElement * iter = list->head;
     NSCacheElement * next = NULL;
     NSCacheType type = list->cacheType;
+    NSProviderCacheList * cache = (NSProviderCacheList *) list;
 
     while (iter)
     {
@@ -264,7 +566,9 @@ NSResult NSProviderStorageDestroy(NSCacheList * list)
         iter = next;
     }
 
-    OICFree(list);
+    NSCacheIndexClear(&cache->byKey);
+    NSCacheIndexClear(&cache->byConsumer);
+    OICFree(cache);
     return NS_OK;
 }
 
@@ -311,7 +615,7 @@ bool NSProviderCompareIdCacheData(NSCacheType type, void * data, const char * id
 
         NS_LOG_V(DEBUG, "Data(subData) = [%s]", subData->id);
 
-        OCObservationId currID = *id;
+        OCObservationId currID = *(const OCObservationId *) id;
 
         if (NSIsSameObId(subData, currID))
         {
@@ -412,7 +716,6 @@ NSResult NSProviderDeleteCacheData(NSCacheType type, void * data)
 NSResult NSProviderStorageDelete(NSCacheList * list, const char * delId)
 {
     pthread_mutex_lock(&NSCacheMutex);
-    NSCacheElement * prev = list->head;
     NSCacheElement * del = list->head;
 
     NSCacheType type = list->cacheType;
@@ -424,47 +727,27 @@ NSResult NSProviderStorageDelete(NSCacheList * list, const char * delId)
         return NS_FAIL;
     }
 
-    if (NSProviderCompareIdCacheData(type, del->data, delId))
+    if (NSIsIndexedCacheType(type))
     {
-        if (del == list->head) // first object
-        {
-            if (del == list->tail) // first object (one object)
-            {
-                list->tail = del->next;
-            }
-
-            list->head = del->next;
-            NSProviderDeleteCacheData(type, del->data);
-            OICFree(del);
-            pthread_mutex_unlock(&NSCacheMutex);
-            return NS_OK;
-        }
+        del = NSProviderStorageRead(list, delId);
     }
-
-    del = del->next;
-
-    while (del)
+    else
     {
-        if (NSProviderCompareIdCacheData(type, del->data, delId))
+        while (del && !NSProviderCompareIdCacheData(type, del->data, delId))
         {
-            if (del == list->tail) // delete object same to last object
-            {
-                list->tail = prev;
-            }
-
-            prev->next = del->next;
-            NSProviderDeleteCacheData(type, del->data);
-            OICFree(del);
-            pthread_mutex_unlock(&NSCacheMutex);
-            return NS_OK;
+            del = del->next;
         }
+    }
 
-        prev = del;
-        del = del->next;
+    if (!del)
+    {
+        pthread_mutex_unlock(&NSCacheMutex);
+        return NS_FAIL;
     }
 
+    NSRemoveCacheElement((NSProviderCacheList *) list, del);
     pthread_mutex_unlock(&NSCacheMutex);
-    return NS_FAIL;
+    return NS_OK;
 }
 
 NSTopicLL * NSProviderGetTopicsCacheData(NSCacheList * regTopicList)
@@ -532,42 +815,37 @@ NSTopicLL * NSProviderGetConsumerTopicsCacheData(NSCacheList * regTopicList,
         return NULL;
     }
 
-    NSCacheElement * iter = conTopicList->head;
-    conTopicList->cacheType = NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID;
+    NSCacheIndexEntry * entry =
+            NSCacheIndexFind(&((NSProviderCacheList *) conTopicList)->byConsumer, consumerId);
 
-    while (iter)
+    for (; entry; entry = NSCacheIndexFindNext(entry))
     {
-        NSCacheTopicSubData * curr = (NSCacheTopicSubData *)iter->data;
+        NSCacheTopicSubData * curr = (NSCacheTopicSubData *) entry->element->data;
 
-        if (curr && strcmp(curr->id, consumerId) == 0)
-        {
-            NS_LOG_V(DEBUG, "curr->id = %s", curr->id);
-            NS_LOG_V(DEBUG, "curr->topicName = %s", curr->topicName);
-            NSTopicLL * topicIter = topics;
+        NS_LOG_V(DEBUG, "curr->id = %s", curr->id);
+        NS_LOG_V(DEBUG, "curr->topicName = %s", curr->topicName);
+        NSTopicLL * topicIter = topics;
 
-            while (topicIter)
+        while (topicIter)
+        {
+            if (strcmp(topicIter->topicName, curr->topicName) == 0)
             {
-                if (strcmp(topicIter->topicName, curr->topicName) == 0)
-                {
-                    topicIter->state = NS_TOPIC_SUBSCRIBED;
-                    break;
-                }
-
-                topicIter = topicIter->next;
+                topicIter->state = NS_TOPIC_SUBSCRIBED;
+                break;
             }
-        }
 
-        iter = iter->next;
+            topicIter = topicIter->next;
+        }
     }
 
-    conTopicList->cacheType = NS_PROVIDER_CACHE_CONSUMER_TOPIC_NAME;
     pthread_mutex_unlock(&NSCacheMutex);
     NS_LOG(DEBUG, "NSProviderGetConsumerTopics - OUT");
 
     return topics;
 }
 
-bool NSProviderIsTopicSubScribed(NSCacheElement * conTopicList, char * cId, char * topicName)
+bool NSProviderIsTopicSubScribed(NSCacheList * conTopicList, const char * cId,
+        const char * topicName)
 {
     pthread_mutex_lock(&NSCacheMutex);
 
@@ -577,23 +855,10 @@ bool NSProviderIsTopicSubScribed(NSCacheElement * conTopicList, char * cId, char
         return false;
     }
 
-    NSCacheElement * iter = conTopicList;
-
-    while (iter)
-    {
-        NSCacheTopicSubData * curr = (NSCacheTopicSubData *) iter->data;
-
-        if ( (strcmp(curr->id, cId) == 0) && (strcmp(curr->topicName, topicName) == 0) )
-        {
-            pthread_mutex_unlock(&NSCacheMutex);
-            return true;
-        }
-
-        iter = iter->next;
-    }
+    bool subscribed = NSFindConsumerTopic((NSProviderCacheList *) conTopicList, cId, topicName);
 
     pthread_mutex_unlock(&NSCacheMutex);
-    return false;
+    return subscribed;
 }
 
 NSResult NSProviderDeleteConsumerTopic(NSCacheList * conTopicList,
@@ -610,67 +875,111 @@ NSResult NSProviderDeleteConsumerTopic(NSCacheList * conTopicList,
         return NS_ERROR;
     }
 
-    NSCacheElement * prev = conTopicList->head;
-    NSCacheElement * del = conTopicList->head;
+    NS_LOG_V(DEBUG, "compareid = %s", cId);
+    NS_LOG_V(DEBUG, "comparetopicName = %s", topicName);
 
-    NSCacheType type = conTopicList->cacheType;
+    NSProviderCacheList * cache = (NSProviderCacheList *) conTopicList;
+    NSCacheElement * del = NSFindConsumerTopic(cache, cId, topicName);
 
     if (!del)
     {
-        NS_LOG(DEBUG, "list head is NULL");
         pthread_mutex_unlock(&NSCacheMutex);
         return NS_FAIL;
     }
 
-    NSCacheTopicSubData * curr = (NSCacheTopicSubData *) del->data;
-    NS_LOG_V(DEBUG, "compareid = %s", cId);
-    NS_LOG_V(DEBUG, "comparetopicName = %s", topicName);
-    NS_LOG_V(DEBUG, "curr->id = %s", curr->id);
-    NS_LOG_V(DEBUG, "curr->topicName = %s", curr->topicName);
+    NSRemoveCacheElement(cache, del);
+    pthread_mutex_unlock(&NSCacheMutex);
+    return NS_OK;
+}
 
-    if ( (strncmp(curr->id, cId, NS_UUID_STRING_SIZE) == 0) &&
-            (strcmp(curr->topicName, topicName) == 0) )
+/* Appends the observation IDs of an allowed subscriber for the message or sync resource. */
+static void NSAppendObserverIds(NSCacheSubData * subData, bool sync,
+        OCObservationId * obIds, size_t * count)
+{
+    if (!subData->isWhite)
     {
-        if (del == conTopicList->head) // first object
-        {
-            if (del == conTopicList->tail) // first object (one object)
-            {
-                conTopicList->tail = del->next;
-            }
+        return;
+    }
 
-            conTopicList->head = del->next;
-            NSProviderDeleteCacheData(type, del->data);
-            OICFree(del);
-            pthread_mutex_unlock(&NSCacheMutex);
-            return NS_OK;
+    int obId = sync ? subData->syncObId : subData->messageObId;
+
+    if (obId != 0)
+    {
+        obIds[(*count)++] = (OCObservationId) obId;
+    }
+
+#if (defined WITH_CLOUD && defined RD_CLIENT)
+    int remoteObId = sync ? subData->remote_syncObId : subData->remote_messageObId;
+
+    if (remoteObId != 0)
+    {
+        obIds[(*count)++] = (OCObservationId) remoteObId;
+    }
+#endif
+}
+
+OCObservationId * NSProviderGetObserverIds(NSCacheList * subList, NSCacheList * conTopicList,
+        const char * topicName, bool sync, size_t * count)
+{
+    pthread_mutex_lock(&NSCacheMutex);
+
+    NSProviderCacheList * subCache = (NSProviderCacheList *) subList;
+    NSCacheIndexEntry * entry = NULL;
+    size_t candidates = 0;
+
+    *count = 0;
+
+    if (topicName)
+    {
+        // Only the consumers of the topic, found through the topic index.
+        NSCacheIndex * byTopic = &((NSProviderCacheList *) conTopicList)->byKey;
+
+        for (entry = NSCacheIndexFind(byTopic, topicName); entry;
+                entry = NSCacheIndexFindNext(entry))
+        {
+            candidates++;
         }
     }
+    else
+    {
+        candidates = subCache->byKey.count;
+    }
 
-    curr = NULL;
-    del = del->next;
+    // Each subscriber observes through at most a local and a remote observation.
+    OCObservationId * obIds = (OCObservationId *) OICMalloc(
+            (2 * candidates + 1) * sizeof(OCObservationId));
 
-    while (del)
+    if (!obIds)
     {
-        curr = (NSCacheTopicSubData *) del->data;
-        if ( (strncmp(curr->id, cId, NS_UUID_STRING_SIZE) == 0) &&
-                (strcmp(curr->topicName, topicName) == 0) )
+        pthread_mutex_unlock(&NSCacheMutex);
+        return NULL;
+    }
+
+    if (topicName)
+    {
+        NSCacheIndex * byTopic = &((NSProviderCacheList *) conTopicList)->byKey;
+
+        for (entry = NSCacheIndexFind(byTopic, topicName); entry;
+                entry = NSCacheIndexFindNext(entry))
         {
-            if (del == conTopicList->tail) // delete object same to last object
+            NSCacheTopicSubData * topicData = (NSCacheTopicSubData *) entry->element->data;
+            NSCacheIndexEntry * subEntry = NSCacheIndexFind(&subCache->byKey, topicData->id);
+
+            if (subEntry)
             {
-                conTopicList->tail = prev;
+                NSAppendObserverIds((NSCacheSubData *) subEntry->element->data, sync,
+                        obIds, count);
             }
-
-            prev->next = del->next;
-            NSProviderDeleteCacheData(type, del->data);
-            OICFree(del);
-            pthread_mutex_unlock(&NSCacheMutex);
-            return NS_OK;
         }
-
-        prev = del;
-        del = del->next;
+    }
+    else
+    {
+        for (NSCacheElement * iter = subList->head; iter; iter = iter->next)
+        {
+            NSAppendObserverIds((NSCacheSubData *) iter->data, sync, obIds, count);
+        }
     }
 
     pthread_mutex_unlock(&NSCacheMutex);
-    return NS_FAIL;
+    return obIds;
 }
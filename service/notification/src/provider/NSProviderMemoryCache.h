@@ -52,11 +52,21 @@ NSTopicLL * NSProviderGetTopicsCacheData(NSCacheList * regTopicList);
 NSTopicLL * NSProviderGetConsumerTopicsCacheData(NSCacheList * regTopicList,
         NSCacheList * conTopicList, const char * consumerId);
 
-bool NSProviderIsTopicSubScribed(NSCacheElement * conTopicList, char * cId, char * topicName);
+bool NSProviderIsTopicSubScribed(NSCacheList * conTopicList, const char * cId,
+        const char * topicName);
 
 NSResult NSProviderDeleteConsumerTopic(NSCacheList * conTopicList,
         NSCacheTopicSubData * topicSubData);
 
+/*
+ * Returns a new array with the observation IDs of the allowed subscribers of
+ * the message resource, or of the sync resource if sync is set. With a topic
+ * name only the consumers subscribed to that topic are included.
+ * The caller frees the array.
+ */
+OCObservationId * NSProviderGetObserverIds(NSCacheList * subList, NSCacheList * conTopicList,
+        const char * topicName, bool sync, size_t * count);
+
 pthread_mutex_t NSCacheMutex;
 pthread_mutexattr_t NSCacheMutexAttr;
 
@@ -103,13 +103,11 @@ OCStackResult NSProviderPublishTopic(OCRepPayload * payload, OCClientResponseHan
 }
 #endif
 
-NSResult NSSendNotification(NSMessage *msg)
+static NSResult NSSendNotificationToObservers(NSMessage *msg, const OCObservationId * obArray,
+        size_t obCount)
 {
-    NS_LOG(DEBUG, "NSSendMessage - IN");
-
     OCResourceHandle rHandle;
-    OCObservationId obArray[255] = { 0, };
-    int obCount = 0, i;
+    size_t i;
 
     if (NSPutMessageResource(msg, &rHandle) != NS_OK)
     {
@@ -132,146 +130,161 @@ NSResult NSSendNotification(NSMessage *msg)
     }
 #endif
 
-    if (consumerSubList->head == NULL)
-    {
-        NS_LOG(ERROR, "SubList->head is NULL, empty SubList");
-        return NS_ERROR;
-    }
-
-    NSCacheElement * it = consumerSubList->head;
-
-    while (it)
-    {
-        NSCacheSubData * subData = (NSCacheSubData *) it->data;
-        NS_LOG_V(DEBUG, "message subData->id = %s", subData->id);
-        NS_LOG_V(DEBUG, "subData->messageId = %d", subData->messageObId);
-        NS_LOG_V(DEBUG, "subData->cloud_messageId = %d", subData->remote_messageObId);
-        NS_LOG_V(DEBUG, "subData->syncId = %d", subData->syncObId);
-        NS_LOG_V(DEBUG, "subData->cloud_syncId = %d", subData->remote_syncObId);
-        NS_LOG_V(DEBUG, "subData->isWhite = %d", subData->isWhite);
-
-        if (subData->isWhite)
-        {
-            if(subData->messageObId != 0)
-            {
-                if (msg->topic && (msg->topic)[0] != '\0')
-                {
-                    NS_LOG_V(DEBUG, "this is topic message: %s", msg->topic);
-
-                    if (NSProviderIsTopicSubScribed(consumerTopicList->head, subData->id, msg->topic))
-                    {
-                        obArray[obCount++] = subData->messageObId;
-                    }
-                }
-                else
-                {
-                    obArray[obCount++] = subData->messageObId;
-                }
-            }
-
-#if (defined WITH_CLOUD && defined RD_CLIENT)
-            if (subData->remote_messageObId != 0)
-            {
-                if (msg->topic && (msg->topic)[0] != '\0')
-                {
-                    NS_LOG_V(DEBUG, "this is topic message via remote server: %s", msg->topic);
-                    if (NSProviderIsTopicSubScribed(consumerTopicList->head, subData->id, msg->topic))
-                    {
-                        obArray[obCount++] = subData->remote_messageObId;
-                    }
-                }
-                else
-                {
-                    obArray[obCount++] = subData->remote_messageObId;
-                }
-            }
-#endif
-
-        }
-        it = it->next;
-    }
-
     for (i = 0; i < obCount; ++i)
     {
         NS_LOG(DEBUG, "-------------------------------------------------------message\n");
-        NS_LOG_V(DEBUG, "SubScription WhiteList[%d] = %d", i, obArray[i]);
+        NS_LOG_V(DEBUG, "SubScription WhiteList[%zu] = %u", i, obArray[i]);
         NS_LOG(DEBUG, "-------------------------------------------------------message\n");
     }
 
     if (!obCount)
     {
         NS_LOG(ERROR, "observer count is zero");
+        OCRepPayloadDestroy(payload);
+        msg->extraInfo = NULL;
         return NS_ERROR;
     }
 
-    OCStackResult ocstackResult = OCNotifyListOfObservers(rHandle, obArray, obCount, payload,
-            OC_LOW_QOS);
+    OCStackResult ocstackResult = OCNotifyListOfObserversWithCount(rHandle, obArray, obCount,
+            payload, OC_LOW_QOS);
 
     NS_LOG_V(DEBUG, "Message ocstackResult = %d", ocstackResult);
 
+    OCRepPayloadDestroy(payload);
+    msg->extraInfo = NULL;
+
     if (ocstackResult != OC_STACK_OK)
     {
         NS_LOG(ERROR, "fail to send message");
-        OCRepPayloadDestroy(payload);
-        msg->extraInfo = NULL;
         return NS_ERROR;
     }
 
-    OCRepPayloadDestroy(payload);
-    msg->extraInfo = NULL;
-
-    NS_LOG(DEBUG, "NSSendMessage - OUT");
     return NS_OK;
 }
 
-NSResult NSSendSync(NSSyncInfo *sync)
+static const char * NSGetMessageTopic(NSMessage *msg)
 {
-    NS_LOG(DEBUG, "NSSendSync - IN");
+    if (msg->topic && (msg->topic)[0] != '\0')
+    {
+        return msg->topic;
+    }
+    return NULL;
+}
 
-    OCObservationId obArray[255] = { 0, };
-    int obCount = 0;
-    int i;
+NSResult NSSendNotification(NSMessage *msg)
+{
+    NS_LOG(DEBUG, "NSSendMessage - IN");
 
-    OCResourceHandle rHandle;
-    if (NSPutSyncResource(sync, &rHandle) != NS_OK)
+    OCObservationId * obArray = NULL;
+    size_t obCount = 0;
+
+    const char * topic = NSGetMessageTopic(msg);
+    if (topic)
     {
-        NS_LOG(ERROR, PCF("Fail to put sync resource"));
-        return NS_ERROR;
+        NS_LOG_V(DEBUG, "this is topic message: %s", topic);
     }
 
-    NSCacheElement * it = consumerSubList->head;
+    if (consumerSubList->head != NULL)
+    {
+        obArray = NSProviderGetObserverIds(consumerSubList, consumerTopicList, topic, false,
+                &obCount);
+        if (!obArray)
+        {
+            NS_LOG(ERROR, "fail to allocate observer list");
+            return NS_ERROR;
+        }
+    }
+
+    NSResult result = NSSendNotificationToObservers(msg, obArray, obCount);
+    OICFree(obArray);
+
+    NS_LOG(DEBUG, "NSSendMessage - OUT");
+    return result;
+}
+
+/**
+ * Sends the queued messages of a batch. Messages of the same topic share
+ * one lookup of the observers, which walks the subscription cache.
+ */
+static void NSSendNotificationBatch(NSTask ** batch, size_t count)
+{
+    NS_LOG_V(DEBUG, "NSSendNotificationBatch - IN : %zu messages", count);
+
+    OCObservationId * obArrays[NS_NOTIFICATION_BATCH_SIZE] = { NULL, };
+    size_t obCounts[NS_NOTIFICATION_BATCH_SIZE] = { 0, };
+    bool hasSubscriber = consumerSubList->head != NULL;
+    size_t i, j;
 
-    while (it)
+    for (i = 0; i < count; ++i)
     {
-        NSCacheSubData * subData = (NSCacheSubData *) it->data;
-        NS_LOG_V(DEBUG, "sync subData->id = %s", subData->id);
-        NS_LOG_V(DEBUG, "subData->messageId = %d", subData->messageObId);
-        NS_LOG_V(DEBUG, "subData->cloud_messageId = %d", subData->remote_messageObId);
-        NS_LOG_V(DEBUG, "subData->syncId = %d", subData->syncObId);
-        NS_LOG_V(DEBUG, "subData->cloud_syncId = %d", subData->remote_syncObId);
-        NS_LOG_V(DEBUG, "subData->isWhite = %d", subData->isWhite);
-
-        if (subData->isWhite)
+        NSMessage * msg = (NSMessage *) batch[i]->taskData;
+        const char * topic = NSGetMessageTopic(msg);
+        const OCObservationId * obArray = NULL;
+        size_t obCount = 0;
+
+        for (j = 0; hasSubscriber && j < i; ++j)
         {
-            if (subData->syncObId != 0)
+            const char * other = NSGetMessageTopic((NSMessage *) batch[j]->taskData);
+            if (obArrays[j] && (topic == other || (topic && other && !strcmp(topic, other))))
             {
-                obArray[obCount++] = subData->syncObId;
+                obArray = obArrays[j];
+                obCount = obCounts[j];
+                break;
             }
+        }
 
-#if (defined WITH_CLOUD && defined RD_CLIENT)
-            if (subData->remote_syncObId != 0)
+        if (hasSubscriber && !obArray)
+        {
+            obArrays[i] = NSProviderGetObserverIds(consumerSubList, consumerTopicList, topic,
+                    false, &obCounts[i]);
+            obArray = obArrays[i];
+            obCount = obCounts[i];
+            if (!obArray)
             {
-                obArray[obCount++] = subData->remote_syncObId;
+                NS_LOG(ERROR, "fail to allocate observer list");
             }
-#endif
         }
-        it = it->next;
+
+        NSSendNotificationToObservers(msg, obArray, obCount);
+        NSFreeMessage(msg);
+        OICFree(batch[i]);
+    }
+
+    for (i = 0; i < count; ++i)
+    {
+        OICFree(obArrays[i]);
+    }
+
+    NS_LOG(DEBUG, "NSSendNotificationBatch - OUT");
+}
+
+NSResult NSSendSync(NSSyncInfo *sync)
+{
+    NS_LOG(DEBUG, "NSSendSync - IN");
+
+    OCObservationId * obArray = NULL;
+    size_t obCount = 0;
+    size_t i;
+
+    OCResourceHandle rHandle;
+    if (NSPutSyncResource(sync, &rHandle) != NS_OK)
+    {
+        NS_LOG(ERROR, PCF("Fail to put sync resource"));
+        return NS_ERROR;
+    }
+
+    obArray = NSProviderGetObserverIds(consumerSubList, NULL, NULL, true, &obCount);
+    if (!obArray)
+    {
+        NS_LOG(ERROR, "fail to allocate observer list");
+        return NS_ERROR;
     }
 
     OCRepPayload* payload = NULL;
     if (NSSetSyncPayload(sync, &payload) != NS_OK)
     {
         NS_LOG(ERROR, "Failed to allocate payload");
+        OICFree(obArray);
         return NS_ERROR;
     }
 
@@ -298,12 +311,13 @@ NSResult NSSendSync(NSSyncInfo *sync)
     for (i = 0; i < obCount; ++i)
     {
         NS_LOG(DEBUG, "-------------------------------------------------------message\n");
-        NS_LOG_V(DEBUG, "Sync WhiteList[%d] = %d", i, obArray[i]);
+        NS_LOG_V(DEBUG, "Sync WhiteList[%zu] = %u", i, obArray[i]);
         NS_LOG(DEBUG, "-------------------------------------------------------message\n");
     }
 
-    OCStackResult ocstackResult = OCNotifyListOfObservers(rHandle, obArray,
+    OCStackResult ocstackResult = OCNotifyListOfObserversWithCount(rHandle, obArray,
             obCount, payload, OC_LOW_QOS);
+    OICFree(obArray);
 
     NS_LOG_V(DEBUG, "Sync ocstackResult = %d", ocstackResult);
     if (ocstackResult != OC_STACK_OK)
@@ -330,40 +344,46 @@ void * NSNotificationSchedule(void *ptr)
     {
         sem_wait(&NSSemaphore[NOTIFICATION_SCHEDULER]);
         pthread_mutex_lock(&NSMutex[NOTIFICATION_SCHEDULER]);
+        NSTask *node = NSPopQueue(NOTIFICATION_SCHEDULER);
+        pthread_mutex_unlock(&NSMutex[NOTIFICATION_SCHEDULER]);
 
-        if (NSHeadMsg[NOTIFICATION_SCHEDULER] != NULL)
+        // Tasks are handled without holding the queue, so that NSSendMessage
+        // and NSProviderSendSyncInfo do not block while messages are sent.
+        if (node == NULL)
         {
-            NSTask *node = NSHeadMsg[NOTIFICATION_SCHEDULER];
-            NSHeadMsg[NOTIFICATION_SCHEDULER] = node->nextTask;
+            continue;
+        }
 
-            switch (node->taskType)
+        switch (node->taskType)
+        {
+            case TASK_SEND_NOTIFICATION:
             {
-                case TASK_SEND_NOTIFICATION:
-                {
-                    NS_LOG(DEBUG, "CASE TASK_SEND_NOTIFICATION : ");
-                    NSSendNotification((NSMessage *)node->taskData);
-                    NSFreeMessage((NSMessage *)node->taskData);
-                }
-                    break;
-                case TASK_SEND_READ:
-                    NS_LOG(DEBUG, "CASE TASK_SEND_READ : ");
-                    NSSendSync((NSSyncInfo*) node->taskData);
-                    NSFreeSync((NSSyncInfo*) node->taskData);
-                    break;
-                case TASK_RECV_READ:
-                    NS_LOG(DEBUG, "CASE TASK_RECV_READ : ");
-                    NSSendSync((NSSyncInfo*) node->taskData);
-                    NSPushQueue(CALLBACK_RESPONSE_SCHEDULER, TASK_CB_SYNC, node->taskData);
-                    break;
-                default:
-                    NS_LOG(ERROR, "Unknown type message");
-                    break;
-
+                NS_LOG(DEBUG, "CASE TASK_SEND_NOTIFICATION : ");
+                NSTask * batch[NS_NOTIFICATION_BATCH_SIZE];
+                batch[0] = node;
+                // Messages queued right behind this one join it, see NSPopQueueBatch.
+                NSSendNotificationBatch(batch, NSPopQueueBatch(NOTIFICATION_SCHEDULER,
+                        TASK_SEND_NOTIFICATION, batch, NS_NOTIFICATION_BATCH_SIZE,
+                        NS_NOTIFICATION_BATCH_WINDOW));
+                node = NULL;
             }
-            OICFree(node);
-        }
+                break;
+            case TASK_SEND_READ:
+                NS_LOG(DEBUG, "CASE TASK_SEND_READ : ");
+                NSSendSync((NSSyncInfo*) node->taskData);
+                NSFreeSync((NSSyncInfo*) node->taskData);
+                break;
+            case TASK_RECV_READ:
+                NS_LOG(DEBUG, "CASE TASK_RECV_READ : ");
+                NSSendSync((NSSyncInfo*) node->taskData);
+                NSPushQueue(CALLBACK_RESPONSE_SCHEDULER, TASK_CB_SYNC, node->taskData);
+                break;
+            default:
+                NS_LOG(ERROR, "Unknown type message");
+                break;
 
-        pthread_mutex_unlock(&NSMutex[NOTIFICATION_SCHEDULER]);
+        }
+        OICFree(node);
     }
 
     NS_LOG(INFO, "Destroy NSNotificationSchedule");
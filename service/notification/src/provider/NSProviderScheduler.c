@@ -25,9 +25,17 @@ pthread_mutex_t NSMutex[THREAD_COUNT];
 sem_t NSSemaphore[THREAD_COUNT];
 bool NSIsRunning[THREAD_COUNT] = { false, };
 
+// Signalled with each queued task, waited for on CLOCK_MONOTONIC by NSPopQueueBatch.
+static pthread_cond_t NSQueueCond[THREAD_COUNT];
+
 NSTask* NSHeadMsg[THREAD_COUNT];
 NSTask* NSTailMsg[THREAD_COUNT];
 
+// Last queued task which goes ahead of the others, NULL if none is queued.
+static NSTask* NSLastUrgentMsg[THREAD_COUNT];
+
+NSProviderQueueStats NSQueueStats[THREAD_COUNT];
+
 void * NSCallbackResponseSchedule(void *ptr);
 void * NSDiscoverySchedule(void *ptr);
 void * NSSubScriptionSchedule(void *ptr);
@@ -40,13 +48,20 @@ bool NSInitScheduler()
 
     int i = 0;
 
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+
     for (i = 0; i < THREAD_COUNT; i++)
     {
         pthread_mutex_init(&NSMutex[i], NULL);
+        pthread_cond_init(&NSQueueCond[i], &condAttr);
         NSIsRunning[i] = true;
         sem_init(&(NSSemaphore[i]), 0, 0);
     }
 
+    pthread_condattr_destroy(&condAttr);
+
     NS_LOG(DEBUG, "NSInitScheduler - OUT");
 
     return true;
@@ -101,7 +116,8 @@ bool NSStartScheduler()
 
         }
 
-        NSHeadMsg[i] = NSTailMsg[i] = NULL;
+        NSHeadMsg[i] = NSTailMsg[i] = NSLastUrgentMsg[i] = NULL;
+        memset(&NSQueueStats[i], 0, sizeof(NSProviderQueueStats));
 
         pthread_mutex_unlock(&NSMutex[i]);
 
@@ -121,6 +137,10 @@ bool NSStopScheduler()
 
         NSIsRunning[i] = false;
 
+        pthread_mutex_lock(&NSMutex[i]);
+        pthread_cond_signal(&NSQueueCond[i]);
+        pthread_mutex_unlock(&NSMutex[i]);
+
         sem_post(&(NSSemaphore[i]));
         pthread_join(NSThread[i], (void **) &status);
 
@@ -136,10 +156,12 @@ bool NSStopScheduler()
             OICFree(temp);
         }
 
-        NSTailMsg[i] = NSHeadMsg[i] = NULL;
+        NSTailMsg[i] = NSHeadMsg[i] = NSLastUrgentMsg[i] = NULL;
+        NSQueueStats[i].pendingTasks = 0;
 
         pthread_mutex_unlock(&NSMutex[i]);
         pthread_mutex_destroy(&NSMutex[i]);
+        pthread_cond_destroy(&NSQueueCond[i]);
     }
 
     NS_LOG(DEBUG, "NSStopScheduler - OUT");
@@ -147,6 +169,41 @@ bool NSStopScheduler()
     return true;
 }
 
+static bool NSIsUrgentTask(NSSchedulerType schedulerType, NSTaskType taskType)
+{
+    // Sync informations are small and acknowledge what consumers already have,
+    // they should not wait behind a burst of messages. The callback queue stays
+    // in order: a sync callback must not come before the subscription callback
+    // of its consumer, and the sync information does not tell the consumer.
+    if (schedulerType == NOTIFICATION_SCHEDULER)
+    {
+        return taskType == TASK_SEND_READ || taskType == TASK_RECV_READ;
+    }
+    return false;
+}
+
+/*
+ * Returns the task the sync information has to be queued behind: the last
+ * queued sync information, or the message it is about if that is still
+ * queued, so that no consumer gets the state of a message before the message.
+ * Only messages are queued after the last sync information.
+ */
+static NSTask * NSFindSyncPosition(NSSchedulerType schedulerType, NSSyncInfo * sync)
+{
+    NSTask * prev = NSLastUrgentMsg[schedulerType];
+    NSTask * temp = prev ? prev->nextTask : NSHeadMsg[schedulerType];
+
+    for (; temp; temp = temp->nextTask)
+    {
+        NSMessage * msg = (NSMessage *) temp->taskData;
+        if (temp->taskType == TASK_SEND_NOTIFICATION && msg && msg->messageId == sync->messageId)
+        {
+            return temp;
+        }
+    }
+    return prev;
+}
+
 void NSPushQueue(NSSchedulerType schedulerType, NSTaskType taskType, void* data)
 {
 
@@ -161,34 +218,163 @@ void NSPushQueue(NSSchedulerType schedulerType, NSTaskType taskType, void* data)
     NS_LOG_V(DEBUG, "NSSchedulerType = %d", schedulerType);
     NS_LOG_V(DEBUG, "NSTaskType = %d", taskType);
 
+    NSTask* newNode = (NSTask*) OICMalloc(sizeof(NSTask));
+    if (!newNode)
+    {
+        NS_LOG(ERROR, "Fail to allocate task");
+        pthread_mutex_unlock(&NSMutex[schedulerType]);
+        return;
+    }
+
+    newNode->taskType = taskType;
+    newNode->taskData = data;
+    newNode->nextTask = NULL;
+    newNode->queuedTime = OICGetCurrentTime(TIME_IN_US);
+
+    bool isUrgent = data && NSIsUrgentTask(schedulerType, taskType);
+
+    if (NSHeadMsg[schedulerType] == NULL)
+    {
+        NSHeadMsg[schedulerType] = NSTailMsg[schedulerType] = newNode;
+    }
+    else if (!isUrgent)
+    {
+        NSTailMsg[schedulerType]->nextTask = newNode;
+        NSTailMsg[schedulerType] = newNode;
+    }
+    else
+    {
+        NSTask* prev = NSFindSyncPosition(schedulerType, (NSSyncInfo *) data);
+        if (prev == NULL)
+        {
+            newNode->nextTask = NSHeadMsg[schedulerType];
+            NSHeadMsg[schedulerType] = newNode;
+        }
+        else
+        {
+            newNode->nextTask = prev->nextTask;
+            prev->nextTask = newNode;
+            if (NSTailMsg[schedulerType] == prev)
+            {
+                NSTailMsg[schedulerType] = newNode;
+            }
+        }
+    }
+
+    if (isUrgent)
+    {
+        NSLastUrgentMsg[schedulerType] = newNode;
+    }
+
+    NSQueueStats[schedulerType].pendingTasks++;
+
+    sem_post(&(NSSemaphore[schedulerType]));
+    pthread_cond_signal(&NSQueueCond[schedulerType]);
+    NS_LOG(DEBUG, "NSPushQueue - OUT");
+    pthread_mutex_unlock(&NSMutex[schedulerType]);
+}
+
+NSTask * NSPopQueue(NSSchedulerType schedulerType)
+{
+    NSTask * node = NSHeadMsg[schedulerType];
+
+    if (!node)
+    {
+        return NULL;
+    }
+
+    NSHeadMsg[schedulerType] = node->nextTask;
     if (NSHeadMsg[schedulerType] == NULL)
     {
-        NSHeadMsg[schedulerType] = (NSTask*) OICMalloc(sizeof(NSTask));
+        NSTailMsg[schedulerType] = NULL;
+    }
+    if (NSLastUrgentMsg[schedulerType] == node)
+    {
+        NSLastUrgentMsg[schedulerType] = NULL;
+    }
+    node->nextTask = NULL;
+
+    uint64_t now = OICGetCurrentTime(TIME_IN_US);
+    uint64_t latency = now > node->queuedTime ? now - node->queuedTime : 0;
+    NSProviderQueueStats * stats = &NSQueueStats[schedulerType];
 
-        if (NSHeadMsg[schedulerType])
+    if (stats->pendingTasks)
+    {
+        stats->pendingTasks--;
+    }
+    stats->processedTasks++;
+    stats->totalLatency += latency;
+    if (latency > stats->maxLatency)
+    {
+        stats->maxLatency = latency;
+    }
+
+    if (NSIsUrgentTask(schedulerType, node->taskType))
+    {
+        stats->syncTasks++;
+        stats->syncTotalLatency += latency;
+        if (latency > stats->syncMaxLatency)
         {
-            NSHeadMsg[schedulerType]->taskType = taskType;
-            NSHeadMsg[schedulerType]->taskData = data;
-            NSHeadMsg[schedulerType]->nextTask = NULL;
-            NSTailMsg[schedulerType] = NSHeadMsg[schedulerType];
+            stats->syncMaxLatency = latency;
         }
     }
-    else
+
+    return node;
+}
+
+size_t NSPopQueueBatch(NSSchedulerType schedulerType, NSTaskType taskType,
+        NSTask ** batch, size_t size, uint32_t windowMs)
+{
+    struct timespec deadline;
+    size_t count = 1;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_nsec += windowMs * NS_PER_MS;
+    deadline.tv_sec += deadline.tv_nsec / (NS_PER_MS * MS_PER_SEC);
+    deadline.tv_nsec %= (NS_PER_MS * MS_PER_SEC);
+
+    pthread_mutex_lock(&NSMutex[schedulerType]);
+
+    while (count < size && NSIsRunning[schedulerType])
     {
-        NSTask* newNode = (NSTask*) OICMalloc(sizeof(NSTask));
-        if (newNode)
+        if (NSHeadMsg[schedulerType] == NULL)
         {
-            newNode->taskType = taskType;
-            newNode->taskData = data;
-            newNode->nextTask = NULL;
+            // Only a batch already in progress waits for more tasks,
+            // a task queued on its own is handled right away.
+            if (count == 1)
+            {
+                break;
+            }
+            if (pthread_cond_timedwait(&NSQueueCond[schedulerType],
+                    &NSMutex[schedulerType], &deadline) != 0
+                    && NSHeadMsg[schedulerType] == NULL)
+            {
+                break;
+            }
+            continue;
+        }
 
-            NSTailMsg[schedulerType]->nextTask = newNode;
-            NSTailMsg[schedulerType] = newNode;
+        if (NSHeadMsg[schedulerType]->taskType != taskType)
+        {
+            break;
         }
+
+        // Consume the count posted when the task was queued, it cannot block
+        // as the task is still in the queue.
+        sem_trywait(&NSSemaphore[schedulerType]);
+        batch[count++] = NSPopQueue(schedulerType);
     }
 
-    sem_post(&(NSSemaphore[schedulerType]));
-    NS_LOG(DEBUG, "NSPushQueue - OUT");
+    NSQueueStats[schedulerType].batches++;
+    pthread_mutex_unlock(&NSMutex[schedulerType]);
+
+    return count;
+}
+
+void NSGetQueueStats(NSSchedulerType schedulerType, NSProviderQueueStats * stats)
+{
+    pthread_mutex_lock(&NSMutex[schedulerType]);
+    *stats = NSQueueStats[schedulerType];
     pthread_mutex_unlock(&NSMutex[schedulerType]);
 }
 
@@ -33,6 +33,7 @@
 #include "oic_malloc.h"
 #include "oic_string.h"
 #include "NSUtil.h"
+#include "NSProviderInterface.h"
 
 extern NSTask* NSHeadMsg[THREAD_COUNT]; // Current MSG;
 extern NSTask* NSTailMsg[THREAD_COUNT]; // Recently MSG;
@@ -41,6 +42,7 @@ extern pthread_t NSThread[THREAD_COUNT];
 extern pthread_mutex_t NSMutex[THREAD_COUNT];
 extern sem_t NSSemaphore[THREAD_COUNT];
 extern bool NSIsRunning[THREAD_COUNT];
+extern NSProviderQueueStats NSQueueStats[THREAD_COUNT];
 
 extern void * NSCallbackResponseSchedule(void *ptr);
 extern void * NSDiscoverySchedule(void *ptr);
@@ -53,6 +55,23 @@ bool NSInitScheduler();
 bool NSStartScheduler();
 bool NSStopScheduler();
 void NSPushQueue(NSSchedulerType, NSTaskType, void*);
+
+/**
+ * Take the first task of a scheduler queue and account its waiting time.
+ * The caller must hold the mutex of the scheduler.
+ */
+NSTask * NSPopQueue(NSSchedulerType);
+
+/**
+ * Take the tasks of taskType queued right behind batch[0], up to size tasks in
+ * total. Once a second task has joined, waits windowMs milliseconds at most for
+ * more; a task queued on its own is not delayed. Stops at any other task.
+ * The caller must not hold the mutex of the scheduler.
+ * @return number of tasks in batch
+ */
+size_t NSPopQueueBatch(NSSchedulerType schedulerType, NSTaskType taskType,
+        NSTask ** batch, size_t size, uint32_t windowMs);
+void NSGetQueueStats(NSSchedulerType, NSProviderQueueStats *);
 void NSFreeData(NSSchedulerType, NSTask * );
 
 #endif /* _PROVIDER_SCHEDULER_H_ */
@@ -394,8 +394,7 @@ void * NSSubScriptionSchedule(void *ptr)
 
         if (NSHeadMsg[SUBSCRIPTION_SCHEDULER] != NULL)
         {
-            NSTask *node = NSHeadMsg[SUBSCRIPTION_SCHEDULER];
-            NSHeadMsg[SUBSCRIPTION_SCHEDULER] = node->nextTask;
+            NSTask *node = NSPopQueue(SUBSCRIPTION_SCHEDULER);
 
             switch (node->taskType)
             {
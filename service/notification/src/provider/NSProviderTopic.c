@@ -140,41 +140,29 @@ NSResult NSSendTopicUpdation()
     OCRepPayloadSetPropInt(payload, NS_ATTRIBUTE_MESSAGE_ID, NS_TOPIC);
     OCRepPayloadSetPropString(payload, NS_ATTRIBUTE_PROVIDER_ID, NSGetProviderInfo()->providerId);
 
-    OCObservationId obArray[255] =
-    { 0, };
-    int obCount = 0;
+    size_t obCount = 0;
+    OCObservationId * obArray = NSProviderGetObserverIds(consumerSubList, NULL, NULL, false,
+            &obCount);
 
-    NSCacheElement * it = consumerSubList->head;
-
-    while (it)
+    if (!obArray)
     {
-        NSCacheSubData * subData = (NSCacheSubData *) it->data;
-
-        if (subData->isWhite)
-        {
-            if (subData->messageObId != 0)
-            {
-                obArray[obCount++] = subData->messageObId;
-            }
-
-#if (defined WITH_CLOUD && defined RD_CLIENT)
-            if (subData->remote_messageObId != 0)
-            {
-                obArray[obCount++] = subData->remote_messageObId;
-            }
-#endif
-        }
-
-        it = it->next;
+        NS_LOG(ERROR, "fail to allocate observer list");
+        OCRepPayloadDestroy(payload);
+        return NS_ERROR;
     }
 
     if (!obCount)
     {
         NS_LOG(ERROR, "observer count is zero");
+        OICFree(obArray);
         return NS_ERROR;
     }
 
-    if (OCNotifyListOfObservers(rHandle, obArray, obCount, payload, OC_HIGH_QOS) != OC_STACK_OK)
+    OCStackResult ocstackResult = OCNotifyListOfObserversWithCount(rHandle, obArray, obCount,
+            payload, OC_HIGH_QOS);
+    OICFree(obArray);
+
+    if (ocstackResult != OC_STACK_OK)
     {
         NS_LOG(ERROR, "fail to send topic updation");
         OCRepPayloadDestroy(payload);
@@ -377,7 +365,7 @@ NSResult NSPostConsumerTopics(OCEntityHandlerRequest * entityHandlerRequest)
     NS_LOG_V(DEBUG, "TOPIC consumer ID = %s", consumerId);
 
     consumerTopicList->cacheType = NS_PROVIDER_CACHE_CONSUMER_TOPIC_CID;
-
+
     while (NSProviderStorageDelete(consumerTopicList, consumerId) != NS_FAIL)
     {
     }
@@ -421,7 +409,7 @@ NSResult NSPostConsumerTopics(OCEntityHandlerRequest * entityHandlerRequest)
             newObj->data = (NSCacheData *) topicSubData;
             newObj->next = NULL;
 
-            NSProviderStorageWrite(consumerTopicList, newObj);
+            NSProviderStorageWrite(consumerTopicList, newObj);
         }
     }
     NSSendTopicUpdationToConsumer(consumerId);
@@ -444,8 +432,7 @@ void * NSTopicSchedule(void * ptr)
 
         if (NSHeadMsg[TOPIC_SCHEDULER] != NULL)
         {
-            NSTask *node = NSHeadMsg[TOPIC_SCHEDULER];
-            NSHeadMsg[TOPIC_SCHEDULER] = node->nextTask;
+            NSTask *node = NSPopQueue(TOPIC_SCHEDULER);
 
             switch (node->taskType)
             {
@@ -490,7 +477,7 @@ void * NSTopicSchedule(void * ptr)
                         }
                     }
                     pthread_cond_signal(topicSyncResult->condition);
-                    pthread_mutex_unlock(topicSyncResult->mutex);
+                    pthread_mutex_unlock(topicSyncResult->mutex);
                 }
                     break;
                 case TASK_UNSUBSCRIBE_TOPIC:
@@ -0,0 +1,212 @@
+//******************************************************************
+//
+// Copyright 2016 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+extern "C"
+{
+#include "NSProviderScheduler.h"
+}
+
+namespace
+{
+    NSMessage g_messages[4];
+    NSSyncInfo g_syncs[2];
+
+    // Takes the next task the way the scheduler thread does.
+    NSTask * popTask(NSSchedulerType type)
+    {
+        sem_trywait(&NSSemaphore[type]);
+        pthread_mutex_lock(&NSMutex[type]);
+        NSTask * task = NSPopQueue(type);
+        pthread_mutex_unlock(&NSMutex[type]);
+        return task;
+    }
+
+    // Returns the data of the next task and frees the task, the data is owned by the test.
+    void * popData(NSSchedulerType type)
+    {
+        NSTask * task = popTask(type);
+        if (!task)
+        {
+            return NULL;
+        }
+        void * data = task->taskData;
+        OICFree(task);
+        return data;
+    }
+}
+
+// The queues are used without the scheduler threads, which would take the tasks.
+class NotificationProviderSchedulerTest : public testing::Test
+{
+public:
+    static void SetUpTestCase()
+    {
+        NSInitScheduler();
+
+        for (size_t i = 0; i < sizeof(g_messages) / sizeof(g_messages[0]); ++i)
+        {
+            g_messages[i].messageId = 100 + i;
+        }
+        g_syncs[0].messageId = g_messages[1].messageId;
+        g_syncs[0].state = NS_SYNC_READ;
+        g_syncs[1].messageId = 1;
+        g_syncs[1].state = NS_SYNC_DELETED;
+    }
+
+protected:
+    void TearDown()
+    {
+        while (popData(NOTIFICATION_SCHEDULER) || popData(CALLBACK_RESPONSE_SCHEDULER))
+        {
+        }
+    }
+};
+
+TEST_F(NotificationProviderSchedulerTest, ExpectSyncAheadOfOtherMessages)
+{
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[0]);
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[2]);
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_READ, &g_syncs[1]);
+
+    EXPECT_EQ(&g_syncs[1], popData(NOTIFICATION_SCHEDULER));
+    EXPECT_EQ(&g_messages[0], popData(NOTIFICATION_SCHEDULER));
+    EXPECT_EQ(&g_messages[2], popData(NOTIFICATION_SCHEDULER));
+    EXPECT_EQ(NULL, popData(NOTIFICATION_SCHEDULER));
+}
+
+TEST_F(NotificationProviderSchedulerTest, ExpectSyncBehindItsMessage)
+{
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[0]);
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[1]);
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[2]);
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_READ, &g_syncs[0]);
+    // Sync informations keep their order among themselves.
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_RECV_READ, &g_syncs[1]);
+
+    EXPECT_EQ(&g_messages[0], popData(NOTIFICATION_SCHEDULER));
+    EXPECT_EQ(&g_messages[1], popData(NOTIFICATION_SCHEDULER));
+    EXPECT_EQ(&g_syncs[0], popData(NOTIFICATION_SCHEDULER));
+    EXPECT_EQ(&g_syncs[1], popData(NOTIFICATION_SCHEDULER));
+    EXPECT_EQ(&g_messages[2], popData(NOTIFICATION_SCHEDULER));
+    EXPECT_EQ(NULL, popData(NOTIFICATION_SCHEDULER));
+}
+
+TEST_F(NotificationProviderSchedulerTest, ExpectCallbacksInOrder)
+{
+    int subscription = 0;
+    NSPushQueue(CALLBACK_RESPONSE_SCHEDULER, TASK_CB_SUBSCRIPTION, &subscription);
+    NSPushQueue(CALLBACK_RESPONSE_SCHEDULER, TASK_CB_SYNC, &g_syncs[1]);
+
+    EXPECT_EQ(&subscription, popData(CALLBACK_RESPONSE_SCHEDULER));
+    EXPECT_EQ(&g_syncs[1], popData(CALLBACK_RESPONSE_SCHEDULER));
+}
+
+TEST_F(NotificationProviderSchedulerTest, ExpectBatchNotDelayedForSingleMessage)
+{
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[0]);
+
+    NSTask * batch[NS_NOTIFICATION_BATCH_SIZE];
+    batch[0] = popTask(NOTIFICATION_SCHEDULER);
+    ASSERT_NE(nullptr, batch[0]);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(1u, NSPopQueueBatch(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION,
+            batch, NS_NOTIFICATION_BATCH_SIZE, 1000));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+    OICFree(batch[0]);
+}
+
+TEST_F(NotificationProviderSchedulerTest, ExpectBatchStopsAtOtherTask)
+{
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[0]);
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[1]);
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[2]);
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_READ, &g_syncs[0]);
+
+    NSTask * batch[NS_NOTIFICATION_BATCH_SIZE];
+    batch[0] = popTask(NOTIFICATION_SCHEDULER);
+    ASSERT_NE(nullptr, batch[0]);
+
+    ASSERT_EQ(2u, NSPopQueueBatch(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION,
+            batch, NS_NOTIFICATION_BATCH_SIZE, 10));
+    EXPECT_EQ(&g_messages[0], batch[0]->taskData);
+    EXPECT_EQ(&g_messages[1], batch[1]->taskData);
+    OICFree(batch[0]);
+    OICFree(batch[1]);
+
+    EXPECT_EQ(&g_syncs[0], popData(NOTIFICATION_SCHEDULER));
+    EXPECT_EQ(&g_messages[2], popData(NOTIFICATION_SCHEDULER));
+}
+
+TEST_F(NotificationProviderSchedulerTest, ExpectBatchWaitsForMessagesWithinWindow)
+{
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[0]);
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[1]);
+
+    NSTask * batch[4];
+    batch[0] = popTask(NOTIFICATION_SCHEDULER);
+    ASSERT_NE(nullptr, batch[0]);
+
+    std::thread producer([]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[2]);
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    size_t count = NSPopQueueBatch(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION,
+            batch, 4, 200);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    producer.join();
+
+    ASSERT_EQ(3u, count);
+    EXPECT_EQ(&g_messages[2], batch[2]->taskData);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(200));
+    for (size_t i = 0; i < count; ++i)
+    {
+        OICFree(batch[i]);
+    }
+}
+
+TEST_F(NotificationProviderSchedulerTest, ExpectQueueStatsCountTasks)
+{
+    NSProviderQueueStats before;
+    NSGetQueueStats(NOTIFICATION_SCHEDULER, &before);
+
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_NOTIFICATION, &g_messages[0]);
+    NSPushQueue(NOTIFICATION_SCHEDULER, TASK_SEND_READ, &g_syncs[1]);
+
+    NSProviderQueueStats stats;
+    NSGetQueueStats(NOTIFICATION_SCHEDULER, &stats);
+    EXPECT_EQ(before.pendingTasks + 2, stats.pendingTasks);
+
+    popData(NOTIFICATION_SCHEDULER);
+    popData(NOTIFICATION_SCHEDULER);
+
+    NSGetQueueStats(NOTIFICATION_SCHEDULER, &stats);
+    EXPECT_EQ(before.pendingTasks, stats.pendingTasks);
+    EXPECT_EQ(before.processedTasks + 2, stats.processedTasks);
+    EXPECT_EQ(before.syncTasks + 1, stats.syncTasks);
+    EXPECT_GE(stats.maxLatency, stats.syncMaxLatency);
+}
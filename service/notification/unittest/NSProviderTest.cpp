@@ -495,6 +495,15 @@ TEST_F(NotificationProviderTest, ExpectFailSendMessage)
     EXPECT_EQ(result, NS_FAIL);
 }
 
+TEST_F(NotificationProviderTest, ExpectFailGetQueueStats)
+{
+    NSResult result;
+    result = NS_SUCCESS;
+    result = NSProviderGetQueueStats(NULL);
+
+    EXPECT_EQ(result, NS_FAIL);
+}
+
 TEST_F(NotificationProviderTest, ExpectFailRegisterTopic)
 {
     NSResult result;
@@ -27,6 +27,7 @@
 #ifndef RCSBUNDLEINFO_H_
 #define RCSBUNDLEINFO_H_
 
+#include <chrono>
 #include <string>
 
 namespace OIC
@@ -90,6 +91,14 @@ namespace OIC
                 */
                 virtual bool isActivated() = 0;
 
+                /**
+                * API for getting the time the last activation of the bundle took
+                *
+                * @return activation time of the bundle, zero if it was never activated
+                *
+                */
+                virtual std::chrono::milliseconds getActivationTime() = 0;
+
                 RCSBundleInfo()
                 {
                 };
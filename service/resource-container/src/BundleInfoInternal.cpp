@@ -38,6 +38,7 @@ namespace OIC
             m_activated = false;
             m_java_bundle = false;
             m_id = 0;
+            m_activationTime = std::chrono::milliseconds::zero();
         }
 
         BundleInfoInternal::~BundleInfoInternal()
@@ -98,6 +99,16 @@ namespace OIC
             return m_activated;
         }
 
+        void BundleInfoInternal::setActivationTime(std::chrono::milliseconds activationTime)
+        {
+            m_activationTime = activationTime;
+        }
+
+        std::chrono::milliseconds BundleInfoInternal::getActivationTime()
+        {
+            return m_activationTime;
+        }
+
         void BundleInfoInternal::setBundleActivator(activator_t *activator)
         {
             m_activator = activator;
@@ -230,6 +241,7 @@ namespace OIC
             m_version = source->getVersion();
             m_loaded = source->isLoaded();
             m_activated = source->isActivated();
+            m_activationTime = source->getActivationTime();
             m_java_bundle = source->getJavaBundle();
             m_activator = source->getBundleActivator();
             m_bundleHandle = source->getBundleHandle();
@@ -21,6 +21,7 @@
 #ifndef BUNDLEINFOINTERNAL_H_
 #define BUNDLEINFOINTERNAL_H_
 
+#include <chrono>
 #include <string>
 #include "RCSBundleInfo.h"
 #include "ResourceContainerBundleAPI.h"
@@ -59,6 +60,9 @@ namespace OIC
                 void setActivated(bool activated);
                 bool isActivated();
 
+                void setActivationTime(std::chrono::milliseconds activationTime);
+                virtual std::chrono::milliseconds getActivationTime();
+
                 virtual void setLibraryPath(const std::string &libpath);
                 virtual const std::string &getLibraryPath();
 
@@ -108,6 +112,7 @@ namespace OIC
                 void *m_bundleHandle;
                 string m_activator_name;
                 string m_library_path;
+                std::chrono::milliseconds m_activationTime;
 #if (JAVA_SUPPORT)
                 jmethodID m_java_activator, m_java_deactivator;
                 jobject m_java_activator_object;
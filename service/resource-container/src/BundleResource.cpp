@@ -23,10 +23,10 @@
 #include <list>
 #include <string.h>
 #include <iostream>
-#include <boost/thread.hpp>
 #include "NotificationReceiver.h"
 
 #include "InternalTypes.h"
+#include "NotificationDispatcher.h"
 
 namespace OIC
 {
@@ -76,25 +76,14 @@ namespace OIC
 
             for (auto &it : attrs)
             {
-                OIC_LOG_V(INFO, CONTAINER_TAG, "set attribute \(%s)'",
-                           std::string(it.key() + "\', with " + it.value().toString()).c_str());
+                OIC_LOG_V(DEBUG, CONTAINER_TAG, "set attribute (%s)", it.key().c_str());
 
                 m_resourceAttributes[it.key()] = it.value();
             }
 
             if(notify)
             {
-                // asynchronous notification
-                auto notifyFunc = [](NotificationReceiver *notificationReceiver,
-                                        std::string uri)
-                {
-                    if (notificationReceiver)
-                    {
-                        notificationReceiver->onNotificationReceived(uri);
-                    }
-                };
-                auto f = std::bind(notifyFunc, m_pNotiReceiver, m_uri);
-                boost::thread notifyThread(f);
+                sendNotification(m_pNotiReceiver, m_uri);
             }
 
         }
@@ -102,24 +91,13 @@ namespace OIC
         void BundleResource::setAttribute(const std::string &key,
                                           RCSResourceAttributes::Value &&value, bool notify)
         {
-            OIC_LOG_V(INFO, CONTAINER_TAG, "set attribute \(%s)'", std::string(key + "\', with " +
-                     value.toString()).c_str());
+            OIC_LOG_V(DEBUG, CONTAINER_TAG, "set attribute (%s)", key.c_str());
             std::lock_guard<std::mutex> lock(m_resourceAttributes_mutex);
             m_resourceAttributes[key] = std::move(value);
 
             if(notify)
             {
-                // asynchronous notification
-                auto notifyFunc = [](NotificationReceiver *notificationReceiver,
-                                        std::string uri)
-                {
-                    if (notificationReceiver)
-                    {
-                        notificationReceiver->onNotificationReceived(uri);
-                    }
-                };
-                auto f = std::bind(notifyFunc, m_pNotiReceiver, m_uri);
-                boost::thread notifyThread(f);
+                sendNotification(m_pNotiReceiver, m_uri);
             }
 
         }
@@ -142,9 +120,16 @@ namespace OIC
             setAttribute(key, value, true);
         }
 
+        void BundleResource::sendNotification(NotificationReceiver *notificationReceiver,
+                                              std::string uri)
+        {
+            // Delivered asynchronously, merged with notifications still pending for the uri.
+            NotificationDispatcher::getInstance()->post(notificationReceiver, uri);
+        }
+
         RCSResourceAttributes::Value BundleResource::getAttribute(const std::string &key)
         {
-            OIC_LOG_V(INFO, CONTAINER_TAG, "get attribute \'(%s)" , std::string(key + "\'").c_str());
+            OIC_LOG_V(DEBUG, CONTAINER_TAG, "get attribute (%s)", key.c_str());
             std::lock_guard<std::mutex> lock(m_resourceAttributes_mutex);
             return m_resourceAttributes.at(key);
         }
@@ -73,6 +73,8 @@ namespace OIC
         bool Configuration::isHasInput(std::string &bundleId) const
         {
 
+            std::lock_guard< std::mutex > lock(m_mapisHasInputLock);
+
             try
             {
                 OIC_LOG_V(INFO, CONTAINER_TAG, "isHasInput: (%d) %s",m_mapisHasInput.at(bundleId), bundleId.c_str() );
@@ -85,6 +87,13 @@ namespace OIC
             }
         }
 
+        void Configuration::setHasInput(const std::string &bundleId)
+        {
+            // Bundles activated concurrently read their resource configuration at once.
+            std::lock_guard< std::mutex > lock(m_mapisHasInputLock);
+            m_mapisHasInput[bundleId] = true;
+        }
+
         void Configuration::getConfiguredBundles(configInfo *configOutput)
         {
             rapidxml::xml_node< char > *bundle = nullptr;
@@ -283,7 +292,7 @@ namespace OIC
 
                                                     if (strKey.compare(INPUT_RESOURCE))
                                                     {
-                                                        m_mapisHasInput[strBundleId] = true;
+                                                        setHasInput(strBundleId);
                                                         OIC_LOG_V(INFO, CONTAINER_TAG,
                                                                 "Bundle has input (%s)",
                                                                 strBundleId.c_str());
@@ -409,7 +418,7 @@ namespace OIC
 
                                                     if (strKey.compare(INPUT_RESOURCE))
                                                     {
-                                                        m_mapisHasInput[strBundleId] = true;
+                                                        setHasInput(strBundleId);
                                                         OIC_LOG_V(INFO, CONTAINER_TAG,
                                                                 "Bundle has input (%s)",
                                                                 strBundleId.c_str());
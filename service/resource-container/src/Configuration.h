@@ -32,6 +32,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
 
 #include "rapidxml/rapidxml.hpp"
 #include "rapidxml/rapidxml_print.hpp"
@@ -69,12 +70,14 @@ namespace OIC
 
             private:
                 void getConfigDocument(string pathConfigFile);
+                void setHasInput(const std::string &bundleId);
 
                 bool m_loaded;
                 string m_pathConfigFile;
                 string m_strConfigData;
                 rapidxml::xml_document< char > m_xmlDoc;
                 std::map<std::string, bool> m_mapisHasInput; // bundleId, isHasInput
+                mutable std::mutex m_mapisHasInputLock;
         };
     }
 }
@@ -0,0 +1,110 @@
+//******************************************************************
+//
+// Copyright 2016 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#include "NotificationDispatcher.h"
+
+#include <exception>
+
+#include "InternalTypes.h"
+
+namespace OIC
+{
+    namespace Service
+    {
+        NotificationDispatcher *NotificationDispatcher::getInstance()
+        {
+            static NotificationDispatcher instance;
+            return &instance;
+        }
+
+        NotificationDispatcher::NotificationDispatcher() :
+            m_stop(false)
+        {
+            m_thread = std::thread(&NotificationDispatcher::dispatch, this);
+        }
+
+        NotificationDispatcher::~NotificationDispatcher()
+        {
+            {
+                std::lock_guard< std::mutex > lock(m_mutex);
+                m_stop = true;
+            }
+            m_cond.notify_one();
+
+            if (m_thread.joinable())
+            {
+                m_thread.join();
+            }
+        }
+
+        void NotificationDispatcher::post(NotificationReceiver *receiver, const std::string &uri)
+        {
+            if (!receiver)
+            {
+                return;
+            }
+
+            {
+                std::lock_guard< std::mutex > lock(m_mutex);
+
+                Notification notification(receiver, uri);
+                if (!m_pending.insert(notification).second)
+                {
+                    return;
+                }
+                m_queue.push_back(std::move(notification));
+            }
+            m_cond.notify_one();
+        }
+
+        void NotificationDispatcher::dispatch()
+        {
+            std::unique_lock< std::mutex > lock(m_mutex);
+
+            while (true)
+            {
+                m_cond.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+
+                if (m_stop)
+                {
+                    break;
+                }
+
+                Notification notification = std::move(m_queue.front());
+                m_queue.pop_front();
+                m_pending.erase(notification);
+
+                // Unlocked while delivering, so the resource can post again
+                // for changes made meanwhile.
+                lock.unlock();
+                try
+                {
+                    notification.first->onNotificationReceived(notification.second);
+                }
+                catch (const std::exception &e)
+                {
+                    OIC_LOG_V(ERROR, CONTAINER_TAG, "Failed to notify %s : %s",
+                              notification.second.c_str(), e.what());
+                }
+                lock.lock();
+            }
+        }
+    }
+}
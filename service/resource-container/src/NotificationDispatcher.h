@@ -0,0 +1,76 @@
+//******************************************************************
+//
+// Copyright 2016 Samsung Electronics All Rights Reserved.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
+
+#ifndef NOTIFICATIONDISPATCHER_H_
+#define NOTIFICATIONDISPATCHER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "NotificationReceiver.h"
+
+namespace OIC
+{
+    namespace Service
+    {
+        /**
+        * @class    NotificationDispatcher
+        * @brief    Delivers notifications of bundle resources to their receivers on a
+        *               single worker thread.
+        *
+        * A notification posted while an earlier one for the same receiver and uri is still
+        * pending is merged into it, since the receiver reads the latest attributes anyway.
+        */
+        class NotificationDispatcher
+        {
+            public:
+                static NotificationDispatcher *getInstance();
+
+                void post(NotificationReceiver *receiver, const std::string &uri);
+
+            private:
+                typedef std::pair< NotificationReceiver *, std::string > Notification;
+
+                NotificationDispatcher();
+                ~NotificationDispatcher();
+
+                NotificationDispatcher(const NotificationDispatcher &) = delete;
+                NotificationDispatcher &operator=(const NotificationDispatcher &) = delete;
+
+                void dispatch();
+
+            private:
+                std::deque< Notification > m_queue;
+                std::set< Notification > m_pending;
+                bool m_stop;
+
+                std::mutex m_mutex;
+                std::condition_variable m_cond;
+                std::thread m_thread;
+        };
+    }
+}
+
+#endif /* NOTIFICATIONDISPATCHER_H_ */
@@ -29,6 +29,8 @@
 #include <thread>
 #include <mutex>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 
 #include "BundleActivator.h"
 #include "SoftSensorResource.h"
@@ -77,6 +79,7 @@ namespace OIC
                     if (m_config->isLoaded())
                     {
                         configInfo bundles;
+                        std::vector< std::string > soBundleIds;
                         m_config->getConfiguredBundles(&bundles);
 
                         for (unsigned int i = 0; i < bundles.size(); i++)
@@ -98,8 +101,20 @@ namespace OIC
                                                  bundles[i][BUNDLE_PATH]).c_str());
 
                             registerBundle(bundleInfo);
-                            activateBundle(bundleInfo);
+
+                            // .so bundles are independent of each other and are activated
+                            // concurrently below, Java bundles share the JVM.
+                            if (bundleInfo->getSoBundle() && bundleInfo->isLoaded())
+                            {
+                                soBundleIds.push_back(bundleInfo->getID());
+                            }
+                            else
+                            {
+                                activateBundle(bundleInfo);
+                            }
                         }
+
+                        activateBundlesConcurrently(soBundleIds);
                     }
                     else
                     {
@@ -194,6 +209,44 @@ namespace OIC
                      std::string(m_bundles[id]->getID()).c_str());
         }
 
+        void ResourceContainerImpl::activateBundlesConcurrently(const std::vector< std::string > &ids)
+        {
+            std::atomic< size_t > next(0);
+
+            auto activateNext = [this, &ids, &next]()
+            {
+                for (size_t i = next++; i < ids.size(); i = next++)
+                {
+                    try
+                    {
+                        activateBundleThread(ids[i]);
+                    }
+                    catch (...)
+                    {
+                        OIC_LOG_V(INFO, CONTAINER_TAG, "Activating bundle: (%s) failed",
+                                  ids[i].c_str());
+                    }
+                }
+            };
+
+            size_t numThreads = std::min< size_t >(ids.size(),
+                    std::max(1u, std::min(std::thread::hardware_concurrency(),
+                                          (unsigned int) BUNDLE_ACTIVATION_MAX_THREADS)));
+
+            std::vector< std::thread > threads;
+            for (size_t i = 1; i < numThreads; i++)
+            {
+                threads.emplace_back(activateNext);
+            }
+
+            activateNext();
+
+            for (auto &thread : threads)
+            {
+                thread.join();
+            }
+        }
+
         void ResourceContainerImpl::deactivateBundle(const std::string &id)
         {
             if (m_bundles[id]->getJavaBundle())
@@ -818,12 +871,13 @@ namespace OIC
 
         void ResourceContainerImpl::activateSoBundle(const std::string &bundleId)
         {
-            activator_t *bundleActivator = m_bundles[bundleId]->getBundleActivator();
+            shared_ptr<BundleInfoInternal> bundleInfoInternal = m_bundles.at(bundleId);
+            activator_t *bundleActivator = bundleInfoInternal->getBundleActivator();
 
             if (bundleActivator != NULL)
             {
-                bundleActivator(this, m_bundles[bundleId]->getID());
-                m_bundles[bundleId]->setActivated(true);
+                bundleActivator(this, bundleInfoInternal->getID());
+                bundleInfoInternal->setActivated(true);
             }
             else
             {
@@ -831,7 +885,6 @@ namespace OIC
                 OIC_LOG(ERROR, CONTAINER_TAG, "Activation unsuccessful.");
             }
 
-            shared_ptr<BundleInfoInternal> bundleInfoInternal = m_bundles[bundleId];
             bundleInfoInternal->setActivated(true);
 
         }
@@ -978,22 +1031,30 @@ namespace OIC
 
         void ResourceContainerImpl::activateBundleThread(const std::string &id)
         {
+            // may run on several threads at once, so m_bundles is only looked up
+            shared_ptr<BundleInfoInternal> bundleInfo = m_bundles.at(id);
+            auto startTime = std::chrono::steady_clock::now();
+
             OIC_LOG_V(INFO, CONTAINER_TAG, "Activating bundle: (%s)",
-                     std::string(m_bundles[id]->getID()).c_str());
+                     std::string(bundleInfo->getID()).c_str());
 
-            if (m_bundles[id]->getJavaBundle())
+            if (bundleInfo->getJavaBundle())
             {
 #if(JAVA_SUPPORT)
                 activateJavaBundle(id);
 #endif
             }
-            else if (m_bundles[id]->getSoBundle())
+            else if (bundleInfo->getSoBundle())
             {
                 activateSoBundle (id);
             }
 
-            OIC_LOG_V(INFO, CONTAINER_TAG, "Bundle activated: (%s)",
-                     std::string(m_bundles[id]->getID()).c_str());
+            bundleInfo->setActivationTime(std::chrono::duration_cast< std::chrono::milliseconds >(
+                    std::chrono::steady_clock::now() - startTime));
+
+            OIC_LOG_V(INFO, CONTAINER_TAG, "Bundle activated: (%s) in %lld ms",
+                     std::string(bundleInfo->getID()).c_str(),
+                     (long long) bundleInfo->getActivationTime().count());
         }
 
 #if(JAVA_SUPPORT)
@@ -43,6 +43,7 @@
 #define BUNDLE_ACTIVATION_WAIT_SEC 10
 #define BUNDLE_SET_GET_WAIT_SEC 10
 #define BUNDLE_PATH_MAXLEN 300
+#define BUNDLE_ACTIVATION_MAX_THREADS 4
 
 using namespace OIC::Service;
 
@@ -131,6 +132,7 @@ namespace OIC
                 void discoverInputResource(const std::string &outputResourceUri);
                 void undiscoverInputResource(const std::string &outputResourceUri);
                 void activateBundleThread(const std::string &bundleId);
+                void activateBundlesConcurrently(const std::vector< std::string > &bundleIds);
 
                 void activateBundle(shared_ptr<RCSBundleInfo> bundleInfo);
                 void deactivateBundle(shared_ptr<RCSBundleInfo> bundleInfo);
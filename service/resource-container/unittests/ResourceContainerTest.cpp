@@ -27,6 +27,9 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 #include <UnitTestHelper.h>
 
@@ -178,6 +181,48 @@ class TestSoftSensorResource: public SoftSensorResource
         {
         }
 };
+/*Notification receiver that holds the first notification until released*/
+class BlockingNotificationReceiver: public NotificationReceiver
+{
+    public:
+        BlockingNotificationReceiver() : m_count(0), m_released(false)
+        {
+        }
+
+        virtual void onNotificationReceived(const std::string &)
+        {
+            std::unique_lock< std::mutex > lock(m_mutex);
+            ++m_count;
+            m_cond.notify_all();
+            m_cond.wait(lock, [this] { return m_released; });
+        }
+
+        bool waitForCount(int count)
+        {
+            std::unique_lock< std::mutex > lock(m_mutex);
+            return m_cond.wait_for(lock, std::chrono::seconds(1),
+                                   [this, count] { return m_count >= count; });
+        }
+
+        void release()
+        {
+            std::lock_guard< std::mutex > lock(m_mutex);
+            m_released = true;
+            m_cond.notify_all();
+        }
+
+        int getCount()
+        {
+            std::lock_guard< std::mutex > lock(m_mutex);
+            return m_count;
+        }
+
+    private:
+        int m_count;
+        bool m_released;
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+};
 
 class ResourceContainerTest: public TestWithMock
 {
@@ -245,6 +290,26 @@ TEST_F(ResourceContainerTest, TestBundleResource)
     EXPECT_EQ(2, testResource.getAttribute("attrib2"));
 }
 
+TEST_F(ResourceContainerTest, PendingNotificationsOfBundleResourceAreMerged)
+{
+    BlockingNotificationReceiver receiver;
+    TestBundleResource testResource;
+    testResource.m_uri = "/test_resource";
+    testResource.registerObserver(&receiver);
+
+    testResource.setAttribute("attrib1", RCSResourceAttributes::Value(1));
+    ASSERT_TRUE(receiver.waitForCount(1));
+
+    testResource.setAttribute("attrib1", RCSResourceAttributes::Value(2));
+    testResource.setAttribute("attrib1", RCSResourceAttributes::Value(3));
+    testResource.setAttribute("attrib1", RCSResourceAttributes::Value(4));
+    receiver.release();
+
+    ASSERT_TRUE(receiver.waitForCount(2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(2, receiver.getCount());
+}
+
 TEST_F(ResourceContainerTest, TestSoftSensorResource)
 {
     TestSoftSensorResource softSensorResource;
@@ -292,6 +357,25 @@ TEST_F(ResourceContainerTest, BundleActivatedWhenContainerStartedWithValidConfig
     m_pResourceContainer->stopContainer();
 }
 
+TEST_F(ResourceContainerTest, BundlesActivatedConcurrentlyWhenContainerStarted)
+{
+    std::string configPath;
+    getCurrentPath(&configPath);
+    configPath.append("/ResourceContainerConcurrentConfig.xml");
+
+    m_pResourceContainer->startContainer(configPath);
+
+    std::list<std::unique_ptr<RCSBundleInfo>> bundles = m_pResourceContainer->listBundles();
+    EXPECT_EQ((unsigned int) 3, bundles.size());
+    for (auto &bundle : bundles)
+    {
+        EXPECT_TRUE(bundle->isActivated());
+        EXPECT_GT(bundle->getActivationTime(), std::chrono::milliseconds::zero());
+    }
+
+    m_pResourceContainer->stopContainer();
+}
+
 TEST_F(ResourceContainerTest, BundleNotRegisteredWhenContainerStartedWithInvalidConfigFile)
 {
     m_pResourceContainer->startContainer("invalidConfig");
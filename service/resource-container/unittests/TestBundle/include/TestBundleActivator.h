@@ -29,6 +29,8 @@
 
 using namespace OIC::Service;
 
+#define TEST_BUNDLE_ACTIVATION_MILLITIME 20
+
 class TestBundleActivator : public BundleActivator
 {
     public:
@@ -20,7 +20,14 @@
 
 #include "TestBundleActivator.h"
 
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+// Several bundles of a configuration may share this library and are activated concurrently.
 TestBundleActivator *bundle;
+static int activations = 0;
+static std::mutex activationMutex;
 
 TestBundleActivator::TestBundleActivator()
 {
@@ -71,14 +78,28 @@ void TestBundleActivator::destroyResource(BundleResource::Ptr pBundleResource)
 extern "C" void test_externalActivateBundle(ResourceContainerBundleAPI *resourceContainer,
         std::string bundleId)
 {
-    bundle = new TestBundleActivator();
-    bundle->activateBundle(resourceContainer, bundleId);
+    {
+        std::lock_guard< std::mutex > lock(activationMutex);
+        if (activations++ == 0)
+        {
+            bundle = new TestBundleActivator();
+        }
+        bundle->activateBundle(resourceContainer, bundleId);
+    }
+
+    // take measurable time, the container records how long the activation took
+    std::this_thread::sleep_for(std::chrono::milliseconds(TEST_BUNDLE_ACTIVATION_MILLITIME));
 }
 
 extern "C" void test_externalDeactivateBundle()
 {
-    bundle->deactivateBundle();
-    delete bundle;
+    std::lock_guard< std::mutex > lock(activationMutex);
+    if (--activations == 0)
+    {
+        bundle->deactivateBundle();
+        delete bundle;
+        bundle = nullptr;
+    }
 }
 
 extern "C" void test_externalCreateResource(resourceInfo resourceInfo)
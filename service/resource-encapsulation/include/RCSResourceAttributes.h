@@ -33,6 +33,7 @@
 #define BOOST_MPL_LIMIT_VECTOR_SIZE 30
 
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -409,13 +410,18 @@ namespace OIC
             class iterator;
             class const_iterator;
 
+        private:
+            class ChangeTracker;
+
         public:
-            RCSResourceAttributes() = default;
-            RCSResourceAttributes(const RCSResourceAttributes&) = default;
-            RCSResourceAttributes(RCSResourceAttributes&&) = default;
+            RCSResourceAttributes();
+            RCSResourceAttributes(const RCSResourceAttributes&);
+            RCSResourceAttributes(RCSResourceAttributes&&);
+
+            ~RCSResourceAttributes();
 
-            RCSResourceAttributes& operator=(const RCSResourceAttributes&) = default;
-            RCSResourceAttributes& operator=(RCSResourceAttributes&&) = default;
+            RCSResourceAttributes& operator=(const RCSResourceAttributes&);
+            RCSResourceAttributes& operator=(RCSResourceAttributes&&);
 
             /**
              * Returns an {@link iterator} referring to the first element.
@@ -562,7 +568,34 @@ namespace OIC
              */
             size_t size() const BOOST_NOEXCEPT;
 
+            /**
+             * Starts tracking changes of the elements.
+             *
+             * While tracking, the value of an element is saved the first time it is accessed
+             * for modification, so the changed elements can be found without comparing
+             * every element. Tracking can be nested; each call must be paired with
+             * stopTrackingChanges().
+             *
+             * @note Getting a non-const iterator saves all the elements.
+             *
+             * @see stopTrackingChanges
+             */
+            void startTrackingChanges() const;
+
+            /**
+             * Stops the tracking most recently started.
+             *
+             * @return Keys of the elements added, removed or changed since the matching
+             *         startTrackingChanges().
+             *
+             * @see startTrackingChanges
+             */
+            std::vector< std::string > stopTrackingChanges() const;
+
         private:
+            void trackChange(const std::string& key);
+            void trackAllChanges();
+
             template< typename VISITOR >
             void visit(VISITOR& visitor) const
             {
@@ -580,6 +613,8 @@ namespace OIC
             {
                 KeyValueVisitorHelper< VISITOR, std::true_type > helper{ visitor };
 
+                trackAllChanges();
+
                 for (auto& i : m_values)
                 {
                     boost::variant< const std::string& > key{ i.first };
@@ -590,6 +625,8 @@ namespace OIC
         private:
             std::unordered_map< std::string, Value > m_values;
 
+            mutable std::unique_ptr< ChangeTracker > m_changeTracker;
+
             //! @cond
             friend class ResourceAttributesConverter;
 
@@ -26,6 +26,7 @@
 #ifndef SERVER_RCSRESOURCEOBJECT_H
 #define SERVER_RCSRESOURCEOBJECT_H
 
+#include <chrono>
 #include <string>
 #include <mutex>
 #include <thread>
@@ -47,6 +48,7 @@ namespace OIC
         class RCSRequest;
         class RCSRepresentation;
         class InterfaceHandler;
+        class ExpiryTimer;
 
         /**
          * @brief Thrown when lock has not been acquired.
@@ -486,6 +488,47 @@ namespace OIC
              */
             AutoNotifyPolicy getAutoNotifyPolicy() const;
 
+            /**
+             * Sets the window in which auto notifications are merged.
+             *
+             * An auto notification is delayed by the window, and all auto notifications
+             * requested until it is sent are merged into it.
+             * The default is zero, which notifies immediately.
+             *
+             * @param window window to be set
+             *
+             * @note Attributes changed in the scope of a LockGuard are notified once
+             *       when the scope ends, regardless of the window.
+             *
+             * @see setMinNotifyInterval
+             */
+            void setAutoNotifyWindow(std::chrono::milliseconds window);
+
+            /**
+             * Returns the current auto notify window.
+             */
+            std::chrono::milliseconds getAutoNotifyWindow() const;
+
+            /**
+             * Sets the minimum interval between notifications, which limits the rate of
+             * notifications sent to the observers of this resource.
+             *
+             * An auto notification requested sooner is delayed until the interval elapses,
+             * merging any others requested meanwhile.
+             * Calls to notify() are not delayed, but each starts a new interval.
+             * The default is zero.
+             *
+             * @param interval interval to be set
+             *
+             * @see setAutoNotifyWindow
+             */
+            void setMinNotifyInterval(std::chrono::milliseconds interval);
+
+            /**
+             * Returns the current minimum notify interval.
+             */
+            std::chrono::milliseconds getMinNotifyInterval() const;
+
             /**
              * Sets the policy for handling a set request.
              *
@@ -585,6 +628,9 @@ namespace OIC
             void autoNotify(bool, AutoNotifyPolicy) const;
             void autoNotify(bool) const;
 
+            bool scheduleNotify() const;
+            void sendScheduledNotify() const;
+
             bool testValueUpdated(const std::string&, const RCSResourceAttributes::Value&) const;
 
             template< typename K, typename V >
@@ -628,6 +674,17 @@ namespace OIC
 
             std::map< std::string, InterfaceHandler > m_interfaceHandlers;
 
+            std::weak_ptr< RCSResourceObject > m_self;
+
+            std::chrono::milliseconds m_autoNotifyWindow;
+            std::chrono::milliseconds m_minNotifyInterval;
+
+            mutable std::chrono::steady_clock::time_point m_lastNotifyTime;
+            mutable bool m_isNotifyScheduled;
+            mutable std::unique_ptr< ExpiryTimer > m_notifyTimer;
+
+            mutable std::mutex m_mutexForNotify;
+
             friend class RCSSeparateResponse;
         };
 
@@ -686,8 +743,6 @@ namespace OIC
             AutoNotifyPolicy m_autoNotifyPolicy;
 
             bool m_isOwningLock;
-
-            std::function<void()> m_autoNotifyFunc;
         };
 
     }
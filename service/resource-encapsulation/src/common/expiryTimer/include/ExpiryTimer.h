@@ -38,6 +38,7 @@ namespace OIC
             typedef unsigned int Id;
             typedef std::function< void(Id) > Callback;
             typedef long long DelayInMilliSec;
+            typedef std::function< void(std::function< void() >) > Executor;
 
         public:
             ExpiryTimer();
@@ -56,6 +57,14 @@ namespace OIC
             size_t getNumOfPending();
             size_t getNumOfPending() const;
 
+            /**
+             * Sets how expired callbacks of all timers are run, for example on a
+             * thread pool. The executor is called from the timer thread and must
+             * not block. By default every callback runs on a new detached thread.
+             * An empty executor restores the default.
+             */
+            static void setExecutor(Executor);
+
         private:
             void sweep();
 
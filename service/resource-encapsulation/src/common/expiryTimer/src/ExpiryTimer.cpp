@@ -98,6 +98,11 @@ namespace OIC
             return ret;
         }
 
+        void ExpiryTimer::setExecutor(Executor executor)
+        {
+            ExpiryTimerImpl::getInstance()->setExecutor(std::move(executor));
+        }
+
         void ExpiryTimer::sweep()
         {
             for (auto it = m_tasks.begin(); it != m_tasks.end();)
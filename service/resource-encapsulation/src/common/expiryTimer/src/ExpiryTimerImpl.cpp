@@ -30,14 +30,21 @@ namespace OIC
         namespace
         {
             constexpr ExpiryTimerImpl::Id INVALID_ID{ 0U };
+
+            void runOnNewThread(std::function< void() > task)
+            {
+                std::thread(std::move(task)).detach();
+            }
         }
 
         ExpiryTimerImpl::ExpiryTimerImpl() :
                 m_tasks{ },
+                m_taskIndex{ },
                 m_thread{ },
                 m_mutex{ },
                 m_cond{ },
                 m_stop{ false },
+                m_executor{ runOnNewThread },
                 m_mt{ std::random_device{ }() },
                 m_dist{ }
         {
@@ -49,6 +56,7 @@ namespace OIC
             {
                 std::lock_guard< std::mutex > lock{ m_mutex };
                 m_tasks.clear();
+                m_taskIndex.clear();
                 m_stop = true;
             }
             m_cond.notify_all();
@@ -73,7 +81,11 @@ namespace OIC
                 throw RCSInvalidParameterException{ "callback is empty." };
             }
 
-            return addTask(convertToTime(Milliseconds{ delay }), std::move(cb), generateId());
+            // A steady clock keeps deadlines unaffected by changes of the system time.
+            const auto expiry = Clock::now() + Milliseconds{ delay };
+
+            std::lock_guard< std::mutex > lock{ m_mutex };
+            return addTask(expiry, std::move(cb));
         }
 
         bool ExpiryTimerImpl::cancel(Id id)
@@ -82,15 +94,11 @@ namespace OIC
 
             std::lock_guard< std::mutex > lock{ m_mutex };
 
-            for(auto it = m_tasks.begin(); it != m_tasks.end(); ++it)
-            {
-                if(it->second->getId() == id)
-                {
-                    m_tasks.erase(it);
-                    return true;
-                }
-            }
-            return false;
+            auto it = m_taskIndex.find(id);
+            if (it == m_taskIndex.end()) return false;
+
+            eraseTask(it->second);
+            return true;
         }
 
         size_t ExpiryTimerImpl::cancelAll(
@@ -99,54 +107,47 @@ namespace OIC
             std::lock_guard< std::mutex > lock{ m_mutex };
             size_t erased { 0 };
 
-            for(auto it = m_tasks.begin(); it != m_tasks.end();)
+            for (const auto& task : tasks)
             {
-                if(tasks.count(it->second))
+                auto it = m_taskIndex.find(task->getId());
+
+                if (it != m_taskIndex.end() && it->second->second == task)
                 {
-                    it = m_tasks.erase(it);
+                    eraseTask(it->second);
                     ++erased;
                 }
-                else
-                {
-                    ++it;
-                }
             }
             return erased;
         }
 
-        ExpiryTimerImpl::Milliseconds ExpiryTimerImpl::convertToTime(Milliseconds delay)
+        void ExpiryTimerImpl::setExecutor(Executor executor)
         {
-            const auto now = std::chrono::system_clock::now();
-            return std::chrono::duration_cast< Milliseconds >(now.time_since_epoch()) + delay;
+            std::lock_guard< std::mutex > lock{ m_mutex };
+            m_executor = executor ? std::move(executor) : Executor{ runOnNewThread };
         }
 
         std::shared_ptr< TimerTask > ExpiryTimerImpl::addTask(
-                Milliseconds delay, Callback cb, Id id)
+                Clock::time_point expiry, Callback cb)
         {
-            std::lock_guard< std::mutex > lock{ m_mutex };
+            auto newTask = std::make_shared< TimerTask >(generateId(), std::move(cb));
+            auto it = m_tasks.insert({ expiry, newTask });
+            m_taskIndex.insert({ newTask->getId(), it });
 
-            auto newTask = std::make_shared< TimerTask >(id, std::move(cb));
-            m_tasks.insert({ delay, newTask });
-            m_cond.notify_all();
+            // The timer thread only needs to wake up if the next deadline moved.
+            if (it == m_tasks.begin()) m_cond.notify_all();
 
             return newTask;
         }
 
         bool ExpiryTimerImpl::containsId(Id id) const
         {
-            for (const auto& info : m_tasks)
-            {
-                if (info.second->getId() == id) return true;
-            }
-            return false;
+            return m_taskIndex.find(id) != m_taskIndex.end();
         }
 
         ExpiryTimerImpl::Id ExpiryTimerImpl::generateId()
         {
             Id newId = m_dist(m_mt);
 
-            std::lock_guard< std::mutex > lock{ m_mutex };
-
             while (newId == INVALID_ID || containsId(newId))
             {
                 newId = m_dist(m_mt);
@@ -154,27 +155,27 @@ namespace OIC
             return newId;
         }
 
-        void ExpiryTimerImpl::executeExpired()
+        void ExpiryTimerImpl::eraseTask(TaskMap::iterator it)
         {
-            if (m_tasks.empty()) return;
+            m_taskIndex.erase(it->second->getId());
+            m_tasks.erase(it);
+        }
 
-            auto now = std::chrono::system_clock::now().time_since_epoch();
+        std::vector< std::function< void() > > ExpiryTimerImpl::takeExpired()
+        {
+            std::vector< std::function< void() > > expired;
+            const auto now = Clock::now();
 
             auto it = m_tasks.begin();
             for (; it != m_tasks.end() && it->first <= now; ++it)
             {
-                it->second->execute();
+                m_taskIndex.erase(it->second->getId());
+                expired.push_back(it->second->expire());
             }
 
             m_tasks.erase(m_tasks.begin(), it);
-        }
-
-        ExpiryTimerImpl::Milliseconds ExpiryTimerImpl::remainingTimeForNext() const
-        {
-            const Milliseconds& expiredTime = m_tasks.begin()->first;
 
-            return std::chrono::duration_cast< Milliseconds >(expiredTime -
-                    std::chrono::system_clock::now().time_since_epoch()) + Milliseconds{ 1 };
+            return expired;
         }
 
         void ExpiryTimerImpl::run()
@@ -189,9 +190,24 @@ namespace OIC
 
                 if (m_stop) break;
 
-                m_cond.wait_for(lock, remainingTimeForNext());
+                // Copied, the task may be canceled while waiting.
+                const auto nextExpiry = m_tasks.begin()->first;
+                m_cond.wait_until(lock, nextExpiry);
 
-                executeExpired();
+                auto expired = takeExpired();
+                if (expired.empty()) continue;
+
+                // Callbacks are handed over without the lock, so a slow executor
+                // does not hold up posting and canceling.
+                auto executor = m_executor;
+                lock.unlock();
+
+                for (auto& task : expired)
+                {
+                    executor(std::move(task));
+                }
+
+                lock.lock();
             }
         }
 
@@ -202,16 +218,15 @@ namespace OIC
         {
         }
 
-        void TimerTask::execute()
+        std::function< void() > TimerTask::expire()
         {
-            if (isExecuted()) return;
-
             ExpiryTimerImpl::Id id { m_id };
             m_id = INVALID_ID;
 
-            std::thread(std::move(m_callback), id).detach();
-
+            auto callback = std::move(m_callback);
             m_callback = ExpiryTimerImpl::Callback{ };
+
+            return std::bind(std::move(callback), id);
         }
 
         bool TimerTask::isExecuted() const
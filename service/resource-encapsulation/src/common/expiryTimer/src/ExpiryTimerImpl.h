@@ -28,8 +28,10 @@
 #include <chrono>
 #include <condition_variable>
 #include <random>
+#include <unordered_map>
 #include <unordered_set>
 #include <atomic>
+#include <vector>
 
 namespace OIC
 {
@@ -42,11 +44,14 @@ namespace OIC
         public:
             typedef unsigned int Id;
             typedef std::function< void(Id) > Callback;
+            typedef std::function< void(std::function< void() >) > Executor;
 
             typedef long long DelayInMillis;
 
         private:
             typedef std::chrono::milliseconds Milliseconds;
+            typedef std::chrono::steady_clock Clock;
+            typedef std::multimap< Clock::time_point, std::shared_ptr< TimerTask > > TaskMap;
 
         private:
             ExpiryTimerImpl();
@@ -63,37 +68,52 @@ namespace OIC
             bool cancel(Id);
             size_t cancelAll(const std::unordered_set< std::shared_ptr<TimerTask > >&);
 
-        private:
-            static Milliseconds convertToTime(Milliseconds);
+            /**
+             * @see ExpiryTimer::setExecutor
+             */
+            void setExecutor(Executor);
 
-            std::shared_ptr< TimerTask > addTask(Milliseconds, Callback, Id);
+        private:
+            /**
+             * @pre The lock must be acquired with m_mutex.
+             */
+            std::shared_ptr< TimerTask > addTask(Clock::time_point, Callback);
 
             /**
              * @pre The lock must be acquired with m_mutex.
              */
             bool containsId(Id) const;
+
+            /**
+             * @pre The lock must be acquired with m_mutex.
+             */
             Id generateId();
 
             /**
              * @pre The lock must be acquired with m_mutex.
              */
-            void executeExpired();
+            void eraseTask(TaskMap::iterator);
 
             /**
+             * Removes the expired tasks and marks them executed.
+             *
              * @pre The lock must be acquired with m_mutex.
              */
-            Milliseconds remainingTimeForNext() const;
+            std::vector< std::function< void() > > takeExpired();
 
             void run();
 
         private:
-            std::multimap< Milliseconds, std::shared_ptr< TimerTask > > m_tasks;
+            TaskMap m_tasks;
+            std::unordered_map< Id, TaskMap::iterator > m_taskIndex;
 
             std::thread m_thread;
             std::mutex m_mutex;
             std::condition_variable m_cond;
             bool m_stop;
 
+            Executor m_executor;
+
             std::mt19937 m_mt;
             std::uniform_int_distribution< Id > m_dist;
 
@@ -114,7 +134,7 @@ namespace OIC
             ExpiryTimerImpl::Id getId() const;
 
         private:
-            void execute();
+            std::function< void() > expire();
 
         private:
             std::atomic< ExpiryTimerImpl::Id > m_id;
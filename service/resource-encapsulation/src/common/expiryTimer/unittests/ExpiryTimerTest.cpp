@@ -22,6 +22,9 @@
 
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 #include "RCSException.h"
 #include "ExpiryTimer.h"
@@ -350,3 +353,54 @@ TEST_F(ExpiryTimerTest, AllTasksAreCancelledAfterTimerDestroyed)
 
     Wait(200);
 }
+
+TEST_F(ExpiryTimerTest, ExpiredCallbacksRunOnExecutor)
+{
+    std::atomic_int executed{ 0 };
+
+    ExpiryTimer::setExecutor([&executed](std::function< void() > task)
+            {
+                ++executed;
+                std::thread(std::move(task)).join();
+            });
+
+    FunctionObject* functor = mocks.Mock< FunctionObject >();
+
+    mocks.ExpectCall(functor, FunctionObject::execute).Do(
+            [this](ExpiryTimer::Id)
+            {
+                Proceed();
+            }
+    );
+
+    timer.post(1, std::bind(&FunctionObject::execute, functor, std::placeholders::_1));
+
+    Wait();
+    ExpiryTimer::setExecutor({ });
+
+    ASSERT_EQ(1, executed);
+}
+
+TEST_F(ExpiryTimerTest, PostAndCancelManyTasks)
+{
+    constexpr size_t numOfTask{ 100000 };
+    std::vector< ExpiryTimer::Id > ids;
+    ids.reserve(numOfTask);
+
+    auto begin = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < numOfTask; ++i)
+    {
+        ids.push_back(timer.post(10000 + i % 1000, [](ExpiryTimer::Id){ }));
+    }
+
+    for (auto id : ids)
+    {
+        ASSERT_TRUE(timer.cancel(id));
+    }
+
+    // A scan per cancel would take far longer than this for so many tasks.
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds{ 10 });
+
+    ASSERT_EQ(0U, timer.getNumOfPending());
+}
@@ -70,6 +70,8 @@ namespace OIC
                     const std::string& resourceInterface,
                     const OC::QueryParamsMap& queryParametersMap, GetCallback) = 0;
 
+            virtual void requestGetWith(const HeaderOptions&, GetCallback) = 0;
+
             virtual void requestSet(const RCSResourceAttributes&, SetCallback) = 0;
 
             virtual void requestSetWith(const std::string& resourceType,
@@ -109,6 +109,22 @@ namespace OIC
                                 std::move(callback), _1, _2, _3));
             }
 
+            void requestGetWith(const HeaderOptions& headerOptions, GetCallback callback)
+            {
+                // The base resource only takes header options for all of its requests.
+                m_baseResource->setHeaderOptions(headerOptions);
+                try
+                {
+                    requestGetWith("", "", {}, std::move(callback));
+                }
+                catch (...)
+                {
+                    m_baseResource->unsetHeaderOptions();
+                    throw;
+                }
+                m_baseResource->unsetHeaderOptions();
+            }
+
             void requestSet(const RCSResourceAttributes& attrs, SetCallback callback)
             {
                 requestSetWith("", "", {}, attrs, std::move(callback));
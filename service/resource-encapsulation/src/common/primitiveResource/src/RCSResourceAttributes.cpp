@@ -21,6 +21,7 @@
 #include "RCSResourceAttributes.h"
 
 #include <sstream>
+#include <unordered_set>
 
 #include "ResourceAttributesUtils.h"
 #include "ResourceAttributesConverter.h"
@@ -550,8 +551,160 @@ namespace OIC
         }
 
 
+        class RCSResourceAttributes::ChangeTracker
+        {
+        private:
+            struct Record
+            {
+                std::string key;
+                bool existed;
+                Value value;
+            };
+
+        public:
+            void start()
+            {
+                m_scopes.push_back(m_records.size());
+            }
+
+            bool isTracking() const
+            {
+                return !m_scopes.empty();
+            }
+
+            void record(const std::string& key,
+                    const std::unordered_map< std::string, Value >& values)
+            {
+                auto last = m_lastRecords.find(key);
+                if (last != m_lastRecords.end() && last->second >= m_scopes.back()) return;
+
+                auto found = values.find(key);
+
+                if (found == values.end())
+                {
+                    m_records.push_back(Record{ key, false, Value{ } });
+                }
+                else
+                {
+                    m_records.push_back(Record{ key, true, found->second });
+                }
+                m_lastRecords[key] = m_records.size() - 1;
+            }
+
+            std::vector< std::string > stop(
+                    const std::unordered_map< std::string, Value >& values)
+            {
+                std::vector< std::string > changedKeys;
+                std::unordered_set< std::string > checkedKeys;
+
+                const size_t begin = m_scopes.back();
+                m_scopes.pop_back();
+
+                // A key can be recorded again by a nested tracking.
+                // The first record since the start holds the value to compare with.
+                for (size_t i = begin; i < m_records.size(); ++i)
+                {
+                    const Record& record = m_records[i];
+
+                    if (!checkedKeys.insert(record.key).second) continue;
+
+                    auto found = values.find(record.key);
+                    const bool exists = found != values.end();
+
+                    if (exists != record.existed || (exists && found->second != record.value))
+                    {
+                        changedKeys.push_back(record.key);
+                    }
+                }
+
+                if (m_scopes.empty())
+                {
+                    m_records.clear();
+                    m_lastRecords.clear();
+                }
+
+                return changedKeys;
+            }
+
+        private:
+            std::vector< size_t > m_scopes;
+            std::vector< Record > m_records;
+            std::unordered_map< std::string, size_t > m_lastRecords;
+        };
+
+        RCSResourceAttributes::RCSResourceAttributes() = default;
+
+        RCSResourceAttributes::RCSResourceAttributes(const RCSResourceAttributes& from) :
+                m_values{ from.m_values }
+        {
+        }
+
+        RCSResourceAttributes::RCSResourceAttributes(RCSResourceAttributes&& from)
+        {
+            from.trackAllChanges();
+            m_values = std::move(from.m_values);
+        }
+
+        RCSResourceAttributes::~RCSResourceAttributes() = default;
+
+        RCSResourceAttributes& RCSResourceAttributes::operator=(const RCSResourceAttributes& rhs)
+        {
+            if (m_changeTracker)
+            {
+                trackAllChanges();
+                for (const auto& i : rhs.m_values) trackChange(i.first);
+            }
+
+            m_values = rhs.m_values;
+            return *this;
+        }
+
+        RCSResourceAttributes& RCSResourceAttributes::operator=(RCSResourceAttributes&& rhs)
+        {
+            if (m_changeTracker)
+            {
+                trackAllChanges();
+                for (const auto& i : rhs.m_values) trackChange(i.first);
+            }
+            rhs.trackAllChanges();
+
+            m_values = std::move(rhs.m_values);
+            return *this;
+        }
+
+        void RCSResourceAttributes::startTrackingChanges() const
+        {
+            if (!m_changeTracker) m_changeTracker.reset(new ChangeTracker);
+
+            m_changeTracker->start();
+        }
+
+        std::vector< std::string > RCSResourceAttributes::stopTrackingChanges() const
+        {
+            if (!m_changeTracker) return { };
+
+            auto changedKeys = m_changeTracker->stop(m_values);
+
+            if (!m_changeTracker->isTracking()) m_changeTracker.reset();
+
+            return changedKeys;
+        }
+
+        void RCSResourceAttributes::trackChange(const std::string& key)
+        {
+            if (m_changeTracker) m_changeTracker->record(key, m_values);
+        }
+
+        void RCSResourceAttributes::trackAllChanges()
+        {
+            if (!m_changeTracker) return;
+
+            for (const auto& i : m_values) m_changeTracker->record(i.first, m_values);
+        }
+
         auto RCSResourceAttributes::begin() noexcept -> iterator
         {
+            trackAllChanges();
             return iterator{ m_values.begin() };
         }
 
@@ -582,11 +735,13 @@ namespace OIC
 
         auto RCSResourceAttributes::operator[](const std::string& key) -> Value&
         {
+            trackChange(key);
             return m_values[key];
         }
 
         auto RCSResourceAttributes::operator[](std::string&& key) -> Value&
         {
+            trackChange(key);
             return m_values[std::move(key)];
         }
 
@@ -594,7 +749,9 @@ namespace OIC
         {
             try
             {
-                return m_values.at(key);
+                auto& value = m_values.at(key);
+                trackChange(key);
+                return value;
             }
             catch (const std::out_of_range&)
             {
@@ -616,16 +773,19 @@ namespace OIC
 
         void RCSResourceAttributes::clear() noexcept
         {
+            trackAllChanges();
             return m_values.clear();
         }
 
         bool RCSResourceAttributes::erase(const std::string& key)
         {
+            trackChange(key);
             return m_values.erase(key) == 1U;
         }
 
         auto RCSResourceAttributes::erase(const_iterator pos) -> iterator
         {
+            trackChange(pos.m_cur->first);
             return iterator{ m_values.erase(pos.m_cur) };
         }
 
@@ -49,6 +49,9 @@ public:
 
     virtual OCStackResult cancelObserve() = 0;
 
+    virtual void setHeaderOptions(const OC::HeaderOptions&) = 0;
+    virtual void unsetHeaderOptions() = 0;
+
     virtual std::string sid() const = 0;
     virtual std::string uri() const = 0;
     virtual std::string host() const = 0;
@@ -90,6 +93,32 @@ TEST_F(PrimitiveResourceTest, RequestGetThrowsOCResourceGetReturnsNotOK)
     ASSERT_THROW(resource->requestGet(PrimitiveResource::GetCallback()), RCSPlatformException);
 }
 
+TEST_F(PrimitiveResourceTest, RequestGetWithHeaderOptionsSetsThemOnlyForTheGet)
+{
+    HeaderOptions headerOptions{ HeaderOption{ OC::HeaderOption::ETAG_OPTION_ID, "tag" } };
+
+    mocks.ExpectCall(fakeResource, FakeOCResource::setHeaderOptions).Match(
+            [](const OC::HeaderOptions& options)
+            {
+                return options.size() == 1 && options[0].getOptionData() == "tag";
+            }
+        );
+    mocks.ExpectCall(fakeResource, FakeOCResource::get).Return(OC_STACK_OK);
+    mocks.ExpectCall(fakeResource, FakeOCResource::unsetHeaderOptions);
+
+    resource->requestGetWith(headerOptions, PrimitiveResource::GetCallback());
+}
+
+TEST_F(PrimitiveResourceTest, RequestGetWithHeaderOptionsUnsetsThemWhenGetFails)
+{
+    mocks.OnCall(fakeResource, FakeOCResource::setHeaderOptions);
+    mocks.OnCall(fakeResource, FakeOCResource::get).Return(OC_STACK_ERROR);
+    mocks.ExpectCall(fakeResource, FakeOCResource::unsetHeaderOptions);
+
+    ASSERT_THROW(resource->requestGetWith(HeaderOptions{ }, PrimitiveResource::GetCallback()),
+            RCSPlatformException);
+}
+
 TEST_F(PrimitiveResourceTest, RequestSetInvokesOCResourcePost)
 {
     mocks.ExpectCall(fakeResource, FakeOCResource::post).Return(OC_STACK_OK);
@@ -24,6 +24,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 using namespace testing;
 using namespace OIC::Service;
 
@@ -120,6 +122,48 @@ TEST_F(ResourceAttributesTest, ChangeValueWithAtGetter)
     ASSERT_EQ(resourceAttributes[KEY], "after");
 }
 
+TEST_F(ResourceAttributesTest, TrackingReturnsOnlyChangedKeys)
+{
+    constexpr char otherKey[]{ "other" };
+    constexpr char newKey[]{ "new" };
+    resourceAttributes[KEY] = 1;
+    resourceAttributes[otherKey] = 2;
+
+    resourceAttributes.startTrackingChanges();
+    resourceAttributes[KEY] = 1;
+    resourceAttributes[otherKey] = 3;
+    resourceAttributes[newKey] = 4;
+
+    auto changedKeys = resourceAttributes.stopTrackingChanges();
+    std::sort(changedKeys.begin(), changedKeys.end());
+
+    ASSERT_EQ((std::vector< std::string >{ newKey, otherKey }), changedKeys);
+}
+
+TEST_F(ResourceAttributesTest, TrackingReturnsErasedKey)
+{
+    resourceAttributes[KEY] = 1;
+
+    resourceAttributes.startTrackingChanges();
+    resourceAttributes.erase(KEY);
+
+    ASSERT_EQ(std::vector< std::string >{ KEY }, resourceAttributes.stopTrackingChanges());
+}
+
+TEST_F(ResourceAttributesTest, NestedTrackingComparesWithValueAtItsStart)
+{
+    resourceAttributes[KEY] = 1;
+
+    resourceAttributes.startTrackingChanges();
+    resourceAttributes[KEY] = 2;
+
+    resourceAttributes.startTrackingChanges();
+    resourceAttributes[KEY] = 2;
+    ASSERT_TRUE(resourceAttributes.stopTrackingChanges().empty());
+
+    ASSERT_EQ(std::vector< std::string >{ KEY }, resourceAttributes.stopTrackingChanges());
+}
+
 TEST_F(ResourceAttributesTest, CanHaveNestedResourceAttributes)
 {
     constexpr char nestedKey[]{ "nested" };
@@ -22,8 +22,10 @@
 #define RB_DEVICEPRESENCE_H_
 
 #include <list>
+#include <memory>
 #include <string>
 #include <atomic>
+#include <mutex>
 
 #include "BrokerTypes.h"
 #include "ResourcePresence.h"
@@ -50,15 +52,20 @@ namespace OIC
 
             void initializeDevicePresence(PrimitiveResourcePtr pResource);
 
-            void addPresenceResource(ResourcePresence * rPresence);
+            void addPresenceResource(ResourcePresencePtr rPresence);
             void removePresenceResource(ResourcePresence * rPresence);
 
             bool isEmptyResourcePresence() const;
             const std::string getAddress() const;
             DEVICE_STATE getDeviceState() const noexcept;
 
+            void notifyProbeResult(ResourcePresence * probe, BROKER_STATE probedState);
+
         private:
-            std::list<ResourcePresence * > resourcePresenceList;
+            // The pointer identifies an entry even after its resource has expired.
+            typedef std::pair<ResourcePresence *, std::weak_ptr<ResourcePresence> > PresenceEntry;
+            std::list<PresenceEntry> resourcePresenceList;
+            mutable std::recursive_mutex listMutex;
 
             std::string address;
             std::atomic_int state;
@@ -73,6 +80,7 @@ namespace OIC
             SubscribeCB pSubscribeRequestCB;
             PresenceSubscriber presenceSubscriber;
 
+            std::list<ResourcePresencePtr> getPresenceResources() const;
             void changeAllPresenceMode(BROKER_MODE mode);
             void subscribeCB(OCStackResult ret,const unsigned int seq, const std::string& Hostaddress);
             void timeOutCB(TimerID id);
@@ -55,6 +55,14 @@ namespace OIC
             const PrimitiveResourcePtr getPrimitiveResource() const;
             BROKER_STATE getResourceState() const;
 
+            /**
+             * Only one resource per device, the probe resource, polls the device
+             * in NON_PRESENCE_MODE. Its result is handed to the other resources
+             * of the device with receiveProbeResult().
+             */
+            void setProbeResource(bool isProbe);
+            void receiveProbeResult(BROKER_STATE probedState);
+
         private:
             std::unique_ptr<std::list<BrokerRequesterInfoPtr>> requesterList;
             PrimitiveResourcePtr primitiveResource;
@@ -68,6 +76,9 @@ namespace OIC
             std::mutex cbMutex;
             unsigned int timeoutHandle;
 
+            std::atomic_bool isProbeResource;
+            std::weak_ptr<DevicePresence> devicePresence;
+
             RequestGetCB pGetCB;
             TimerCB pTimeoutCB;
             TimerCB pPollingCB;
@@ -81,6 +92,8 @@ namespace OIC
 
             void pollingCB(unsigned int msg = 0);
 
+            void notifyProbeResult(BROKER_STATE probedState);
+
             void executeAllBrokerCB(BROKER_STATE changedState);
             void setResourcestate(BROKER_STATE _state);
         };
@@ -92,26 +92,80 @@ namespace OIC
             return address;
         }
 
-        void DevicePresence::addPresenceResource(ResourcePresence * rPresence)
+        void DevicePresence::addPresenceResource(ResourcePresencePtr rPresence)
         {
             OIC_LOG_V(DEBUG, BROKER_TAG, "addPresenceResource()");
-            resourcePresenceList.push_back(rPresence);
+            std::lock_guard<std::recursive_mutex> lock(listMutex);
+            resourcePresenceList.push_back(PresenceEntry(rPresence.get(), rPresence));
+
+            if(resourcePresenceList.size() == 1)
+            {
+                rPresence->setProbeResource(true);
+            }
         }
 
         void DevicePresence::removePresenceResource(ResourcePresence * rPresence)
         {
             OIC_LOG_V(DEBUG, BROKER_TAG, "removePresenceResource()");
-            resourcePresenceList.remove(rPresence);
+            ResourcePresencePtr nextProbe;
+            {
+                std::lock_guard<std::recursive_mutex> lock(listMutex);
+                bool wasProbe = !resourcePresenceList.empty()
+                        && resourcePresenceList.front().first == rPresence;
+
+                resourcePresenceList.remove_if([rPresence](const PresenceEntry & entry)
+                        {
+                            return entry.first == rPresence;
+                        });
+
+                if(wasProbe && !resourcePresenceList.empty())
+                {
+                    nextProbe = resourcePresenceList.front().second.lock();
+                }
+            }
+
+            if(nextProbe != nullptr)
+            {
+                OIC_LOG_V(DEBUG, BROKER_TAG, "hand over probing to next resource");
+                nextProbe->setProbeResource(true);
+            }
+        }
+
+        std::list<ResourcePresencePtr> DevicePresence::getPresenceResources() const
+        {
+            std::lock_guard<std::recursive_mutex> lock(listMutex);
+            std::list<ResourcePresencePtr> list;
+            for(auto & entry : resourcePresenceList)
+            {
+                ResourcePresencePtr resource = entry.second.lock();
+                if(resource != nullptr)
+                {
+                    list.push_back(resource);
+                }
+            }
+            return list;
         }
 
         void DevicePresence::changeAllPresenceMode(BROKER_MODE mode)
         {
             OIC_LOG_V(DEBUG, BROKER_TAG, "changeAllPresenceMode()");
-            if(!resourcePresenceList.empty())
+            for(auto & it : getPresenceResources())
+            {
+                it->changePresenceMode(mode);
+            }
+        }
+
+        void DevicePresence::notifyProbeResult(ResourcePresence * probe, BROKER_STATE probedState)
+        {
+            OIC_LOG_V(DEBUG, BROKER_TAG, "notifyProbeResult()");
+
+            // Called without the list lock. A broker callback may release a resource,
+            // which then removes itself from the list.
+            for(auto & it : getPresenceResources())
             {
-                for(auto it : resourcePresenceList)
+                if(it.get() != probe)
                 {
-                    it->changePresenceMode(mode);
+                    it->receiveProbeResult(probedState);
                 }
             }
         }
@@ -119,6 +173,7 @@ namespace OIC
         bool DevicePresence::isEmptyResourcePresence() const
         {
             OIC_LOG_V(DEBUG, BROKER_TAG, "isEmptyResourcePresence()");
+            std::lock_guard<std::recursive_mutex> lock(listMutex);
             return resourcePresenceList.empty();
         }
 
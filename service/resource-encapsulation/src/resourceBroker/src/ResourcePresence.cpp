@@ -69,7 +69,7 @@ namespace OIC
         ResourcePresence::ResourcePresence()
         : requesterList(nullptr), primitiveResource(nullptr),
           state(BROKER_STATE::REQUESTED), mode(BROKER_MODE::NON_PRESENCE_MODE),
-          isWithinTime(true), receivedTime(0L), timeoutHandle(0)
+          isWithinTime(true), receivedTime(0L), timeoutHandle(0), isProbeResource(false)
         {
         }
 
@@ -87,11 +87,13 @@ namespace OIC
             = std::unique_ptr<std::list<BrokerRequesterInfoPtr>>
             (new std::list<BrokerRequesterInfoPtr>);
 
+            // Registered first, so that the response to the initial request
+            // already knows whether this resource probes the device.
+            registerDevicePresence();
+
             timeoutHandle = expiryTimer.post(BROKER_SAFE_MILLISECOND, pTimeoutCB);
             OIC_LOG_V(DEBUG,BROKER_TAG,"initializeResourcePresence::requestGet.\n");
             primitiveResource->requestGet(pGetCB);
-
-            registerDevicePresence();
         }
 
 
@@ -186,7 +188,8 @@ namespace OIC
                 }
                 DeviceAssociation::getInstance()->addDevice(foundDevice);
             }
-            foundDevice->addPresenceResource(this);
+            devicePresence = foundDevice;
+            foundDevice->addPresenceResource(shared_from_this());
         }
 
         void ResourcePresence::executeAllBrokerCB(BROKER_STATE changedState)
@@ -233,12 +236,15 @@ namespace OIC
 
             executeAllBrokerCB(BROKER_STATE::LOST_SIGNAL);
             pollingCB();
+
+            lock.unlock();
+            notifyProbeResult(BROKER_STATE::LOST_SIGNAL);
         }
 
         void ResourcePresence::pollingCB(unsigned int /*msg*/)
         {
             OIC_LOG_V(DEBUG, BROKER_TAG, "pollingCB().\n");
-            if(this->requesterList->size() != 0)
+            if(isProbeResource && this->requesterList->size() != 0)
             {
                 this->requestResourceState();
                 timeoutHandle = expiryTimer.post(BROKER_SAFE_MILLISECOND,pTimeoutCB);
@@ -264,11 +270,16 @@ namespace OIC
                 isWithinTime = true;
             }
 
-            if(mode == BROKER_MODE::NON_PRESENCE_MODE)
+            if(mode == BROKER_MODE::NON_PRESENCE_MODE && isProbeResource)
             {
                 expiryTimer.post(BROKER_SAFE_MILLISECOND,pPollingCB);
             }
 
+            lock.unlock();
+            // Any answer, even for a deleted resource, means the device is reachable.
+            notifyProbeResult((eCode == OC_STACK_OK || eCode == OC_STACK_CONTINUE ||
+                    eCode == OC_STACK_RESOURCE_DELETED) ?
+                    BROKER_STATE::ALIVE : BROKER_STATE::LOST_SIGNAL);
         }
 
         void ResourcePresence::verifiedGetResponse(int eCode)
@@ -318,7 +329,7 @@ namespace OIC
             if(newMode != mode)
             {
                 expiryTimer.cancel(timeoutHandle);
-                if(newMode == BROKER_MODE::NON_PRESENCE_MODE)
+                if(newMode == BROKER_MODE::NON_PRESENCE_MODE && isProbeResource)
                 {
                     timeoutHandle = expiryTimer.post(BROKER_SAFE_MILLISECOND,pTimeoutCB);
                     requestResourceState();
@@ -326,5 +337,50 @@ namespace OIC
                 mode = newMode;
             }
         }
+
+        void ResourcePresence::setProbeResource(bool isProbe)
+        {
+            OIC_LOG_V(DEBUG, BROKER_TAG, "setProbeResource()\n");
+            bool wasProbe = isProbeResource.exchange(isProbe);
+
+            // Take over polling from the previous probe resource of the device.
+            if(isProbe && !wasProbe && mode == BROKER_MODE::NON_PRESENCE_MODE
+                    && !isEmptyRequester())
+            {
+                timeoutHandle = expiryTimer.post(BROKER_SAFE_MILLISECOND, pTimeoutCB);
+                requestResourceState();
+            }
+        }
+
+        void ResourcePresence::receiveProbeResult(BROKER_STATE probedState)
+        {
+            OIC_LOG_V(DEBUG, BROKER_TAG, "receiveProbeResult()\n");
+            std::unique_lock<std::mutex> lock(cbMutex);
+
+            if(mode != BROKER_MODE::NON_PRESENCE_MODE)
+            {
+                return;
+            }
+
+            time_t currentTime;
+            time(&currentTime);
+            receivedTime = currentTime;
+
+            executeAllBrokerCB(probedState);
+        }
+
+        void ResourcePresence::notifyProbeResult(BROKER_STATE probedState)
+        {
+            if(!isProbeResource)
+            {
+                return;
+            }
+
+            DevicePresencePtr device = devicePresence.lock();
+            if(device != nullptr)
+            {
+                device->notifyProbeResult(this, probedState);
+            }
+        }
     } // namespace Service
 } // namespace OIC
@@ -125,7 +125,10 @@ TEST_F(DevicePresenceTest,initializeDevicePresence_ErrorHandlingIfAbnormalResour
 TEST_F(DevicePresenceTest,addPresenceResource_NormalHandlingIfNormalResource)
 {
 
-    ResourcePresence * resource = (ResourcePresence *)new ResourcePresence();
+    ResourcePresencePtr resource(new ResourcePresence(), [](ResourcePresence *)
+                                 {
+
+                                 });
     instance->addPresenceResource(resource);
 
     ASSERT_FALSE(instance->isEmptyResourcePresence());
@@ -261,5 +261,38 @@ TEST_F(ResourcePresenceTest,getCB_NormalHandlingIfMessageOC_STACK_OK)
 
 }
 
+TEST_F(ResourcePresenceTest,probeResultIsSharedWithResourcesOfSameDevice)
+{
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestGet).Do(
+                [](GetCallback callback)
+                {
+                    OIC::Service::HeaderOptions op;
+                    RCSResourceAttributes attr;
+                    OIC::Service::ResponseStatement res(attr);
 
+                    callback(op,res,OC_STACK_OK);
+                });
+    mocks.OnCall(pResource.get(), PrimitiveResource::getHost).Return("address2");
+    mocks.OnCallFuncOverload(static_cast< subscribePresenceSig1 >(OC::OCPlatform::subscribePresence)).Return(OC_STACK_OK);
 
+    PrimitiveResource::Ptr otherResource = PrimitiveResource::Ptr(mocks.Mock< PrimitiveResource >(),
+                                           [](PrimitiveResource*)
+                                           {
+
+                                           });
+    mocks.OnCall(otherResource.get(), PrimitiveResource::getHost).Return("address2");
+    // Only the initial request, the device is polled through the first resource.
+    mocks.ExpectCall(otherResource.get(), PrimitiveResource::requestGet);
+
+    instance->initializeResourcePresence(pResource);
+    instance->addBrokerRequester(1,cb);
+
+    std::shared_ptr<ResourcePresence> other(new ResourcePresence());
+    other->initializeResourcePresence(otherResource);
+    other->addBrokerRequester(2,cb);
+
+    sleep(BROKER_SAFE_SECOND + 2);
+
+    ASSERT_EQ(BROKER_STATE::ALIVE,other->getResourceState());
+    other.reset();
+}
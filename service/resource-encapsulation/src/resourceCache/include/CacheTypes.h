@@ -41,6 +41,9 @@ namespace OIC
 #define CACHE_TAG  "CACHE"
 #define CACHE_DEFAULT_REPORT_MILLITIME 10000
 #define CACHE_DEFAULT_EXPIRED_MILLITIME 15000
+// time a polled resource may stay silent past its next poll before the signal is lost
+#define CACHE_EXPIRED_MARGIN_MILLITIME \
+    (CACHE_DEFAULT_EXPIRED_MILLITIME - CACHE_DEFAULT_REPORT_MILLITIME)
 
         enum class REPORT_FREQUENCY
         {
@@ -81,6 +84,21 @@ namespace OIC
 
         typedef int CacheID;
 
+        struct CacheStatistics
+        {
+            // reads of the cached data while it was ready, and while it was not
+            unsigned long long hits;
+            unsigned long long misses;
+            // GET requests sent
+            unsigned long long requests;
+            // GET responses and observe notifications received
+            unsigned long long responses;
+            // responses which only confirmed the cached data, by ETag or by content
+            unsigned long long revalidations;
+            // reports sent to subscribers
+            unsigned long long reports;
+        };
+
         typedef std::function<OCStackResult(std::shared_ptr<PrimitiveResource>,
                                             const RCSResourceAttributes &)> CacheCB;
         typedef std::map<int, std::pair<Report_Info, CacheCB>> SubscriberInfo;
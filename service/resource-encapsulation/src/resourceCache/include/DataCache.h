@@ -60,6 +60,7 @@ namespace OIC
                 void requestGet();
                 bool isEmptySubscriber() const;
                 bool isCachedData() const;
+                CacheStatistics getStatistics() const;
 
             private:
                 // resource instance
@@ -67,6 +68,7 @@ namespace OIC
 
                 // cached data info
                 RCSResourceAttributes attributes;
+                std::string eTag;
                 CACHE_STATE state;
                 CACHE_MODE mode;
                 bool isReady;
@@ -88,6 +90,9 @@ namespace OIC
 
                 unsigned int lastSequenceNum;
 
+                mutable std::mutex stat_mutex;
+                mutable CacheStatistics statistics;
+
             public:
                 void onObserve(const HeaderOptions &_hos,
                                const ResponseStatement &_rep, int _result, unsigned int _seq);
@@ -98,7 +103,11 @@ namespace OIC
 
                 CacheID generateCacheID();
                 SubscriberInfoPair findSubscriber(CacheID id);
-                void notifyObservers(const RCSResourceAttributes Att);
+                void notifyObservers(const RCSResourceAttributes &Att, const std::string &tag);
+                bool isCachedTag(const std::string &tag) const;
+                void schedulePolling(const HeaderOptions &_hos);
+                void sendGetRequest();
+                void countStatistic(unsigned long long CacheStatistics::*counter) const;
         };
     } // namespace Service
 } // namespace OIC
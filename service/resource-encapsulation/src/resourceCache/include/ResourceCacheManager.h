@@ -68,6 +68,9 @@ namespace OIC
                 // throw InvalidParameterException;
                 bool isCachedData(CacheID id) const;
 
+                // throw InvalidParameterException;
+                CacheStatistics getCacheStatistics(CacheID id) const;
+
             private:
                 static ResourceCacheManager *s_instance;
                 static std::mutex s_mutex;
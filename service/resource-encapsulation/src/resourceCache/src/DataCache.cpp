@@ -75,6 +75,35 @@ namespace OIC
                                  std::placeholders::_1, std::placeholders::_2,
                                  std::placeholders::_3, rpPtr);
             }
+
+            std::string findHeaderOption(const HeaderOptions &_hos, uint16_t optionID)
+            {
+                for (const auto &option : _hos)
+                {
+                    if (option.getOptionID() == optionID)
+                    {
+                        return option.getOptionData();
+                    }
+                }
+                return std::string();
+            }
+
+            long long getPollingMilliTime(const HeaderOptions &_hos)
+            {
+                // Max-Age is an unsigned integer of up to four bytes in network byte order.
+                std::string maxAge = findHeaderOption(_hos, OC::HeaderOption::MAX_AGE_OPTION_ID);
+                if (maxAge.empty() || maxAge.size() > sizeof(uint32_t))
+                {
+                    return CACHE_DEFAULT_REPORT_MILLITIME;
+                }
+
+                long long seconds = 0;
+                for (unsigned char byte : maxAge)
+                {
+                    seconds = (seconds << 8) | byte;
+                }
+                return seconds > 0 ? seconds * 1000 : CACHE_DEFAULT_REPORT_MILLITIME;
+            }
         }
 
         DataCache::DataCache()
@@ -90,6 +119,8 @@ namespace OIC
             pollingHandle = 0;
             lastSequenceNum = 0;
             isReady = false;
+
+            statistics = CacheStatistics();
         }
 
         DataCache::~DataCache()
@@ -123,7 +154,7 @@ namespace OIC
             pTimerCB = (TimerCB)(std::bind(&DataCache::onTimeOut, this, std::placeholders::_1));
             pPollingCB = (TimerCB)(std::bind(&DataCache::onPollingOut, this, std::placeholders::_1));
 
-            sResource->requestGet(pGetCB);
+            sendGetRequest();
             if (sResource->isObservable())
             {
                 sResource->requestObserve(pObserveCB);
@@ -194,8 +225,10 @@ namespace OIC
             std::lock_guard<std::mutex> lock(att_mutex);
             if (state != CACHE_STATE::READY)
             {
+                countStatistic(&CacheStatistics::misses);
                 return RCSResourceAttributes();
             }
+            countStatistic(&CacheStatistics::hits);
             return attributes;
         }
 
@@ -204,9 +237,10 @@ namespace OIC
             return isReady;
         }
 
-        void DataCache::onObserve(const HeaderOptions & /*_hos*/,
+        void DataCache::onObserve(const HeaderOptions &_hos,
                                   const ResponseStatement &_rep, int _result, unsigned int _seq)
         {
+            countStatistic(&CacheStatistics::responses);
 
             if (_result != OC_STACK_OK || _rep.getAttributes().empty() || lastSequenceNum > _seq)
             {
@@ -231,13 +265,25 @@ namespace OIC
             networkTimer.cancel(networkTimeOutHandle);
             networkTimeOutHandle = networkTimer.post(CACHE_DEFAULT_EXPIRED_MILLITIME, pTimerCB);
 
-            notifyObservers(_rep.getAttributes());
+            notifyObservers(_rep.getAttributes(),
+                            findHeaderOption(_hos, OC::HeaderOption::ETAG_OPTION_ID));
         }
 
-        void DataCache::onGet(const HeaderOptions & /*_hos*/,
+        void DataCache::onGet(const HeaderOptions &_hos,
                               const ResponseStatement &_rep, int _result)
         {
-            if (_result != OC_STACK_OK || _rep.getAttributes().empty())
+            countStatistic(&CacheStatistics::responses);
+
+            if (_result != OC_STACK_OK)
+            {
+                return;
+            }
+
+            // A response carrying the ETag that was sent is a 2.03 Valid without a payload:
+            // the cached data is still current and there is nothing to decode or report.
+            std::string tag = findHeaderOption(_hos, OC::HeaderOption::ETAG_OPTION_ID);
+            bool isValid = isCachedTag(tag);
+            if (!isValid && _rep.getAttributes().empty())
             {
                 return;
             }
@@ -250,22 +296,44 @@ namespace OIC
 
             if (mode != CACHE_MODE::OBSERVE)
             {
-                networkTimer.cancel(networkTimeOutHandle);
-                networkTimeOutHandle = networkTimer.post(
-                                           CACHE_DEFAULT_EXPIRED_MILLITIME, pTimerCB);
+                schedulePolling(_hos);
+            }
 
-                pollingHandle = pollingTimer.post(CACHE_DEFAULT_REPORT_MILLITIME, pPollingCB);
+            if (isValid)
+            {
+                countStatistic(&CacheStatistics::revalidations);
+                return;
             }
 
-            notifyObservers(_rep.getAttributes());
+            notifyObservers(_rep.getAttributes(), tag);
         }
 
-        void DataCache::notifyObservers(const RCSResourceAttributes Att)
+        bool DataCache::isCachedTag(const std::string &tag) const
+        {
+            std::lock_guard<std::mutex> lock(att_mutex);
+            return !tag.empty() && tag == eTag;
+        }
+
+        void DataCache::schedulePolling(const HeaderOptions &_hos)
+        {
+            // Poll again when the data is no longer fresh according to the Max-Age option.
+            long long pollingTime = getPollingMilliTime(_hos);
+
+            networkTimer.cancel(networkTimeOutHandle);
+            networkTimeOutHandle = networkTimer.post(
+                                       pollingTime + CACHE_EXPIRED_MARGIN_MILLITIME, pTimerCB);
+
+            pollingHandle = pollingTimer.post(pollingTime, pPollingCB);
+        }
+
+        void DataCache::notifyObservers(const RCSResourceAttributes &Att, const std::string &tag)
         {
             {
                 std::lock_guard<std::mutex> lock(att_mutex);
+                eTag = tag;
                 if (attributes == Att)
                 {
+                    countStatistic(&CacheStatistics::revalidations);
                     return;
                 }
                 attributes = Att;
@@ -276,6 +344,7 @@ namespace OIC
             {
                 if (i.second.first.rf == REPORT_FREQUENCY::UPTODATE)
                 {
+                    countStatistic(&CacheStatistics::reports);
                     i.second.second(this->sResource, Att);
                 }
             }
@@ -308,7 +377,7 @@ namespace OIC
             if (sResource != nullptr)
             {
                 mode = CACHE_MODE::FREQUENCY;
-                sResource->requestGet(pGetCB);
+                sendGetRequest();
             }
             return;
         }
@@ -332,9 +401,44 @@ namespace OIC
         {
             state = CACHE_STATE::UPDATING;
             if (sResource != nullptr)
+            {
+                sendGetRequest();
+            }
+        }
+
+        void DataCache::sendGetRequest()
+        {
+            HeaderOptions hos;
+            {
+                std::lock_guard<std::mutex> lock(att_mutex);
+                if (!eTag.empty())
+                {
+                    // Ask the server to answer 2.03 Valid if the cached data is still current.
+                    hos.emplace_back(OC::HeaderOption::ETAG_OPTION_ID, eTag);
+                }
+            }
+
+            countStatistic(&CacheStatistics::requests);
+            if (hos.empty())
             {
                 sResource->requestGet(pGetCB);
             }
+            else
+            {
+                sResource->requestGetWith(hos, pGetCB);
+            }
+        }
+
+        void DataCache::countStatistic(unsigned long long CacheStatistics::*counter) const
+        {
+            std::lock_guard<std::mutex> lock(stat_mutex);
+            ++(statistics.*counter);
+        }
+
+        CacheStatistics DataCache::getStatistics() const
+        {
+            std::lock_guard<std::mutex> lock(stat_mutex);
+            return statistics;
         }
 
         bool DataCache::isEmptySubscriber() const
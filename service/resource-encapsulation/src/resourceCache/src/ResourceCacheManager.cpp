@@ -234,6 +234,21 @@ namespace OIC
             return handler->isCachedData();
         }
 
+        CacheStatistics ResourceCacheManager::getCacheStatistics(CacheID id) const
+        {
+            if (id == 0)
+            {
+                throw RCSInvalidParameterException {"[getCacheStatistics] CacheID is NULL"};
+            }
+
+            DataCachePtr handler = findDataCache(id);
+            if (handler == nullptr)
+            {
+                throw RCSInvalidParameterException {"[getCacheStatistics] CacheID is invaild"};
+            }
+            return handler->getStatistics();
+        }
+
         void ResourceCacheManager::initializeResourceCacheManager()
         {
             std::lock_guard<std::mutex> lock(s_mutex);
@@ -18,7 +18,10 @@
 //
 //-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 #include <gtest/gtest.h>
 #include <HippoMocks/hippomocks.h>
 
@@ -269,3 +272,103 @@ TEST_F(DataCacheTest, requestGet_normalCasetest)
 
     cacheHandler->requestGet();
 }
+
+TEST_F(DataCacheTest, getStatistics_countsUnchangedResponseAsRevalidation)
+{
+
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestGet).Do(
+        [](GetCallback callback)
+    {
+        OIC::Service::HeaderOptions hos;
+        OIC::Service::RCSResourceAttributes attr;
+        attr["power"] = 1;
+        OIC::Service::ResponseStatement rep(attr);
+        callback(hos, rep, OC_STACK_OK);
+        return;
+    });
+
+    cacheHandler->initializeDataCache(pResource);
+    cacheHandler->requestGet();
+    cacheHandler->getCachedData();
+
+    CacheStatistics statistics = cacheHandler->getStatistics();
+    ASSERT_EQ(2u, statistics.requests);
+    ASSERT_EQ(2u, statistics.responses);
+    ASSERT_EQ(1u, statistics.revalidations);
+    ASSERT_EQ(1u, statistics.hits);
+}
+
+TEST_F(DataCacheTest, requestGet_sendsCachedETagAndSkipsReportOnValid)
+{
+    typedef void (PrimitiveResource::*GetWithHeaderOptions)(
+        const OIC::Service::HeaderOptions &, PrimitiveResource::GetCallback);
+
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestGet).Do(
+        [](GetCallback callback)
+    {
+        OIC::Service::HeaderOptions hos;
+        hos.emplace_back(OC::HeaderOption::ETAG_OPTION_ID, "v1");
+        OIC::Service::RCSResourceAttributes attr;
+        attr["power"] = 1;
+        OIC::Service::ResponseStatement rep(attr);
+        callback(hos, rep, OC_STACK_OK);
+        return;
+    });
+    std::string sentTag;
+    mocks.ExpectCallOverload(pResource.get(),
+                             static_cast<GetWithHeaderOptions>(&PrimitiveResource::requestGetWith)).Do(
+        [&sentTag](const OIC::Service::HeaderOptions &options, GetCallback callback)
+    {
+        for (const auto &option : options)
+        {
+            if (option.getOptionID() == OC::HeaderOption::ETAG_OPTION_ID)
+            {
+                sentTag = option.getOptionData();
+            }
+        }
+
+        // 2.03 Valid echoes the ETag and carries no representation.
+        OIC::Service::HeaderOptions hos;
+        hos.emplace_back(OC::HeaderOption::ETAG_OPTION_ID, "v1");
+        OIC::Service::ResponseStatement rep(OIC::Service::RCSResourceAttributes{});
+        callback(hos, rep, OC_STACK_OK);
+        return;
+    });
+
+    cacheHandler->initializeDataCache(pResource);
+    id = cacheHandler->addSubscriber(cb, REPORT_FREQUENCY::UPTODATE, 0);
+    cacheHandler->requestGet();
+
+    ASSERT_EQ("v1", sentTag);
+    ASSERT_EQ(1, cacheHandler->getCachedData()["power"].get<int>());
+
+    CacheStatistics statistics = cacheHandler->getStatistics();
+    ASSERT_EQ(1u, statistics.revalidations);
+    ASSERT_EQ(0u, statistics.reports);
+}
+
+TEST_F(DataCacheTest, onGet_schedulesPollingFromMaxAge)
+{
+    std::atomic<int> requests{ 0 };
+    mocks.OnCall(pResource.get(), PrimitiveResource::requestGet).Do(
+        [&requests](GetCallback callback)
+    {
+        ++requests;
+        OIC::Service::HeaderOptions hos;
+        hos.emplace_back(OC::HeaderOption::MAX_AGE_OPTION_ID, std::string{ "\x01", 1 });
+        OIC::Service::RCSResourceAttributes attr;
+        attr["power"] = 1;
+        OIC::Service::ResponseStatement rep(attr);
+        callback(hos, rep, OC_STACK_OK);
+        return;
+    });
+
+    cacheHandler->initializeDataCache(pResource);
+
+    // Without Max-Age the next poll would only be sent after CACHE_DEFAULT_REPORT_MILLITIME.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    int sent = requests.load();
+    cacheHandler.reset();
+
+    ASSERT_LE(2, sent);
+}
@@ -201,6 +201,12 @@ TEST_F(ResourceCacheManagerTest, getResourceCacheStateCacheID_cacheIDIsZero)
                  RCSInvalidParameterException);
 }
 
+TEST_F(ResourceCacheManagerTest, getCacheStatisticsCacheID_cacheIDIsZero)
+{
+
+    ASSERT_THROW(cacheInstance->getCacheStatistics(0), RCSInvalidParameterException);
+}
+
 TEST_F(ResourceCacheManagerTest, getResourceCacheStateCacheID_handlerIsNULL)
 {
 
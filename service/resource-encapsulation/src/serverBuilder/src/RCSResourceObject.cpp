@@ -25,6 +25,7 @@
 #include "RequestHandler.h"
 #include "AssertUtils.h"
 #include "AtomicHelper.h"
+#include "ExpiryTimer.h"
 #include "ResourceAttributesConverter.h"
 #include "ResourceAttributesUtils.h"
 #include "RCSRequest.h"
@@ -96,31 +97,6 @@ namespace
         return RESPONSE::defaultAction();
     }
 
-    typedef void (RCSResourceObject::* AutoNotifyFunc)
-            (bool, RCSResourceObject::AutoNotifyPolicy) const;
-
-    std::function<void()> createAutoNotifyInvoker(AutoNotifyFunc autoNotifyFunc,
-            const RCSResourceObject& resourceObject,
-            const RCSResourceAttributes& resourceAttributes,
-            RCSResourceObject::AutoNotifyPolicy autoNotifyPolicy)
-    {
-        if(autoNotifyPolicy == RCSResourceObject::AutoNotifyPolicy::UPDATED)
-        {
-            auto&& compareAttributesFunc =
-                    std::bind(std::not_equal_to<RCSResourceAttributes>(),
-                                resourceAttributes,
-                                std::cref(resourceAttributes));
-            return std::bind(autoNotifyFunc,
-                    &resourceObject, std::move(compareAttributesFunc), autoNotifyPolicy);
-        }
-        else if(autoNotifyPolicy == RCSResourceObject::AutoNotifyPolicy::ALWAYS)
-        {
-            return std::bind(autoNotifyFunc,
-                    &resourceObject, true, autoNotifyPolicy);
-        }
-        return {};
-    }
-
     void insertValue(std::vector<std::string>& container, std::string value)
     {
         if (value.empty()) return;
@@ -243,6 +219,7 @@ namespace OIC
             });
 
             server->init(handle, m_interfaces, m_types, m_defaultInterface);
+            server->m_self = server;
 
             return server;
         }
@@ -264,7 +241,12 @@ namespace OIC
                 m_attributeUpdatedListeners{ },
                 m_lockOwner{ },
                 m_mutex{ },
-                m_mutexAttributeUpdatedListeners{ }
+                m_mutexAttributeUpdatedListeners{ },
+                m_autoNotifyWindow{ 0 },
+                m_minNotifyInterval{ 0 },
+                m_lastNotifyTime{ },
+                m_isNotifyScheduled{ false },
+                m_mutexForNotify{ }
         {
             m_lockOwner.reset(new AtomicThreadId);
         }
@@ -434,6 +416,9 @@ namespace OIC
             invokeOCFuncWithResultExpect({ OC_STACK_OK, OC_STACK_NO_OBSERVERS },
                     static_cast< NotifyAllObservers >(OC::OCPlatform::notifyAllObservers),
                     m_resourceHandle);
+
+            std::lock_guard< std::mutex > lock(m_mutexForNotify);
+            m_lastNotifyTime = std::chrono::steady_clock::now();
         }
 
         void RCSResourceObject::addAttributeUpdatedListener(const std::string& key,
@@ -478,6 +463,30 @@ namespace OIC
             return m_autoNotifyPolicy;
         }
 
+        void RCSResourceObject::setAutoNotifyWindow(std::chrono::milliseconds window)
+        {
+            std::lock_guard< std::mutex > lock(m_mutexForNotify);
+            m_autoNotifyWindow = window;
+        }
+
+        std::chrono::milliseconds RCSResourceObject::getAutoNotifyWindow() const
+        {
+            std::lock_guard< std::mutex > lock(m_mutexForNotify);
+            return m_autoNotifyWindow;
+        }
+
+        void RCSResourceObject::setMinNotifyInterval(std::chrono::milliseconds interval)
+        {
+            std::lock_guard< std::mutex > lock(m_mutexForNotify);
+            m_minNotifyInterval = interval;
+        }
+
+        std::chrono::milliseconds RCSResourceObject::getMinNotifyInterval() const
+        {
+            std::lock_guard< std::mutex > lock(m_mutexForNotify);
+            return m_minNotifyInterval;
+        }
+
         void RCSResourceObject::setSetRequestHandlerPolicy(SetRequestHandlerPolicy policy)
         {
             m_setRequestHandlerPolicy = policy;
@@ -572,9 +581,58 @@ namespace OIC
             if(autoNotifyPolicy == AutoNotifyPolicy::UPDATED &&
                     isAttributesChanged == false) return;
 
+            if (scheduleNotify()) return;
+
             notify();
         }
 
+        bool RCSResourceObject::scheduleNotify() const
+        {
+            std::lock_guard< std::mutex > lock(m_mutexForNotify);
+
+            // Merged into the notification already scheduled.
+            if (m_isNotifyScheduled) return true;
+
+            const auto now = std::chrono::steady_clock::now();
+            const auto due = std::max(now + m_autoNotifyWindow,
+                    m_lastNotifyTime + m_minNotifyInterval);
+
+            if (due <= now) return false;
+
+            auto delay = std::chrono::duration_cast< std::chrono::milliseconds >(due - now);
+            if (delay < due - now) ++delay;
+
+            if (!m_notifyTimer) m_notifyTimer.reset(new ExpiryTimer);
+
+            std::weak_ptr< RCSResourceObject > weakRes{ m_self };
+            m_notifyTimer->post(delay.count(), [weakRes](ExpiryTimer::Id)
+            {
+                if (auto resource = weakRes.lock()) resource->sendScheduledNotify();
+            });
+
+            m_isNotifyScheduled = true;
+            return true;
+        }
+
+        void RCSResourceObject::sendScheduledNotify() const
+        {
+            {
+                std::lock_guard< std::mutex > lock(m_mutexForNotify);
+                m_isNotifyScheduled = false;
+                m_lastNotifyTime = std::chrono::steady_clock::now();
+            }
+
+            try
+            {
+                notify();
+            }
+            catch (const RCSPlatformException& e)
+            {
+                OIC_LOG_V(WARNING, LOG_TAG, "Failed to send scheduled notification : %s",
+                        e.what());
+            }
+        }
+
         OCEntityHandlerResult RCSResourceObject::entityHandler(
                 const std::weak_ptr< RCSResourceObject >& weakRes,
                 const std::shared_ptr< OC::OCResourceRequest >& request)
@@ -793,7 +851,18 @@ namespace OIC
 
         RCSResourceObject::LockGuard::~LockGuard() noexcept(false)
         {
-            if (!std::uncaught_exception() && m_autoNotifyFunc) m_autoNotifyFunc();
+            bool isAttributesChanged = true;
+
+            if (m_autoNotifyPolicy == AutoNotifyPolicy::UPDATED)
+            {
+                isAttributesChanged =
+                        !m_resourceObject.m_resourceAttributes.stopTrackingChanges().empty();
+            }
+
+            if (!std::uncaught_exception())
+            {
+                m_resourceObject.autoNotify(isAttributesChanged, m_autoNotifyPolicy);
+            }
 
             if (m_isOwningLock)
             {
@@ -810,8 +879,11 @@ namespace OIC
                 m_resourceObject.setLockOwner(std::this_thread::get_id());
                 m_isOwningLock = true;
             }
-            m_autoNotifyFunc = ::createAutoNotifyInvoker(&RCSResourceObject::autoNotify,
-                    m_resourceObject, m_resourceObject.m_resourceAttributes, m_autoNotifyPolicy);
+
+            if (m_autoNotifyPolicy == AutoNotifyPolicy::UPDATED)
+            {
+                m_resourceObject.m_resourceAttributes.startTrackingChanges();
+            }
         }
 
       RCSResourceObject::WeakGuard::WeakGuard(
@@ -315,6 +315,31 @@ TEST_F(AutoNotifyTest, WithUpdatePolicy_WillBeNotifiedIfAttributeIsDeleted)
     server->removeAttribute(KEY);
 }
 
+TEST_F(AutoNotifyTest, WithAutoNotifyWindow_UpdatesAreMergedIntoOneNotification)
+{
+    server->setAutoNotifyWindow(std::chrono::milliseconds{ 10 });
+
+    mocks.ExpectCallFuncOverload(static_cast< NotifyAllObservers >(
+            OC::OCPlatform::notifyAllObservers)).Return(OC_STACK_OK);
+
+    server->setAttribute(KEY, VALUE);
+    server->setAttribute(KEY, VALUE + 1);
+    server->setAttribute(KEY, VALUE + 2);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{ 200 });
+}
+
+TEST_F(AutoNotifyTest, WithMinNotifyInterval_UpdateWithinIntervalIsDelayed)
+{
+    server->setMinNotifyInterval(std::chrono::seconds{ 10 });
+
+    mocks.ExpectCallFuncOverload(static_cast< NotifyAllObservers >(
+            OC::OCPlatform::notifyAllObservers)).Return(OC_STACK_OK);
+
+    server->setAttribute(KEY, VALUE);
+    server->setAttribute(KEY, VALUE + 1);
+}
+
 class AutoNotifyWithGuardTest: public AutoNotifyTest
 {
 };
@@ -21,6 +21,7 @@
 #include "SceneCollectionResource.h"
 
 #include <atomic>
+#include "logger.h"
 #include "OCApi.h"
 #include "RCSRequest.h"
 #include "RCSSeparateResponse.h"
@@ -193,13 +194,14 @@ namespace OIC
                 std::lock_guard<std::mutex> memberlock(m_sceneMemberLock);
                 auto executeHandler
                     = SceneExecuteResponseHandler::createExecuteHandler(
-                            shared_from_this(), std::move(executeCB));
+                            shared_from_this(), sceneName, std::move(executeCB));
                 for (auto & it : m_sceneMembers)
                 {
-                    it->execute(std::move(sceneName), std::bind(
+                    it->execute(sceneName, std::bind(
                             &SceneExecuteResponseHandler::onResponse, executeHandler,
                             std::placeholders::_1, std::placeholders::_2));
                 }
+                executeHandler->onRequestsSent();
             }
         }
 
@@ -431,12 +433,45 @@ namespace OIC
         void SceneCollectionResource::SceneExecuteResponseHandler::
         onResponse(const RCSResourceAttributes & /*attributes*/, int errorCode)
         {
-            m_responseMembers++;
-            if (errorCode != SCENE_RESPONSE_SUCCESS && m_errorCode != errorCode)
+            if (errorCode != SCENE_RESPONSE_SUCCESS)
             {
                 m_errorCode = errorCode;
             }
-            if (m_responseMembers == m_numOfMembers)
+            if (--m_numOfPending == 0)
+            {
+                onCompleted(false);
+            }
+        }
+
+        void SceneCollectionResource::SceneExecuteResponseHandler::onRequestsSent()
+        {
+            if (--m_numOfPending == 0)
+            {
+                onCompleted(true);
+            }
+        }
+
+        void SceneCollectionResource::SceneExecuteResponseHandler::
+        onCompleted(bool isCalledFromExecute)
+        {
+            OIC_LOG_V(DEBUG, "[SCENE_MANAGER]", "scene %s executed on %d members in %lld ms",
+                    m_sceneName.c_str(), m_numOfMembers,
+                    (long long) std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - m_startTime).count());
+
+            if (!m_cb)
+            {
+                return;
+            }
+
+            // The last response normally completes the execution, on its own thread.
+            // When every member completed synchronously, the caller of execute still
+            // has to return before the callback runs (e.g. to set up a separate response).
+            if (isCalledFromExecute)
+            {
+                std::thread(std::move(m_cb), m_errorCode.load()).detach();
+            }
+            else
             {
                 m_cb(m_errorCode);
             }
@@ -444,18 +479,17 @@ namespace OIC
 
         SceneCollectionResource::SceneExecuteResponseHandler::Ptr
         SceneCollectionResource::SceneExecuteResponseHandler::createExecuteHandler(
-                const SceneCollectionResource::Ptr ptr, SceneExecuteCallback executeCB)
+                const SceneCollectionResource::Ptr ptr, const std::string & sceneName,
+                SceneExecuteCallback executeCB)
         {
             auto executeHandler = std::make_shared<SceneExecuteResponseHandler>();
 
             executeHandler->m_numOfMembers = ptr->m_sceneMembers.size();
-            executeHandler->m_responseMembers = 0;
+            executeHandler->m_numOfPending = executeHandler->m_numOfMembers + 1;
+            executeHandler->m_sceneName = sceneName;
+            executeHandler->m_startTime = std::chrono::steady_clock::now();
 
-            executeHandler->m_cb =
-                    [executeCB](int eCode)
-                    {
-                        std::thread(std::move(executeCB), eCode).detach();
-                    };
+            executeHandler->m_cb = std::move(executeCB);
 
             executeHandler->m_owner
                 = std::weak_ptr<SceneCollectionResource>(ptr);
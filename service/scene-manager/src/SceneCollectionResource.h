@@ -21,6 +21,8 @@
 #ifndef SCENE_COLLECTION_RESOURCE_OBJECT_H
 #define SCENE_COLLECTION_RESOURCE_OBJECT_H
 
+#include <atomic>
+#include <chrono>
 #include <list>
 
 #include "RCSResourceObject.h"
@@ -78,18 +80,26 @@ namespace OIC
                 typedef std::shared_ptr<SceneExecuteResponseHandler> Ptr;
 
                 SceneExecuteResponseHandler()
-                : m_numOfMembers(0), m_responseMembers(0), m_errorCode(0) { }
+                : m_numOfMembers(0), m_numOfPending(0), m_errorCode(0) { }
                 ~SceneExecuteResponseHandler() = default;
 
                 int m_numOfMembers;
-                int m_responseMembers;
-                int m_errorCode;
+                // responses not received yet, plus one held until all requests are sent.
+                std::atomic_int m_numOfPending;
+                std::atomic_int m_errorCode;
+                std::string m_sceneName;
+                std::chrono::steady_clock::time_point m_startTime;
                 std::weak_ptr<SceneCollectionResource> m_owner;
                 SceneExecuteCallback m_cb;
 
                 static SceneExecuteResponseHandler::Ptr createExecuteHandler(
-                        const SceneCollectionResource::Ptr, SceneExecuteCallback);
+                        const SceneCollectionResource::Ptr, const std::string &,
+                        SceneExecuteCallback);
                 void onResponse(const RCSResourceAttributes &, int);
+                void onRequestsSent();
+
+            private:
+                void onCompleted(bool isCalledFromExecute);
             };
 
             class SceneCollectionRequestHandler
@@ -111,6 +111,10 @@ namespace OIC
 
         void SceneMemberResource::addMappingInfo(MappingInfo && mInfo)
         {
+            std::lock_guard<std::mutex> planLock(m_executionPlanLock);
+
+            m_executionPlans[mInfo.sceneName][mInfo.key] = mInfo.value;
+
             RCSResourceAttributes newAtt;
             {
                 RCSResourceObject::LockGuard guard(m_sceneMemberResourceObj);
@@ -198,23 +202,30 @@ namespace OIC
         void SceneMemberResource::execute(std::string && sceneName, MemberexecuteCallback executeCB)
         {
             RCSResourceAttributes setAtt;
+            {
+                std::lock_guard<std::mutex> planLock(m_executionPlanLock);
+                auto foundPlan = m_executionPlans.find(sceneName);
+                if (foundPlan != m_executionPlans.end())
+                {
+                    setAtt = foundPlan->second;
+                }
+            }
 
-            auto mInfo = getMappingInfos();
-            std::for_each(mInfo.begin(), mInfo.end(),
-                    [& setAtt, & sceneName](const MappingInfo & info)
-                    {
-                        if(info.sceneName == sceneName)
-                        {
-                            setAtt[info.key] = info.value;
-                        }
-                    });
+            if (setAtt.empty())
+            {
+                if (executeCB != nullptr)
+                {
+                    executeCB(RCSResourceAttributes(), SCENE_RESPONSE_SUCCESS);
+                }
+                return;
+            }
 
-            if (setAtt.empty() && executeCB != nullptr)
+            if (executeCB == nullptr)
             {
-                executeCB(RCSResourceAttributes(), SCENE_RESPONSE_SUCCESS);
+                executeCB = [](const RCSResourceAttributes &, int) { };
             }
 
-            m_remoteMemberObj->setRemoteAttributes(setAtt, executeCB);
+            m_remoteMemberObj->setRemoteAttributes(setAtt, std::move(executeCB));
         }
 
         void SceneMemberResource::execute(
@@ -257,16 +268,8 @@ namespace OIC
 
         bool SceneMemberResource::hasSceneValue(const std::string & sceneValue) const
         {
-            auto mInfo = getMappingInfos();
-            if (std::find_if(mInfo.begin(), mInfo.end(),
-                    [& sceneValue](const MappingInfo & info) -> bool
-                    {
-                        return info.sceneName == sceneValue;
-                    }) != mInfo.end())
-            {
-                return true;
-            }
-            return false;
+            std::lock_guard<std::mutex> planLock(m_executionPlanLock);
+            return m_executionPlans.find(sceneValue) != m_executionPlans.end();
         }
 
         SceneMemberResource::MappingInfo
@@ -27,6 +27,9 @@
 #ifndef SCENE_MEMBER_RESOURCE_OBJECT_H
 #define SCENE_MEMBER_RESOURCE_OBJECT_H
 
+#include <mutex>
+#include <unordered_map>
+
 #include "RCSResourceObject.h"
 #include "RCSRemoteResourceObject.h"
 #include "SceneCommons.h"
@@ -195,6 +198,11 @@ namespace OIC
             RCSRemoteResourceObject::Ptr m_remoteMemberObj;
             SceneMemberRequestHandler m_requestHandler;
 
+            // attributes to set at the remote resource for each scene value,
+            // kept in step with the scene mappings so executing needs no parsing.
+            mutable std::mutex m_executionPlanLock;
+            std::unordered_map<std::string, RCSResourceAttributes> m_executionPlans;
+
             SceneMemberResource() = default;
 
             SceneMemberResource(const SceneMemberResource &) = delete;
@@ -56,7 +56,7 @@ class ClientController
                 int choice = -1;
                 std::cout << "Enter your choice: ";
                 std::cin >> choice;
-                if (choice < 0 || choice > 14)
+                if (choice < 0 || choice > 15)
                 {
                     std::cout << "Invaild choice !" << std::endl; continue;
                 }
@@ -76,7 +76,8 @@ class ClientController
                     case 11: configure(); break;
                     case 12: getDeviceInfo(); break;
                     case 13: getPlatformInfo(); break;
-                    case 14: printMenu(); break;
+                    case 14: runLoadTest(); break;
+                    case 15: printMenu(); break;
                     case 0: cont = false;
                 }
             }
@@ -99,7 +100,8 @@ class ClientController
             std::cout << "11. Configure (using RAML file)" << std::endl;
             std::cout << "12. Get Device Information" << std::endl;
             std::cout << "13. Get Platform Information" << std::endl;
-            std::cout << "14: Help" << std::endl;
+            std::cout << "14. Run load test" << std::endl;
+            std::cout << "15: Help" << std::endl;
             std::cout << "0. Exit" << std::endl;
             std::cout << "###################################################" << std::endl;
         }
@@ -475,6 +477,69 @@ class ClientController
             }
         }
 
+        void runLoadTest()
+        {
+            SimulatorRemoteResourceSP resource = selectResource();
+            if (!resource) return;
+
+            LoadTestConfig config;
+            int type = 0;
+            std::cout << "Request type (1: GET, 2: PUT, 3: POST): ";
+            std::cin >> type;
+            config.type = (2 == type) ? RequestType::RQ_TYPE_PUT :
+                          (3 == type) ? RequestType::RQ_TYPE_POST : RequestType::RQ_TYPE_GET;
+            std::cout << "Concurrency: ";
+            std::cin >> config.concurrency;
+            std::cout << "Requests per second (0 for unlimited): ";
+            std::cin >> config.requestRate;
+            std::cout << "Duration in seconds: ";
+            std::cin >> config.duration;
+            std::cout << "Timeout in milliseconds: ";
+            std::cin >> config.timeout;
+
+            SimulatorRemoteResource::LoadTestCallback callback =
+                [] (const std::string & uid, int sessionId, OperationState state,
+                    const LoadTestReport & report)
+            {
+                std::cout << "\nLoad test status received ![id:  " << sessionId <<
+                          "  State: " << getOperationStateString(state) << " UID: " << uid << "]" <<
+                          std::endl;
+                if (OP_START == state)
+                    return;
+
+                std::cout << "Requests: " << report.requestCount << " Success: " <<
+                          report.successCount << " Errors: " << report.errorCount <<
+                          " Timeouts: " << report.timeoutCount << std::endl;
+                std::cout << "Throughput: " << report.throughput << " responses/s Error rate: " <<
+                          report.errorRate << std::endl;
+                std::cout << "Latency (us): min " << report.minLatency << " mean " <<
+                          report.meanLatency << " p50 " << report.p50Latency << " p99 " <<
+                          report.p99Latency << " p999 " << report.p999Latency << " max " <<
+                          report.maxLatency << std::endl;
+            };
+
+            try
+            {
+                int id = resource->startLoadTest(config, callback);
+                std::cout << "startLoadTest is successful!id: " << id << std::endl;
+            }
+            catch (InvalidArgsException &e)
+            {
+                std::cout << "InvalidArgsException occured [code : " << e.code() << " Detail: "
+                          << e.what() << "]" << std::endl;
+            }
+            catch (NoSupportException &e)
+            {
+                std::cout << "NoSupportException occured [code : " << e.code() << " Detail: " <<
+                          e.what() << "]" << std::endl;
+            }
+            catch (SimulatorException &e)
+            {
+                std::cout << "SimulatorException occured [code : " << e.code() << " Detail: " <<
+                          e.what() << "]" << std::endl;
+            }
+        }
+
         void configure()
         {
             SimulatorRemoteResourceSP resource = selectResource();
@@ -22,6 +22,8 @@
 
 std::vector<SimulatorSingleResourceSP> g_singleResources;
 std::vector<SimulatorCollectionResourceSP> g_collectionResources;
+std::vector<SimulatorResourceSP> g_scaleResources;
+std::vector<int> g_bulkUpdationIds;
 
 class AppLogger : public ILogger
 {
@@ -322,6 +324,68 @@ void stopAutomation()
     }
 }
 
+void simulateResourcesAtScale()
+{
+    std::string configPath;
+    std::cout << "Enter RAML path: ";
+    std::cin >> configPath;
+
+    unsigned int count = 0;
+    std::cout << "Number of resources: ";
+    std::cin >> count;
+
+    int updateRate = 0;
+    std::cout << "Attribute updates per second (0 for none): ";
+    std::cin >> updateRate;
+
+    try
+    {
+        std::vector<SimulatorResourceSP> resources =
+            SimulatorManager::getInstance()->createResource(configPath, count);
+        for (auto &resource : resources)
+        {
+            resource->start();
+        }
+
+        g_scaleResources.insert(g_scaleResources.end(), resources.begin(), resources.end());
+        std::cout << resources.size() << " resources started" << std::endl;
+
+        if (updateRate > 0)
+        {
+            int id = SimulatorManager::getInstance()->startBulkUpdation(resources, updateRate);
+            g_bulkUpdationIds.push_back(id);
+            std::cout << "Bulk updation started [id: " << id << "]" << std::endl;
+        }
+    }
+    catch (InvalidArgsException &e)
+    {
+        std::cout << "InvalidArgsException occured [code : " << e.code() << " Details: "
+                  << e.what() << "]" << std::endl;
+    }
+    catch (SimulatorException &e)
+    {
+        std::cout << "SimulatorException occured [code : " << e.code() << " Details: "
+                  << e.what() << "]" << std::endl;
+    }
+}
+
+void stopResourcesAtScale()
+{
+    for (auto &id : g_bulkUpdationIds)
+    {
+        SimulatorManager::getInstance()->stopBulkUpdation(id);
+    }
+
+    for (auto &resource : g_scaleResources)
+    {
+        resource->stop();
+    }
+
+    std::cout << g_scaleResources.size() << " resources stopped" << std::endl;
+    g_bulkUpdationIds.clear();
+    g_scaleResources.clear();
+}
+
 void getObservers()
 {
     int index = selectResource();
@@ -356,7 +420,9 @@ void printMainMenu()
     std::cout << "10. Set Device Info" << std::endl;
     std::cout << "11. Set Platform Info" << std::endl;
     std::cout << "12. Add Interface" << std::endl;
-    std::cout << "13. Help" << std::endl;
+    std::cout << "13. Simulate resources at scale" << std::endl;
+    std::cout << "14. Stop resources simulated at scale" << std::endl;
+    std::cout << "15. Help" << std::endl;
     std::cout << "0. Exit" << std::endl;
     std::cout << "######################################" << std::endl;
 }
@@ -461,7 +527,7 @@ int main(int argc, char *argv[])
         int choice = -1;
         std::cout << "Enter your choice: ";
         std::cin >> choice;
-        if (choice < 0 || choice > 14)
+        if (choice < 0 || choice > 15)
         {
             std::cout << "Invaild choice !" << std::endl; continue;
         }
@@ -480,7 +546,9 @@ int main(int argc, char *argv[])
             case 10: setDeviceInfo(); break;
             case 11: setPlatformInfo(); break;
             case 12: addInterface(); break;
-            case 13: printMainMenu(); break;
+            case 13: simulateResourcesAtScale(); break;
+            case 14: stopResourcesAtScale(); break;
+            case 15: printMainMenu(); break;
             case 0: cont = false;
         }
     }
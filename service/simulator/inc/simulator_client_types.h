@@ -22,6 +22,7 @@
 #define SIMULATOR_CLIENT_TYPES_H_
 
 #include <iostream>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include "simulator_error_codes.h"
@@ -54,6 +55,55 @@ typedef enum
     OP_ABORT
 } OperationState;
 
+/**
+ * Parameters of a load test session.
+ */
+typedef struct
+{
+    /** Request type to be sent (GET, PUT or POST). */
+    RequestType type;
+
+    /** Maximum number of requests waiting for a response at any time. */
+    int concurrency;
+
+    /** Target requests per second. 0 sends as fast as the concurrency allows. */
+    int requestRate;
+
+    /** Duration of the session in seconds. */
+    int duration;
+
+    /** Time in milliseconds after which a request without response is counted as timed out. */
+    int timeout;
+} LoadTestConfig;
+
+/**
+ * Result of a load test session. Latencies are in microseconds and, when a request
+ * rate is set, measured from the time a request was scheduled to be sent.
+ */
+typedef struct
+{
+    uint64_t requestCount;
+    uint64_t successCount;
+    uint64_t errorCount;
+    uint64_t timeoutCount;
+
+    /** Elapsed time of the session in seconds. */
+    double duration;
+
+    /** Successful responses per second. */
+    double throughput;
+
+    /** Share of requests which failed or timed out. */
+    double errorRate;
+
+    uint64_t minLatency;
+    uint64_t maxLatency;
+    double meanLatency;
+    uint64_t p50Latency;
+    uint64_t p99Latency;
+    uint64_t p999Latency;
+} LoadTestReport;
+
 typedef enum
 {
     /** use when defaults are ok. */
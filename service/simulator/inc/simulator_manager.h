@@ -37,6 +37,9 @@
 #include "simulator_exceptions.h"
 #include "simulator_logger.h"
 
+#include <map>
+#include <mutex>
+
 typedef std::function<void(const std::string &hostUri, DeviceInfo &deviceInfo)> DeviceInfoCallback;
 typedef std::function<void(const std::string &hostUri, PlatformInfo &platformInfo)>
 PlatformInfoCallback;
@@ -48,6 +51,7 @@ PlatformInfoCallback;
  *              and creation/deletion of resources.
  *
  */
+class BulkUpdateScheduler;
 class SimulatorManager
 {
     public:
@@ -83,6 +87,33 @@ class SimulatorManager
         std::vector<std::shared_ptr<SimulatorResource>> createResource(
                     const std::string &configPath, unsigned int count);
 
+        /**
+         * This method is for driving attribute updates of many resources, typically created
+         * together with createResource(configPath, count), from a single scheduler thread.
+         * Resources are updated in round robin, one attribute per update, and every update
+         * notifies the observers of the updated resource. Updations run until stopped.
+         * The values are generated from the schema of the first resource, so all the resources
+         * are expected to share it. An attribute which another resource does not have, or
+         * whose value it rejects, is skipped for that resource with an error logged.
+         *
+         * @param resources - Single resources to be updated.
+         * @param updateRate - Number of updates per second across all the resources.
+         *
+         * @return Identifier of the bulk updation.
+         *
+         * NOTE: API would throw @InvalidArgsException when invalid arguments passed, and
+         * @SimulatorException if any other error occured.
+         */
+        int startBulkUpdation(const std::vector<std::shared_ptr<SimulatorResource>> &resources,
+                              int updateRate);
+
+        /**
+         * This method is for stopping a bulk updation.
+         *
+         * @param id - Identifier of the bulk updation.
+         */
+        void stopBulkUpdation(int id);
+
         /**
          * This method is for creating single type resource.
          *
@@ -217,6 +248,10 @@ class SimulatorManager
         SimulatorManager &operator=(const SimulatorManager &) = delete;
         SimulatorManager(const SimulatorManager &&) = delete;
         SimulatorManager &operator=(const SimulatorManager && ) = delete;
+
+        std::mutex m_bulkUpdationLock;
+        std::map<int, std::shared_ptr<BulkUpdateScheduler>> m_bulkUpdations;
+        int m_bulkUpdationId;
 };
 
 #endif
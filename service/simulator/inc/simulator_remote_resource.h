@@ -82,6 +82,18 @@ class SimulatorRemoteResource : private UnCopyable
         typedef std::function<void(const std::string &uid, int id, OperationState state)>
         AutoRequestGenerationCallback;
 
+        /**
+         * Callback method for receiving load test progress state and result.
+         *
+         * @param uid - Identifier of remote resource.
+         * @param id - Load test session id.
+         * @param state - Load test state.
+         * @param report - Result of the session, valid with OP_COMPLETE and OP_ABORT.
+         */
+        typedef std::function<void(const std::string &uid, int id, OperationState state,
+                                   const LoadTestReport &report)>
+        LoadTestCallback;
+
         /**
          * API for getting URI of resource.
          *
@@ -279,6 +291,29 @@ class SimulatorRemoteResource : private UnCopyable
          * @param id - Identifier of auto request generating session.
          */
         virtual void stopAutoRequesting(int id) = 0;
+
+        /**
+         * API to start sending requests to remote resource with the given concurrency
+         * and rate for measuring latency and throughput. PUT and POST requests carry
+         * the representation of the request model, so the resource must be configured
+         * for them.
+         *
+         * @param config - Load test parameters.
+         * @param callback - callback for receiving progress state and result of the
+         * load test.
+         *
+         * @return Identifier of load test session. This id should be used
+         * for stopping the same.
+         */
+        virtual int startLoadTest(const LoadTestConfig &config, LoadTestCallback callback) = 0;
+
+        /**
+         * API to stop load test session. The callback receives the result
+         * collected so far.
+         *
+         * @param id - Identifier of load test session.
+         */
+        virtual void stopLoadTest(int id) = 0;
 };
 
 typedef std::shared_ptr<SimulatorRemoteResource> SimulatorRemoteResourceSP;
@@ -0,0 +1,142 @@
+/******************************************************************
+ *
+ * Copyright 2016 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Every bucket has 2^(SUB_BUCKET_BITS - 1) sub buckets past the first one,
+// which bounds the relative error of a reported value to 1/128.
+#define SUB_BUCKET_BITS 8
+#define SUB_BUCKET_HALF_COUNT (1 << (SUB_BUCKET_BITS - 1))
+
+static unsigned int magnitudeOf(uint64_t value)
+{
+    unsigned int magnitude = 0;
+    while ((value >> magnitude) >= (1 << SUB_BUCKET_BITS))
+    {
+        magnitude++;
+    }
+
+    return magnitude;
+}
+
+LatencyHistogram::LatencyHistogram(uint64_t highestValue)
+    :   m_highestValue(highestValue),
+        m_totalCount(0),
+        m_min(std::numeric_limits<uint64_t>::max()),
+        m_max(0),
+        m_sum(0)
+{
+    m_counts.resize(indexOf(highestValue) + 1, 0);
+}
+
+void LatencyHistogram::record(uint64_t value)
+{
+    if (value > m_highestValue)
+    {
+        value = m_highestValue;
+    }
+
+    m_counts[indexOf(value)]++;
+    m_totalCount++;
+    m_sum += value;
+    if (value < m_min)
+    {
+        m_min = value;
+    }
+    if (value > m_max)
+    {
+        m_max = value;
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    m_totalCount = 0;
+    m_min = std::numeric_limits<uint64_t>::max();
+    m_max = 0;
+    m_sum = 0;
+}
+
+uint64_t LatencyHistogram::min() const
+{
+    return m_totalCount ? m_min : 0;
+}
+
+double LatencyHistogram::mean() const
+{
+    return m_totalCount ? m_sum / m_totalCount : 0;
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const
+{
+    if (!m_totalCount)
+    {
+        return 0;
+    }
+
+    if (percentile >= 100)
+    {
+        return m_max;
+    }
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100 * m_totalCount));
+    if (target < 1)
+    {
+        target = 1;
+    }
+
+    uint64_t cumulative = 0;
+    for (size_t index = 0; index < m_counts.size(); index++)
+    {
+        cumulative += m_counts[index];
+        if (cumulative >= target)
+        {
+            uint64_t value = highestValueAt(index);
+            return value < m_max ? value : m_max;
+        }
+    }
+
+    return m_max;
+}
+
+size_t LatencyHistogram::indexOf(uint64_t value) const
+{
+    // Values below 2^SUB_BUCKET_BITS map one to one, larger ones are shifted
+    // down into the upper half of the sub buckets of their magnitude.
+    unsigned int magnitude = magnitudeOf(value);
+    return magnitude * SUB_BUCKET_HALF_COUNT + (value >> magnitude);
+}
+
+uint64_t LatencyHistogram::highestValueAt(size_t index) const
+{
+    unsigned int magnitude = 0;
+    if (index >= 2 * SUB_BUCKET_HALF_COUNT)
+    {
+        magnitude = index / SUB_BUCKET_HALF_COUNT - 1;
+    }
+
+    uint64_t lowest = static_cast<uint64_t>(index - magnitude * SUB_BUCKET_HALF_COUNT) << magnitude;
+    return lowest + (static_cast<uint64_t>(1) << magnitude) - 1;
+}
@@ -0,0 +1,81 @@
+/******************************************************************
+ *
+ * Copyright 2016 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/**
+ * @file latency_histogram.h
+ *
+ * @brief This file provides a histogram for recording request latencies.
+ *
+ */
+
+#ifndef SIMULATOR_LATENCY_HISTOGRAM_H_
+#define SIMULATOR_LATENCY_HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class   LatencyHistogram
+ * @brief   Log-linear histogram in the style of HdrHistogram. Values are kept in
+ *          buckets whose width doubles with every power of two, each split into
+ *          equal sub buckets, so any recorded value is reported within 1% using a
+ *          fixed amount of memory.
+ */
+class LatencyHistogram
+{
+    public:
+        /**
+         * @param highestValue - Highest value to be tracked. Larger values are
+         * recorded as this value.
+         */
+        LatencyHistogram(uint64_t highestValue);
+
+        void record(uint64_t value);
+        void reset();
+
+        uint64_t count() const { return m_totalCount; }
+        uint64_t min() const;
+        uint64_t max() const { return m_max; }
+        double mean() const;
+
+        /**
+         * API to get the value below which the given percentage of the recorded
+         * values fall.
+         *
+         * @param percentile - Percentile in the range 0 to 100.
+         *
+         * @return Highest value equivalent to the percentile, 0 if nothing is recorded.
+         */
+        uint64_t percentile(double percentile) const;
+
+    private:
+        size_t indexOf(uint64_t value) const;
+        uint64_t highestValueAt(size_t index) const;
+
+        std::vector<uint64_t> m_counts;
+        uint64_t m_highestValue;
+        uint64_t m_totalCount;
+        uint64_t m_min;
+        uint64_t m_max;
+        double m_sum;
+};
+
+#endif
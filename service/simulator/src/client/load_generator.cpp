@@ -0,0 +1,227 @@
+/******************************************************************
+ *
+ * Copyright 2016 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "load_generator.h"
+#include "simulator_logger.h"
+#include "logger.h"
+#include "OCException.h"
+
+#include <thread>
+
+#define TAG "LOAD_GENERATOR"
+
+// Latencies above one hour are recorded as one hour
+#define MAX_TRACKED_LATENCY_US (3600ULL * 1000 * 1000)
+
+LoadGenerator::LoadGenerator(int id, const std::shared_ptr<OC::OCResource> &ocResource,
+                             const LoadTestConfig &config, const SimulatorResourceModel &representation,
+                             ProgressStateCallback callback)
+    :   m_id(id),
+        m_ocResource(ocResource),
+        m_config(config),
+        m_representation(representation.asOCRepresentation()),
+        m_callback(callback),
+        m_stopRequested(false),
+        m_finished(false),
+        m_outstanding(0),
+        m_requestCnt(0),
+        m_successCnt(0),
+        m_errorCnt(0),
+        m_timeoutCnt(0),
+        m_histogram(MAX_TRACKED_LATENCY_US) {}
+
+void LoadGenerator::start()
+{
+    // The dispatched thread and pending responses keep the generator alive
+    std::thread(&LoadGenerator::sendRequests, shared_from_this()).detach();
+}
+
+void LoadGenerator::stop()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_stopRequested = true;
+    m_cond.notify_all();
+}
+
+void LoadGenerator::sendRequests()
+{
+    OIC_LOG(DEBUG, TAG, "Sending OP_START event");
+    m_callback(m_id, OP_START, LoadTestReport());
+
+    Clock::time_point start = Clock::now();
+    Clock::time_point end = start + std::chrono::seconds(m_config.duration);
+    Clock::duration interval = Clock::duration::zero();
+    if (m_config.requestRate > 0)
+    {
+        interval = std::chrono::duration_cast<Clock::duration>(
+                       std::chrono::duration<double>(1.0 / m_config.requestRate));
+    }
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    Clock::time_point next = start;
+    while (!m_stopRequested)
+    {
+        if (m_config.requestRate > 0)
+        {
+            // Keep to the schedule, so a slow server cannot slow down the load
+            if (next >= end || m_cond.wait_until(lock, next, [this] { return m_stopRequested; }))
+            {
+                break;
+            }
+        }
+        else if (Clock::now() >= end)
+        {
+            break;
+        }
+
+        bool ready = m_cond.wait_until(lock, end, [this]
+        {
+            return m_stopRequested || m_outstanding < m_config.concurrency;
+        });
+        if (!ready || m_stopRequested)
+        {
+            break;
+        }
+
+        // Requests held back by the concurrency limit are charged with the delay
+        Clock::time_point scheduled = (m_config.requestRate > 0) ? next : Clock::now();
+        m_outstanding++;
+        m_requestCnt++;
+
+        lock.unlock();
+        OCStackResult result = sendRequest(scheduled);
+        lock.lock();
+
+        if (OC_STACK_OK != result)
+        {
+            m_outstanding--;
+            m_errorCnt++;
+        }
+
+        next += interval;
+    }
+
+    // Wait for the responses of requests in flight
+    m_cond.wait_until(lock, Clock::now() + std::chrono::milliseconds(m_config.timeout),
+                      [this] { return 0 == m_outstanding; });
+    m_timeoutCnt += m_outstanding;
+    m_finished = true;
+
+    LoadTestReport report = buildReport(Clock::now() - start);
+    bool aborted = m_stopRequested;
+    lock.unlock();
+
+    SIM_LOG(ILogger::INFO, "Load test completed." << "\nRequests: " << report.requestCount
+            << "\nThroughput: " << report.throughput << " responses/s"
+            << "\nError rate: " << report.errorRate
+            << "\nLatency (us): p50 " << report.p50Latency << " p99 " << report.p99Latency
+            << " p999 " << report.p999Latency << " max " << report.maxLatency);
+
+    OIC_LOG(DEBUG, TAG, aborted ? "Sending OP_ABORT event" : "Sending OP_COMPLETE event");
+    m_callback(m_id, aborted ? OP_ABORT : OP_COMPLETE, report);
+}
+
+OCStackResult LoadGenerator::sendRequest(Clock::time_point scheduled)
+{
+    OC::QueryParamsMap queryParams;
+    auto callback = std::bind(&LoadGenerator::onResponseReceived, shared_from_this(),
+                              std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
+                              scheduled);
+
+    try
+    {
+        switch (m_config.type)
+        {
+            case RequestType::RQ_TYPE_GET:
+                return m_ocResource->get(queryParams, callback);
+
+            case RequestType::RQ_TYPE_PUT:
+                return m_ocResource->put(m_representation, queryParams, callback);
+
+            case RequestType::RQ_TYPE_POST:
+                return m_ocResource->post(m_representation, queryParams, callback);
+
+            default:
+                return OC_STACK_INVALID_METHOD;
+        }
+    }
+    catch (OC::OCException &e)
+    {
+        OIC_LOG_V(ERROR, TAG, "Failed to send request [%s]", e.reason().c_str());
+        return static_cast<OCStackResult>(e.code());
+    }
+}
+
+void LoadGenerator::onResponseReceived(const OC::HeaderOptions &headerOptions,
+                                       const OC::OCRepresentation &rep, const int errorCode,
+                                       Clock::time_point scheduled)
+{
+    uint64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(
+                           Clock::now() - scheduled).count();
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (m_finished)
+    {
+        return;
+    }
+
+    m_outstanding--;
+    if (latency > static_cast<uint64_t>(m_config.timeout) * 1000)
+    {
+        m_timeoutCnt++;
+    }
+    else if (errorCode <= OC_STACK_RESOURCE_CHANGED)
+    {
+        m_successCnt++;
+        m_histogram.record(latency);
+    }
+    else
+    {
+        m_errorCnt++;
+    }
+
+    m_cond.notify_all();
+}
+
+LoadTestReport LoadGenerator::buildReport(Clock::duration elapsed)
+{
+    LoadTestReport report = LoadTestReport();
+    report.requestCount = m_requestCnt;
+    report.successCount = m_successCnt;
+    report.errorCount = m_errorCnt;
+    report.timeoutCount = m_timeoutCnt;
+    report.duration = std::chrono::duration<double>(elapsed).count();
+    if (report.duration > 0)
+    {
+        report.throughput = m_successCnt / report.duration;
+    }
+    if (m_requestCnt)
+    {
+        report.errorRate = static_cast<double>(m_errorCnt + m_timeoutCnt) / m_requestCnt;
+    }
+
+    report.minLatency = m_histogram.min();
+    report.maxLatency = m_histogram.max();
+    report.meanLatency = m_histogram.mean();
+    report.p50Latency = m_histogram.percentile(50);
+    report.p99Latency = m_histogram.percentile(99);
+    report.p999Latency = m_histogram.percentile(99.9);
+    return report;
+}
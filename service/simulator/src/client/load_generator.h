@@ -0,0 +1,88 @@
+/******************************************************************
+ *
+ * Copyright 2016 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/**
+ * @file load_generator.h
+ *
+ * @brief This file provides class for load testing a remote resource.
+ *
+ */
+
+#ifndef SIMULATOR_LOAD_GENERATOR_H_
+#define SIMULATOR_LOAD_GENERATOR_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "simulator_client_types.h"
+#include "simulator_resource_model.h"
+#include "latency_histogram.h"
+
+/**
+ * @class   LoadGenerator
+ * @brief   Sends requests of one type to a remote resource at a target rate, keeping at
+ *          most the configured number of requests in flight, and reports the latency
+ *          distribution, throughput and error rate once the session ends.
+ */
+class LoadGenerator : public std::enable_shared_from_this<LoadGenerator>
+{
+    public:
+        typedef std::function<void (int, OperationState, const LoadTestReport &)>
+        ProgressStateCallback;
+
+        LoadGenerator(int id, const std::shared_ptr<OC::OCResource> &ocResource,
+                      const LoadTestConfig &config, const SimulatorResourceModel &representation,
+                      ProgressStateCallback callback);
+        int id() const {return m_id;}
+        void start();
+        void stop();
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        void sendRequests();
+        OCStackResult sendRequest(Clock::time_point scheduled);
+        void onResponseReceived(const OC::HeaderOptions &headerOptions,
+                                const OC::OCRepresentation &rep, const int errorCode,
+                                Clock::time_point scheduled);
+        LoadTestReport buildReport(Clock::duration elapsed);
+
+        int m_id;
+        std::shared_ptr<OC::OCResource> m_ocResource;
+        LoadTestConfig m_config;
+        OC::OCRepresentation m_representation;
+        ProgressStateCallback m_callback;
+
+        std::mutex m_lock;
+        std::condition_variable m_cond;
+        bool m_stopRequested;
+        bool m_finished;
+        int m_outstanding;
+        uint64_t m_requestCnt;
+        uint64_t m_successCnt;
+        uint64_t m_errorCnt;
+        uint64_t m_timeoutCnt;
+        LatencyHistogram m_histogram;
+};
+
+typedef std::shared_ptr<LoadGenerator> LoadGeneratorSP;
+
+#endif
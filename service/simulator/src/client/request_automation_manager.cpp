@@ -173,6 +173,37 @@ int RequestAutomationMngr::startOnPOST(const std::shared_ptr<RequestModel> &requ
     return m_id++;
 }
 
+int RequestAutomationMngr::startLoadTest(const LoadTestConfig &config,
+        const SimulatorResourceModel &representation,
+        LoadGenerator::ProgressStateCallback callback)
+{
+    if (config.concurrency < 1 || config.requestRate < 0 || config.duration < 1
+        || config.timeout < 1)
+    {
+        OIC_LOG(ERROR, TAG, "Invalid load test configuration!");
+        throw InvalidArgsException(SIMULATOR_INVALID_PARAM, "Invalid load test configuration!");
+    }
+
+    if (!callback)
+    {
+        OIC_LOG(ERROR, TAG, "Invalid callback!");
+        throw InvalidArgsException(SIMULATOR_INVALID_CALLBACK, "Invalid callback!");
+    }
+
+    // Create load test session
+    LoadGenerator::ProgressStateCallback localCallback = std::bind(
+                &RequestAutomationMngr::onLoadTestProgress, this, std::placeholders::_1,
+                std::placeholders::_2, std::placeholders::_3, callback);
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    LoadGeneratorSP loadGen = std::make_shared<LoadGenerator>(m_id, m_ocResource, config,
+                              representation, localCallback);
+    m_loadGenList[m_id] = loadGen;
+    loadGen->start();
+
+    return m_id++;
+}
+
 void RequestAutomationMngr::stop(int id)
 {
     std::lock_guard<std::mutex> lock(m_lock);
@@ -180,6 +211,10 @@ void RequestAutomationMngr::stop(int id)
     {
         m_requestGenList[id]->stop();
     }
+    else if (m_loadGenList.end() != m_loadGenList.find(id))
+    {
+        m_loadGenList[id]->stop();
+    }
 }
 
 void RequestAutomationMngr::onProgressChange(int sessionId, OperationState state,
@@ -198,10 +233,27 @@ void RequestAutomationMngr::onProgressChange(int sessionId, OperationState state
     clientCallback(sessionId, state);
 }
 
+void RequestAutomationMngr::onLoadTestProgress(int sessionId, OperationState state,
+        const LoadTestReport &report, LoadGenerator::ProgressStateCallback clientCallback)
+{
+    if (!isValid(sessionId))
+        return;
+
+    // Remove the load generator from list if it is completed
+    if (state == OP_COMPLETE || state == OP_ABORT)
+    {
+        remove(sessionId);
+    }
+
+    // Delegate notification to app callback
+    clientCallback(sessionId, state, report);
+}
+
 bool RequestAutomationMngr::isValid(int id)
 {
     std::lock_guard<std::mutex> lock(m_lock);
-    if (m_requestGenList.end() != m_requestGenList.find(id))
+    if (m_requestGenList.end() != m_requestGenList.find(id)
+        || m_loadGenList.end() != m_loadGenList.find(id))
     {
         return true;
     }
@@ -228,4 +280,8 @@ void RequestAutomationMngr::remove(int id)
     {
         m_requestGenList.erase(m_requestGenList.find(id));
     }
+    else if (m_loadGenList.end() != m_loadGenList.find(id))
+    {
+        m_loadGenList.erase(m_loadGenList.find(id));
+    }
 }
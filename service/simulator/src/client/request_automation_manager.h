@@ -32,6 +32,7 @@
 #include <unordered_map>
 
 #include "request_generation.h"
+#include "load_generator.h"
 
 namespace OC
 {
@@ -53,17 +54,25 @@ class RequestAutomationMngr
         int startOnPOST(const std::shared_ptr<RequestModel> &requestSchema,
                         RequestGeneration::ProgressStateCallback callback);
 
+        int startLoadTest(const LoadTestConfig &config,
+                          const SimulatorResourceModel &representation,
+                          LoadGenerator::ProgressStateCallback callback);
+
         void stop(int id);
 
     private:
         void onProgressChange(int sessionId, OperationState state,
                               RequestGeneration::ProgressStateCallback clientCallback);
+        void onLoadTestProgress(int sessionId, OperationState state,
+                                const LoadTestReport &report,
+                                LoadGenerator::ProgressStateCallback clientCallback);
         bool isValid(int id);
         bool isInProgress(RequestType type);
         void remove(int id);
 
         std::mutex m_lock;
         std::unordered_map<int, std::shared_ptr<RequestGeneration>> m_requestGenList;
+        std::unordered_map<int, LoadGeneratorSP> m_loadGenList;
         int m_id;
         std::shared_ptr<OC::OCResource> m_ocResource;
 };
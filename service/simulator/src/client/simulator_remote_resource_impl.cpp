@@ -448,6 +448,49 @@ void SimulatorRemoteResourceImpl::stopAutoRequesting(int id)
     m_requestAutomationMngr.stop(id);
 }
 
+int SimulatorRemoteResourceImpl::startLoadTest(const LoadTestConfig &config,
+        LoadTestCallback callback)
+{
+    VALIDATE_CALLBACK(callback)
+
+    SimulatorResourceModel representation;
+    switch (config.type)
+    {
+        case RequestType::RQ_TYPE_GET:
+            break;
+
+        case RequestType::RQ_TYPE_PUT:
+        case RequestType::RQ_TYPE_POST:
+            {
+                // Requests carry the representation described by the request model
+                std::string requestType = requestTypeToString(config.type);
+                if (m_requestModels.end() == m_requestModels.find(requestType)
+                    || !m_requestModels[requestType]->getRequestRepSchema())
+                {
+                    OIC_LOG(ERROR, TAG, "Resource is not configured for this request type!");
+                    throw NoSupportException("Resource is not configured for this request type!");
+                }
+
+                representation =
+                    m_requestModels[requestType]->getRequestRepSchema()->buildResourceModel();
+            }
+            break;
+
+        case RequestType::RQ_TYPE_DELETE:
+        default:
+            throw NoSupportException("Not implemented!");
+    }
+
+    return m_requestAutomationMngr.startLoadTest(config, representation,
+            std::bind(&SimulatorRemoteResourceImpl::onLoadTestState, this, std::placeholders::_1,
+                      std::placeholders::_2, std::placeholders::_3, callback));
+}
+
+void SimulatorRemoteResourceImpl::stopLoadTest(int id)
+{
+    m_requestAutomationMngr.stop(id);
+}
+
 void SimulatorRemoteResourceImpl::onResponseReceived(SimulatorResult result,
         const SimulatorResourceModel &resourceModel, const RequestInfo &reqInfo,
         ResponseCallback callback)
@@ -461,6 +504,12 @@ void SimulatorRemoteResourceImpl::onAutoRequestingState(int sessionId, Operation
     callback(m_id, sessionId, state);
 }
 
+void SimulatorRemoteResourceImpl::onLoadTestState(int sessionId, OperationState state,
+        const LoadTestReport &report, LoadTestCallback callback)
+{
+    callback(m_id, sessionId, state, report);
+}
+
 SimulatorConnectivityType SimulatorRemoteResourceImpl::convertConnectivityType(
     OCConnectivityType type) const
 {
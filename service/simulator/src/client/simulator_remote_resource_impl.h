@@ -82,6 +82,8 @@ class SimulatorRemoteResourceImpl : public SimulatorRemoteResource
             const std::string &path);
         int startAutoRequesting(RequestType type, AutoRequestGenerationCallback callback);
         void stopAutoRequesting(int id);
+        int startLoadTest(const LoadTestConfig &config, LoadTestCallback callback);
+        void stopLoadTest(int id);
 
     private:
         void configure(const std::shared_ptr<RAML::Raml> &raml);
@@ -89,6 +91,8 @@ class SimulatorRemoteResourceImpl : public SimulatorRemoteResource
                                 const RequestInfo &reqInfo, ResponseCallback callback);
         void onAutoRequestingState(int sessionId, OperationState state,
                                    AutoRequestGenerationCallback callback);
+        void onLoadTestState(int sessionId, OperationState state, const LoadTestReport &report,
+                             LoadTestCallback callback);
         SimulatorConnectivityType convertConnectivityType(OCConnectivityType type) const;
 
         std::string m_id;
@@ -0,0 +1,129 @@
+/******************************************************************
+ *
+ * Copyright 2016 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include "bulk_update_scheduler.h"
+#include "attribute_generator.h"
+#include "simulator_exceptions.h"
+#include "simulator_logger.h"
+#include "logger.h"
+
+#define TAG "BULK_UPDATE_SCHEDULER"
+
+// Upper limit on the values generated for one attribute, ranges can be large
+#define MAX_VALUES_PER_ATTRIBUTE 32
+
+BulkUpdateScheduler::BulkUpdateScheduler(int id,
+        const std::vector<SimulatorSingleResourceImplSP> &resources, int updateRate)
+    :   m_id(id),
+        m_updateRate(updateRate),
+        m_stopRequested(false),
+        m_resources(resources),
+        m_thread(nullptr) {}
+
+BulkUpdateScheduler::~BulkUpdateScheduler()
+{
+    stop();
+}
+
+void BulkUpdateScheduler::start()
+{
+    // Build the table of values once for all the resources, from the first one's schema.
+    // Updates a resource with another schema cannot take are logged in updateResources().
+    for (auto &attributeEntry : m_resources[0]->getAttributes())
+    {
+        std::vector<SimulatorResourceAttribute> values;
+        AttributeGenerator attributeGen(attributeEntry.second);
+        SimulatorResourceAttribute attribute;
+        while (values.size() < MAX_VALUES_PER_ATTRIBUTE && attributeGen.next(attribute))
+        {
+            values.push_back(attribute);
+        }
+
+        if (values.size())
+        {
+            m_values.push_back(values);
+        }
+    }
+
+    if (0 == m_values.size())
+    {
+        OIC_LOG(ERROR, TAG, "Resource has no attribute values to update!");
+        throw SimulatorException(SIMULATOR_ERROR, "Resource has no attribute values to update!");
+    }
+
+    m_thread.reset(new std::thread(&BulkUpdateScheduler::updateResources, this));
+}
+
+void BulkUpdateScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stopRequested = true;
+    }
+
+    m_condVariable.notify_one();
+    if (m_thread && m_thread->joinable())
+        m_thread->join();
+}
+
+void BulkUpdateScheduler::updateResources()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    std::chrono::steady_clock::duration interval =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / m_updateRate));
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+
+    // Each round updates every resource once. Rounds walk through the attributes and
+    // their values, and resources are offset so neighbours do not carry the same value.
+    uint64_t tick = 0;
+    while (!m_stopRequested)
+    {
+        size_t index = tick % m_resources.size();
+        uint64_t round = tick / m_resources.size();
+        const std::vector<SimulatorResourceAttribute> &values = m_values[round % m_values.size()];
+        const SimulatorResourceAttribute &attribute =
+            values[(round / m_values.size() + index) % values.size()];
+
+        lock.unlock();
+        try
+        {
+            if (!m_resources[index]->updateAttributeValue(attribute))
+            {
+                SIM_LOG(ILogger::ERROR, "[" << m_resources[index]->getURI() << "] "
+                        << "Attribute " << attribute.getName() << " rejected the update!");
+            }
+        }
+        catch (std::exception &e)
+        {
+            // A failing resource must not stop the updates of the others
+            SIM_LOG(ILogger::ERROR, "[" << m_resources[index]->getURI() << "] "
+                    << "Error when updating attribute: " << e.what());
+        }
+        lock.lock();
+
+        tick++;
+        next += interval;
+        m_condVariable.wait_until(lock, next, [this] { return m_stopRequested; });
+    }
+
+    SIM_LOG(ILogger::INFO, "Bulk updation stopped [id: " << m_id << ", updates: " << tick
+            << "].");
+}
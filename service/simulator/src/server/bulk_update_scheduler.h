@@ -0,0 +1,71 @@
+/******************************************************************
+ *
+ * Copyright 2016 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/**
+ * @file bulk_update_scheduler.h
+ *
+ * @brief This file provides class for updating attributes of many resources from
+ *        a single thread.
+ *
+ */
+
+#ifndef SIMULATOR_BULK_UPDATE_SCHEDULER_H_
+#define SIMULATOR_BULK_UPDATE_SCHEDULER_H_
+
+#include <thread>
+#include <condition_variable>
+
+#include "simulator_single_resource_impl.h"
+
+/**
+ * @class   BulkUpdateScheduler
+ * @brief   Updates one attribute of one resource per tick, going round robin over the
+ *          resources at the configured rate. Every update notifies the observers of the
+ *          updated resource. The values come from one table built from the schema of the
+ *          first resource, so nothing is kept per resource. Resources with another schema
+ *          are not rejected: the updates they cannot take only log an error.
+ */
+class BulkUpdateScheduler
+{
+    public:
+        BulkUpdateScheduler(int id, const std::vector<SimulatorSingleResourceImplSP> &resources,
+                            int updateRate);
+
+        ~BulkUpdateScheduler();
+        void start();
+        void stop();
+
+    private:
+        void updateResources();
+
+        int m_id;
+        int m_updateRate;
+        bool m_stopRequested;
+        std::vector<SimulatorSingleResourceImplSP> m_resources;
+        std::vector<std::vector<SimulatorResourceAttribute>> m_values;
+        std::unique_ptr<std::thread> m_thread;
+
+        std::mutex m_lock;
+        std::condition_variable m_condVariable;
+};
+
+typedef std::shared_ptr<BulkUpdateScheduler> BulkUpdateSchedulerSP;
+
+#endif
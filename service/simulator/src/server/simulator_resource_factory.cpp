@@ -27,6 +27,19 @@
 
 #define TAG "SIM_RESOURCE_FACTORY"
 
+static std::shared_ptr<SimulatorResourceModelSchema> copyResourceModelSchema(
+    const std::shared_ptr<SimulatorResourceModelSchema> &resModelSchema)
+{
+    std::shared_ptr<SimulatorResourceModelSchema> copy = SimulatorResourceModelSchema::build();
+    for (auto &propertyEntry : resModelSchema->getChildProperties())
+    {
+        copy->add(propertyEntry.first, propertyEntry.second,
+                  resModelSchema->isRequired(propertyEntry.first));
+    }
+
+    return copy;
+}
+
 SimulatorResourceFactory *SimulatorResourceFactory::getInstance()
 {
     static SimulatorResourceFactory s_instance;
@@ -60,7 +73,13 @@ std::shared_ptr<SimulatorResource> SimulatorResourceFactory::createResource(
         return nullptr;
     }
 
-    return buildResource(ramlResource);
+    std::vector<std::shared_ptr<SimulatorResource> > resources = buildResources(ramlResource, 1);
+    if (!resources.size())
+    {
+        return nullptr;
+    }
+
+    return resources[0];
 }
 
 std::vector<std::shared_ptr<SimulatorResource> > SimulatorResourceFactory::createResource(
@@ -92,19 +111,7 @@ std::vector<std::shared_ptr<SimulatorResource> > SimulatorResourceFactory::creat
         return resources;
     }
 
-    while (count--)
-    {
-        std::shared_ptr<SimulatorResource> resource = buildResource(ramlResource);
-        if (!resource)
-        {
-            OIC_LOG(ERROR, TAG, "Failed to create resource!");
-            return resources;
-        }
-
-        resources.push_back(resource);
-    }
-
-    return resources;
+    return buildResources(ramlResource, count);
 }
 
 std::shared_ptr<SimulatorSingleResource> SimulatorResourceFactory::createSingleResource(
@@ -127,9 +134,11 @@ std::shared_ptr<SimulatorCollectionResource> SimulatorResourceFactory::createCol
     return std::shared_ptr<SimulatorCollectionResource>(collectionResource);
 }
 
-std::shared_ptr<SimulatorResource> SimulatorResourceFactory::buildResource(
-    const std::shared_ptr<RAML::RamlResource> &ramlResource)
+std::vector<std::shared_ptr<SimulatorResource> > SimulatorResourceFactory::buildResources(
+    const std::shared_ptr<RAML::RamlResource> &ramlResource, unsigned int count)
 {
+    std::vector<std::shared_ptr<SimulatorResource>> resources;
+
     // Build resource request and respone model schema
     RequestModelBuilder requestModelBuilder;
     std::unordered_map<std::string, RequestModelSP> requestModels =
@@ -139,7 +148,7 @@ std::shared_ptr<SimulatorResource> SimulatorResourceFactory::buildResource(
     if (requestModels.end() == requestModels.find("GET"))
     {
         OIC_LOG(ERROR, TAG, "Resource's RAML does not have GET request model!");
-        return nullptr;
+        return resources;
     }
 
     RequestModelSP getRequestModel = requestModels["GET"];
@@ -147,7 +156,7 @@ std::shared_ptr<SimulatorResource> SimulatorResourceFactory::buildResource(
     if (!getResponseModel)
     {
         OIC_LOG(ERROR, TAG, "Resource's RAML does not have response for GET request!");
-        return nullptr;
+        return resources;
     }
 
     std::shared_ptr<SimulatorResourceModelSchema> responseSchema =
@@ -155,7 +164,7 @@ std::shared_ptr<SimulatorResource> SimulatorResourceFactory::buildResource(
     if (!responseSchema)
     {
         OIC_LOG(ERROR, TAG, "Failed to get schema from response model!");
-        return nullptr;
+        return resources;
     }
 
     SimulatorResourceModel resourceModel = responseSchema->buildResourceModel();
@@ -212,48 +221,58 @@ std::shared_ptr<SimulatorResource> SimulatorResourceFactory::buildResource(
     resourceModel.remove("n");
     resourceModel.remove("id");
 
-    // Create simple/collection resource
-    std::shared_ptr<SimulatorResource> simResource;
-    if (resourceModel.contains("links"))
-    {
-        std::shared_ptr<SimulatorCollectionResourceImpl> collectionRes(
-            new SimulatorCollectionResourceImpl());
-
-        collectionRes->setName(resourceName);
-        if(!resourceType.empty())
-            collectionRes->setResourceType(resourceType);
-        if (interfaceTypes.size() > 0)
-            collectionRes->setInterface(interfaceTypes);
-        collectionRes->setURI(ResourceURIFactory::getInstance()->makeUniqueURI(resourceURI));
-
-        // Set the resource model and its schema to simulated resource
-        collectionRes->setResourceModel(resourceModel);
-        collectionRes->setResourceModelSchema(responseSchema);
-        collectionRes->setRequestModel(requestModels);
-
-        simResource = collectionRes;
-    }
-    else
+    // Create simple/collection resources. The RAML is processed only once and all the
+    // resources share the request models and the resource model schema built from it.
+    bool shared = (count > 1);
+    resources.reserve(count);
+    while (count--)
     {
-        std::shared_ptr<SimulatorSingleResourceImpl> singleRes(
-            new SimulatorSingleResourceImpl());
-
-        singleRes->setName(resourceName);
-        if(!resourceType.empty())
-            singleRes->setResourceType(resourceType);
-        if (interfaceTypes.size() > 0)
-            singleRes->setInterface(interfaceTypes);
-        singleRes->setURI(ResourceURIFactory::getInstance()->makeUniqueURI(resourceURI));
-
-        // Set the resource model and its schema to simulated resource
-        singleRes->setResourceModel(resourceModel);
-        singleRes->setResourceModelSchema(responseSchema);
-        singleRes->setRequestModel(requestModels);
-
-        simResource = singleRes;
+        std::shared_ptr<SimulatorResource> simResource;
+        if (resourceModel.contains("links"))
+        {
+            std::shared_ptr<SimulatorCollectionResourceImpl> collectionRes(
+                new SimulatorCollectionResourceImpl());
+
+            collectionRes->setName(resourceName);
+            if(!resourceType.empty())
+                collectionRes->setResourceType(resourceType);
+            if (interfaceTypes.size() > 0)
+                collectionRes->setInterface(interfaceTypes);
+            collectionRes->setURI(ResourceURIFactory::getInstance()->makeUniqueURI(resourceURI));
+
+            // Set the resource model and its schema to simulated resource. Collections
+            // do not copy the schema on change, so each one gets its own copy.
+            collectionRes->setResourceModel(resourceModel);
+            collectionRes->setResourceModelSchema(
+                shared ? copyResourceModelSchema(responseSchema) : responseSchema);
+            collectionRes->setRequestModel(requestModels);
+
+            simResource = collectionRes;
+        }
+        else
+        {
+            std::shared_ptr<SimulatorSingleResourceImpl> singleRes(
+                new SimulatorSingleResourceImpl());
+
+            singleRes->setName(resourceName);
+            if(!resourceType.empty())
+                singleRes->setResourceType(resourceType);
+            if (interfaceTypes.size() > 0)
+                singleRes->setInterface(interfaceTypes);
+            singleRes->setURI(ResourceURIFactory::getInstance()->makeUniqueURI(resourceURI));
+
+            // Set the resource model and its schema to simulated resource
+            singleRes->setResourceModel(resourceModel);
+            singleRes->setResourceModelSchema(responseSchema, shared);
+            singleRes->setRequestModel(requestModels);
+
+            simResource = singleRes;
+        }
+
+        resources.push_back(simResource);
     }
 
-    return simResource;
+    return resources;
 }
 
 void SimulatorResourceFactory::addInterfaceFromQueryParameter(
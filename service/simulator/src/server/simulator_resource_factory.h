@@ -88,8 +88,8 @@ class SimulatorResourceFactory
             const std::string &name, const std::string &uri, const std::string &resourceType);
 
     private:
-        std::shared_ptr<SimulatorResource> buildResource(
-            const std::shared_ptr<RAML::RamlResource> &ramlResource);
+        std::vector<std::shared_ptr<SimulatorResource> > buildResources(
+            const std::shared_ptr<RAML::RamlResource> &ramlResource, unsigned int count);
 
         void addInterfaceFromQueryParameter(
             std::vector<std::string> queryParamValue, std::vector<std::string> &interfaceTypes);
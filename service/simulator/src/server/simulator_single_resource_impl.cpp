@@ -32,6 +32,7 @@ SimulatorSingleResourceImpl::SimulatorSingleResourceImpl()
     m_interfaces.push_back(OC::DEFAULT_INTERFACE);
     m_property = static_cast<OCResourceProperty>(OC_DISCOVERABLE | OC_OBSERVABLE);
     m_resModelSchema = SimulatorResourceModelSchema::build();
+    m_sharedSchema = false;
 
     // Set resource supports GET, PUT and POST by default
     m_requestModels["GET"] = nullptr;
@@ -360,6 +361,7 @@ bool SimulatorSingleResourceImpl::addAttribute(
         return false;
     }
 
+    detachResourceModelSchema();
     m_resModelSchema->add(attribute.getName(), attribute.getProperty());
 
     if (notify && isStarted())
@@ -389,7 +391,7 @@ bool SimulatorSingleResourceImpl::updateAttributeValue(
     // Validate the new value against attribute schema property
     std::lock_guard<std::mutex> schemaLock(m_modelSchemaLock);
     auto property = m_resModelSchema->get(attribute.getName());
-    if (!(property->validate(attribute.getValue())))
+    if (!property || !(property->validate(attribute.getValue())))
     {
         return false;
     }
@@ -429,6 +431,7 @@ bool SimulatorSingleResourceImpl::removeAttribute(
     std::lock_guard<std::recursive_mutex> modelLock(m_modelLock);
     std::lock_guard<std::mutex> schemaLock(m_modelSchemaLock);
 
+    detachResourceModelSchema();
     m_resModelSchema->remove(attrName);
     if (!m_resModel.remove(attrName))
     {
@@ -519,10 +522,30 @@ void SimulatorSingleResourceImpl::setResourceModel(const SimulatorResourceModel
 }
 
 void SimulatorSingleResourceImpl::setResourceModelSchema(
-    const std::shared_ptr<SimulatorResourceModelSchema> &resModelSchema)
+    const std::shared_ptr<SimulatorResourceModelSchema> &resModelSchema, bool shared)
 {
     std::lock_guard<std::mutex> lock(m_modelSchemaLock);
     m_resModelSchema = resModelSchema;
+    m_sharedSchema = shared;
+}
+
+void SimulatorSingleResourceImpl::detachResourceModelSchema()
+{
+    // Schema shared with other resources is copied before changing it for this resource.
+    // The copy still refers to the same attribute properties.
+    if (!m_sharedSchema)
+        return;
+
+    std::shared_ptr<SimulatorResourceModelSchema> resModelSchema =
+        SimulatorResourceModelSchema::build();
+    for (auto &propertyEntry : m_resModelSchema->getChildProperties())
+    {
+        resModelSchema->add(propertyEntry.first, propertyEntry.second,
+                            m_resModelSchema->isRequired(propertyEntry.first));
+    }
+
+    m_resModelSchema = resModelSchema;
+    m_sharedSchema = false;
 }
 
 void SimulatorSingleResourceImpl::setRequestModel(
@@ -78,7 +78,9 @@ class SimulatorSingleResourceImpl : public SimulatorSingleResource,
         SimulatorSingleResourceImpl();
         void setResourceModel(const SimulatorResourceModel &resModel);
         void setResourceModelSchema(
-            const std::shared_ptr<SimulatorResourceModelSchema> &resModelSchema);
+            const std::shared_ptr<SimulatorResourceModelSchema> &resModelSchema,
+            bool shared = false);
+        void detachResourceModelSchema();
         void setRequestModel(
             const std::unordered_map<std::string, std::shared_ptr<RequestModel>> &requestModels);
         void notify(int observerID, const SimulatorResourceModel &resModel);
@@ -104,6 +106,7 @@ class SimulatorSingleResourceImpl : public SimulatorSingleResource,
         std::mutex m_modelSchemaLock;
         SimulatorResourceModel m_resModel;
         std::shared_ptr<SimulatorResourceModelSchema> m_resModelSchema;
+        bool m_sharedSchema;
         std::unordered_map<std::string, std::shared_ptr<RequestModel>> m_requestModels;
         UpdateAutomationMngr m_updateAutomationMgr;
         std::vector<ObserverInfo> m_observersList;
@@ -20,6 +20,7 @@
 
 #include "simulator_manager.h"
 #include "simulator_resource_factory.h"
+#include "bulk_update_scheduler.h"
 #include "simulator_remote_resource_impl.h"
 #include "simulator_utils.h"
 
@@ -30,6 +31,7 @@ SimulatorManager *SimulatorManager::getInstance()
 }
 
 SimulatorManager::SimulatorManager()
+    :   m_bulkUpdationId(0)
 {
     OC::PlatformConfig conf
     {
@@ -84,6 +86,50 @@ std::vector<std::shared_ptr<SimulatorResource>> SimulatorManager::createResource
     return resources;
 }
 
+int SimulatorManager::startBulkUpdation(
+    const std::vector<std::shared_ptr<SimulatorResource>> &resources, int updateRate)
+{
+    VALIDATE_INPUT(!resources.size(), "No resources!")
+    VALIDATE_INPUT(updateRate <= 0, "Invalid update rate!")
+
+    std::vector<SimulatorSingleResourceImplSP> singleResources;
+    singleResources.reserve(resources.size());
+    for (auto &resource : resources)
+    {
+        SimulatorSingleResourceImplSP singleResource =
+            std::dynamic_pointer_cast<SimulatorSingleResourceImpl>(resource);
+        VALIDATE_INPUT(!singleResource, "Only single resources can be updated!")
+        singleResources.push_back(singleResource);
+    }
+
+    std::lock_guard<std::mutex> lock(m_bulkUpdationLock);
+    BulkUpdateSchedulerSP scheduler = std::make_shared<BulkUpdateScheduler>(m_bulkUpdationId,
+                                      singleResources, updateRate);
+    scheduler->start();
+
+    SIM_LOG(ILogger::INFO, "Bulk updation started [resources: " << singleResources.size()
+            << ", rate: " << updateRate << ", id: " << m_bulkUpdationId << "].");
+
+    m_bulkUpdations[m_bulkUpdationId] = scheduler;
+    return m_bulkUpdationId++;
+}
+
+void SimulatorManager::stopBulkUpdation(int id)
+{
+    BulkUpdateSchedulerSP scheduler;
+    {
+        std::lock_guard<std::mutex> lock(m_bulkUpdationLock);
+        auto entry = m_bulkUpdations.find(id);
+        if (m_bulkUpdations.end() == entry)
+            return;
+
+        scheduler = entry->second;
+        m_bulkUpdations.erase(entry);
+    }
+
+    scheduler->stop();
+}
+
 std::shared_ptr<SimulatorSingleResource> SimulatorManager::createSingleResource(
     const std::string &name, const std::string &uri, const std::string &resourceType)
 {
@@ -0,0 +1,121 @@
+/******************************************************************
+ *
+ * Copyright 2016 Samsung Electronics All Rights Reserved.
+ *
+ *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "latency_histogram.h"
+
+// Values below 256 have buckets of their own, from 256 on the buckets are two wide.
+TEST(LatencyHistogramTest, ValuesBelowFirstMagnitudeAreExact)
+{
+    LatencyHistogram histogram(100000);
+    histogram.record(0);
+    histogram.record(100000);
+    EXPECT_EQ(0u, histogram.percentile(50));
+
+    histogram.reset();
+    histogram.record(255);
+    histogram.record(100000);
+    EXPECT_EQ(255u, histogram.percentile(50));
+}
+
+TEST(LatencyHistogramTest, ValuesFromFirstMagnitudeShareBuckets)
+{
+    LatencyHistogram histogram(100000);
+    histogram.record(256);
+    histogram.record(100000);
+    EXPECT_EQ(257u, histogram.percentile(50));
+
+    histogram.reset();
+    histogram.record(258);
+    histogram.record(100000);
+    EXPECT_EQ(259u, histogram.percentile(50));
+}
+
+TEST(LatencyHistogramTest, ReportedValueIsWithinOnePercent)
+{
+    LatencyHistogram histogram(10000000);
+    for (uint64_t value = 1; value <= 10000000; value = value * 3 + 1)
+    {
+        histogram.reset();
+        histogram.record(value);
+        histogram.record(10000000);
+
+        uint64_t reported = histogram.percentile(50);
+        EXPECT_LE(value, reported);
+        EXPECT_GE(value + value / 100, reported);
+    }
+}
+
+TEST(LatencyHistogramTest, Percentiles)
+{
+    LatencyHistogram histogram(1000);
+    for (uint64_t value = 1; value <= 100; value++)
+    {
+        histogram.record(value);
+    }
+
+    EXPECT_EQ(1u, histogram.percentile(0));
+    EXPECT_EQ(50u, histogram.percentile(50));
+    EXPECT_EQ(99u, histogram.percentile(99));
+    EXPECT_EQ(100u, histogram.percentile(100));
+}
+
+TEST(LatencyHistogramTest, PercentileOfEmptyHistogramIsZero)
+{
+    LatencyHistogram histogram(1000);
+
+    EXPECT_EQ(0u, histogram.percentile(0));
+    EXPECT_EQ(0u, histogram.percentile(50));
+    EXPECT_EQ(0u, histogram.percentile(100));
+}
+
+TEST(LatencyHistogramTest, ValuesAboveHighestValueAreClamped)
+{
+    LatencyHistogram histogram(1000);
+    histogram.record(5000);
+
+    EXPECT_EQ(1u, histogram.count());
+    EXPECT_EQ(1000u, histogram.min());
+    EXPECT_EQ(1000u, histogram.max());
+    EXPECT_DOUBLE_EQ(1000, histogram.mean());
+    EXPECT_EQ(1000u, histogram.percentile(50));
+    EXPECT_EQ(1000u, histogram.percentile(100));
+}
+
+TEST(LatencyHistogramTest, ResetClearsRecordedValues)
+{
+    LatencyHistogram histogram(1000);
+    histogram.record(10);
+    histogram.record(900);
+    histogram.reset();
+
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0u, histogram.min());
+    EXPECT_EQ(0u, histogram.max());
+    EXPECT_DOUBLE_EQ(0, histogram.mean());
+    EXPECT_EQ(0u, histogram.percentile(50));
+
+    histogram.record(7);
+    EXPECT_EQ(1u, histogram.count());
+    EXPECT_EQ(7u, histogram.min());
+    EXPECT_EQ(7u, histogram.max());
+    EXPECT_EQ(7u, histogram.percentile(50));
+}